@@ -0,0 +1,132 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Forces the compiler to assume the given value is read, so
+ * that the computation producing it cannot be eliminated
+ */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Forces the compiler to reload value from memory before its next use,
+ * so that a computation on it cannot be hoisted out of a loop
+ */
+template <typename T>
+inline void clobber(T& value)
+{
+	asm volatile("" : "+m"(value) : : "memory");
+}
+
+/**
+ * Forces the compiler to assume that the memory behind pointer is read,
+ * so that the stores filling it cannot be eliminated
+ */
+inline void escape(const void* pointer)
+{
+	asm volatile("" : : "g"(pointer) : "memory");
+}
+
+/**
+ * Runs a benchmark function for the given number of iterations and
+ * returns the average time taken per operation in nanoseconds
+ *
+ * @param iterations the number of times to call the function
+ * @param opsPerIteration the number of operations performed per call
+ * @param func the function to benchmark
+ */
+template <typename Func>
+inline double timeBenchmark(int iterations, long opsPerIteration, Func func)
+{
+	func(); // warm up caches before timing
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++)
+	{
+		func();
+	}
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+	return ns / ((double)iterations * opsPerIteration);
+}
+
+/**
+ * Times a benchmark function without a fixed number of iterations: the
+ * iterations double until one run takes at least minNs, and the fastest
+ * of repetitions runs of that many iterations is returned in nanoseconds
+ * per operation, which filters out interruptions by other processes
+ *
+ * @param minNs the shortest run that is long enough to time
+ * @param repetitions the number of runs to take the fastest of
+ * @param opsPerIteration the number of operations performed per call
+ * @param func the function to benchmark
+ */
+template <typename Func>
+inline double timeAdaptiveBenchmark(double minNs, int repetitions, long opsPerIteration, Func func)
+{
+	int iterations = 1;
+	double nsPerOp = timeBenchmark(iterations, opsPerIteration, func);
+
+	while (nsPerOp * iterations * opsPerIteration < minNs && iterations < (1 << 30))
+	{
+		iterations *= 2;
+		nsPerOp = timeBenchmark(iterations, opsPerIteration, func);
+	}
+
+	for (int i = 1; i < repetitions; i++)
+	{
+		double run = timeBenchmark(iterations, opsPerIteration, func);
+
+		if (run < nsPerOp)
+		{
+			nsPerOp = run;
+		}
+	}
+
+	return nsPerOp;
+}
+
+/**
+ * Runs a benchmark function for the given number of iterations and
+ * prints the average time taken per operation
+ *
+ * @param name the name of the benchmark
+ * @param iterations the number of times to call the function
+ * @param opsPerIteration the number of operations performed per call
+ * @param func the function to benchmark
+ */
+template <typename Func>
+inline double runBenchmark(const char* name, int iterations, long opsPerIteration, Func func)
+{
+	double nsPerOp = timeBenchmark(iterations, opsPerIteration, func);
+
+	printf("%-32s %10.3f ns/op\n", name, nsPerOp);
+
+	return nsPerOp;
+}
+
+/**
+ * Runs a benchmark function like runBenchmark, but prints the
+ * throughput in millions of operations per second
+ */
+template <typename Func>
+inline double runThroughputBenchmark(const char* name, int iterations, long opsPerIteration, Func func)
+{
+	double nsPerOp = timeBenchmark(iterations, opsPerIteration, func);
+
+	printf("%-32s %10.1f Mops/s\n", name, 1000.0 / nsPerOp);
+
+	return nsPerOp;
+}
+
+#endif
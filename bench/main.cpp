@@ -0,0 +1,3600 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "math3d/math3d.hpp"
+#include "math3d/expression.hpp"
+#include "math3d/kernels/table.hpp"
+#include "bench.hpp"
+
+#ifdef MATH3D_HEADER_ONLY
+	#define BUILD_MODE "header-only"
+#else
+	#define BUILD_MODE "static library"
+#endif
+
+static const int COUNT = 4096;
+static const int ITERATIONS = 2000;
+
+typedef void (*UnaryKernel)(float*, const float*);
+typedef void (*BinaryKernel)(float*, const float*, const float*);
+
+static float randomFloat()
+{
+	return (float)rand() / RAND_MAX * 200.0f - 100.0f;
+}
+
+/**
+ * Checks that a kernel reproduces the scalar reference bit-for-bit
+ * over a set of random inputs
+ */
+static bool verifyKernel(const char* name, BinaryKernel reference, BinaryKernel kernel,
+	int outSize, int aSize, int bSize)
+{
+	for (int i = 0; i < 10000; i++)
+	{
+		float a[16], b[16], expected[16], actual[16];
+
+		for (int j = 0; j < 16; j++)
+		{
+			a[j] = j < aSize ? randomFloat() : 0;
+			b[j] = j < bSize ? randomFloat() : 0;
+		}
+
+		reference(expected, a, b);
+		kernel(actual, a, b);
+
+		if (memcmp(expected, actual, outSize * sizeof(float)) != 0)
+		{
+			printf("%s does not match the scalar kernel\n", name);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool verifyKernel(const char* name, UnaryKernel reference, UnaryKernel kernel,
+	int outSize, int inSize)
+{
+	for (int i = 0; i < 10000; i++)
+	{
+		float in[16], expected[16], actual[16];
+
+		for (int j = 0; j < 16; j++)
+		{
+			in[j] = j < inSize ? randomFloat() : 0;
+		}
+
+		reference(expected, in);
+		kernel(actual, in);
+
+		if (memcmp(expected, actual, outSize * sizeof(float)) != 0)
+		{
+			printf("%s does not match the scalar kernel\n", name);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Checks that m * inverse is the identity matrix, to within the
+ * rounding error of a float inverse
+ */
+template <typename T>
+static bool verifyInverse(const char* type, const char* name, const Matrix4x4T<T>& m, const Matrix4x4T<T>& inverse)
+{
+	Matrix4x4T<T> product = m * inverse;
+
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			T expected = x == y ? 1 : 0;
+
+			if (fabs(product[y][x] - expected) > 1e-4)
+			{
+				printf("%s::%s is not the inverse of the matrix\n", type, name);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/** @brief checks each inverse on the kind of matrix it is meant for */
+template <typename T>
+static bool verifyInverses(const char* type)
+{
+	Matrix4x4T<T> projection = Matrix4x4T<T>::perspective(1.2f, 16.0f / 9.0f, 0.1f, 100.0f);
+	Matrix4x4T<T> rigid = Matrix4x4T<T>::position(1.0f, -2.0f, 3.0f) * Matrix4x4T<T>::rotation(0.3f, 0.2f, 0.1f);
+	Matrix4x4T<T> affine = rigid * Matrix4x4T<T>::scale(2.0f, 0.5f, 4.0f);
+	bool verified = true;
+
+	verified &= verifyInverse(type, "inverse (projection)", projection, projection.inverse());
+	verified &= verifyInverse(type, "inverse (affine)", affine, affine.inverse());
+	verified &= verifyInverse(type, "inverseAffine", affine, affine.inverseAffine());
+	verified &= verifyInverse(type, "inverseRigid", rigid, rigid.inverseRigid());
+
+	return verified;
+}
+
+/** @brief fills n floats with random values */
+static std::vector<float> randomStream(size_t n)
+{
+	std::vector<float> v(n);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		v[i] = randomFloat();
+	}
+
+	return v;
+}
+
+/**
+ * Makes a palette of random rigid bone transforms as both matrices and
+ * dual quaternions
+ */
+static void makeBonePalette(int bones, std::vector<Affine3x4>& matrices, std::vector<DualQuaternion>& dualQuaternions)
+{
+	matrices.clear();
+	dualQuaternions.clear();
+
+	for (int i = 0; i < bones; i++)
+	{
+		Transform t(Vector3(randomFloat(), randomFloat(), randomFloat()),
+			Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize(), Vector3(1, 1, 1));
+
+		matrices.push_back(t.getAffineTransformation());
+		dualQuaternions.push_back(DualQuaternion::fromTransform(t));
+	}
+}
+
+/** @brief binds n vertices to 4 random bones each, with weights that sum to 1 */
+static void makeBoneWeights(size_t n, int bones, std::vector<uint16_t> (&indices)[4], std::vector<float> (&weights)[4])
+{
+	for (int k = 0; k < 4; k++)
+	{
+		indices[k].resize(n);
+		weights[k].resize(n);
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		float w[4], sum = 0;
+
+		for (int k = 0; k < 4; k++)
+		{
+			indices[k][i] = (uint16_t)(rand() % bones);
+			w[k] = (float)rand() / RAND_MAX + 0.01f;
+			sum += w[k];
+		}
+
+		for (int k = 0; k < 4; k++)
+		{
+			weights[k][i] = w[k] / sum;
+		}
+	}
+}
+
+/**
+ * Checks that the batch kernels of a table reproduce the reference
+ * bit-for-bit, using a count that exercises the scalar tail loops
+ */
+static bool verifyBatchKernels(const Kernels& reference, const Kernels& kernels)
+{
+	const size_t n = 1003;
+	std::vector<float> a[3] = {randomStream(n), randomStream(n), randomStream(n)};
+	std::vector<float> b[3] = {randomStream(n), randomStream(n), randomStream(n)};
+	std::vector<float> expected[3] = {std::vector<float>(n), std::vector<float>(n), std::vector<float>(n)};
+	std::vector<float> actual[3] = {std::vector<float>(n), std::vector<float>(n), std::vector<float>(n)};
+	bool verified = true;
+
+	auto check = [&](const char* name, int streams)
+	{
+		for (int i = 0; i < streams; i++)
+		{
+			if (memcmp(expected[i].data(), actual[i].data(), n * sizeof(float)) != 0)
+			{
+				printf("%s does not match the scalar kernel\n", name);
+				verified = false;
+				return;
+			}
+		}
+	};
+
+	reference.streamAdd(expected[0].data(), a[0].data(), b[0].data(), n);
+	kernels.streamAdd(actual[0].data(), a[0].data(), b[0].data(), n);
+	check("streamAdd", 1);
+
+	reference.streamSub(expected[0].data(), a[0].data(), b[0].data(), n);
+	kernels.streamSub(actual[0].data(), a[0].data(), b[0].data(), n);
+	check("streamSub", 1);
+
+	reference.streamMul(expected[0].data(), a[0].data(), b[0].data(), n);
+	kernels.streamMul(actual[0].data(), a[0].data(), b[0].data(), n);
+	check("streamMul", 1);
+
+	reference.streamScale(expected[0].data(), a[0].data(), 0.37f, n);
+	kernels.streamScale(actual[0].data(), a[0].data(), 0.37f, n);
+	check("streamScale", 1);
+
+	reference.vec3Dot(expected[0].data(), a[0].data(), a[1].data(), a[2].data(), b[0].data(), b[1].data(), b[2].data(), n);
+	kernels.vec3Dot(actual[0].data(), a[0].data(), a[1].data(), a[2].data(), b[0].data(), b[1].data(), b[2].data(), n);
+	check("vec3Dot", 1);
+
+	reference.vec3Cross(expected[0].data(), expected[1].data(), expected[2].data(),
+		a[0].data(), a[1].data(), a[2].data(), b[0].data(), b[1].data(), b[2].data(), n);
+	kernels.vec3Cross(actual[0].data(), actual[1].data(), actual[2].data(),
+		a[0].data(), a[1].data(), a[2].data(), b[0].data(), b[1].data(), b[2].data(), n);
+	check("vec3Cross", 3);
+
+	reference.vec3MagSq(expected[0].data(), a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.vec3MagSq(actual[0].data(), a[0].data(), a[1].data(), a[2].data(), n);
+	check("vec3MagSq", 1);
+
+	reference.vec3Magnitude(expected[0].data(), a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.vec3Magnitude(actual[0].data(), a[0].data(), a[1].data(), a[2].data(), n);
+	check("vec3Magnitude", 1);
+
+	reference.vec3Normalize(expected[0].data(), expected[1].data(), expected[2].data(),
+		a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.vec3Normalize(actual[0].data(), actual[1].data(), actual[2].data(),
+		a[0].data(), a[1].data(), a[2].data(), n);
+	check("vec3Normalize", 3);
+
+	// the fast kernels use hardware estimates, so they are only checked against the documented error
+	kernels.vec3NormalizeFast(actual[0].data(), actual[1].data(), actual[2].data(),
+		a[0].data(), a[1].data(), a[2].data(), n);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (fabsf(actual[0][i] - expected[0][i]) > 1e-6f || fabsf(actual[1][i] - expected[1][i]) > 1e-6f ||
+			fabsf(actual[2][i] - expected[2][i]) > 1e-6f)
+		{
+			printf("vec3NormalizeFast exceeds its error bound\n");
+			verified = false;
+			break;
+		}
+	}
+
+	float m[16];
+
+	for (int i = 0; i < 16; i++)
+	{
+		m[i] = randomFloat();
+	}
+
+	reference.mat4TransformPoints(expected[0].data(), expected[1].data(), expected[2].data(), m,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.mat4TransformPoints(actual[0].data(), actual[1].data(), actual[2].data(), m,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	check("mat4TransformPoints", 3);
+
+	reference.mat4TransformDirections(expected[0].data(), expected[1].data(), expected[2].data(), m,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.mat4TransformDirections(actual[0].data(), actual[1].data(), actual[2].data(), m,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	check("mat4TransformDirections", 3);
+
+	reference.mat4TransformHomogeneous(expected[0].data(), expected[1].data(), expected[2].data(), m,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.mat4TransformHomogeneous(actual[0].data(), actual[1].data(), actual[2].data(), m,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	check("mat4TransformHomogeneous", 3);
+
+	std::vector<float> t(n);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		t[i] = (float)rand() / RAND_MAX;
+	}
+
+	reference.streamLerp(expected[0].data(), a[0].data(), b[0].data(), t.data(), n);
+	kernels.streamLerp(actual[0].data(), a[0].data(), b[0].data(), t.data(), n);
+	check("streamLerp", 1);
+
+	// unit quaternions, every other pair close enough for quatSlerp to nlerp
+	std::vector<float> qa[4], qb[4], qExpected[4], qActual[4];
+
+	for (int c = 0; c < 4; c++)
+	{
+		qa[c].resize(n);
+		qb[c].resize(n);
+		qExpected[c].resize(n);
+		qActual[c].resize(n);
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		Quaternion from = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+		Quaternion to = i % 2 == 0 ? Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize()
+			: Quaternion(from.x + 0.001f, from.y, from.z, -from.w).normalize();
+
+		qa[0][i] = from.x;
+		qa[1][i] = from.y;
+		qa[2][i] = from.z;
+		qa[3][i] = from.w;
+		qb[0][i] = to.x;
+		qb[1][i] = to.y;
+		qb[2][i] = to.z;
+		qb[3][i] = to.w;
+	}
+
+	auto checkQuaternions = [&](const char* name)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			if (qExpected[c] != qActual[c])
+			{
+				printf("%s does not match the scalar kernel\n", name);
+				verified = false;
+				return;
+			}
+		}
+	};
+
+	reference.quatNlerp(qExpected[0].data(), qExpected[1].data(), qExpected[2].data(), qExpected[3].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), qb[0].data(), qb[1].data(), qb[2].data(), qb[3].data(),
+		t.data(), n);
+	kernels.quatNlerp(qActual[0].data(), qActual[1].data(), qActual[2].data(), qActual[3].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), qb[0].data(), qb[1].data(), qb[2].data(), qb[3].data(),
+		t.data(), n);
+	checkQuaternions("quatNlerp");
+
+	reference.quatSlerp(qExpected[0].data(), qExpected[1].data(), qExpected[2].data(), qExpected[3].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), qb[0].data(), qb[1].data(), qb[2].data(), qb[3].data(),
+		t.data(), n);
+	kernels.quatSlerp(qActual[0].data(), qActual[1].data(), qActual[2].data(), qActual[3].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), qb[0].data(), qb[1].data(), qb[2].data(), qb[3].data(),
+		t.data(), n);
+	checkQuaternions("quatSlerp");
+
+	float rotation[4] = {qa[0][0], qa[1][0], qa[2][0], qa[3][0]};
+
+	reference.quatRotateVectors(expected[0].data(), expected[1].data(), expected[2].data(), rotation,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.quatRotateVectors(actual[0].data(), actual[1].data(), actual[2].data(), rotation,
+		a[0].data(), a[1].data(), a[2].data(), n);
+	check("quatRotateVectors", 3);
+
+	reference.quatsRotateVectors(expected[0].data(), expected[1].data(), expected[2].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.quatsRotateVectors(actual[0].data(), actual[1].data(), actual[2].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), a[0].data(), a[1].data(), a[2].data(), n);
+	check("quatsRotateVectors", 3);
+
+	// some zeros in a[1] and b[0], so that atan2(0, 0) and the axes are covered
+	for (size_t i = 0; i < n; i += 97)
+	{
+		b[0][i] = 0;
+		a[1][i] = 0;
+	}
+
+	reference.streamSinCos(expected[0].data(), expected[1].data(), a[0].data(), n);
+	kernels.streamSinCos(actual[0].data(), actual[1].data(), a[0].data(), n);
+	check("streamSinCos", 2);
+
+	reference.streamAtan2(expected[0].data(), a[1].data(), b[0].data(), n);
+	kernels.streamAtan2(actual[0].data(), a[1].data(), b[0].data(), n);
+	check("streamAtan2", 1);
+
+	reference.quatFromEulerAngles(qExpected[0].data(), qExpected[1].data(), qExpected[2].data(), qExpected[3].data(),
+		a[0].data(), a[1].data(), a[2].data(), n);
+	kernels.quatFromEulerAngles(qActual[0].data(), qActual[1].data(), qActual[2].data(), qActual[3].data(),
+		a[0].data(), a[1].data(), a[2].data(), n);
+	checkQuaternions("quatFromEulerAngles");
+
+	reference.quatFromAxisAngle(qExpected[0].data(), qExpected[1].data(), qExpected[2].data(), qExpected[3].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), a[0].data(), n);
+	kernels.quatFromAxisAngle(qActual[0].data(), qActual[1].data(), qActual[2].data(), qActual[3].data(),
+		qa[0].data(), qa[1].data(), qa[2].data(), a[0].data(), n);
+	checkQuaternions("quatFromAxisAngle");
+
+	std::vector<Affine3x4> bones;
+	std::vector<DualQuaternion> dualBones;
+	std::vector<uint16_t> boneIndices[4];
+	std::vector<float> boneWeights[4];
+
+	makeBonePalette(61, bones, dualBones);
+	makeBoneWeights(n, 61, boneIndices, boneWeights);
+
+	const uint16_t* indices[4] = {boneIndices[0].data(), boneIndices[1].data(), boneIndices[2].data(), boneIndices[3].data()};
+	const float* weights[4] = {boneWeights[0].data(), boneWeights[1].data(), boneWeights[2].data(), boneWeights[3].data()};
+
+	for (int influences = 1; influences <= 4; influences++)
+	{
+		reference.skinLinear(expected[0].data(), expected[1].data(), expected[2].data(),
+			a[0].data(), a[1].data(), a[2].data(), indices, weights, influences, &bones[0].matrix[0][0], 12, n);
+		kernels.skinLinear(actual[0].data(), actual[1].data(), actual[2].data(),
+			a[0].data(), a[1].data(), a[2].data(), indices, weights, influences, &bones[0].matrix[0][0], 12, n);
+		check("skinLinear", 3);
+
+		reference.skinDualQuat(expected[0].data(), expected[1].data(), expected[2].data(),
+			a[0].data(), a[1].data(), a[2].data(), indices, weights, influences, &dualBones[0].real.x, n);
+		kernels.skinDualQuat(actual[0].data(), actual[1].data(), actual[2].data(),
+			a[0].data(), a[1].data(), a[2].data(), indices, weights, influences, &dualBones[0].real.x, n);
+		check("skinDualQuat", 3);
+	}
+
+	std::vector<uint32_t> expectedPacked32(n), actualPacked32(n);
+	std::vector<uint16_t> expectedPacked16(3 * n), actualPacked16(3 * n);
+
+	reference.quatPack32(expectedPacked32.data(), qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), n);
+	kernels.quatPack32(actualPacked32.data(), qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), n);
+
+	if (expectedPacked32 != actualPacked32)
+	{
+		printf("quatPack32 does not match the scalar kernel\n");
+		verified = false;
+	}
+
+	reference.quatUnpack32(qExpected[0].data(), qExpected[1].data(), qExpected[2].data(), qExpected[3].data(),
+		expectedPacked32.data(), n);
+	kernels.quatUnpack32(qActual[0].data(), qActual[1].data(), qActual[2].data(), qActual[3].data(),
+		expectedPacked32.data(), n);
+	checkQuaternions("quatUnpack32");
+
+	reference.quatPack48(expectedPacked16.data(), qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), n);
+	kernels.quatPack48(actualPacked16.data(), qa[0].data(), qa[1].data(), qa[2].data(), qa[3].data(), n);
+
+	if (expectedPacked16 != actualPacked16)
+	{
+		printf("quatPack48 does not match the scalar kernel\n");
+		verified = false;
+	}
+
+	reference.quatUnpack48(qExpected[0].data(), qExpected[1].data(), qExpected[2].data(), qExpected[3].data(),
+		expectedPacked16.data(), n);
+	kernels.quatUnpack48(qActual[0].data(), qActual[1].data(), qActual[2].data(), qActual[3].data(),
+		expectedPacked16.data(), n);
+	checkQuaternions("quatUnpack48");
+
+	// a range narrower than the values, so that clamping is exercised too
+	reference.streamQuantize16(expectedPacked16.data(), a[0].data(), -80, 65535 / 160.0f, n);
+	kernels.streamQuantize16(actualPacked16.data(), a[0].data(), -80, 65535 / 160.0f, n);
+
+	if (expectedPacked16 != actualPacked16)
+	{
+		printf("streamQuantize16 does not match the scalar kernel\n");
+		verified = false;
+	}
+
+	reference.streamDequantize16(expected[0].data(), expectedPacked16.data(), -80, 160 / 65535.0f, n);
+	kernels.streamDequantize16(actual[0].data(), expectedPacked16.data(), -80, 160 / 65535.0f, n);
+	check("streamDequantize16", 1);
+
+	std::vector<float> interleaved(n * 3);
+	std::vector<float> expectedInterleaved(n * 3);
+	std::vector<float> actualInterleaved(n * 3);
+	reference.vec3Interleave(interleaved.data(), a[0].data(), a[1].data(), a[2].data(), n);
+
+	reference.vec3Deinterleave(expected[0].data(), expected[1].data(), expected[2].data(), interleaved.data(), n);
+	kernels.vec3Deinterleave(actual[0].data(), actual[1].data(), actual[2].data(), interleaved.data(), n);
+	check("vec3Deinterleave", 3);
+
+	reference.vec3Interleave(expectedInterleaved.data(), b[0].data(), b[1].data(), b[2].data(), n);
+	kernels.vec3Interleave(actualInterleaved.data(), b[0].data(), b[1].data(), b[2].data(), n);
+
+	if (expectedInterleaved != actualInterleaved)
+	{
+		printf("vec3Interleave does not match the scalar kernel\n");
+		verified = false;
+	}
+
+	// planes at a distance of 60 from the origin, so that some of the objects are culled by each
+	float planes[24];
+
+	for (int p = 0; p < 6; p++)
+	{
+		Vector3 normal = Vector3(randomFloat(), randomFloat(), randomFloat()).normalize();
+
+		planes[4 * p + 0] = normal.x;
+		planes[4 * p + 1] = normal.y;
+		planes[4 * p + 2] = normal.z;
+		planes[4 * p + 3] = 60;
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			b[j][i] = fabsf(b[j][i]) * 0.25f;
+		}
+	}
+
+	std::vector<uint32_t> expectedVisible(n), actualVisible(n);
+	size_t expectedCount = reference.frustumCullSpheres(expectedVisible.data(), planes,
+		a[0].data(), a[1].data(), a[2].data(), b[0].data(), 7, n);
+	size_t actualCount = kernels.frustumCullSpheres(actualVisible.data(), planes,
+		a[0].data(), a[1].data(), a[2].data(), b[0].data(), 7, n);
+
+	if (expectedCount != actualCount || memcmp(expectedVisible.data(), actualVisible.data(), actualCount * sizeof(uint32_t)) != 0)
+	{
+		printf("frustumCullSpheres does not match the scalar kernel\n");
+		verified = false;
+	}
+
+	expectedCount = reference.frustumCullBoxes(expectedVisible.data(), planes,
+		a[0].data(), a[1].data(), a[2].data(), b[0].data(), b[1].data(), b[2].data(), 7, n);
+	actualCount = kernels.frustumCullBoxes(actualVisible.data(), planes,
+		a[0].data(), a[1].data(), a[2].data(), b[0].data(), b[1].data(), b[2].data(), 7, n);
+
+	if (expectedCount != actualCount || memcmp(expectedVisible.data(), actualVisible.data(), actualCount * sizeof(uint32_t)) != 0)
+	{
+		printf("frustumCullBoxes does not match the scalar kernel\n");
+		verified = false;
+	}
+
+	// n boxes of 6 floats, with a matrix of 12 floats each or a single one
+	std::vector<float> boxes = randomStream(6 * n), matrices = randomStream(12 * n);
+	std::vector<float> expectedBoxes(6 * n), actualBoxes(6 * n);
+
+	for (size_t stride = 0; stride <= 12; stride += 12)
+	{
+		reference.aabbTransform(expectedBoxes.data(), boxes.data(), matrices.data(), stride, n);
+		kernels.aabbTransform(actualBoxes.data(), boxes.data(), matrices.data(), stride, n);
+
+		if (expectedBoxes != actualBoxes)
+		{
+			printf("aabbTransform does not match the scalar kernel\n");
+			verified = false;
+		}
+	}
+
+	// in place
+	actualBoxes = boxes;
+	kernels.aabbTransform(actualBoxes.data(), actualBoxes.data(), matrices.data(), 12, n);
+
+	if (expectedBoxes != actualBoxes)
+	{
+		printf("aabbTransform does not match the scalar kernel in place\n");
+		verified = false;
+	}
+
+	// n large triangles as streams of their first vertex and edges, and
+	// rays through the origin from random points, so that most rays hit some
+	std::vector<float> triangles = randomStream(9 * n);
+
+	for (size_t i = 0; i < 3 * n; i++)
+	{
+		triangles[i] *= 0.1f;
+	}
+
+	for (int i = 0; i < 64; i++)
+	{
+		const float ray[6] = {a[0][i], a[1][i], a[2][i], -a[0][i], -a[1][i], -a[2][i]};
+		float expectedT = 2, expectedU = 0, expectedV = 0;
+		float actualT = 2, actualU = 0, actualV = 0;
+
+		// all of them, and a few at an offset into the streams
+		size_t offset = i % 2 == 0 ? 0 : (size_t)i;
+		size_t count = i % 2 == 0 ? n : 7 + i % 16;
+		size_t expectedIndex = reference.rayTriangles(ray, triangles.data() + offset, n, count, expectedT, expectedU, expectedV);
+		size_t actualIndex = kernels.rayTriangles(ray, triangles.data() + offset, n, count, actualT, actualU, actualV);
+
+		if (expectedIndex != actualIndex || expectedT != actualT || expectedU != actualU || expectedV != actualV)
+		{
+			printf("rayTriangles does not match the scalar kernel\n");
+			verified = false;
+			break;
+		}
+	}
+
+	// n rays through the origin against each of a few of the triangles
+	std::vector<float> directions[3] = {a[0], a[1], a[2]};
+
+	for (size_t i = 0; i < n; i++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			directions[c][i] = -a[c][i];
+		}
+	}
+
+	std::vector<float> expectedHits[3] = {std::vector<float>(n, 2.0f), std::vector<float>(n), std::vector<float>(n)};
+	std::vector<float> actualHits[3] = {std::vector<float>(n, 2.0f), std::vector<float>(n), std::vector<float>(n)};
+	std::vector<uint32_t> expectedTriangles(n, ~0u), actualTriangles(n, ~0u);
+
+	for (uint32_t t = 0; t < 16; t++)
+	{
+		float triangle[9];
+
+		for (int s = 0; s < 9; s++)
+		{
+			triangle[s] = triangles[s * n + t];
+		}
+
+		expectedCount = reference.raysTriangle(expectedTriangles.data(), expectedHits[0].data(), expectedHits[1].data(),
+			expectedHits[2].data(), triangle, t, a[0].data(), a[1].data(), a[2].data(),
+			directions[0].data(), directions[1].data(), directions[2].data(), n);
+		actualCount = kernels.raysTriangle(actualTriangles.data(), actualHits[0].data(), actualHits[1].data(),
+			actualHits[2].data(), triangle, t, a[0].data(), a[1].data(), a[2].data(),
+			directions[0].data(), directions[1].data(), directions[2].data(), n);
+
+		if (expectedCount != actualCount || expectedTriangles != actualTriangles || expectedHits[0] != actualHits[0] ||
+			expectedHits[1] != actualHits[1] || expectedHits[2] != actualHits[2])
+		{
+			printf("raysTriangle does not match the scalar kernel\n");
+			verified = false;
+			break;
+		}
+	}
+
+	return verified;
+}
+
+#ifndef MATH3D_HEADER_ONLY
+/** @brief checks every kernel in a dispatch table against the scalar table */
+static bool verifyKernels(SIMDLevel level)
+{
+	const Kernels& reference = Dispatch::kernels(SIMDLevel::Scalar);
+	const Kernels& kernels = Dispatch::kernels(level);
+	bool verified = true;
+
+	verified &= verifyKernel("mat4Mul", reference.mat4Mul, kernels.mat4Mul, 16, 16, 16);
+	verified &= verifyKernel("mat4Inverse", reference.mat4Inverse, kernels.mat4Inverse, 16, 16);
+	verified &= verifyKernel("mat4InverseAffine", reference.mat4InverseAffine, kernels.mat4InverseAffine, 16, 16);
+	verified &= verifyKernel("mat4TransformPoint", reference.mat4TransformPoint, kernels.mat4TransformPoint, 3, 16, 3);
+	verified &= verifyKernel("affineMul", reference.affineMul, kernels.affineMul, 12, 12, 12);
+	verified &= verifyKernel("affineInverse", reference.affineInverse, kernels.affineInverse, 12, 12);
+	verified &= verifyKernel("quatMul", reference.quatMul, kernels.quatMul, 4, 4, 4);
+	verified &= verifyKernel("quatNormalize", reference.quatNormalize, kernels.quatNormalize, 4, 4);
+	verified &= verifyBatchKernels(reference, kernels);
+
+	if (!verified)
+	{
+		printf("kernels for %s failed verification\n", Dispatch::levelName(level));
+	}
+
+	return verified;
+}
+#endif
+
+static void benchMat4Mul(const char* name, BinaryKernel kernel, const std::vector<Matrix4x4>& m)
+{
+	runBenchmark(name, ITERATIONS, COUNT, [&]()
+	{
+		Matrix4x4 acc = Matrix4x4::identity();
+		Matrix4x4 tmp;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			kernel(&tmp.matrix[0][0], &acc.matrix[0][0], &m[i].matrix[0][0]);
+			acc = tmp;
+		}
+
+		doNotOptimize(acc);
+	});
+}
+
+/**
+ * Measures point transform throughput from cache-resident sizes up to
+ * ones bound by memory bandwidth, comparing a per-point operator* loop
+ * with the batch API on Vector3 arrays (AoS) and Vector3Array (SoA)
+ */
+static void benchTransformPoints()
+{
+	const long MAX_POINTS = 100000000;
+	Matrix4x4 m = Matrix4x4::position(1.0f, 2.0f, 3.0f) * Matrix4x4::rotation(0.1f, 0.2f, 0.3f);
+
+	for (long count = 1000; count <= MAX_POINTS; count *= 10)
+	{
+		// about 200M points per measurement, at least once
+		int iterations = count >= 200000000 ? 1 : (int)(200000000 / count);
+		char name[64];
+
+		std::vector<Vector3> aos(count, Vector3(1.0f, 2.0f, 3.0f));
+
+		snprintf(name, sizeof(name), "loop operator* (%ld)", count);
+		runThroughputBenchmark(name, iterations, count, [&]()
+		{
+			for (long i = 0; i < count; i++)
+			{
+				aos[i] = m * aos[i];
+			}
+
+			doNotOptimize(aos[0]);
+		});
+
+		snprintf(name, sizeof(name), "transformPoints AoS (%ld)", count);
+		runThroughputBenchmark(name, iterations, count, [&]()
+		{
+			m.transformPoints(aos.data(), aos.data(), count);
+			doNotOptimize(aos[0]);
+		});
+
+		std::vector<Vector3>().swap(aos);
+		Vector3Array soa(count);
+
+		snprintf(name, sizeof(name), "transformPoints SoA (%ld)", count);
+		runThroughputBenchmark(name, iterations, count, [&]()
+		{
+			m.transformPoints(soa, soa);
+			doNotOptimize(soa.x()[0]);
+		});
+	}
+}
+
+/**
+ * Compares recomputing every world matrix of a scene graph each frame
+ * with TransformHierarchy::update when only some nodes moved
+ */
+static void benchTransformHierarchy()
+{
+	const int NODES = 10000;
+	TransformHierarchy hierarchy;
+	std::vector<Transform> locals;
+	std::vector<int> parents;
+
+	for (int i = 0; i < NODES; i++)
+	{
+		Transform local(Vector3(1.0f, 0.5f, 0.25f * i), Quaternion::fromAxisAngle(Vector3(0, 1, 0), i * 0.001f),
+			Vector3(1, 1, 1));
+		int parent = i == 0 ? -1 : (i - 1) / 4;
+
+		locals.push_back(local);
+		parents.push_back(parent);
+		hierarchy.add(local, parent < 0 ? TransformHierarchy::NONE : (size_t)parent);
+	}
+
+	hierarchy.update();
+
+	std::vector<Matrix4x4> world(NODES);
+
+	runBenchmark("hierarchy recompute all", ITERATIONS / 10, NODES, [&]()
+	{
+		for (int i = 0; i < NODES; i++)
+		{
+			Matrix4x4 local = locals[i].getTransformation();
+			world[i] = parents[i] < 0 ? local : world[parents[i]] * local;
+		}
+
+		doNotOptimize(world[NODES - 1]);
+	});
+
+	float angle = 0;
+
+	runBenchmark("hierarchy update (1% dirty)", ITERATIONS / 10, NODES, [&]()
+	{
+		angle += 0.01f;
+
+		// move the last 1% of the nodes, which are all leaves
+		for (int i = NODES - 1; i >= NODES - NODES / 100; i--)
+		{
+			hierarchy.setRotation(i, Quaternion::fromAxisAngle(Vector3(0, 1, 0), angle));
+		}
+
+		hierarchy.update();
+		doNotOptimize(hierarchy.getWorldMatrices()[NODES - 1]);
+	});
+
+	runBenchmark("hierarchy update (root dirty)", ITERATIONS / 10, NODES, [&]()
+	{
+		angle += 0.01f;
+
+		hierarchy.setRotation(0, Quaternion::fromAxisAngle(Vector3(0, 1, 0), angle));
+		hierarchy.update();
+		doNotOptimize(hierarchy.getWorldMatrices()[NODES - 1]);
+	});
+}
+
+/** @brief builds a clip of bones that each rotate and move through keys keyframes over one second */
+static AnimationClip makeClip(int bones, int keys)
+{
+	AnimationClip clip(bones);
+
+	for (int bone = 0; bone < bones; bone++)
+	{
+		Vector3 axis = Vector3(randomFloat(), randomFloat(), randomFloat()).normalize();
+
+		for (int key = 0; key < keys; key++)
+		{
+			float time = (float)key / (keys - 1);
+
+			clip[bone].translation.add(time, Vector3(randomFloat(), randomFloat(), randomFloat()) * 0.01f);
+			clip[bone].rotation.add(time, Quaternion::fromAxisAngle(axis, randomFloat() * 0.05f));
+		}
+	}
+
+	return clip;
+}
+
+/**
+ * Samples a track the way the sampler replaces: a binary search for the
+ * keyframes, then one Quaternion::slerp or nlerp and Vector3 lerp per bone
+ */
+static Transform sampleTrack(const TransformTrack& track, float time, bool slerp)
+{
+	const float* times = track.rotation.times();
+	size_t count = track.rotation.size();
+	size_t next = std::upper_bound(times, times + count, time) - times;
+	size_t key = next == 0 ? 0 : next - 1;
+	float t = 0;
+
+	if (next == 0 || next == count)
+	{
+		next = key;
+	}
+	else
+	{
+		t = (time - times[key]) / (times[next] - times[key]);
+	}
+
+	Quaternion from = track.rotation.getValue(key);
+	Quaternion to = track.rotation.getValue(next);
+	Vector3 a = track.translation.getValue(key);
+	Vector3 b = track.translation.getValue(next);
+
+	return Transform(a + (b - a) * t, slerp ? from.slerp(to, t) : from.nlerp(to, t), Vector3(1, 1, 1));
+}
+
+/** @brief checks the sampler against per-bone interpolation over a playthrough and a rewind */
+static bool verifyAnimationSampler()
+{
+	const int BONES = 37;
+	AnimationClip clip = makeClip(BONES, 9);
+	AnimationSampler sampler(clip);
+	std::vector<Transform> sampled(BONES);
+	const float times[] = {-0.5f, 0.0f, 0.1f, 0.125f, 0.4f, 0.99f, 1.5f, 0.3f, 0.7f};
+
+	for (int interpolation = 0; interpolation < 2; interpolation++)
+	{
+		bool slerp = interpolation == 1;
+
+		sampler.setInterpolation(slerp ? RotationInterpolation::Slerp : RotationInterpolation::Nlerp);
+
+		for (float time : times)
+		{
+			sampler.sample(time, sampled.data());
+
+			for (int bone = 0; bone < BONES; bone++)
+			{
+				Transform expected = sampleTrack(clip[bone], time, slerp);
+				Quaternion q = sampled[bone].rotation;
+
+				if (sampled[bone].position != expected.position || sampled[bone].scale != expected.scale ||
+					fabs(q.x - expected.rotation.x) > 1e-5f || fabs(q.y - expected.rotation.y) > 1e-5f ||
+					fabs(q.z - expected.rotation.z) > 1e-5f || fabs(q.w - expected.rotation.w) > 1e-5f)
+				{
+					printf("AnimationSampler does not match %s at time %g\n", slerp ? "slerp" : "nlerp", time);
+					return false;
+				}
+			}
+		}
+	}
+
+	// refilling the tracks with fewer keyframes leaves the cursors past their ends
+	sampler.sample(0.9f, sampled.data());
+
+	AnimationClip shorter = makeClip(BONES, 3);
+
+	for (int bone = 0; bone < BONES; bone++)
+	{
+		clip[bone].translation.clear();
+		clip[bone].rotation.clear();
+
+		for (size_t key = 0; key < shorter[bone].rotation.size(); key++)
+		{
+			clip[bone].translation.add(shorter[bone].translation.times()[key], shorter[bone].translation.getValue(key));
+			clip[bone].rotation.add(shorter[bone].rotation.times()[key], shorter[bone].rotation.getValue(key));
+		}
+	}
+
+	sampler.sample(0.95f, sampled.data());
+
+	for (int bone = 0; bone < BONES; bone++)
+	{
+		Transform expected = sampleTrack(clip[bone], 0.95f, true);
+		Quaternion q = sampled[bone].rotation;
+
+		if (sampled[bone].position != expected.position || fabs(q.x - expected.rotation.x) > 1e-5f ||
+			fabs(q.y - expected.rotation.y) > 1e-5f || fabs(q.z - expected.rotation.z) > 1e-5f ||
+			fabs(q.w - expected.rotation.w) > 1e-5f)
+		{
+			printf("AnimationSampler does not match a track refilled with fewer keyframes\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Compares sampling a skeleton one bone at a time with a binary search
+ * per bone against the batch AnimationSampler, playing the clip forward
+ */
+static void benchAnimationSampler()
+{
+	const int BONES = 1000;
+	AnimationClip clip = makeClip(BONES, 31);
+	std::vector<Transform> pose(BONES);
+	float time = 0;
+
+	auto advance = [&time]()
+	{
+		time += 1.0f / 240;
+
+		if (time > 1)
+		{
+			time = 0;
+		}
+	};
+
+	runBenchmark("per-bone slerp sample", ITERATIONS, BONES, [&]()
+	{
+		advance();
+
+		for (int bone = 0; bone < BONES; bone++)
+		{
+			pose[bone] = sampleTrack(clip[bone], time, true);
+		}
+
+		doNotOptimize(pose[BONES - 1]);
+	});
+
+	AnimationSampler sampler(clip);
+
+	runBenchmark("AnimationSampler slerp", ITERATIONS, BONES, [&]()
+	{
+		advance();
+		sampler.sample(time, pose.data());
+		doNotOptimize(pose[BONES - 1]);
+	});
+
+	sampler.setInterpolation(RotationInterpolation::Nlerp);
+
+	runBenchmark("AnimationSampler nlerp", ITERATIONS, BONES, [&]()
+	{
+		advance();
+		sampler.sample(time, pose.data());
+		doNotOptimize(pose[BONES - 1]);
+	});
+}
+
+/**
+ * Checks DualQuaternion conversions against Transform, and that both
+ * kinds of skinning agree when every vertex is bound to a single bone
+ */
+static bool verifySkinning()
+{
+	const int BONES = 23;
+	const size_t VERTICES = 517;
+	std::vector<Affine3x4> bones;
+	std::vector<DualQuaternion> dualBones;
+
+	makeBonePalette(BONES, bones, dualBones);
+
+	for (int i = 0; i < BONES; i++)
+	{
+		Transform t = dualBones[i].toTransform();
+		Vector3 p(randomFloat(), randomFloat(), randomFloat());
+		Vector3 expected = bones[i].transformPoint(p);
+		Vector3 actual = dualBones[i].transformPoint(p);
+		Vector3 roundTrip = t.getAffineTransformation().transformPoint(p);
+
+		if ((actual - expected).magnitude() > 1e-2f || (roundTrip - expected).magnitude() > 1e-2f)
+		{
+			printf("DualQuaternion does not match the Transform of bone %d\n", i);
+			return false;
+		}
+	}
+
+	std::vector<uint16_t> boneIndices[4];
+	std::vector<float> boneWeights[4];
+
+	makeBoneWeights(VERTICES, BONES, boneIndices, boneWeights);
+	std::fill(boneWeights[0].begin(), boneWeights[0].end(), 1.0f);
+
+	const uint16_t* indices[4] = {boneIndices[0].data(), boneIndices[1].data(), boneIndices[2].data(), boneIndices[3].data()};
+	const float* weights[4] = {boneWeights[0].data(), boneWeights[1].data(), boneWeights[2].data(), boneWeights[3].data()};
+	BoneWeightsView influences(indices, weights, 1, VERTICES);
+
+	std::vector<Vector3> positions(VERTICES), linear(VERTICES);
+	Vector3Array dual(VERTICES);
+
+	for (size_t i = 0; i < VERTICES; i++)
+	{
+		positions[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+	}
+
+	Skinning::linearBlend(ConstVector3View(positions.data(), VERTICES), influences, bones.data(),
+		Vector3View(linear.data(), VERTICES));
+	Skinning::dualQuaternionBlend(ConstVector3View(positions.data(), VERTICES), influences, dualBones.data(), dual);
+
+	for (size_t i = 0; i < VERTICES; i++)
+	{
+		if (linear[i] != bones[indices[0][i]].transformPoint(positions[i]) || (dual[i] - linear[i]).magnitude() > 1e-2f)
+		{
+			printf("Skinning does not match the bone transform at vertex %d\n", (int)i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Compares blending a Matrix4x4 per vertex against batch linear blend
+ * and dual quaternion skinning with 4 influences, in vertices per second
+ */
+static void benchSkinning()
+{
+	const int BONES = 100;
+	const size_t VERTICES = 16384;
+	std::vector<Affine3x4> bones;
+	std::vector<DualQuaternion> dualBones;
+	std::vector<Matrix4x4> matrixBones;
+	std::vector<uint16_t> boneIndices[4];
+	std::vector<float> boneWeights[4];
+
+	makeBonePalette(BONES, bones, dualBones);
+	makeBoneWeights(VERTICES, BONES, boneIndices, boneWeights);
+
+	for (int i = 0; i < BONES; i++)
+	{
+		matrixBones.push_back(bones[i].toMatrix4x4());
+	}
+
+	const uint16_t* indices[4] = {boneIndices[0].data(), boneIndices[1].data(), boneIndices[2].data(), boneIndices[3].data()};
+	const float* weights[4] = {boneWeights[0].data(), boneWeights[1].data(), boneWeights[2].data(), boneWeights[3].data()};
+	BoneWeightsView influences(indices, weights, 4, VERTICES);
+
+	std::vector<Vector3> positions(VERTICES), skinned(VERTICES);
+	Vector3Array soaPositions(VERTICES), soaSkinned(VERTICES);
+
+	for (size_t i = 0; i < VERTICES; i++)
+	{
+		positions[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		soaPositions.set(i, positions[i]);
+	}
+
+	runThroughputBenchmark("per-vertex Matrix4x4 blend", ITERATIONS / 10, VERTICES, [&]()
+	{
+		for (size_t i = 0; i < VERTICES; i++)
+		{
+			Matrix4x4 m;
+
+			for (int r = 0; r < 3; r++)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					m.matrix[r][c] = matrixBones[indices[0][i]].matrix[r][c] * weights[0][i] +
+						matrixBones[indices[1][i]].matrix[r][c] * weights[1][i] +
+						matrixBones[indices[2][i]].matrix[r][c] * weights[2][i] +
+						matrixBones[indices[3][i]].matrix[r][c] * weights[3][i];
+				}
+			}
+
+			skinned[i] = m * positions[i];
+		}
+
+		doNotOptimize(skinned[0]);
+	});
+
+	runThroughputBenchmark("Skinning linear Matrix4x4", ITERATIONS / 10, VERTICES, [&]()
+	{
+		Skinning::linearBlend(soaPositions, influences, matrixBones.data(), soaSkinned);
+		doNotOptimize(soaSkinned.x()[0]);
+	});
+
+	runThroughputBenchmark("Skinning linear Affine3x4", ITERATIONS / 10, VERTICES, [&]()
+	{
+		Skinning::linearBlend(soaPositions, influences, bones.data(), soaSkinned);
+		doNotOptimize(soaSkinned.x()[0]);
+	});
+
+	runThroughputBenchmark("Skinning dual quaternion", ITERATIONS / 10, VERTICES, [&]()
+	{
+		Skinning::dualQuaternionBlend(soaPositions, influences, dualBones.data(), soaSkinned);
+		doNotOptimize(soaSkinned.x()[0]);
+	});
+}
+
+/** @brief the largest difference between the components of two quaternions */
+static float quaternionError(const Quaternion& a, const Quaternion& b)
+{
+	return std::max(std::max(fabsf(a.x - b.x), fabsf(a.y - b.y)), std::max(fabsf(a.z - b.z), fabsf(a.w - b.w)));
+}
+
+/**
+ * Measures the largest error of the quaternion and transform encodings
+ * over random values, and checks it against the documented bounds and
+ * that the batch functions match the single ones
+ */
+static bool verifyCompression(bool print)
+{
+	const size_t N = 100003;
+	std::vector<Quaternion> rotations;
+	std::vector<Transform> transforms;
+
+	for (size_t i = 0; i < N; i++)
+	{
+		Quaternion q = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+
+		rotations.push_back(q);
+		transforms.push_back(Transform(Vector3(randomFloat(), randomFloat(), randomFloat()), q,
+			Vector3(randomFloat(), randomFloat(), randomFloat()) * 0.01f + Vector3(1, 1, 1)));
+	}
+
+	std::vector<uint32_t> packed32(N);
+	std::vector<uint16_t> packed48(3 * N);
+	std::vector<Quaternion> unpacked32(N, Quaternion(0, 0, 0, 1)), unpacked48(N, Quaternion(0, 0, 0, 1));
+
+	QuaternionPacking::pack32(rotations.data(), packed32.data(), N);
+	QuaternionPacking::unpack32(packed32.data(), unpacked32.data(), N);
+	QuaternionPacking::pack48(rotations.data(), packed48.data(), N);
+	QuaternionPacking::unpack48(packed48.data(), unpacked48.data(), N);
+
+	// the same rotation may come back negated
+	float error32 = 0, error48 = 0;
+
+	for (size_t i = 0; i < N; i++)
+	{
+		Quaternion q = rotations[i];
+		Quaternion negated(-q.x, -q.y, -q.z, -q.w);
+
+		if (packed32[i] != QuaternionPacking::pack32(q) || unpacked32[i] != QuaternionPacking::unpack32(packed32[i]) ||
+			unpacked48[i] != QuaternionPacking::unpack48(&packed48[3 * i]))
+		{
+			printf("QuaternionPacking batches do not match single quaternions\n");
+			return false;
+		}
+
+		error32 = std::max(error32, std::min(quaternionError(unpacked32[i], q), quaternionError(unpacked32[i], negated)));
+		error48 = std::max(error48, std::min(quaternionError(unpacked48[i], q), quaternionError(unpacked48[i], negated)));
+	}
+
+	Vector3Quantizer positionQuantizer(Vector3(-100, -100, -100), Vector3(100, 100, 100));
+	TransformQuantizer quantizer(positionQuantizer, Vector3Quantizer(Vector3(0.99f, 0.99f, 0.99f), Vector3(1.01f, 1.01f, 1.01f)));
+	std::vector<PackedTransform> packedTransforms(N);
+	std::vector<Transform> unpackedTransforms(N);
+	Vector3 positionError(0, 0, 0);
+
+	quantizer.pack(transforms.data(), packedTransforms.data(), N);
+	quantizer.unpack(packedTransforms.data(), unpackedTransforms.data(), N);
+
+	for (size_t i = 0; i < N; i++)
+	{
+		Transform single = quantizer.unpack(quantizer.pack(transforms[i]));
+
+		if (memcmp(&single, &unpackedTransforms[i], sizeof(Transform)) != 0)
+		{
+			printf("TransformQuantizer batches do not match single transforms\n");
+			return false;
+		}
+
+		Vector3 d = unpackedTransforms[i].position - transforms[i].position;
+
+		positionError = Vector3(std::max(positionError.x, fabsf(d.x)), std::max(positionError.y, fabsf(d.y)),
+			std::max(positionError.z, fabsf(d.z)));
+	}
+
+	// allow for the rounding of the float arithmetic itself
+	Vector3 positionBound = positionQuantizer.getMaxError() * 1.01f;
+
+	if (print)
+	{
+		printf("%-32s %10.2e\n", "quaternion 32-bit max error", error32);
+		printf("%-32s %10.2e\n", "quaternion 48-bit max error", error48);
+		printf("%-32s %10.2e (bound %.2e)\n", "position 16-bit max error", positionError.x, positionQuantizer.getMaxError().x);
+	}
+
+	if (error32 > 2.1e-3f || error48 > 6.6e-5f || positionError.x > positionBound.x ||
+		positionError.y > positionBound.y || positionError.z > positionBound.z)
+	{
+		printf("compressed quaternions or transforms exceed their error bounds\n");
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Compares packing quaternions one at a time against the batch functions,
+ * in quaternions per second, and packing whole transforms
+ */
+static void benchCompression()
+{
+	std::vector<Quaternion> rotations;
+	std::vector<float> x(COUNT), y(COUNT), z(COUNT), w(COUNT);
+	std::vector<Transform> transforms;
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		Quaternion q = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+
+		rotations.push_back(q);
+		transforms.push_back(Transform(Vector3(randomFloat(), randomFloat(), randomFloat()), q, Vector3(1, 1, 1)));
+		x[i] = q.x;
+		y[i] = q.y;
+		z[i] = q.z;
+		w[i] = q.w;
+	}
+
+	std::vector<uint32_t> packed32(COUNT);
+	std::vector<uint16_t> packed48(3 * COUNT);
+
+	verifyCompression(true);
+
+	runThroughputBenchmark("loop QuaternionPacking::pack32", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			packed32[i] = QuaternionPacking::pack32(rotations[i]);
+		}
+
+		doNotOptimize(packed32[0]);
+	});
+
+	runThroughputBenchmark("QuaternionPacking pack32 SoA", ITERATIONS, COUNT, [&]()
+	{
+		QuaternionPacking::pack32(x.data(), y.data(), z.data(), w.data(), packed32.data(), COUNT);
+		doNotOptimize(packed32[0]);
+	});
+
+	runThroughputBenchmark("QuaternionPacking unpack32 SoA", ITERATIONS, COUNT, [&]()
+	{
+		QuaternionPacking::unpack32(packed32.data(), x.data(), y.data(), z.data(), w.data(), COUNT);
+		doNotOptimize(x[0]);
+	});
+
+	runThroughputBenchmark("QuaternionPacking pack48 SoA", ITERATIONS, COUNT, [&]()
+	{
+		QuaternionPacking::pack48(x.data(), y.data(), z.data(), w.data(), packed48.data(), COUNT);
+		doNotOptimize(packed48[0]);
+	});
+
+	runThroughputBenchmark("QuaternionPacking unpack48 SoA", ITERATIONS, COUNT, [&]()
+	{
+		QuaternionPacking::unpack48(packed48.data(), x.data(), y.data(), z.data(), w.data(), COUNT);
+		doNotOptimize(x[0]);
+	});
+
+	TransformQuantizer quantizer(Vector3Quantizer(Vector3(-100, -100, -100), Vector3(100, 100, 100)),
+		Vector3Quantizer(Vector3(0, 0, 0), Vector3(2, 2, 2)));
+	std::vector<PackedTransform> packedTransforms(COUNT);
+
+	runThroughputBenchmark("TransformQuantizer pack", ITERATIONS, COUNT, [&]()
+	{
+		quantizer.pack(transforms.data(), packedTransforms.data(), COUNT);
+		doNotOptimize(packedTransforms[0]);
+	});
+
+	runThroughputBenchmark("TransformQuantizer unpack", ITERATIONS, COUNT, [&]()
+	{
+		quantizer.unpack(packedTransforms.data(), transforms.data(), COUNT);
+		doNotOptimize(transforms[0]);
+	});
+}
+
+/**
+ * Measures the largest relative error of Precision::Fast normalization
+ * against the exact path, and checks it against the documented bound
+ */
+static bool verifyFastNormalize(bool print)
+{
+	float vectorError = 0, quaternionError = 0;
+
+	for (int i = 0; i < 100000; i++)
+	{
+		// magnitudes spread over many orders of magnitude
+		float scale = powf(10, (float)(rand() % 13 - 6));
+		Vector3 v = Vector3(randomFloat(), randomFloat(), randomFloat()) * scale;
+		Quaternion q = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()) * scale;
+		Vector3 ve = v.normalize(), vf = v.normalize(Precision::Fast);
+		Quaternion qe = q.normalize(), qf = q.normalize(Precision::Fast);
+
+		vectorError = std::max(vectorError, (vf - ve).magnitude());
+		quaternionError = std::max(quaternionError, (qf - qe).magnitude());
+	}
+
+	if (print)
+	{
+		printf("%-32s %10.2e\n", "Vector3 fast normalize max error", vectorError);
+		printf("%-32s %10.2e\n", "Quaternion fast normalize error", quaternionError);
+	}
+
+	if (vectorError > 1e-6f || quaternionError > 1e-6f)
+	{
+		printf("Precision::Fast normalization exceeds its error bound\n");
+		return false;
+	}
+
+	return true;
+}
+
+/** @brief compares the exact and fast normalization paths, one at a time and in batches */
+static void benchFastNormalize()
+{
+	std::vector<Vector3> v(COUNT), vOut(COUNT);
+	std::vector<Quaternion> q, qOut(COUNT, Quaternion(0, 0, 0, 1));
+	Vector3Array soa(COUNT), soaOut(COUNT);
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		q.push_back(Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize());
+		soa.set(i, v[i]);
+	}
+
+	verifyFastNormalize(true);
+
+	for (int p = 0; p < 2; p++)
+	{
+		Precision precision = p == 0 ? Precision::Exact : Precision::Fast;
+		const char* suffix = p == 0 ? "exact" : "fast";
+		char name[64];
+
+		snprintf(name, sizeof(name), "Vector3::normalize %s", suffix);
+		runBenchmark(name, ITERATIONS, COUNT, [&]()
+		{
+			for (int i = 0; i < COUNT; i++)
+			{
+				vOut[i] = v[i].normalize(precision);
+			}
+
+			doNotOptimize(vOut[0]);
+		});
+
+		snprintf(name, sizeof(name), "Quaternion::nlerp %s", suffix);
+		runBenchmark(name, ITERATIONS, COUNT, [&]()
+		{
+			for (int i = 0; i < COUNT; i++)
+			{
+				qOut[i] = q[i].nlerp(q[COUNT - 1 - i], 0.3f, true, precision);
+			}
+
+			doNotOptimize(qOut[0]);
+		});
+
+		snprintf(name, sizeof(name), "Vector3Array::normalize %s", suffix);
+		runBenchmark(name, ITERATIONS, COUNT, [&]()
+		{
+			Vector3Array::normalize(soa, soaOut, precision);
+			doNotOptimize(soaOut.x()[0]);
+		});
+	}
+}
+
+/**
+ * Measures the largest error of the Trigonometry polynomials against the
+ * double-precision standard library, and of the batch quaternion
+ * constructors against the single ones, checking them against the
+ * documented bounds
+ */
+static bool verifyTrigonometry(bool print)
+{
+	const int n = 100000;
+	std::vector<float> angles(n), y(n), x(n), s(n), c(n), r(n);
+	double sinCosError = 0, atan2Error = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		angles[i] = randomFloat() * 81.92f;
+		y[i] = randomFloat() * powf(10, (float)(rand() % 7 - 3));
+		x[i] = randomFloat() * powf(10, (float)(rand() % 7 - 3));
+	}
+
+	Trigonometry::sincos(angles.data(), s.data(), c.data(), n);
+	Trigonometry::atan2(y.data(), x.data(), r.data(), n);
+
+	bool matches = true;
+
+	for (int i = 0; i < n; i++)
+	{
+		float s1, c1;
+
+		Trigonometry::sincos(angles[i], s1, c1);
+		matches &= s1 == s[i] && c1 == c[i] && Trigonometry::atan2(y[i], x[i]) == r[i];
+
+		sinCosError = std::max(sinCosError, fabs(s[i] - sin((double)angles[i])));
+		sinCosError = std::max(sinCosError, fabs(c[i] - cos((double)angles[i])));
+		atan2Error = std::max(atan2Error, fabs(r[i] - atan2((double)y[i], (double)x[i])));
+	}
+
+	std::vector<Vector3> euler, axes;
+	std::vector<Vector3d> eulerd;
+	std::vector<float> axisAngles;
+	std::vector<Quaternion> q(n, Quaternion(0, 0, 0, 1)), qa(n, Quaternion(0, 0, 0, 1));
+	std::vector<Quaterniond> qd(n, Quaterniond(0, 0, 0, 1));
+	std::vector<Quaternion> from, to, slerped(n, Quaternion(0, 0, 0, 1));
+	std::vector<Quaterniond> fromd, tod, slerpedd(n, Quaterniond(0, 0, 0, 1));
+	std::vector<float> inc;
+	std::vector<double> incd;
+	float quaternionError = 0, slerpError = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		euler.push_back(Vector3(randomFloat(), randomFloat(), randomFloat()) * 0.0314f);
+		eulerd.push_back(Vector3d(euler[i]));
+		axes.push_back(Vector3(randomFloat(), randomFloat(), randomFloat()).normalize());
+		axisAngles.push_back(randomFloat() * 0.0314f);
+
+		// every eighth pair is nearly the same rotation, on either side, to cover the nlerp fallback
+		from.push_back(Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize());
+		to.push_back(i % 8 == 0 ? (from[i] + Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()) * 1e-4f).normalize() *
+			(i % 16 == 0 ? -1.0f : 1.0f) : Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize());
+		inc.push_back(fabsf(randomFloat()) / 100);
+		fromd.push_back(Quaterniond(from[i].x, from[i].y, from[i].z, from[i].w));
+		tod.push_back(Quaterniond(to[i].x, to[i].y, to[i].z, to[i].w));
+		incd.push_back(inc[i]);
+	}
+
+	Quaternion::fromEulerAnglesBatch(euler.data(), q.data(), n);
+	Quaternion::fromAxisAngleBatch(axes.data(), axisAngles.data(), qa.data(), n);
+	Quaterniond::fromEulerAnglesBatch(eulerd.data(), qd.data(), n);
+	Quaternion::slerpBatch(from.data(), to.data(), inc.data(), slerped.data(), n);
+	Quaterniond::slerpBatch(fromd.data(), tod.data(), incd.data(), slerpedd.data(), n);
+
+	for (int i = 0; i < n; i++)
+	{
+		Quaternion e = Quaternion::fromEulerAngles(euler[i]);
+		Quaternion ea = Quaternion::fromAxisAngle(axes[i], axisAngles[i]);
+
+		quaternionError = std::max(quaternionError, std::max(fabsf(q[i].x - e.x), fabsf(q[i].y - e.y)));
+		quaternionError = std::max(quaternionError, std::max(fabsf(q[i].z - e.z), fabsf(q[i].w - e.w)));
+		quaternionError = std::max(quaternionError, std::max(fabsf(qa[i].x - ea.x), fabsf(qa[i].y - ea.y)));
+		quaternionError = std::max(quaternionError, std::max(fabsf(qa[i].z - ea.z), fabsf(qa[i].w - ea.w)));
+		matches &= qd[i] == Quaterniond::fromEulerAngles(eulerd[i]);
+
+		Quaternion es = from[i].slerp(to[i], inc[i]);
+
+		slerpError = std::max(slerpError, std::max(fabsf(slerped[i].x - es.x), fabsf(slerped[i].y - es.y)));
+		slerpError = std::max(slerpError, std::max(fabsf(slerped[i].z - es.z), fabsf(slerped[i].w - es.w)));
+		matches &= slerpedd[i] == fromd[i].slerp(tod[i], incd[i]);
+	}
+
+	if (print)
+	{
+		printf("%-32s %10.2e\n", "Trigonometry sincos max error", sinCosError);
+		printf("%-32s %10.2e\n", "Trigonometry atan2 max error", atan2Error);
+		printf("%-32s %10.2e\n", "Quaternion batch max error", quaternionError);
+		printf("%-32s %10.2e\n", "Quaternion slerpBatch max error", slerpError);
+	}
+
+	if (!matches)
+	{
+		printf("the Trigonometry batch functions do not match the single ones\n");
+		return false;
+	}
+
+	if (sinCosError > 1.5e-7 || atan2Error > 3.5e-7 || quaternionError > 5e-7f || slerpError > 1e-6f)
+	{
+		printf("Trigonometry exceeds its error bound\n");
+		return false;
+	}
+
+	return true;
+}
+
+/** @brief the view-projection matrix of a camera at (1, 2, 3) for the Frustum benchmarks */
+static Matrix4x4 cameraViewProjection()
+{
+	return Matrix4x4::perspective(1.2f, 1.5f, 0.1f, 100.0f) * Matrix4x4::rotation(0.1f, 0.2f, 0.3f) *
+		Matrix4x4::position(-1.0f, -2.0f, -3.0f);
+}
+
+/** @brief tests whether a point is in the clip volume -w <= x, y, z <= w of a matrix, and how far inside */
+static bool insideClipVolume(const Matrix4x4& m, const Vector3& p, double& margin)
+{
+	double clip[4];
+
+	for (int r = 0; r < 4; r++)
+	{
+		clip[r] = (double)m[r][0] * p.x + (double)m[r][1] * p.y + (double)m[r][2] * p.z + m[r][3];
+	}
+
+	margin = clip[3] - std::max(fabs(clip[0]), std::max(fabs(clip[1]), fabs(clip[2])));
+
+	return margin >= 0;
+}
+
+/**
+ * Checks the Frustum planes against the clip volume of the matrix they
+ * were extracted from, that culled spheres and boxes lie outside of it,
+ * and that the batch culling matches the single tests for both packed and
+ * strided views
+ */
+static bool verifyFrustum()
+{
+	const size_t n = 20000;
+	Matrix4x4 viewProjection = cameraViewProjection();
+	Frustum frustum(viewProjection);
+	std::vector<Vector3> centers, extents;
+	std::vector<float> radii;
+	bool verified = true;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		centers.push_back(Vector3(randomFloat(), randomFloat(), randomFloat()));
+		extents.push_back(Vector3(fabsf(randomFloat()), fabsf(randomFloat()), fabsf(randomFloat())) * 0.05f);
+		radii.push_back(fabsf(randomFloat()) * 0.05f);
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		double margin;
+		bool inside = insideClipVolume(viewProjection, centers[i], margin);
+
+		// points too close to a plane for float rounding to agree are skipped
+		if (fabs(margin) > 1e-3 && frustum.containsPoint(centers[i]) != inside)
+		{
+			printf("Frustum::containsPoint does not match the clip volume\n");
+			verified = false;
+			break;
+		}
+
+		if (inside && (!frustum.intersectsSphere(centers[i], radii[i]) || !frustum.intersectsBox(centers[i], extents[i])))
+		{
+			printf("Frustum culls an object whose center is inside of it\n");
+			verified = false;
+			break;
+		}
+	}
+
+	Vector3Array soaCenters((ConstVector3View(centers.data(), n))), soaExtents((ConstVector3View(extents.data(), n)));
+	std::vector<uint32_t> packed(n), strided(n);
+	size_t spheres = frustum.cullSpheres(soaCenters, radii.data(), packed.data());
+	size_t stridedSpheres = frustum.cullSpheres(ConstVector3View(centers.data(), n), radii.data(), strided.data());
+	size_t boxes = 0, visibleSpheres = 0, visibleBoxes = 0;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		visibleSpheres += frustum.intersectsSphere(centers[i], radii[i]);
+	}
+
+	if (spheres != visibleSpheres || stridedSpheres != spheres || !std::equal(packed.begin(), packed.begin() + spheres, strided.begin()))
+	{
+		printf("Frustum::cullSpheres does not match Frustum::intersectsSphere\n");
+		verified = false;
+	}
+
+	for (size_t i = 0; i < spheres && verified; i++)
+	{
+		verified = frustum.intersectsSphere(centers[packed[i]], radii[packed[i]]) && (i == 0 || packed[i] > packed[i - 1]);
+	}
+
+	boxes = frustum.cullBoxes(soaCenters, soaExtents, packed.data());
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (frustum.intersectsBox(centers[i], extents[i]))
+		{
+			verified &= visibleBoxes < boxes && packed[visibleBoxes] == i;
+			visibleBoxes++;
+		}
+	}
+
+	if (!verified || boxes != visibleBoxes || boxes != frustum.cullBoxes(ConstVector3View(centers.data(), n),
+		ConstVector3View(extents.data(), n), strided.data()) || !std::equal(packed.begin(), packed.begin() + boxes, strided.begin()))
+	{
+		printf("Frustum batch culling does not match the single tests\n");
+		verified = false;
+	}
+
+	std::vector<AABB> boxArray;
+	std::vector<Sphere> sphereArray;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		boxArray.push_back(AABB::fromCenterExtents(centers[i], extents[i]));
+		sphereArray.push_back(Sphere(centers[i], radii[i]));
+	}
+
+	boxes = frustum.cullBoxes(boxArray.data(), n, packed.data());
+	spheres = frustum.cullSpheres(sphereArray.data(), n, strided.data());
+	visibleBoxes = visibleSpheres = 0;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (frustum.intersects(boxArray[i]))
+		{
+			verified &= visibleBoxes < boxes && packed[visibleBoxes++] == i;
+		}
+
+		if (frustum.intersects(sphereArray[i]))
+		{
+			verified &= visibleSpheres < spheres && strided[visibleSpheres++] == i;
+		}
+	}
+
+	if (!verified || boxes != visibleBoxes || spheres != visibleSpheres)
+	{
+		printf("Frustum culling of AABB and Sphere arrays does not match the single tests\n");
+		verified = false;
+	}
+
+	return verified;
+}
+
+/** @brief compares culling objects one at a time with the Frustum batch culling */
+static void benchFrustum()
+{
+	const int OBJECTS = 65536;
+	Frustum frustum(cameraViewProjection());
+	std::vector<Vector3> centers, extents;
+	std::vector<float> radii;
+	std::vector<uint32_t> visible(OBJECTS);
+
+	for (int i = 0; i < OBJECTS; i++)
+	{
+		centers.push_back(Vector3(randomFloat(), randomFloat(), randomFloat()));
+		extents.push_back(Vector3(fabsf(randomFloat()), fabsf(randomFloat()), fabsf(randomFloat())) * 0.05f);
+		radii.push_back(fabsf(randomFloat()) * 0.05f);
+	}
+
+	Vector3Array soaCenters((ConstVector3View(centers.data(), OBJECTS))), soaExtents((ConstVector3View(extents.data(), OBJECTS)));
+
+	printf("%-32s %10zu of %d\n", "Frustum visible spheres", frustum.cullSpheres(soaCenters, radii.data(), visible.data()), OBJECTS);
+
+	runBenchmark("Frustum::intersectsSphere", ITERATIONS / 20, OBJECTS, [&]()
+	{
+		size_t count = 0;
+
+		for (int i = 0; i < OBJECTS; i++)
+		{
+			if (frustum.intersectsSphere(centers[i], radii[i]))
+			{
+				visible[count++] = i;
+			}
+		}
+
+		doNotOptimize(count);
+	});
+
+	runBenchmark("Frustum::cullSpheres", ITERATIONS / 20, OBJECTS, [&]()
+	{
+		doNotOptimize(frustum.cullSpheres(soaCenters, radii.data(), visible.data()));
+	});
+
+	runBenchmark("Frustum::intersectsBox", ITERATIONS / 20, OBJECTS, [&]()
+	{
+		size_t count = 0;
+
+		for (int i = 0; i < OBJECTS; i++)
+		{
+			if (frustum.intersectsBox(centers[i], extents[i]))
+			{
+				visible[count++] = i;
+			}
+		}
+
+		doNotOptimize(count);
+	});
+
+	runBenchmark("Frustum::cullBoxes", ITERATIONS / 20, OBJECTS, [&]()
+	{
+		doNotOptimize(frustum.cullBoxes(soaCenters, soaExtents, visible.data()));
+	});
+
+	runBenchmark("Frustum::cullBoxes (Vector3*)", ITERATIONS / 20, OBJECTS, [&]()
+	{
+		doNotOptimize(frustum.cullBoxes(ConstVector3View(centers.data(), OBJECTS), ConstVector3View(extents.data(), OBJECTS),
+			visible.data()));
+	});
+}
+
+/** @brief a random box around a point within 100 of the origin */
+static AABB randomBox()
+{
+	Vector3 center(randomFloat(), randomFloat(), randomFloat());
+	Vector3 extents(fabsf(randomFloat()), fabsf(randomFloat()), fabsf(randomFloat()));
+
+	return AABB::fromCenterExtents(center, extents * 0.05f);
+}
+
+/** @brief a random world matrix with rotation, non-uniform scale and translation */
+static Affine3x4 randomWorldMatrix()
+{
+	Quaternion rotation = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+	Vector3 scale(fabsf(randomFloat()) * 0.02f + 0.1f, fabsf(randomFloat()) * 0.02f + 0.1f, fabsf(randomFloat()) * 0.02f + 0.1f);
+
+	return Affine3x4::fromPositionRotationScale(Vector3(randomFloat(), randomFloat(), randomFloat()), rotation, scale);
+}
+
+/** @brief the 8 corners of a box */
+static void boxCorners(const AABB& box, Vector3* corners)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		corners[i] = Vector3(i & 1 ? box.max.x : box.min.x, i & 2 ? box.max.y : box.min.y, i & 4 ? box.max.z : box.min.z);
+	}
+}
+
+/**
+ * Checks that transformed boxes are the smallest boxes around their
+ * transformed corners, that the batch transforms match the single ones,
+ * and the merging and overlap tests of AABB and Sphere
+ */
+static bool verifyBounds()
+{
+	const size_t n = 10000;
+	std::vector<AABB> boxes, batch, single;
+	std::vector<Affine3x4> matrices;
+	std::vector<Sphere> spheres, sphereBatch;
+	bool verified = true;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		boxes.push_back(randomBox());
+		matrices.push_back(randomWorldMatrix());
+		spheres.push_back(Sphere::fromAABB(boxes[i]));
+	}
+
+	batch = boxes;
+	sphereBatch = spheres;
+	AABB::transformBatch(batch.data(), matrices.data(), batch.data(), n);
+	Sphere::transformBatch(sphereBatch.data(), matrices.data(), sphereBatch.data(), n);
+
+	for (size_t i = 0; i < n && verified; i++)
+	{
+		Vector3 corners[8];
+		boxCorners(boxes[i], corners);
+
+		for (int c = 0; c < 8; c++)
+		{
+			corners[c] = matrices[i].transformPoint(corners[c]);
+		}
+
+		AABB expected = AABB::fromPoints(corners, 8);
+		AABB actual = boxes[i].transform(matrices[i]);
+		Vector3 minError = actual.min - expected.min, maxError = actual.max - expected.max;
+		float error = std::max(std::max(std::max(fabsf(minError.x), fabsf(minError.y)), fabsf(minError.z)),
+			std::max(std::max(fabsf(maxError.x), fabsf(maxError.y)), fabsf(maxError.z)));
+
+		if (error > 1e-4f || batch[i] != actual || sphereBatch[i] != spheres[i].transform(matrices[i]))
+		{
+			printf("AABB::transform does not match its transformed corners\n");
+			verified = false;
+		}
+
+		Sphere sphere = sphereBatch[i];
+
+		for (int c = 0; c < 8; c++)
+		{
+			verified &= (corners[c] - sphere.center).magnitude() <= sphere.radius * 1.0001f;
+		}
+
+		AABB merged = boxes[i].merge(boxes[n - 1 - i]);
+		Sphere mergedSphere = spheres[i].merge(spheres[n - 1 - i]);
+
+		verified &= merged.contains(boxes[i]) && merged.contains(boxes[n - 1 - i]);
+		verified &= boxes[i].overlaps(boxes[n - 1 - i]) == (merged.getSize().x <= boxes[i].getSize().x + boxes[n - 1 - i].getSize().x &&
+			merged.getSize().y <= boxes[i].getSize().y + boxes[n - 1 - i].getSize().y &&
+			merged.getSize().z <= boxes[i].getSize().z + boxes[n - 1 - i].getSize().z);
+		verified &= mergedSphere.radius * 1.0001f >= spheres[i].radius + (mergedSphere.center - spheres[i].center).magnitude();
+		verified &= boxes[i].overlaps(spheres[i]) && spheres[i].contains(boxes[i].getCenter());
+
+		if (!verified)
+		{
+			printf("AABB or Sphere merging and overlap tests are inconsistent\n");
+		}
+	}
+
+	return verified;
+}
+
+/** @brief compares transforming the corners of boxes with the center and extents transform */
+static void benchBounds()
+{
+	std::vector<AABB> boxes, out;
+	std::vector<Matrix4x4> matrices;
+	std::vector<Affine3x4> affine;
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		boxes.push_back(randomBox());
+		affine.push_back(randomWorldMatrix());
+		matrices.push_back(affine[i].toMatrix4x4());
+	}
+
+	out = boxes;
+
+	runBenchmark("AABB 8 corners * Matrix4x4", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			Vector3 corners[8];
+			boxCorners(boxes[i], corners);
+
+			AABB box = AABB::empty();
+
+			for (int c = 0; c < 8; c++)
+			{
+				box = box.merge(matrices[i] * corners[c]);
+			}
+
+			out[i] = box;
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("AABB::transform(Matrix4x4)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			out[i] = boxes[i].transform(matrices[i]);
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("AABB::transformBatch(Affine3x4*)", ITERATIONS, COUNT, [&]()
+	{
+		AABB::transformBatch(boxes.data(), affine.data(), out.data(), COUNT);
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("AABB::transformBatch(Matrix4x4*)", ITERATIONS, COUNT, [&]()
+	{
+		AABB::transformBatch(boxes.data(), matrices.data(), out.data(), COUNT);
+		doNotOptimize(out[0]);
+	});
+}
+
+/**
+ * A triangle soup of a heightfield of size x size vertices, 1 apart in x
+ * and z, with 2 triangles per grid cell
+ */
+static std::vector<Vector3> heightfield(int size)
+{
+	std::vector<Vector3> vertices;
+
+	vertices.reserve(6 * (size_t)(size - 1) * (size - 1));
+
+	for (int z = 0; z < size - 1; z++)
+	{
+		for (int x = 0; x < size - 1; x++)
+		{
+			Vector3 corners[4];
+
+			for (int i = 0; i < 4; i++)
+			{
+				float px = (float)(x + (i & 1)), pz = (float)(z + (i >> 1));
+
+				corners[i] = Vector3(px, 8.0f * sinf(px * 0.05f) * cosf(pz * 0.07f) + 2.0f * sinf(px * 0.31f + pz * 0.17f), pz);
+			}
+
+			Vector3 triangles[6] = {corners[0], corners[1], corners[2], corners[1], corners[3], corners[2]};
+
+			vertices.insert(vertices.end(), triangles, triangles + 6);
+		}
+	}
+
+	return vertices;
+}
+
+/** @brief the closest hit of a ray with every triangle of a soup, in their original order */
+static bool bruteForceIntersect(const std::vector<float>& streams, size_t count, const Ray& ray, float maxDistance,
+	RayHit& hit)
+{
+	const float r[6] = {ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z};
+
+	hit.distance = maxDistance;
+	hit.triangle = (uint32_t)math3d::detail::rayTrianglesScalar(r, streams.data(), count, count, hit.distance, hit.u, hit.v);
+
+	return hit.triangle < count;
+}
+
+/** @brief the triangles of a soup as the streams of their first vertex and edges, like a BVH stores them */
+static std::vector<float> triangleStreams(const std::vector<Vector3>& vertices)
+{
+	size_t count = vertices.size() / 3;
+	std::vector<float> streams(9 * count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const Vector3* v = &vertices[3 * i];
+		Vector3 edge1 = v[1] - v[0], edge2 = v[2] - v[0];
+		float values[9] = {v[0].x, v[0].y, v[0].z, edge1.x, edge1.y, edge1.z, edge2.x, edge2.y, edge2.z};
+
+		for (int s = 0; s < 9; s++)
+		{
+			streams[s * count + i] = values[s];
+		}
+	}
+
+	return streams;
+}
+
+/** @brief a soup of small random triangles within 100 of the origin */
+static std::vector<Vector3> randomTriangles(int count, float size)
+{
+	std::vector<Vector3> vertices;
+
+	for (int i = 0; i < count; i++)
+	{
+		Vector3 v0(randomFloat(), randomFloat(), randomFloat());
+
+		vertices.push_back(v0);
+		vertices.push_back(v0 + Vector3(randomFloat(), randomFloat(), randomFloat()) * size);
+		vertices.push_back(v0 + Vector3(randomFloat(), randomFloat(), randomFloat()) * size);
+	}
+
+	return vertices;
+}
+
+/**
+ * Checks the Ray triangle tests, one at a time and in batches of
+ * triangles or of rays, against the scalar kernel
+ */
+static bool verifyRay()
+{
+	const int TRIANGLES = 1000;
+	const int BATCH_TRIANGLES = 64;
+	std::vector<Vector3> vertices = randomTriangles(TRIANGLES, 0.2f);
+	std::vector<float> streams = triangleStreams(vertices);
+	std::vector<Ray> rays;
+	std::vector<RayHit> batchHits;
+	bool verified = true;
+	int hits = 0;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		Vector3 from(randomFloat(), randomFloat(), randomFloat());
+		Vector3 to(randomFloat(), randomFloat(), randomFloat());
+
+		rays.push_back(Ray(from, to - from));
+	}
+
+	for (int i = 0; i < (int)rays.size() && verified; i++)
+	{
+		const Ray& ray = rays[i];
+		float maxDistance = i % 4 == 0 ? 0.5f : 1.0f;
+		RayHit expected, actual;
+		bool hit = bruteForceIntersect(streams, TRIANGLES, ray, maxDistance, expected);
+		bool found = ray.intersectTriangles(vertices.data(), TRIANGLES, maxDistance, actual);
+
+		if (found != hit || (hit && (actual.distance != expected.distance || actual.triangle != expected.triangle ||
+			actual.u != expected.u || actual.v != expected.v)))
+		{
+			printf("Ray::intersectTriangles does not match the scalar kernel\n");
+			verified = false;
+		}
+
+		hits += hit;
+
+		for (int t = 0; t < BATCH_TRIANGLES && verified; t++)
+		{
+			const float r[6] = {ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z};
+			float distance = maxDistance, u = 0, v = 0;
+
+			hit = math3d::detail::rayTrianglesScalar(r, &streams[t], TRIANGLES, 1, distance, u, v) == 0;
+			found = ray.intersectTriangle(vertices[3 * t], vertices[3 * t + 1], vertices[3 * t + 2], maxDistance, actual);
+
+			if (found != hit || (hit && (actual.distance != distance || actual.u != u || actual.v != v)))
+			{
+				printf("Ray::intersectTriangle does not match the scalar kernel\n");
+				verified = false;
+			}
+		}
+	}
+
+	// each ray against the first triangles, one triangle at a time
+	for (size_t i = 0; i < rays.size(); i++)
+	{
+		RayHit hit = {i % 4 == 0 ? 0.5f : 1.0f, ~0u, 0, 0};
+
+		batchHits.push_back(hit);
+	}
+
+	for (int t = 0; t < BATCH_TRIANGLES; t++)
+	{
+		Ray::intersectBatch(rays.data(), rays.size(), vertices[3 * t], vertices[3 * t + 1], vertices[3 * t + 2],
+			(uint32_t)t, batchHits.data());
+	}
+
+	for (size_t i = 0; i < rays.size() && verified; i++)
+	{
+		const Ray& ray = rays[i];
+		const float r[6] = {ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z};
+		float distance = i % 4 == 0 ? 0.5f : 1.0f, u = 0, v = 0;
+		uint32_t triangle = (uint32_t)math3d::detail::rayTrianglesScalar(r, streams.data(), TRIANGLES, BATCH_TRIANGLES,
+			distance, u, v);
+		const RayHit& actual = batchHits[i];
+
+		if (triangle == BATCH_TRIANGLES ? actual.triangle != ~0u : (actual.triangle != triangle ||
+			actual.distance != distance || actual.u != u || actual.v != v))
+		{
+			printf("Ray::intersectBatch does not match the scalar kernel\n");
+			verified = false;
+		}
+	}
+
+	if (hits == 0)
+	{
+		printf("Ray::intersectTriangles never hits\n");
+		verified = false;
+	}
+
+	return verified;
+}
+
+/**
+ * Checks the closest hit, any hit and overlap queries of a BVH against
+ * testing every triangle, on random triangles and on a heightfield, and
+ * that building on several threads gives the same results
+ */
+static bool verifyBVH()
+{
+	std::vector<Vector3> random = randomTriangles(20000, 0.05f);
+	std::vector<Vector3> terrain = heightfield(64);
+	const std::vector<Vector3>* soups[2] = {&random, &terrain};
+	bool verified = true;
+
+	for (int s = 0; s < 2 && verified; s++)
+	{
+		const std::vector<Vector3>& vertices = *soups[s];
+		size_t count = vertices.size() / 3;
+		std::vector<float> streams = triangleStreams(vertices);
+		BVH single, threaded;
+
+		single.build(vertices.data(), count, 1);
+		threaded.build(vertices.data(), count, 4);
+
+		if (single.getTriangleCount() != count || single.getNodeCount() != threaded.getNodeCount() ||
+			single.getBounds() != AABB::fromPoints(vertices.data(), vertices.size()))
+		{
+			printf("BVH::build does not cover the triangles\n");
+			verified = false;
+		}
+
+		for (int i = 0; i < 2000 && verified; i++)
+		{
+			// rays from random points towards random points, or down onto the terrain
+			Vector3 from(randomFloat(), randomFloat(), randomFloat());
+			Vector3 to(randomFloat(), randomFloat(), randomFloat());
+
+			if (s == 1)
+			{
+				from = Vector3(fabsf(randomFloat()) * 0.63f, 20.0f, fabsf(randomFloat()) * 0.63f);
+				to = Vector3(fabsf(randomFloat()) * 0.63f, -10.0f, fabsf(randomFloat()) * 0.63f);
+			}
+
+			Ray ray(from, to - from);
+			float maxDistance = i % 4 == 0 ? 0.5f : 1.0f;
+			RayHit expected, actual, actualThreaded;
+			bool hit = bruteForceIntersect(streams, count, ray, maxDistance, expected);
+			bool found = single.intersect(ray, maxDistance, actual);
+
+			// on the terrain, adjacent triangles can be hit at the same distance,
+			// of which the brute force test and the BVH may keep either one
+			bool same = found == hit && (!hit || (actual.distance == expected.distance &&
+				(s == 1 || (actual.triangle == expected.triangle && actual.u == expected.u && actual.v == expected.v))));
+
+			same &= threaded.intersect(ray, maxDistance, actualThreaded) == found &&
+				(!found || (actualThreaded.distance == actual.distance && actualThreaded.triangle == actual.triangle));
+			same &= single.intersectsAny(ray, maxDistance) == hit && threaded.intersectsAny(ray, maxDistance) == hit;
+
+			if (!same)
+			{
+				printf("BVH ray queries do not match testing every triangle\n");
+				verified = false;
+			}
+		}
+
+		for (int i = 0; i < 200 && verified; i++)
+		{
+			AABB box = AABB::fromCenterExtents(s == 0 ? Vector3(randomFloat(), randomFloat(), randomFloat()) :
+				Vector3(fabsf(randomFloat()) * 0.63f, 0, fabsf(randomFloat()) * 0.63f), Vector3(4, 4, 4));
+			std::vector<uint32_t> expected, actual, actualThreaded;
+
+			for (size_t t = 0; t < count; t++)
+			{
+				const Vector3* v = &vertices[3 * t];
+
+				if (box.overlapsTriangle(v[0], v[1], v[2]))
+				{
+					expected.push_back((uint32_t)t);
+				}
+				else if (box.contains(v[0]) || box.contains(v[1]) || box.contains(v[2]) ||
+					box.contains((v[0] + v[1] + v[2]) * (1.0f / 3)))
+				{
+					printf("AABB::overlapsTriangle misses a triangle\n");
+					verified = false;
+				}
+			}
+
+			single.overlap(box, actual);
+			threaded.overlap(box, actualThreaded);
+			std::sort(actual.begin(), actual.end());
+			std::sort(actualThreaded.begin(), actualThreaded.end());
+
+			if (actual != expected || actualThreaded != expected)
+			{
+				printf("BVH::overlap does not match testing every triangle\n");
+				verified = false;
+			}
+		}
+	}
+
+	return verified;
+}
+
+/**
+ * Compares the scalar and the dispatched ray-triangle kernels, for one
+ * ray against many triangles and many rays against one triangle, per
+ * ray-triangle test
+ */
+static void benchRay()
+{
+	std::vector<Vector3> vertices = randomTriangles(COUNT, 0.2f);
+	std::vector<float> streams = triangleStreams(vertices);
+	const Kernels& k = math3d::detail::kernels();
+	Ray ray(Vector3(-100, randomFloat(), randomFloat()), Vector3(200, randomFloat(), randomFloat()));
+	const float r[6] = {ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z};
+
+	runBenchmark("rayTriangles (scalar)", ITERATIONS / 10, COUNT, [&]()
+	{
+		float distance = 1, u, v;
+
+		doNotOptimize(math3d::detail::rayTrianglesScalar(r, streams.data(), COUNT, COUNT, distance, u, v));
+	});
+
+	runBenchmark("rayTriangles (dispatched)", ITERATIONS / 10, COUNT, [&]()
+	{
+		float distance = 1, u, v;
+
+		doNotOptimize(k.rayTriangles(r, streams.data(), COUNT, COUNT, distance, u, v));
+	});
+
+	runBenchmark("Ray::intersectTriangles", ITERATIONS / 10, COUNT, [&]()
+	{
+		RayHit hit;
+
+		doNotOptimize(ray.intersectTriangles(vertices.data(), COUNT, 1, hit));
+	});
+
+	// rays from random points through a triangle around the origin
+	std::vector<Ray> rays;
+	std::vector<float> soa[6] = {std::vector<float>(COUNT), std::vector<float>(COUNT), std::vector<float>(COUNT),
+		std::vector<float>(COUNT), std::vector<float>(COUNT), std::vector<float>(COUNT)};
+	std::vector<float> distance(COUNT), u(COUNT), v(COUNT);
+	std::vector<uint32_t> triangles(COUNT);
+	std::vector<RayHit> hits(COUNT);
+	Vector3 a(-20, -20, 0), b(20, -20, 0), c(0, 20, 0);
+	Vector3 edge1 = b - a, edge2 = c - a;
+	const float triangle[9] = {a.x, a.y, a.z, edge1.x, edge1.y, edge1.z, edge2.x, edge2.y, edge2.z};
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		Vector3 from(randomFloat(), randomFloat(), randomFloat());
+		Vector3 to(randomFloat() * 0.3f, randomFloat() * 0.3f, 0);
+
+		rays.push_back(Ray(from, (to - from) * 2.0f));
+
+		for (int s = 0; s < 3; s++)
+		{
+			soa[s][i] = rays[i].origin[s];
+			soa[3 + s][i] = rays[i].direction[s];
+		}
+	}
+
+	auto resetHits = [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			distance[i] = 1;
+			hits[i].distance = 1;
+		}
+	};
+
+	runBenchmark("raysTriangle (scalar)", ITERATIONS / 10, COUNT, [&]()
+	{
+		resetHits();
+		doNotOptimize(math3d::detail::raysTriangleScalar(triangles.data(), distance.data(), u.data(), v.data(), triangle, 0,
+			soa[0].data(), soa[1].data(), soa[2].data(), soa[3].data(), soa[4].data(), soa[5].data(), COUNT));
+	});
+
+	runBenchmark("raysTriangle (dispatched)", ITERATIONS / 10, COUNT, [&]()
+	{
+		resetHits();
+		doNotOptimize(k.raysTriangle(triangles.data(), distance.data(), u.data(), v.data(), triangle, 0,
+			soa[0].data(), soa[1].data(), soa[2].data(), soa[3].data(), soa[4].data(), soa[5].data(), COUNT));
+	});
+
+	runBenchmark("Ray::intersectBatch", ITERATIONS / 10, COUNT, [&]()
+	{
+		resetHits();
+		doNotOptimize(Ray::intersectBatch(rays.data(), COUNT, a, b, c, 0, hits.data()));
+	});
+}
+
+/**
+ * Measures building a BVH over a heightfield of 1M triangles, and the
+ * rays per second of closest hit queries from above the terrain and of
+ * any hit (line of sight) queries between points just above it
+ */
+static void benchBVH()
+{
+	const int SIZE = 709;
+	const int RAYS = 100000;
+	std::vector<Vector3> terrain = heightfield(SIZE);
+	size_t count = terrain.size() / 3;
+	BVH bvh;
+	char name[64];
+
+	snprintf(name, sizeof(name), "BVH::build %zuK tris, 1 thread", count / 1000);
+	runBenchmark(name, 1, (long)count, [&]()
+	{
+		bvh.build(terrain.data(), count, 1);
+	});
+
+	snprintf(name, sizeof(name), "BVH::build %u hardware threads", std::max(std::thread::hardware_concurrency(), 1u));
+	runBenchmark(name, 1, (long)count, [&]()
+	{
+		bvh.build(terrain.data(), count);
+	});
+
+	std::vector<Ray> down, sight;
+	float extent = (float)(SIZE - 1);
+
+	for (int i = 0; i < RAYS; i++)
+	{
+		Vector3 from(fabsf(randomFloat()) / 100 * extent, 30.0f, fabsf(randomFloat()) / 100 * extent);
+		Vector3 to(fabsf(randomFloat()) / 100 * extent, -10.0f, fabsf(randomFloat()) / 100 * extent);
+
+		down.push_back(Ray(from, to - from));
+
+		// line of sight between two points at most 100 apart, between the
+		// lowest and highest points of the terrain, most of which are blocked
+		from = Vector3(fabsf(randomFloat()) / 100 * (extent - 100), randomFloat() / 20, fabsf(randomFloat()) / 100 * (extent - 100));
+		to = from + Vector3(fabsf(randomFloat()), randomFloat() / 20 - from.y, fabsf(randomFloat()));
+		sight.push_back(Ray(from, to - from));
+	}
+
+	int hits = 0;
+	double ns = timeBenchmark(5, RAYS, [&]()
+	{
+		RayHit hit;
+
+		hits = 0;
+
+		for (int i = 0; i < RAYS; i++)
+		{
+			hits += bvh.intersect(down[i], 1.0f, hit);
+		}
+
+		doNotOptimize(hits);
+	});
+
+	printf("%-32s %10.0f rays/s (%d%% hit)\n", "BVH::intersect", 1e9 / ns, hits * 100 / RAYS);
+
+	ns = timeBenchmark(5, RAYS, [&]()
+	{
+		hits = 0;
+
+		for (int i = 0; i < RAYS; i++)
+		{
+			hits += bvh.intersectsAny(sight[i], 1.0f);
+		}
+
+		doNotOptimize(hits);
+	});
+
+	printf("%-32s %10.0f rays/s (%d%% hit)\n", "BVH::intersectsAny", 1e9 / ns, hits * 100 / RAYS);
+
+	std::vector<float> streams = triangleStreams(terrain);
+	const int BRUTE_FORCE_RAYS = 16;
+
+	ns = timeBenchmark(1, BRUTE_FORCE_RAYS, [&]()
+	{
+		RayHit hit;
+
+		hits = 0;
+
+		for (int i = 0; i < BRUTE_FORCE_RAYS; i++)
+		{
+			hits += bruteForceIntersect(streams, count, down[i], 1.0f, hit);
+		}
+
+		doNotOptimize(hits);
+	});
+
+	printf("%-32s %10.0f rays/s\n", "brute force intersect", 1e9 / ns);
+
+	std::vector<AABB> boxes;
+	std::vector<uint32_t> overlapping;
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		Vector3 center(fabsf(randomFloat()) / 100 * extent, 0, fabsf(randomFloat()) / 100 * extent);
+
+		boxes.push_back(AABB::fromCenterExtents(center, Vector3(4, 4, 4)));
+	}
+
+	runBenchmark("BVH::overlap 8x8x8 box", 10, COUNT, [&]()
+	{
+		overlapping.clear();
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			bvh.overlap(boxes[i], overlapping);
+		}
+
+		doNotOptimize(overlapping.size());
+	});
+}
+
+/** @brief reports a batch operation whose results on a ThreadPool differ from those on one thread */
+static bool checkParallel(const char* name, bool same)
+{
+	if (!same)
+	{
+		printf("%s on a ThreadPool does not match one thread\n", name);
+	}
+
+	return same;
+}
+
+/**
+ * Checks that a ThreadPool runs every chunk exactly once in both
+ * schedules, that the deterministic one runs each chunk on the same
+ * thread every time, that an exception thrown by a chunk reaches the
+ * caller, and that the parallel batch operations match the serial ones
+ * bit-for-bit
+ */
+static bool verifyThreadPool()
+{
+	const size_t N = 100003;
+	const size_t CHUNK = 1000;
+	const size_t CHUNKS = (N + CHUNK - 1) / CHUNK;
+	const unsigned THREADS[3] = {1, 3, 4};
+	bool verified = true;
+
+	for (int t = 0; t < 3; t++)
+	{
+		for (int s = 0; s < 2; s++)
+		{
+			ThreadPool pool(THREADS[t], s == 0 ? ThreadPool::Schedule::Stealing : ThreadPool::Schedule::Deterministic);
+			std::vector<std::thread::id> first(CHUNKS), second(CHUNKS);
+
+			for (int run = 0; run < 2; run++)
+			{
+				std::vector<int> visits(N);
+				std::vector<size_t> ends(CHUNKS);
+				std::vector<std::thread::id>& threads = run == 0 ? first : second;
+
+				pool.parallelFor(N, CHUNK, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						visits[i]++;
+					}
+
+					ends[begin / CHUNK] = end;
+					threads[begin / CHUNK] = std::this_thread::get_id();
+				});
+
+				bool once = std::count(visits.begin(), visits.end(), 1) == (long)N;
+
+				for (size_t c = 0; c < CHUNKS; c++)
+				{
+					once &= ends[c] == std::min((c + 1) * CHUNK, N);
+				}
+
+				if (!once)
+				{
+					printf("ThreadPool::parallelFor does not run every chunk once\n");
+					verified = false;
+				}
+			}
+
+			if (s == 1 && first != second)
+			{
+				printf("ThreadPool deterministic schedule is inconsistent between runs\n");
+				verified = false;
+			}
+
+			// the first chunk runs on a worker and the last on the calling thread, at least when nothing is stolen
+			for (int c = 0; c < 2; c++)
+			{
+				size_t failing = c == 0 ? 0 : CHUNKS - 1;
+				bool thrown = false;
+
+				try
+				{
+					pool.parallelFor(N, CHUNK, [&](size_t begin, size_t)
+					{
+						if (begin / CHUNK == failing)
+						{
+							throw std::runtime_error("chunk failed");
+						}
+					});
+				}
+				catch (const std::runtime_error&)
+				{
+					thrown = true;
+				}
+
+				if (!thrown)
+				{
+					printf("ThreadPool::parallelFor does not rethrow an exception from a chunk\n");
+					verified = false;
+				}
+			}
+
+			// the cancelled chunks must not leak into the next job
+			std::vector<int> visits(N);
+
+			pool.parallelFor(N, CHUNK, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					visits[i]++;
+				}
+			});
+
+			if (std::count(visits.begin(), visits.end(), 1) != (long)N)
+			{
+				printf("ThreadPool::parallelFor does not run every chunk once after an exception\n");
+				verified = false;
+			}
+		}
+	}
+
+	// the batch operations, on a count that leaves a short last chunk
+	const size_t COUNT_POINTS = 200003;
+	ThreadPool pool(4);
+	std::vector<Vector3> points(COUNT_POINTS), expected(COUNT_POINTS), actual(COUNT_POINTS);
+	Affine3x4 affine = Affine3x4::fromPositionRotationScale(Vector3(1, 2, 3),
+		Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize(), Vector3(2, 3, 4));
+	Matrix4x4 matrix = affine.toMatrix4x4();
+
+	for (size_t i = 0; i < COUNT_POINTS; i++)
+	{
+		points[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+	}
+
+	matrix.transformPoints(points.data(), expected.data(), COUNT_POINTS);
+	matrix.transformPoints(points.data(), actual.data(), COUNT_POINTS, pool);
+	verified &= checkParallel("Matrix4x4::transformPoints", expected == actual);
+
+	Vector3Array soa((ConstVector3View(points.data(), COUNT_POINTS))), soaExpected(COUNT_POINTS), soaActual(COUNT_POINTS);
+
+	affine.transformPoints(soa, soaExpected);
+	affine.transformPoints(soa, soaActual, pool);
+	verified &= checkParallel("Affine3x4::transformPoints", memcmp(soaExpected.x(), soaActual.x(), COUNT_POINTS * sizeof(float)) == 0 &&
+		memcmp(soaExpected.y(), soaActual.y(), COUNT_POINTS * sizeof(float)) == 0 &&
+		memcmp(soaExpected.z(), soaActual.z(), COUNT_POINTS * sizeof(float)) == 0);
+
+	Vector3Array::normalize(ConstVector3View(points.data(), COUNT_POINTS), Vector3View(expected.data(), COUNT_POINTS));
+	Vector3Array::normalize(ConstVector3View(points.data(), COUNT_POINTS), Vector3View(actual.data(), COUNT_POINTS), pool);
+	verified &= checkParallel("Vector3Array::normalize", expected == actual);
+
+	const size_t COUNT_TRANSFORMS = 20011;
+	std::vector<Transform> transforms;
+	std::vector<Quaternion> from, to;
+	std::vector<Quaternion> expectedRotations(COUNT_TRANSFORMS, Quaternion(0, 0, 0, 1)), actualRotations(expectedRotations);
+	std::vector<float> inc;
+	std::vector<Matrix4x4> expectedMatrices(COUNT_TRANSFORMS), actualMatrices(COUNT_TRANSFORMS);
+	std::vector<Affine3x4> expectedAffine(COUNT_TRANSFORMS), actualAffine(COUNT_TRANSFORMS);
+
+	for (size_t i = 0; i < COUNT_TRANSFORMS; i++)
+	{
+		Quaternion rotation = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+
+		transforms.push_back(Transform(Vector3(randomFloat(), randomFloat(), randomFloat()), rotation, Vector3(1, 2, 3)));
+		from.push_back(rotation);
+		to.push_back(Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize());
+		inc.push_back(fabsf(randomFloat()) / 100);
+	}
+
+	Transform::getTransformationBatch(transforms.data(), expectedMatrices.data(), COUNT_TRANSFORMS);
+	Transform::getTransformationBatch(transforms.data(), actualMatrices.data(), COUNT_TRANSFORMS, pool);
+	verified &= checkParallel("Transform::getTransformationBatch", memcmp(expectedMatrices.data(), actualMatrices.data(),
+		COUNT_TRANSFORMS * sizeof(Matrix4x4)) == 0);
+
+	Transform::getAffineTransformationBatch(transforms.data(), expectedAffine.data(), COUNT_TRANSFORMS);
+	Transform::getAffineTransformationBatch(transforms.data(), actualAffine.data(), COUNT_TRANSFORMS, pool);
+	verified &= checkParallel("Transform::getAffineTransformationBatch", memcmp(expectedAffine.data(), actualAffine.data(),
+		COUNT_TRANSFORMS * sizeof(Affine3x4)) == 0);
+
+	Quaternion::slerpBatch(from.data(), to.data(), inc.data(), expectedRotations.data(), COUNT_TRANSFORMS);
+	Quaternion::slerpBatch(from.data(), to.data(), inc.data(), actualRotations.data(), COUNT_TRANSFORMS, pool);
+	verified &= checkParallel("Quaternion::slerpBatch", memcmp(expectedRotations.data(), actualRotations.data(),
+		COUNT_TRANSFORMS * sizeof(Quaternion)) == 0);
+
+	return verified;
+}
+
+/**
+ * Measures how the parallel batch operations scale from 1 thread to the
+ * number of hardware threads, on data much larger than the caches
+ */
+static void benchThreadPool()
+{
+	const size_t POINTS = 1 << 21;
+	const size_t TRANSFORMS = 500000;
+	unsigned hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<Vector3> points(POINTS), out(POINTS);
+	std::vector<Transform> transforms(TRANSFORMS);
+	std::vector<Affine3x4> matrices(TRANSFORMS);
+	std::vector<Quaternion> from(TRANSFORMS, Quaternion(0, 0, 0, 1)), to(from), rotations(from);
+	std::vector<float> inc(TRANSFORMS);
+	Affine3x4 affine = Affine3x4::fromPositionRotationScale(Vector3(1, 2, 3), Quaternion::fromAxisAngle(Vector3(0, 1, 0), 0.5f),
+		Vector3(1, 1, 1));
+
+	for (size_t i = 0; i < POINTS; i++)
+	{
+		points[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+	}
+
+	for (size_t i = 0; i < TRANSFORMS; i++)
+	{
+		from[i] = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+		to[i] = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+		transforms[i] = Transform(points[i], from[i], Vector3(1, 1, 1));
+		inc[i] = fabsf(randomFloat()) / 100;
+	}
+
+	double serial[4];
+
+	serial[0] = timeBenchmark(10, POINTS, [&]()
+	{
+		affine.transformPoints(points.data(), out.data(), POINTS);
+		doNotOptimize(out[0]);
+	});
+
+	serial[1] = timeBenchmark(10, POINTS, [&]()
+	{
+		Vector3Array::normalize(ConstVector3View(points.data(), POINTS), Vector3View(out.data(), POINTS));
+		doNotOptimize(out[0]);
+	});
+
+	serial[2] = timeBenchmark(5, TRANSFORMS, [&]()
+	{
+		Transform::getAffineTransformationBatch(transforms.data(), matrices.data(), TRANSFORMS);
+		doNotOptimize(matrices[0]);
+	});
+
+	serial[3] = timeBenchmark(5, TRANSFORMS, [&]()
+	{
+		Quaternion::slerpBatch(from.data(), to.data(), inc.data(), rotations.data(), TRANSFORMS);
+		doNotOptimize(rotations[0]);
+	});
+
+	const char* names[4] = {"transformPoints 2M", "normalize 2M", "Transform to Affine 500K", "slerpBatch 500K"};
+
+	for (int i = 0; i < 4; i++)
+	{
+		printf("%-32s %10.3f ns/op serial\n", names[i], serial[i]);
+	}
+
+	// powers of two up to the number of hardware threads, and that number
+	std::vector<unsigned> threadCounts;
+
+	for (unsigned threads = 1; threads < hardwareThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+
+	threadCounts.push_back(hardwareThreads);
+
+	for (unsigned threads : threadCounts)
+	{
+		ThreadPool pool(threads);
+		double ns[4];
+
+		ns[0] = timeBenchmark(10, POINTS, [&]()
+		{
+			affine.transformPoints(points.data(), out.data(), POINTS, pool);
+			doNotOptimize(out[0]);
+		});
+
+		ns[1] = timeBenchmark(10, POINTS, [&]()
+		{
+			Vector3Array::normalize(ConstVector3View(points.data(), POINTS), Vector3View(out.data(), POINTS), pool);
+			doNotOptimize(out[0]);
+		});
+
+		ns[2] = timeBenchmark(5, TRANSFORMS, [&]()
+		{
+			Transform::getAffineTransformationBatch(transforms.data(), matrices.data(), TRANSFORMS, pool);
+			doNotOptimize(matrices[0]);
+		});
+
+		ns[3] = timeBenchmark(5, TRANSFORMS, [&]()
+		{
+			Quaternion::slerpBatch(from.data(), to.data(), inc.data(), rotations.data(), TRANSFORMS, pool);
+			doNotOptimize(rotations[0]);
+		});
+
+		for (int i = 0; i < 4; i++)
+		{
+			char name[64];
+
+			snprintf(name, sizeof(name), "%s x%u", names[i], threads);
+			printf("%-32s %10.3f ns/op %5.2fx\n", name, ns[i], serial[i] / ns[i]);
+		}
+	}
+}
+
+/**
+ * Checks that expression templates give the same results as the Vector3
+ * and Quaternion operators bit-for-bit, for single values and batches of
+ * packed and interleaved vectors
+ */
+static bool verifyExpressions()
+{
+	using namespace math3d::expr;
+
+	const size_t N = 1003;
+	bool verified = true;
+
+	for (size_t i = 0; i < N && verified; i++)
+	{
+		Vector3 axis = Vector3(randomFloat(), randomFloat(), randomFloat()).normalize();
+		Vector3 v(randomFloat(), randomFloat(), randomFloat());
+		float sinA = randomFloat() / 100, cosA = randomFloat() / 100;
+		Vector3 expected = axis * sinA + v * cosA + axis * (axis.dot(v) * (1 - cosA));
+		Vector3 actual = lazy(axis) * sinA + lazy(v) * cosA + axis * (dot(lazy(axis), v) * (1 - cosA));
+		Vector3 evaluated;
+
+		evaluate(lazy(axis) * sinA + lazy(v) * cosA + axis * (dot(lazy(axis), v) * (1 - cosA)), evaluated);
+		Vector3 expectedCross = (axis.cross(v) - v / sinA) * (v - axis);
+		Vector3 actualCross = (cross(lazy(axis), v) - lazy(v) / sinA) * (lazy(v) - axis);
+
+		Quaternion a = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+		Quaternion b = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+		Quaternion expectedLerp = a + (-b - a) * cosA;
+		Quaternion actualLerp = lazy(a) + (-lazy(b) - a) * cosA;
+		Quaternion evaluatedLerp = a;
+
+		evaluate(lazy(a) + (-lazy(b) - a) * cosA, evaluatedLerp);
+
+		if (memcmp(&expected, &actual, sizeof(Vector3)) != 0 || memcmp(&expected, &evaluated, sizeof(Vector3)) != 0 ||
+			memcmp(&expectedCross, &actualCross, sizeof(Vector3)) != 0 || memcmp(&expectedLerp, &actualLerp, sizeof(Quaternion)) != 0 ||
+			memcmp(&expectedLerp, &evaluatedLerp, sizeof(Quaternion)) != 0 || a.dot(b) != dot(lazy(a), b))
+		{
+			printf("expression templates do not match the operators\n");
+			verified = false;
+		}
+	}
+
+	// batches of packed vectors, and of Vector3 objects, whose stride is 3
+	Vector3Array a(N), b(N), out(N);
+	std::vector<Vector3> interleaved(N), interleavedOut(N);
+	std::vector<float> scales(N), dots(N);
+	std::vector<Vector3> before(N);
+
+	for (size_t i = 0; i < N; i++)
+	{
+		a.set(i, Vector3(randomFloat(), randomFloat(), randomFloat()));
+		b.set(i, Vector3(randomFloat(), randomFloat(), randomFloat()));
+		interleaved[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		scales[i] = randomFloat();
+		before[i] = a[i];
+	}
+
+	ConstVector3View view(interleaved.data(), N);
+
+	evaluate(lazy(a) * 0.5f + cross(lazy(a), lazy(b)) * dot(lazy(a), lazy(b)), out);
+	evaluate(lazy(view) - lazy(a) * lazy(scales.data()), Vector3View(interleavedOut.data(), N));
+	evaluate(dot(lazy(a), lazy(view)), dots.data(), N);
+
+	for (size_t i = 0; i < N && verified; i++)
+	{
+		Vector3 expected = a[i] * 0.5f + a[i].cross(b[i]) * a[i].dot(b[i]);
+		Vector3 expectedInterleaved = interleaved[i] - a[i] * scales[i];
+
+		if (out[i] != expected || interleavedOut[i] != expectedInterleaved || dots[i] != a[i].dot(interleaved[i]))
+		{
+			printf("batch expression templates do not match the operators\n");
+			verified = false;
+		}
+	}
+
+	// in place
+	evaluate(lazy(a) + lazy(b), a);
+
+	for (size_t i = 0; i < N && verified; i++)
+	{
+		if (a[i] != before[i] + b[i])
+		{
+			printf("batch expression templates do not match the operators in place\n");
+			verified = false;
+		}
+	}
+
+	return verified;
+}
+
+/**
+ * Compares chains of Vector3 and Quaternion operators, which build a
+ * temporary for each operation, with the same chains as expression
+ * templates, and batch expressions with one Vector3Array pass per operation
+ */
+static void benchExpressions()
+{
+	using namespace math3d::expr;
+
+	std::vector<Vector3> v(COUNT), out(COUNT);
+	std::vector<Quaternion> from(COUNT, Quaternion(0, 0, 0, 1)), to(from), rotations(from);
+	Vector3 axis = Vector3(1, 2, 3).normalize();
+	float sinA = 0.25f, cosA = 0.75f, t = 0.3f;
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		from[i] = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+		to[i] = Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize();
+	}
+
+	// the constants are copied into locals in both chains, so that the compiler
+	// knows that the stores to out cannot change them, whether or not it
+	// inlines the lambda into the timing loop
+	runBenchmark("rotate chain (operators)", ITERATIONS, COUNT, [&]()
+	{
+		const Vector3 a = axis;
+		const float s = sinA, c = cosA;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			out[i] = a * s + v[i] * c + a * (a.dot(v[i]) * (1 - c));
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("rotate chain (expressions)", ITERATIONS, COUNT, [&]()
+	{
+		const Vector3 a = axis;
+		const float s = sinA, c = cosA;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			evaluate(lazy(a) * s + lazy(v[i]) * c + a * (dot(lazy(a), v[i]) * (1 - c)), out[i]);
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("lerp chain (operators)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			rotations[i] = from[i] + (to[i] - from[i]) * t;
+		}
+
+		doNotOptimize(rotations[0]);
+	});
+
+	runBenchmark("lerp chain (expressions)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			evaluate(lazy(from[i]) + (lazy(to[i]) - from[i]) * t, rotations[i]);
+		}
+
+		doNotOptimize(rotations[0]);
+	});
+
+	// batches much larger than the caches, where each pass reads and writes memory
+	const size_t N = 1 << 20;
+	Vector3Array a(N), b(N), scaled(N), crossed(N), result(N);
+
+	for (size_t i = 0; i < N; i++)
+	{
+		a.set(i, Vector3(randomFloat(), randomFloat(), randomFloat()));
+		b.set(i, Vector3(randomFloat(), randomFloat(), randomFloat()));
+	}
+
+	runBenchmark("a * 0.5 + a x b (3 passes)", 10, (long)N, [&]()
+	{
+		Vector3Array::scale(a, 0.5f, scaled);
+		Vector3Array::cross(a, b, crossed);
+		Vector3Array::add(scaled, crossed, result);
+		doNotOptimize(result.x()[0]);
+	});
+
+	runBenchmark("a * 0.5 + a x b (evaluate)", 10, (long)N, [&]()
+	{
+		evaluate(lazy(a) * 0.5f + cross(lazy(a), lazy(b)), result);
+		doNotOptimize(result.x()[0]);
+	});
+}
+
+/** @brief whether all components of two matrices are equal, usable in constant expressions */
+static constexpr bool sameMatrix(const Matrix4x4& a, const Matrix4x4& b)
+{
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			if (a[y][x] != b[y][x])
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/** @brief uses the compound assignment operators, which can change locals in constant expressions */
+static constexpr Vector3 accumulate(Vector3 v)
+{
+	v += Vector3(1, 2, 3);
+	v *= 2;
+	v -= 1;
+	v /= Vector3(1, 1, 2);
+
+	return v;
+}
+
+// compile-time checks of the constexpr constructors, factories and operators
+static_assert(Vector3(1, 2, 3) + Vector3(4, 5, 6) == Vector3(5, 7, 9), "Vector3::operator+");
+static_assert(Vector3(2, 4, 8) / 2 - 1 == Vector3(0, 1, 3), "Vector3 scalar operators");
+static_assert(-Vector3(1, 2, 3) * Vector3(2, 2, 2) == Vector3(-2, -4, -6), "Vector3::operator*");
+static_assert(Vector3(1, 2, 3).dot(Vector3(4, 5, 6)) == 32, "Vector3::dot");
+static_assert(Vector3(1, 0, 0).cross(Vector3(0, 1, 0)) == Vector3(0, 0, 1), "Vector3::cross");
+static_assert(Vector3(1, 2, 3)[2] == 3 && Vector3(1, 2, 3).magSq() == 14, "Vector3::operator[] and magSq");
+static_assert(accumulate(Vector3(1, 1, 1)) == Vector3(3, 5, 3.5f), "Vector3 compound assignment");
+static_assert(Vector3d(Vector3(0.5f, 1, 2)) == Vector3d(0.5, 1, 2), "Vector3 conversion");
+static_assert(Vector2(3, 4).magSq() == 25 && Vector2(1, 2) + 1 == Vector2(2, 3), "Vector2 operators");
+static_assert(Quaternion(1, 2, 3, 4).conjugate() == Quaternion(-1, -2, -3, 4), "Quaternion::conjugate");
+static_assert(Quaternion(1, 2, 3, 4).dot(Quaternion(1, 1, 1, 1)) == 10, "Quaternion::dot");
+static_assert(Quaternion(1, 2, 3, 4) - Quaternion(1, 1, 1, 1) * 2 == Quaternion(-1, 0, 1, 2), "Quaternion operators");
+static_assert(sameMatrix(Matrix4x4::rotation(Quaternion(0, 0, 0, 1)), Matrix4x4::identity()), "Matrix4x4::rotation");
+static_assert(sameMatrix(Matrix4x4::position(1, 2, 3).transpose().transpose(), Matrix4x4::position(Vector3(1, 2, 3))),
+	"Matrix4x4::transpose");
+static_assert(sameMatrix(Matrix4x4::fromAxes(Vector3(0, 0, 1), Vector3(0, 1, 0)), Matrix4x4::identity()), "Matrix4x4::fromAxes");
+static_assert(sameMatrix(Affine3x4::scale(2, 4, 8).toMatrix4x4(), Matrix4x4::scale(Vector3(2, 4, 8))), "Affine3x4::scale");
+
+#ifdef MATH3D_HAS_CONSTANT_EVALUATED
+// a fixed camera transform, folded into a constant at compile time
+static constexpr Quaternion CAMERA_ROTATION(0.1f, 0.7f, -0.2f, 0.68f);
+static constexpr Matrix4x4 CAMERA = Matrix4x4::position(0.3f, 1.7f, -4.2f) * Matrix4x4::rotation(CAMERA_ROTATION) *
+	Matrix4x4::scale(1.5f, 1.5f, 1.5f);
+static constexpr Vector3 CAMERA_FORWARD = CAMERA_ROTATION.forward();
+static constexpr Vector3 CAMERA_POINT = CAMERA * Vector3(0.25f, -3.5f, 7.0f);
+
+static_assert(Quaternion(1, 0, 0, 0) * Quaternion(0, 1, 0, 0) == Quaternion(0, 0, 1, 0), "Quaternion::operator*");
+static_assert(Quaternion(0, 1, 0, 0).forward() == Vector3(0, 0, -1) && Quaternion(0, 0, 0, 1).up() == Vector3(0, 1, 0),
+	"Quaternion::forward and up");
+static_assert(Matrix4x4::position(1, 2, 3) * Matrix4x4::scale(2, 4, 8) * Vector3(1, 1, 1) == Vector3(3, 6, 11),
+	"Matrix4x4::operator*");
+static_assert(sameMatrix(Matrix4x4::position(1, 2, 3) * Matrix4x4::scale(2, 4, 8),
+	Affine3x4::fromPositionRotationScale(Vector3(1, 2, 3), Quaternion(0, 0, 0, 1), Vector3(2, 4, 8)).toMatrix4x4()),
+	"Affine3x4::fromPositionRotationScale");
+#endif
+
+/**
+ * Checks that the constants evaluated at compile time are bit-identical to
+ * the same operations evaluated at runtime, which use the SIMD kernels
+ */
+static bool verifyConstexpr()
+{
+#ifdef MATH3D_HAS_CONSTANT_EVALUATED
+	// read through volatile so that the compiler cannot fold the runtime path
+	volatile float values[] = { 0.1f, 0.7f, -0.2f, 0.68f, 0.3f, 1.7f, -4.2f, 1.5f, 0.25f, -3.5f, 7.0f };
+	Quaternion rotation(values[0], values[1], values[2], values[3]);
+	Matrix4x4 camera = Matrix4x4::position(values[4], values[5], values[6]) * Matrix4x4::rotation(rotation) *
+		Matrix4x4::scale(values[7], values[7], values[7]);
+	Vector3 forward = rotation.forward();
+	Vector3 point = camera * Vector3(values[8], values[9], values[10]);
+
+	if (memcmp(&camera, &CAMERA, sizeof(Matrix4x4)) != 0 || memcmp(&forward, &CAMERA_FORWARD, sizeof(Vector3)) != 0 ||
+		memcmp(&point, &CAMERA_POINT, sizeof(Vector3)) != 0)
+	{
+		printf("constexpr results do not match the runtime ones\n");
+
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+static void benchConstexpr()
+{
+#ifdef MATH3D_HAS_CONSTANT_EVALUATED
+	std::vector<Matrix4x4> world(COUNT), out(COUNT);
+	volatile float scale = 1.5f;
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		world[i] = Matrix4x4::position(randomFloat(), randomFloat(), randomFloat());
+	}
+
+	runBenchmark("world * camera (built per call)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			out[i] = world[i] * (Matrix4x4::position(0.3f, 1.7f, -4.2f) * Matrix4x4::rotation(CAMERA_ROTATION) *
+				Matrix4x4::scale(scale, scale, scale));
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("world * camera (constexpr)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			out[i] = world[i] * CAMERA;
+		}
+
+		doNotOptimize(out[0]);
+	});
+#endif
+}
+
+#ifdef MATH3D_HAS_CONSTANT_EVALUATED
+static_assert(Vector4(1, 2, 3, 4) * 2 - Vector4(1, 1, 1, 1) == Vector4(1, 3, 5, 7), "Vector4 operators");
+static_assert(Matrix4x4::position(1, 2, 3) * Vector4(1, 1, 1, 0) == Vector4(1, 1, 1, 0), "Matrix4x4 * Vector4");
+static_assert(Vector3A(1, 0, 0).cross(Vector3A(0, 1, 0)) / 2 == Vector3A(0, 0, 0.5f), "Vector3A operators");
+#endif
+
+/**
+ * Checks that the SSE operators of Vector4 and Vector3A are bit-identical
+ * to the corresponding scalar Vector3 and Matrix4x4 operators, and that
+ * the padding of a Vector3A stays 0
+ */
+static bool verifyVector4()
+{
+	bool passed = true;
+
+	for (int i = 0; i < COUNT && passed; i++)
+	{
+		Vector3 a(randomFloat(), randomFloat(), randomFloat());
+		Vector3 b(randomFloat() + 2, randomFloat() + 2, randomFloat() + 2);
+		float n = randomFloat() + 2;
+		Vector3A aa(a), ba(b);
+		Vector4 a4(a, n), b4(b, n);
+		Matrix4x4 m = Matrix4x4::position(b) * Matrix4x4::rotation(Quaternion(a.x, a.y, a.z, n).normalize()) *
+			Matrix4x4::scale(n, n, n);
+
+		Vector3 expected[] = { a + b, a - b, a * b, a / b, a + n, a - n, a * n, a / n, -a, a.cross(b), a.normalize(),
+			m * a, m * a };
+		Vector3A actual[] = { aa + ba, aa - ba, aa * ba, aa / ba, aa + n, aa - n, aa * n, aa / n, -aa, aa.cross(ba),
+			aa.normalize(), Vector3A((m * Vector4(a, 1)).toVector3()), Vector3A((m * Vector4(a, 1)).project()) };
+
+		for (size_t j = 0; j < sizeof(expected) / sizeof(expected[0]); j++)
+		{
+			Vector3 result = actual[j].toVector3();
+
+			if (memcmp(&result, &expected[j], sizeof(Vector3)) != 0 || actual[j].padding != 0)
+			{
+				printf("Vector3A operator %d does not match Vector3\n", (int)j);
+				passed = false;
+			}
+		}
+
+		Vector4 sum = a4 + b4;
+		Vector4 quotient = a4 / b4;
+		Vector4 transformed = m * b4;
+		Vector4 expectedTransformed(m[0][0] * b.x + m[0][1] * b.y + m[0][2] * b.z + m[0][3] * n,
+			m[1][0] * b.x + m[1][1] * b.y + m[1][2] * b.z + m[1][3] * n,
+			m[2][0] * b.x + m[2][1] * b.y + m[2][2] * b.z + m[2][3] * n,
+			m[3][0] * b.x + m[3][1] * b.y + m[3][2] * b.z + m[3][3] * n);
+
+		if (aa.dot(ba) != a.dot(b) || sum.toVector3() != a + b || sum.w != n + n ||
+			quotient.toVector3() != a / b || quotient.w != 1 || a4.dot(b4) != a.dot(b) + n * n ||
+			memcmp(&transformed, &expectedTransformed, sizeof(Vector4)) != 0)
+		{
+			printf("Vector4 operators do not match Vector3\n");
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+static void benchVector4()
+{
+	std::vector<Vector3> v3(COUNT), out3(COUNT);
+	std::vector<Vector3A> v3a(COUNT), out3a(COUNT);
+	std::vector<Vector4> v4(COUNT), out4(COUNT);
+	Matrix4x4 m = Matrix4x4::position(0.3f, 1.7f, -4.2f) * Matrix4x4::rotation(Quaternion(0.1f, 0.7f, -0.2f, 0.68f).normalize());
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		v3[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		v3a[i] = Vector3A(v3[i]);
+		v4[i] = Vector4(v3[i], 1);
+	}
+
+	runBenchmark("Vector3 (a + b) * a - b / 2", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			const Vector3& a = v3[i];
+			const Vector3& b = v3[COUNT - 1 - i];
+
+			out3[i] = (a + b) * a - b / 2;
+		}
+
+		doNotOptimize(out3[0]);
+	});
+
+	runBenchmark("Vector3A (a + b) * a - b / 2", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			const Vector3A& a = v3a[i];
+			const Vector3A& b = v3a[COUNT - 1 - i];
+
+			out3a[i] = (a + b) * a - b / 2;
+		}
+
+		doNotOptimize(out3a[0]);
+	});
+
+	runBenchmark("Matrix4x4 * Vector3", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			out3[i] = m * v3[i];
+		}
+
+		doNotOptimize(out3[0]);
+	});
+
+	runBenchmark("Matrix4x4 * Vector4", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			out4[i] = m * v4[i];
+		}
+
+		doNotOptimize(out4[0]);
+	});
+}
+
+/**
+ * Checks that Vector3::rotateBy matches the quaternion products it
+ * replaces, and that the batch rotations match it bit-for-bit, using a
+ * count that exercises the scalar tail loops
+ */
+static bool verifyRotateVectors()
+{
+	const size_t n = 1003;
+	std::vector<Quaternion> rotations;
+	std::vector<Vector3> v(n), expected(n), expectedEach(n), actual(n);
+	std::vector<float> streams[4];
+	ThreadPool pool(3);
+	bool passed = true;
+
+	for (size_t i = 0; i < n; i++)
+	{
+		rotations.push_back(Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize());
+		v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+		expected[i] = v[i].rotateBy(rotations[0]);
+		expectedEach[i] = v[i].rotateBy(rotations[i]);
+
+		Quaternion product = rotations[i] * v[i] * rotations[i].conjugate();
+		Vector3 error = expectedEach[i] - Vector3(product.x, product.y, product.z);
+
+		if (error.magnitude() > 1e-4f * (1 + v[i].magnitude()))
+		{
+			printf("Vector3::rotateBy does not match the quaternion products\n");
+			passed = false;
+			break;
+		}
+
+		streams[0].push_back(rotations[i].x);
+		streams[1].push_back(rotations[i].y);
+		streams[2].push_back(rotations[i].z);
+		streams[3].push_back(rotations[i].w);
+	}
+
+	auto check = [&](const char* name, const std::vector<Vector3>& reference)
+	{
+		if (memcmp(actual.data(), reference.data(), n * sizeof(Vector3)) != 0)
+		{
+			printf("%s does not match Vector3::rotateBy\n", name);
+			passed = false;
+		}
+	};
+
+	Vector3Array soa((ConstVector3View(v.data(), n))), soaOut(n);
+
+	rotations[0].rotateVectors(v.data(), actual.data(), n);
+	check("Quaternion::rotateVectors(Vector3*)", expected);
+
+	rotations[0].rotateVectors(soa, soaOut);
+	Vector3Array::copy(soaOut, Vector3View(actual.data(), n));
+	check("Quaternion::rotateVectors(Vector3Array)", expected);
+
+	rotations[0].rotateVectors(v.data(), actual.data(), n, pool);
+	check("Quaternion::rotateVectors(pool)", expected);
+
+	Vector3Array::rotate(ConstVector3View(v.data(), n), rotations.data(), Vector3View(actual.data(), n));
+	check("Vector3Array::rotate(Quaternion*)", expectedEach);
+
+	Vector3Array::rotate(soa, streams[0].data(), streams[1].data(), streams[2].data(), streams[3].data(), soaOut);
+	Vector3Array::copy(soaOut, Vector3View(actual.data(), n));
+	check("Vector3Array::rotate(streams)", expectedEach);
+
+	Quaterniond rotationd(rotations[0]);
+	std::vector<Vector3d> vd(v.begin(), v.end()), actuald(n);
+
+	rotationd.rotateVectors(vd.data(), actuald.data(), n);
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (actuald[i] != vd[i].rotateBy(rotationd))
+		{
+			printf("Quaterniond::rotateVectors does not match Vector3d::rotateBy\n");
+			passed = false;
+			break;
+		}
+	}
+
+	return passed;
+}
+
+static void benchRotateVectors()
+{
+	std::vector<Quaternion> rotations;
+	std::vector<Vector3> v(COUNT), out(COUNT);
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		rotations.push_back(Quaternion(randomFloat(), randomFloat(), randomFloat(), randomFloat()).normalize());
+		v[i] = Vector3(randomFloat(), randomFloat(), randomFloat());
+	}
+
+	Vector3Array soa((ConstVector3View(v.data(), COUNT))), soaOut(COUNT);
+
+	runBenchmark("rotateBy (quaternion products)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			Quaternion product = rotations[i] * v[i] * rotations[i].conjugate();
+
+			out[i] = Vector3(product.x, product.y, product.z);
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("rotateBy (cross products)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			out[i] = v[i].rotateBy(rotations[i]);
+		}
+
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("Quaternion::rotateVectors", ITERATIONS, COUNT, [&]()
+	{
+		rotations[0].rotateVectors(v.data(), out.data(), COUNT);
+		doNotOptimize(out[0]);
+	});
+
+	runBenchmark("Vector3Array::rotate (N quats)", ITERATIONS, COUNT, [&]()
+	{
+		Vector3Array::rotate(soa, rotations.data(), soaOut);
+		doNotOptimize(soaOut.x()[0]);
+	});
+}
+
+/** @brief compares the standard library and the Trigonometry polynomials, one at a time and in batches */
+static void benchTrigonometry()
+{
+	std::vector<float> angles(COUNT), y(COUNT), x(COUNT), s(COUNT), c(COUNT);
+	std::vector<Vector3> euler(COUNT), axes(COUNT);
+	std::vector<Quaternion> q(COUNT, Quaternion(0, 0, 0, 1));
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		angles[i] = randomFloat() * 0.0314f;
+		y[i] = randomFloat();
+		x[i] = randomFloat();
+		euler[i] = Vector3(randomFloat(), randomFloat(), randomFloat()) * 0.0314f;
+		axes[i] = Vector3(randomFloat(), randomFloat(), randomFloat()).normalize();
+	}
+
+	verifyTrigonometry(true);
+
+	runBenchmark("sin+cos (libm)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			s[i] = sin(angles[i]);
+			c[i] = cos(angles[i]);
+		}
+
+		doNotOptimize(s[0]);
+		doNotOptimize(c[0]);
+	});
+
+	runBenchmark("Trigonometry::sincos batch", ITERATIONS, COUNT, [&]()
+	{
+		Trigonometry::sincos(angles.data(), s.data(), c.data(), COUNT);
+		doNotOptimize(s[0]);
+		doNotOptimize(c[0]);
+	});
+
+	runBenchmark("atan2 (libm)", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			s[i] = atan2(y[i], x[i]);
+		}
+
+		doNotOptimize(s[0]);
+	});
+
+	runBenchmark("Trigonometry::atan2 batch", ITERATIONS, COUNT, [&]()
+	{
+		Trigonometry::atan2(y.data(), x.data(), s.data(), COUNT);
+		doNotOptimize(s[0]);
+	});
+
+	runBenchmark("Quaternion::fromEulerAngles", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			q[i] = Quaternion::fromEulerAngles(euler[i]);
+		}
+
+		doNotOptimize(q[0]);
+	});
+
+	runBenchmark("Quaternion::fromEulerAnglesBatch", ITERATIONS, COUNT, [&]()
+	{
+		Quaternion::fromEulerAnglesBatch(euler.data(), q.data(), COUNT);
+		doNotOptimize(q[0]);
+	});
+
+	runBenchmark("Quaternion::fromAxisAngle", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			q[i] = Quaternion::fromAxisAngle(axes[i], angles[i]);
+		}
+
+		doNotOptimize(q[0]);
+	});
+
+	runBenchmark("Quaternion::fromAxisAngleBatch", ITERATIONS, COUNT, [&]()
+	{
+		Quaternion::fromAxisAngleBatch(axes.data(), angles.data(), q.data(), COUNT);
+		doNotOptimize(q[0]);
+	});
+}
+
+int main()
+{
+	printf("Math3D Benchmark (%s)\n", BUILD_MODE);
+
+	bool verified = true;
+
+#ifdef MATH3D_SSE
+	verified &= verifyKernel("mat4MulSSE", math3d::detail::mat4MulScalar, math3d::detail::mat4MulSSE, 16, 16, 16);
+	verified &= verifyKernel("mat4TransformPointSSE", math3d::detail::mat4TransformPointScalar,
+		math3d::detail::mat4TransformPointSSE, 3, 16, 3);
+	verified &= verifyKernel("mat4InverseSSE", math3d::detail::mat4InverseScalar, math3d::detail::mat4InverseSSE, 16, 16);
+	verified &= verifyKernel("affineMulSSE", math3d::detail::affineMulScalar, math3d::detail::affineMulSSE, 12, 12, 12);
+	verified &= verifyKernel("affineInverseSSE", math3d::detail::affineInverseScalar,
+		math3d::detail::affineInverseSSE, 12, 12);
+#endif
+
+#ifdef MATH3D_AVX
+	verified &= verifyKernel("mat4MulAVX", math3d::detail::mat4MulScalar, math3d::detail::mat4MulAVX, 16, 16, 16);
+#endif
+
+	verified &= verifyBatchKernels(math3d::detail::compileTimeKernels, math3d::detail::kernels());
+	verified &= verifyInverses<float>("Matrix4x4");
+	verified &= verifyInverses<double>("Matrix4x4d");
+	verified &= verifyAnimationSampler();
+	verified &= verifySkinning();
+	verified &= verifyCompression(false);
+	verified &= verifyFastNormalize(false);
+	verified &= verifyTrigonometry(false);
+	verified &= verifyFrustum();
+	verified &= verifyBounds();
+	verified &= verifyRay();
+	verified &= verifyBVH();
+	verified &= verifyThreadPool();
+	verified &= verifyExpressions();
+	verified &= verifyConstexpr();
+	verified &= verifyVector4();
+	verified &= verifyRotateVectors();
+
+#ifndef MATH3D_HEADER_ONLY
+	SIMDLevel detected = Dispatch::detect();
+
+	printf("Detected %s, using %s\n", Dispatch::levelName(detected), Dispatch::levelName(Dispatch::level()));
+
+	for (int i = (int)SIMDLevel::SSE2; i <= (int)detected; i++)
+	{
+		verified &= verifyKernels((SIMDLevel)i);
+	}
+#endif
+
+	if (!verified)
+	{
+		return 1;
+	}
+
+	std::vector<Vector3> a, b;
+	std::vector<Quaternion> q;
+	std::vector<Matrix4x4> m(COUNT);
+	std::vector<Affine3x4> affine(COUNT);
+
+	for (int i = 0; i < COUNT; i++)
+	{
+		a.push_back(Vector3(i * 0.5f, i * 0.25f, i * 0.125f));
+		b.push_back(Vector3(1.0f / (i + 1), 2.0f, -0.5f * i));
+		q.push_back(Quaternion::fromAxisAngle(Vector3(0, 1, 0), i * 0.001f));
+		m[i] = Matrix4x4::position(a[i]) * Matrix4x4::rotation(q[i]);
+		affine[i] = Affine3x4(m[i]);
+	}
+
+	runBenchmark("Vector3::operator+", ITERATIONS, COUNT, [&]()
+	{
+		Vector3 acc;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc = acc + a[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Vector3::operator* + operator+", ITERATIONS, COUNT, [&]()
+	{
+		Vector3 acc;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc += a[i] * b[i] + b[i] * 0.5f;
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Vector3::dot", ITERATIONS, COUNT, [&]()
+	{
+		float acc = 0;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc += a[i].dot(b[i]);
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Vector3::cross", ITERATIONS, COUNT, [&]()
+	{
+		Vector3 acc;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc += a[i].cross(b[i]);
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Quaternion::operator*", ITERATIONS, COUNT, [&]()
+	{
+		Quaternion acc(0, 0, 0, 1);
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc = acc * q[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Matrix4x4::operator[]", ITERATIONS, COUNT, [&]()
+	{
+		float acc = 0;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc += m[i][0][3] + m[i][1][3] + m[i][2][3];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Matrix4x4::operator*(Matrix4x4)", ITERATIONS, COUNT, [&]()
+	{
+		Matrix4x4 acc = Matrix4x4::identity();
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc = acc * m[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	std::vector<Matrix4x4d> md(m.begin(), m.end());
+
+	runBenchmark("Matrix4x4d::operator*(Matrix4x4d)", ITERATIONS, COUNT, [&]()
+	{
+		Matrix4x4d acc = Matrix4x4d::identity();
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc = acc * md[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	runBenchmark("Matrix4x4::operator*(Vector3)", ITERATIONS, COUNT, [&]()
+	{
+		Vector3 acc;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc += m[i] * a[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	std::vector<Matrix4x4> inverses(COUNT);
+
+	runBenchmark("Matrix4x4::inverse", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			inverses[i] = m[i].inverse();
+		}
+
+		doNotOptimize(inverses[0]);
+	});
+
+	runBenchmark("Matrix4x4::inverseAffine", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			inverses[i] = m[i].inverseAffine();
+		}
+
+		doNotOptimize(inverses[0]);
+	});
+
+	runBenchmark("Matrix4x4::inverseRigid", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			inverses[i] = m[i].inverseRigid();
+		}
+
+		doNotOptimize(inverses[0]);
+	});
+
+	runBenchmark("Affine3x4::operator*(Affine3x4)", ITERATIONS, COUNT, [&]()
+	{
+		Affine3x4 acc = Affine3x4::identity();
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc = acc * affine[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	// independent products, as when composing the world matrices of a hierarchy
+	std::vector<Matrix4x4> mOut(COUNT);
+	std::vector<Affine3x4> affineOut(COUNT);
+
+	runBenchmark("Matrix4x4 independent products", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			mOut[i] = m[i] * m[COUNT - 1 - i];
+		}
+
+		doNotOptimize(mOut[0]);
+	});
+
+	runBenchmark("Affine3x4 independent products", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			affineOut[i] = affine[i] * affine[COUNT - 1 - i];
+		}
+
+		doNotOptimize(affineOut[0]);
+	});
+
+	runBenchmark("Affine3x4::operator*(Vector3)", ITERATIONS, COUNT, [&]()
+	{
+		Vector3 acc;
+
+		for (int i = 0; i < COUNT; i++)
+		{
+			acc += affine[i] * a[i];
+		}
+
+		doNotOptimize(acc);
+	});
+
+	std::vector<Vector3> aosOut(COUNT);
+	Vector3Array soaA(ConstVector3View(a.data(), COUNT));
+	Vector3Array soaB(ConstVector3View(b.data(), COUNT));
+	Vector3Array soaOut(COUNT);
+
+	runBenchmark("loop (a + b).normalize()", ITERATIONS, COUNT, [&]()
+	{
+		for (int i = 0; i < COUNT; i++)
+		{
+			aosOut[i] = (a[i] + b[i]).normalize();
+		}
+
+		doNotOptimize(aosOut[0]);
+	});
+
+	runBenchmark("Vector3Array add+normalize SoA", ITERATIONS, COUNT, [&]()
+	{
+		Vector3Array::add(soaA, soaB, soaOut);
+		Vector3Array::normalize(soaOut, soaOut);
+
+		doNotOptimize(soaOut.x()[0]);
+	});
+
+	runBenchmark("Vector3Array add+normalize AoS", ITERATIONS, COUNT, [&]()
+	{
+		Vector3View out(aosOut.data(), COUNT);
+
+		Vector3Array::add(ConstVector3View(a.data(), COUNT), ConstVector3View(b.data(), COUNT), out);
+		Vector3Array::normalize(out, out);
+
+		doNotOptimize(aosOut[0]);
+	});
+
+	benchTransformPoints();
+	benchTransformHierarchy();
+	benchAnimationSampler();
+	benchSkinning();
+	benchCompression();
+	benchFastNormalize();
+	benchTrigonometry();
+	benchFrustum();
+	benchBounds();
+	benchRay();
+	benchBVH();
+	benchThreadPool();
+	benchExpressions();
+	benchConstexpr();
+	benchVector4();
+	benchRotateVectors();
+
+	benchMat4Mul("mat4MulScalar", math3d::detail::mat4MulScalar, m);
+
+#ifdef MATH3D_SSE
+	benchMat4Mul("mat4MulSSE", math3d::detail::mat4MulSSE, m);
+#endif
+
+#ifdef MATH3D_AVX
+	benchMat4Mul("mat4MulAVX", math3d::detail::mat4MulAVX, m);
+#endif
+
+#ifndef MATH3D_HEADER_ONLY
+	for (int i = (int)SIMDLevel::Scalar; i <= (int)detected; i++)
+	{
+		char name[64];
+		snprintf(name, sizeof(name), "Dispatch mat4Mul (%s)", Dispatch::levelName((SIMDLevel)i));
+		benchMat4Mul(name, Dispatch::kernels((SIMDLevel)i).mat4Mul, m);
+	}
+#endif
+
+	return 0;
+}
\ No newline at end of file
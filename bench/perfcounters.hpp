@@ -0,0 +1,205 @@
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+/**
+ * Reads the hardware performance counters of the calling thread through
+ * Linux's perf_event_open, to tell whether a benchmark is limited by
+ * computation (a high number of instructions per cycle) or by memory (cache
+ * misses per operation)
+ *
+ * Every counter is opened on its own, so a CPU or virtual machine that lacks
+ * one still reports the others. Containers commonly forbid perf_event_open
+ * altogether (see /proc/sys/kernel/perf_event_paranoid and seccomp), in which
+ * case available() is false and getError() says why; callers are expected to
+ * carry on with timings only.
+ */
+class PerfCounters
+{
+	public:
+		enum Counter
+		{
+			Cycles,
+			Instructions,
+			L1DataMisses,
+			LastLevelMisses,
+			BranchMisses,
+			COUNTER_COUNT
+		};
+
+		PerfCounters()
+		{
+			for (int i = 0; i < COUNTER_COUNT; i++)
+			{
+				fds[i] = open((Counter)i);
+				values[i] = -1;
+			}
+		}
+
+		~PerfCounters()
+		{
+#ifdef __linux__
+			for (int i = 0; i < COUNTER_COUNT; i++)
+			{
+				if (fds[i] >= 0)
+				{
+					close(fds[i]);
+				}
+			}
+#endif
+		}
+
+		/** @brief gets whether at least one counter could be opened */
+		bool available() const
+		{
+			for (int i = 0; i < COUNTER_COUNT; i++)
+			{
+				if (fds[i] >= 0)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/** @brief gets why the first counter that failed to open could not be opened */
+		const std::string& getError() const
+		{
+			return error;
+		}
+
+		/** @brief resets and starts every counter */
+		void start()
+		{
+#ifdef __linux__
+			for (int i = 0; i < COUNTER_COUNT; i++)
+			{
+				if (fds[i] >= 0)
+				{
+					ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+					ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+				}
+			}
+#endif
+		}
+
+		/**
+		 * Stops every counter and reads the counts since start. When the
+		 * kernel had to share the hardware counters between more events
+		 * than there are registers, the counts are scaled up by the
+		 * fraction of the time each event was actually counted.
+		 */
+		void stop()
+		{
+#ifdef __linux__
+			for (int i = 0; i < COUNTER_COUNT; i++)
+			{
+				if (fds[i] >= 0)
+				{
+					ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+				}
+			}
+
+			for (int i = 0; i < COUNTER_COUNT; i++)
+			{
+				// value, time enabled, time running
+				unsigned long long data[3];
+
+				values[i] = -1;
+
+				if (fds[i] >= 0 && read(fds[i], data, sizeof(data)) == (ssize_t)sizeof(data) && data[2] > 0)
+				{
+					values[i] = (double)data[0] * ((double)data[1] / data[2]);
+				}
+			}
+#endif
+		}
+
+		/** @brief gets the count of the last run, or a negative number if the counter is unavailable */
+		double get(Counter counter) const
+		{
+			return values[counter];
+		}
+
+		/** @brief gets the name of a counter, as used in the JSON report */
+		static const char* name(Counter counter)
+		{
+			static const char* const names[COUNTER_COUNT] =
+			{
+				"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+			};
+
+			return names[counter];
+		}
+	private:
+		int open(Counter counter)
+		{
+#ifdef __linux__
+			perf_event_attr attr;
+
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			switch (counter)
+			{
+				case Cycles:
+					attr.type = PERF_TYPE_HARDWARE;
+					attr.config = PERF_COUNT_HW_CPU_CYCLES;
+					break;
+				case Instructions:
+					attr.type = PERF_TYPE_HARDWARE;
+					attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+					break;
+				case L1DataMisses:
+					attr.type = PERF_TYPE_HW_CACHE;
+					attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+						(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+					break;
+				case LastLevelMisses:
+					attr.type = PERF_TYPE_HARDWARE;
+					attr.config = PERF_COUNT_HW_CACHE_MISSES;
+					break;
+				default:
+					attr.type = PERF_TYPE_HARDWARE;
+					attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+					break;
+			}
+
+			// this thread, on any CPU
+			int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+
+			if (fd < 0 && error.empty())
+			{
+				error = std::string("perf_event_open failed for ") + name(counter) + ": " + strerror(errno);
+			}
+
+			return fd;
+#else
+			(void)counter;
+			error = "hardware counters are only supported on Linux";
+
+			return -1;
+#endif
+		}
+
+		int fds[COUNTER_COUNT];
+		double values[COUNTER_COUNT];
+		std::string error;
+};
+
+#endif
@@ -0,0 +1,811 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "math3d/math3d.hpp"
+#include "math3d/dispatch.hpp"
+#include "bench.hpp"
+#include "perfcounters.hpp"
+
+#ifdef MATH3D_HEADER_ONLY
+	#define BUILD_MODE "header-only"
+#else
+	#define BUILD_MODE "static library"
+#endif
+
+/**
+ * Microbenchmarks of every public operation of Vector2, Vector3,
+ * Quaternion, Matrix4x4 and Transform, for diffing runs between versions
+ * of the library
+ *
+ * Each operation is timed in two ways:
+ * - single: one call at a time, with the operands reloaded from memory
+ *   and the result stored on every call, so that nothing is hoisted,
+ *   batched or vectorized across calls
+ * - batch: a loop applying it to arrays of 16 (L1), 1024 (L1 and L2) and
+ *   65536 (beyond L2) operands, which the compiler is free to optimize
+ *
+ * With --counters, every measurement is followed by a run of the same
+ * length under the hardware performance counters, reporting cycles,
+ * instructions per cycle, and L1 data, last level cache and branch misses
+ * per operation (per element for batches). Where the counters cannot be
+ * opened, e.g. in most containers, only the times are reported.
+ *
+ * Usage: Math3DSuite [--json file] [--filter text] [--min-time ms] [--counters]
+ */
+
+static const size_t BATCH_SIZES[] = {16, 1024, 65536};
+static const size_t BATCH_SIZE_COUNT = sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0]);
+static const size_t MAX_BATCH_SIZE = 65536;
+// the single calls cycle through this many operands so that branches see varied data
+static const size_t SINGLE_OPERANDS = 16;
+static const int REPETITIONS = 3;
+
+/** @brief the time taken by one operation in one mode */
+struct Result
+{
+	std::string name;
+	const char* mode;
+	size_t size;
+	double nsPerOp;
+	// per operation, or negative if unavailable
+	double counters[PerfCounters::COUNTER_COUNT];
+};
+
+/**
+ * Runs the benchmarks as they are added, printing a row per operation
+ * and keeping the results for the JSON report
+ */
+class Suite
+{
+	public:
+		/**
+		 * @param filter only operations whose name contains it run, or all if null
+		 * @param minNs the shortest run that is long enough to time
+		 * @param counters reads hardware counters around every measurement, or null
+		 */
+		Suite(const char* filter, double minNs, PerfCounters* counters)
+		: filter(filter), minNs(minNs), counters(counters), rowStart(0)
+		{
+			printf("%-52s %10s", "operation (ns/op)", "single");
+
+			for (size_t i = 0; i < BATCH_SIZE_COUNT; i++)
+			{
+				printf(" %9zu", BATCH_SIZES[i]);
+			}
+
+			printf("\n");
+		}
+
+		/**
+		 * Benchmarks op(a[i], b[i]) one call at a time and in batches
+		 *
+		 * Note: a and b must hold MAX_BATCH_SIZE operands
+		 */
+		template <typename A, typename B, typename Op>
+		void add(const char* name, const std::vector<A>& a, const std::vector<B>& b, Op op)
+		{
+			if (!selected(name))
+			{
+				return;
+			}
+
+			typedef decltype(op(a[0], b[0])) R;
+
+			std::vector<R> out(MAX_BATCH_SIZE, op(a[0], b[0]));
+			size_t next = 0;
+
+			rowStart = results.size();
+
+			measure(name, "single", 1, [&]()
+			{
+				size_t i = next++ % SINGLE_OPERANDS;
+				A x = a[i];
+				B y = b[i];
+
+				clobber(x);
+				clobber(y);
+				doNotOptimize(op(x, y));
+			});
+
+			for (size_t s = 0; s < BATCH_SIZE_COUNT; s++)
+			{
+				size_t n = BATCH_SIZES[s];
+
+				measure(name, "batch", n, [&]()
+				{
+					for (size_t i = 0; i < n; i++)
+					{
+						out[i] = op(a[i], b[i]);
+					}
+
+					escape(out.data());
+				});
+			}
+
+			endRow();
+		}
+
+		/**
+		 * Benchmarks an operation that only has a batch form
+		 *
+		 * @param func processes the first n elements of its arrays, which
+		 * must hold MAX_BATCH_SIZE elements
+		 */
+		template <typename Func>
+		void addBatch(const char* name, Func func)
+		{
+			if (!selected(name))
+			{
+				return;
+			}
+
+			printf("%-52s %10s", name, "-");
+			rowStart = results.size();
+
+			for (size_t s = 0; s < BATCH_SIZE_COUNT; s++)
+			{
+				size_t n = BATCH_SIZES[s];
+
+				measure(name, "batch", n, [&]()
+				{
+					func(n);
+				});
+			}
+
+			endRow();
+		}
+
+		/** @brief writes the results as JSON, returning whether the file could be written */
+		bool writeJson(const char* path) const
+		{
+			FILE* file = fopen(path, "w");
+
+			if (!file)
+			{
+				return false;
+			}
+
+			fprintf(file, "{\n");
+			fprintf(file, "\t\"build\": \"%s\",\n", BUILD_MODE);
+			fprintf(file, "\t\"simd\": \"%s\",\n", simdLevel());
+			fprintf(file, "\t\"compiler\": \"%s\",\n", jsonEscape(__VERSION__).c_str());
+			fprintf(file, "\t\"unit\": \"ns/op\",\n");
+
+			if (counters)
+			{
+				fprintf(file, "\t\"counters\": \"%s\",\n",
+					counters->available() ? "available" : jsonEscape(counters->getError()).c_str());
+			}
+
+			fprintf(file, "\t\"results\": [\n");
+
+			for (size_t i = 0; i < results.size(); i++)
+			{
+				const Result& r = results[i];
+
+				fprintf(file, "\t\t{\"name\": \"%s\", \"mode\": \"%s\", \"size\": %zu, \"ns_per_op\": %.4f",
+					jsonEscape(r.name).c_str(), r.mode, r.size, r.nsPerOp);
+
+				if (counting())
+				{
+					for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+					{
+						fprintf(file, ", \"%s_per_op\": ", PerfCounters::name((PerfCounters::Counter)c));
+						writeJsonNumber(file, r.counters[c]);
+					}
+
+					fprintf(file, ", \"ipc\": ");
+					writeJsonNumber(file, ipc(r));
+				}
+
+				fprintf(file, "}%s\n", i + 1 < results.size() ? "," : "");
+			}
+
+			fprintf(file, "\t]\n}\n");
+
+			return fclose(file) == 0;
+		}
+
+		/** @brief gets the name of the SIMD level the kernels run at */
+		static const char* simdLevel()
+		{
+#ifdef MATH3D_HEADER_ONLY
+	#if defined(MATH3D_AVX512)
+			return "avx512";
+	#elif defined(MATH3D_AVX)
+			return "avx";
+	#elif defined(MATH3D_SSE)
+			return "sse2";
+	#else
+			return "scalar";
+	#endif
+#else
+			return Dispatch::levelName(Dispatch::level());
+#endif
+		}
+	private:
+		bool selected(const char* name) const
+		{
+			return !filter || strstr(name, filter);
+		}
+
+		bool counting() const
+		{
+			return counters && counters->available();
+		}
+
+		/**
+		 * Times func, which performs ops operations per call, then runs it
+		 * again for about as long under the counters and records both
+		 */
+		template <typename Func>
+		void measure(const char* name, const char* mode, size_t ops, Func func)
+		{
+			Result r = {name, mode, ops, timeAdaptiveBenchmark(minNs, REPETITIONS, ops, func), {}};
+
+			for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+			{
+				r.counters[c] = -1;
+			}
+
+			if (counting())
+			{
+				double iterations = minNs / (r.nsPerOp * ops);
+				long count = iterations < 1 ? 1 : (long)iterations;
+
+				func(); // warm up caches, like timeBenchmark
+
+				counters->start();
+
+				for (long i = 0; i < count; i++)
+				{
+					func();
+				}
+
+				counters->stop();
+
+				for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+				{
+					double value = counters->get((PerfCounters::Counter)c);
+
+					r.counters[c] = value < 0 ? -1 : value / ((double)count * ops);
+				}
+
+			}
+
+			if (strcmp(mode, "single") == 0)
+			{
+				printf("%-52s %10.2f", name, r.nsPerOp);
+			}
+			else
+			{
+				printf(" %9.2f", r.nsPerOp);
+			}
+
+			fflush(stdout);
+
+			results.push_back(r);
+		}
+
+		/** @brief ends the row of an operation, followed by the counters of each of its measurements */
+		void endRow()
+		{
+			printf("\n");
+
+			if (!counting())
+			{
+				return;
+			}
+
+			for (size_t i = rowStart; i < results.size(); i++)
+			{
+				const Result& r = results[i];
+				char label[32];
+
+				snprintf(label, sizeof(label), r.size == 1 ? "%s" : "%s %zu", r.mode, r.size);
+				printf("    %-20s", label);
+				printCounter("cycles", r.counters[PerfCounters::Cycles]);
+				printCounter("IPC", ipc(r));
+				printCounter("L1D miss", r.counters[PerfCounters::L1DataMisses]);
+				printCounter("LLC miss", r.counters[PerfCounters::LastLevelMisses]);
+				printCounter("branch miss", r.counters[PerfCounters::BranchMisses]);
+				printf("\n");
+			}
+		}
+
+		static void printCounter(const char* name, double value)
+		{
+			if (value < 0)
+			{
+				printf("  %s %8s", name, "-");
+			}
+			else
+			{
+				printf("  %s %8.3f", name, value);
+			}
+		}
+
+		/** @brief gets the instructions per cycle of a result, or a negative number if unavailable */
+		static double ipc(const Result& r)
+		{
+			double cycles = r.counters[PerfCounters::Cycles];
+			double instructions = r.counters[PerfCounters::Instructions];
+
+			return cycles > 0 && instructions >= 0 ? instructions / cycles : -1;
+		}
+
+		static void writeJsonNumber(FILE* file, double value)
+		{
+			if (value < 0)
+			{
+				fprintf(file, "null");
+			}
+			else
+			{
+				fprintf(file, "%.4f", value);
+			}
+		}
+
+		static std::string jsonEscape(const std::string& text)
+		{
+			std::string escaped;
+
+			for (size_t i = 0; i < text.size(); i++)
+			{
+				if (text[i] == '"' || text[i] == '\\')
+				{
+					escaped += '\\';
+				}
+
+				escaped += text[i];
+			}
+
+			return escaped;
+		}
+
+		std::vector<Result> results;
+		const char* filter;
+		double minNs;
+		PerfCounters* counters;
+		// the first result of the operation being measured
+		size_t rowStart;
+};
+
+static float randomFloat(float min, float max)
+{
+	return min + (float)rand() / RAND_MAX * (max - min);
+}
+
+/** @brief random numbers away from 0, so that divisions stay finite */
+static std::vector<float> randomScalars()
+{
+	std::vector<float> v;
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		v.push_back(randomFloat(0.5f, 2.0f));
+	}
+
+	return v;
+}
+
+static std::vector<Vector2> randomVector2s()
+{
+	std::vector<Vector2> v;
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		v.push_back(Vector2(randomFloat(0.5f, 2.0f), randomFloat(-2.0f, -0.5f)));
+	}
+
+	return v;
+}
+
+static std::vector<Vector3> randomVector3s()
+{
+	std::vector<Vector3> v;
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		v.push_back(Vector3(randomFloat(0.5f, 2.0f), randomFloat(-2.0f, -0.5f), randomFloat(0.5f, 2.0f)));
+	}
+
+	return v;
+}
+
+static std::vector<Quaternion> randomQuaternions()
+{
+	std::vector<Quaternion> q;
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		q.push_back(Quaternion::fromEulerAngles(randomFloat(-3, 3), randomFloat(-3, 3), randomFloat(-3, 3)));
+	}
+
+	return q;
+}
+
+static std::vector<Transform> randomTransforms()
+{
+	std::vector<Transform> t;
+	std::vector<Vector3> positions = randomVector3s(), scales = randomVector3s();
+	std::vector<Quaternion> rotations = randomQuaternions();
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		t.push_back(Transform(positions[i], rotations[i], scales[i] * scales[i]));
+	}
+
+	return t;
+}
+
+static void benchVector2(Suite& suite)
+{
+	std::vector<Vector2> a = randomVector2s(), b = randomVector2s();
+	std::vector<float> s = randomScalars();
+
+	suite.add("Vector2::Vector2(x, y)", s, s, [](float x, float y) { return Vector2(x, y); });
+	suite.add("Vector2::dot", a, b, [](const Vector2& u, const Vector2& v) { return u.dot(v); });
+	suite.add("Vector2::magnitude", a, s, [](const Vector2& u, float) { return u.magnitude(); });
+	suite.add("Vector2::magSq", a, s, [](const Vector2& u, float) { return u.magSq(); });
+	suite.add("Vector2::normalize", a, s, [](const Vector2& u, float) { return u.normalize(); });
+	suite.add("Vector2::normalize(Fast)", a, s, [](const Vector2& u, float) { return u.normalize(Precision::Fast); });
+	suite.add("Vector2::operator==", a, b, [](const Vector2& u, const Vector2& v) { return (int)(u == v); });
+	suite.add("Vector2::operator!=", a, b, [](const Vector2& u, const Vector2& v) { return (int)(u != v); });
+	suite.add("Vector2::operator-()", a, s, [](const Vector2& u, float) { return -u; });
+	suite.add("Vector2::operator+(Vector2)", a, b, [](const Vector2& u, const Vector2& v) { return u + v; });
+	suite.add("Vector2::operator-(Vector2)", a, b, [](const Vector2& u, const Vector2& v) { return u - v; });
+	suite.add("Vector2::operator*(Vector2)", a, b, [](const Vector2& u, const Vector2& v) { return u * v; });
+	suite.add("Vector2::operator/(Vector2)", a, b, [](const Vector2& u, const Vector2& v) { return u / v; });
+	suite.add("Vector2::operator+(float)", a, s, [](const Vector2& u, float n) { return u + n; });
+	suite.add("Vector2::operator-(float)", a, s, [](const Vector2& u, float n) { return u - n; });
+	suite.add("Vector2::operator*(float)", a, s, [](const Vector2& u, float n) { return u * n; });
+	suite.add("Vector2::operator/(float)", a, s, [](const Vector2& u, float n) { return u / n; });
+	suite.add("Vector2::operator+=(Vector2)", a, b, [](Vector2 u, const Vector2& v) { return u += v; });
+	suite.add("Vector2::operator-=(Vector2)", a, b, [](Vector2 u, const Vector2& v) { return u -= v; });
+	suite.add("Vector2::operator*=(Vector2)", a, b, [](Vector2 u, const Vector2& v) { return u *= v; });
+	suite.add("Vector2::operator/=(Vector2)", a, b, [](Vector2 u, const Vector2& v) { return u /= v; });
+	suite.add("Vector2::operator+=(float)", a, s, [](Vector2 u, float n) { return u += n; });
+	suite.add("Vector2::operator-=(float)", a, s, [](Vector2 u, float n) { return u -= n; });
+	suite.add("Vector2::operator*=(float)", a, s, [](Vector2 u, float n) { return u *= n; });
+	suite.add("Vector2::operator/=(float)", a, s, [](Vector2 u, float n) { return u /= n; });
+	suite.add("Vector2::operator[]", a, s, [](const Vector2& u, float n) { return u[n > 1 ? 1 : 0]; });
+}
+
+static void benchVector3(Suite& suite)
+{
+	std::vector<Vector3> a = randomVector3s(), b = randomVector3s(), axes = randomVector3s();
+	std::vector<Quaternion> q = randomQuaternions();
+	std::vector<float> s = randomScalars();
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		axes[i] = axes[i].normalize();
+	}
+
+	suite.add("Vector3::Vector3(x, y, z)", a, s, [](const Vector3& u, float n) { return Vector3(u.x, n, u.z); });
+	suite.add("Vector3::dot", a, b, [](const Vector3& u, const Vector3& v) { return u.dot(v); });
+	suite.add("Vector3::cross", a, b, [](const Vector3& u, const Vector3& v) { return u.cross(v); });
+	suite.add("Vector3::magnitude", a, s, [](const Vector3& u, float) { return u.magnitude(); });
+	suite.add("Vector3::magSq", a, s, [](const Vector3& u, float) { return u.magSq(); });
+	suite.add("Vector3::normalize", a, s, [](const Vector3& u, float) { return u.normalize(); });
+	suite.add("Vector3::normalize(Fast)", a, s, [](const Vector3& u, float) { return u.normalize(Precision::Fast); });
+	suite.add("Vector3::rotateBy(Quaternion)", a, q, [](const Vector3& u, const Quaternion& r) { return u.rotateBy(r); });
+	suite.add("Vector3::rotateBy(axis, angle)", a, axes, [](const Vector3& u, const Vector3& axis)
+	{
+		return u.rotateBy(axis, axis.x);
+	});
+	suite.add("Vector3::operator==", a, b, [](const Vector3& u, const Vector3& v) { return (int)(u == v); });
+	suite.add("Vector3::operator!=", a, b, [](const Vector3& u, const Vector3& v) { return (int)(u != v); });
+	suite.add("Vector3::operator-()", a, s, [](const Vector3& u, float) { return -u; });
+	suite.add("Vector3::operator+(Vector3)", a, b, [](const Vector3& u, const Vector3& v) { return u + v; });
+	suite.add("Vector3::operator-(Vector3)", a, b, [](const Vector3& u, const Vector3& v) { return u - v; });
+	suite.add("Vector3::operator*(Vector3)", a, b, [](const Vector3& u, const Vector3& v) { return u * v; });
+	suite.add("Vector3::operator/(Vector3)", a, b, [](const Vector3& u, const Vector3& v) { return u / v; });
+	suite.add("Vector3::operator+(float)", a, s, [](const Vector3& u, float n) { return u + n; });
+	suite.add("Vector3::operator-(float)", a, s, [](const Vector3& u, float n) { return u - n; });
+	suite.add("Vector3::operator*(float)", a, s, [](const Vector3& u, float n) { return u * n; });
+	suite.add("Vector3::operator/(float)", a, s, [](const Vector3& u, float n) { return u / n; });
+	suite.add("Vector3::operator+=(Vector3)", a, b, [](Vector3 u, const Vector3& v) { return u += v; });
+	suite.add("Vector3::operator-=(Vector3)", a, b, [](Vector3 u, const Vector3& v) { return u -= v; });
+	suite.add("Vector3::operator*=(Vector3)", a, b, [](Vector3 u, const Vector3& v) { return u *= v; });
+	suite.add("Vector3::operator/=(Vector3)", a, b, [](Vector3 u, const Vector3& v) { return u /= v; });
+	suite.add("Vector3::operator+=(float)", a, s, [](Vector3 u, float n) { return u += n; });
+	suite.add("Vector3::operator-=(float)", a, s, [](Vector3 u, float n) { return u -= n; });
+	suite.add("Vector3::operator*=(float)", a, s, [](Vector3 u, float n) { return u *= n; });
+	suite.add("Vector3::operator/=(float)", a, s, [](Vector3 u, float n) { return u /= n; });
+	suite.add("Vector3::operator[]", a, s, [](const Vector3& u, float n) { return u[n > 1 ? 2 : 0]; });
+}
+
+static void benchQuaternion(Suite& suite)
+{
+	std::vector<Quaternion> a = randomQuaternions(), b = randomQuaternions();
+	std::vector<Vector3> v = randomVector3s(), axes = randomVector3s(), angles = randomVector3s();
+	std::vector<Matrix4x4> m;
+	std::vector<float> s = randomScalars(), t;
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		axes[i] = axes[i].normalize();
+		m.push_back(Matrix4x4::rotation(a[i].x, a[i].y, a[i].z, a[i].w));
+		t.push_back(randomFloat(0, 1));
+	}
+
+	suite.add("Quaternion::fromAxisAngle(x, y, z, angle)", axes, s, [](const Vector3& axis, float angle)
+	{
+		return Quaternion::fromAxisAngle(axis.x, axis.y, axis.z, angle);
+	});
+	suite.add("Quaternion::fromAxisAngle(axis, angle)", axes, s, [](const Vector3& axis, float angle)
+	{
+		return Quaternion::fromAxisAngle(axis, angle);
+	});
+	suite.add("Quaternion::fromAxisAngle(axis)", v, s, [](const Vector3& axis, float) { return Quaternion::fromAxisAngle(axis); });
+	suite.add("Quaternion::fromEulerAngles(x, y, z)", angles, s, [](const Vector3& e, float)
+	{
+		return Quaternion::fromEulerAngles(e.x, e.y, e.z);
+	});
+	suite.add("Quaternion::fromEulerAngles(angles)", angles, s, [](const Vector3& e, float) { return Quaternion::fromEulerAngles(e); });
+	suite.add("Quaternion::fromMatrix", m, s, [](const Matrix4x4& r, float) { return Quaternion::fromMatrix(r); });
+	suite.add("Quaternion::Quaternion(x, y, z, w)", v, s, [](const Vector3& u, float n) { return Quaternion(u.x, u.y, u.z, n); });
+	suite.add("Quaternion::magnitude", a, s, [](const Quaternion& q, float) { return q.magnitude(); });
+	suite.add("Quaternion::magSq", a, s, [](const Quaternion& q, float) { return q.magSq(); });
+	suite.add("Quaternion::normalize", a, s, [](const Quaternion& q, float) { return q.normalize(); });
+	suite.add("Quaternion::normalize(Fast)", a, s, [](const Quaternion& q, float) { return q.normalize(Precision::Fast); });
+	suite.add("Quaternion::conjugate", a, s, [](const Quaternion& q, float) { return q.conjugate(); });
+	suite.add("Quaternion::dot", a, b, [](const Quaternion& q, const Quaternion& r) { return q.dot(r); });
+	suite.add("Quaternion::nlerp", a, b, [](const Quaternion& q, const Quaternion& r) { return q.nlerp(r, 0.3f); });
+	suite.add("Quaternion::nlerp(Fast)", a, b, [](const Quaternion& q, const Quaternion& r)
+	{
+		return q.nlerp(r, 0.3f, true, Precision::Fast);
+	});
+	suite.add("Quaternion::slerp", a, b, [](const Quaternion& q, const Quaternion& r) { return q.slerp(r, 0.3f); });
+	suite.add("Quaternion::operator==", a, b, [](const Quaternion& q, const Quaternion& r) { return (int)(q == r); });
+	suite.add("Quaternion::operator!=", a, b, [](const Quaternion& q, const Quaternion& r) { return (int)(q != r); });
+	suite.add("Quaternion::rotateBy", a, b, [](const Quaternion& q, const Quaternion& r) { return q.rotateBy(r); });
+	suite.add("Quaternion::rotateBy(Fast)", a, b, [](const Quaternion& q, const Quaternion& r)
+	{
+		return q.rotateBy(r, Precision::Fast);
+	});
+	suite.add("Quaternion::operator-()", a, s, [](const Quaternion& q, float) { return -q; });
+	suite.add("Quaternion::operator+(Quaternion)", a, b, [](const Quaternion& q, const Quaternion& r) { return q + r; });
+	suite.add("Quaternion::operator-(Quaternion)", a, b, [](const Quaternion& q, const Quaternion& r) { return q - r; });
+	suite.add("Quaternion::operator*(Quaternion)", a, b, [](const Quaternion& q, const Quaternion& r) { return q * r; });
+	suite.add("Quaternion::operator*(Vector3)", a, v, [](const Quaternion& q, const Vector3& u) { return q * u; });
+	suite.add("Quaternion::operator*(float)", a, s, [](const Quaternion& q, float n) { return q * n; });
+	suite.add("Quaternion::forward", a, s, [](const Quaternion& q, float) { return q.forward(); });
+	suite.add("Quaternion::back", a, s, [](const Quaternion& q, float) { return q.back(); });
+	suite.add("Quaternion::left", a, s, [](const Quaternion& q, float) { return q.left(); });
+	suite.add("Quaternion::right", a, s, [](const Quaternion& q, float) { return q.right(); });
+	suite.add("Quaternion::up", a, s, [](const Quaternion& q, float) { return q.up(); });
+	suite.add("Quaternion::down", a, s, [](const Quaternion& q, float) { return q.down(); });
+	suite.add("Quaternion::operator[]", a, s, [](const Quaternion& q, float n) { return q[n > 1 ? 3 : 0]; });
+
+	std::vector<Quaternion> out(MAX_BATCH_SIZE, Quaternion(0, 0, 0, 1));
+
+	suite.addBatch("Quaternion::fromEulerAnglesBatch", [&](size_t n)
+	{
+		Quaternion::fromEulerAnglesBatch(angles.data(), out.data(), n);
+		escape(out.data());
+	});
+	suite.addBatch("Quaternion::fromAxisAngleBatch", [&](size_t n)
+	{
+		Quaternion::fromAxisAngleBatch(axes.data(), s.data(), out.data(), n);
+		escape(out.data());
+	});
+
+	std::vector<Vector3> rotated(MAX_BATCH_SIZE);
+	Vector3Array soa(ConstVector3View(v.data(), MAX_BATCH_SIZE)), soaOut(MAX_BATCH_SIZE);
+
+	suite.addBatch("Quaternion::rotateVectors(Vector3*)", [&](size_t n)
+	{
+		a[0].rotateVectors(v.data(), rotated.data(), n);
+		escape(rotated.data());
+	});
+	suite.addBatch("Quaternion::rotateVectors(Vector3Array)", [&](size_t n)
+	{
+		a[0].rotateVectors(ConstVector3View(soa.x(), soa.y(), soa.z(), n), Vector3View(soaOut.x(), soaOut.y(), soaOut.z(), n));
+		escape(soaOut.x());
+	});
+	suite.addBatch("Vector3Array::rotate(Quaternion*)", [&](size_t n)
+	{
+		Vector3Array::rotate(ConstVector3View(soa.x(), soa.y(), soa.z(), n), a.data(),
+			Vector3View(soaOut.x(), soaOut.y(), soaOut.z(), n));
+		escape(soaOut.x());
+	});
+}
+
+/** @brief the three operands of Matrix4x4::fromAxes */
+struct Axes
+{
+	Vector3 forward;
+	Vector3 up;
+	Vector3 right;
+};
+
+static void benchMatrix4x4(Suite& suite)
+{
+	std::vector<Transform> transforms = randomTransforms();
+	std::vector<Matrix4x4> a, b, rigid, projections;
+	std::vector<Quaternion> q = randomQuaternions();
+	std::vector<Vector3> v = randomVector3s(), forward = randomVector3s(), up = randomVector3s();
+	std::vector<Axes> axes;
+	std::vector<float> s = randomScalars();
+
+	for (size_t i = 0; i < MAX_BATCH_SIZE; i++)
+	{
+		a.push_back(transforms[i].getTransformation());
+		b.push_back(transforms[MAX_BATCH_SIZE - 1 - i].getTransformation());
+		rigid.push_back(Matrix4x4::position(v[i]) * Matrix4x4::rotation(q[i].x, q[i].y, q[i].z, q[i].w));
+		projections.push_back(Matrix4x4::perspective(s[i], 1.5f, 0.1f, 100.0f) * a[i]);
+		forward[i] = forward[i].normalize();
+		up[i] = forward[i].cross(up[i]).cross(forward[i]).normalize();
+
+		Axes frame = {forward[i], up[i], up[i].cross(forward[i])};
+		axes.push_back(frame);
+	}
+
+	suite.add("Matrix4x4::identity", s, s, [](float, float) { return Matrix4x4::identity(); });
+	suite.add("Matrix4x4::position(x, y, z)", v, s, [](const Vector3& u, float) { return Matrix4x4::position(u.x, u.y, u.z); });
+	suite.add("Matrix4x4::position(Vector3)", v, s, [](const Vector3& u, float) { return Matrix4x4::position(u); });
+	suite.add("Matrix4x4::scale(x, y, z)", v, s, [](const Vector3& u, float) { return Matrix4x4::scale(u.x, u.y, u.z); });
+	suite.add("Matrix4x4::scale(Vector3)", v, s, [](const Vector3& u, float) { return Matrix4x4::scale(u); });
+	suite.add("Matrix4x4::rotation(x, y, z)", v, s, [](const Vector3& u, float) { return Matrix4x4::rotation(u.x, u.y, u.z); });
+	suite.add("Matrix4x4::rotation(Vector3)", v, s, [](const Vector3& u, float) { return Matrix4x4::rotation(u); });
+	suite.add("Matrix4x4::rotation(x, y, z, w)", q, s, [](const Quaternion& r, float)
+	{
+		return Matrix4x4::rotation(r.x, r.y, r.z, r.w);
+	});
+	suite.add("Matrix4x4::fromAxisAngle(x, y, z, angle)", forward, s, [](const Vector3& axis, float angle)
+	{
+		return Matrix4x4::fromAxisAngle(axis.x, axis.y, axis.z, angle);
+	});
+	suite.add("Matrix4x4::fromAxisAngle(axis, angle)", forward, s, [](const Vector3& axis, float angle)
+	{
+		return Matrix4x4::fromAxisAngle(axis, angle);
+	});
+	suite.add("Matrix4x4::fromAxisAngle(axis)", v, s, [](const Vector3& axis, float) { return Matrix4x4::fromAxisAngle(axis); });
+	suite.add("Matrix4x4::fromAxes(forward, up)", forward, up, [](const Vector3& f, const Vector3& u)
+	{
+		return Matrix4x4::fromAxes(f, u);
+	});
+	suite.add("Matrix4x4::fromAxes(forward, up, right)", axes, s, [](const Axes& frame, float)
+	{
+		return Matrix4x4::fromAxes(frame.forward, frame.up, frame.right);
+	});
+	suite.add("Matrix4x4::perspective", s, s, [](float fov, float aspectRatio)
+	{
+		return Matrix4x4::perspective(fov, aspectRatio, 0.1f, 100.0f);
+	});
+	suite.add("Matrix4x4::determinant", a, s, [](const Matrix4x4& m, float) { return m.determinant(); });
+	suite.add("Matrix4x4::inverse", projections, s, [](const Matrix4x4& m, float) { return m.inverse(); });
+	suite.add("Matrix4x4::inverseAffine", a, s, [](const Matrix4x4& m, float) { return m.inverseAffine(); });
+	suite.add("Matrix4x4::inverseRigid", rigid, s, [](const Matrix4x4& m, float) { return m.inverseRigid(); });
+	suite.add("Matrix4x4::transpose", a, s, [](const Matrix4x4& m, float) { return m.transpose(); });
+	suite.add("Matrix4x4::operator*(Matrix4x4)", a, b, [](const Matrix4x4& m, const Matrix4x4& n) { return m * n; });
+	suite.add("Matrix4x4::operator*(Vector3)", a, v, [](const Matrix4x4& m, const Vector3& u) { return m * u; });
+	suite.add("Matrix4x4::operator[]", a, s, [](const Matrix4x4& m, float n) { return m[n > 1 ? 3 : 0][1]; });
+
+	const Matrix4x4& m = a[0];
+	const Matrix4x4& projection = projections[0];
+	std::vector<Vector3> out(MAX_BATCH_SIZE);
+	Vector3Array soa(ConstVector3View(v.data(), MAX_BATCH_SIZE)), soaOut(MAX_BATCH_SIZE);
+
+	suite.addBatch("Matrix4x4::transformPoints(Vector3*)", [&](size_t n)
+	{
+		m.transformPoints(v.data(), out.data(), n);
+		escape(out.data());
+	});
+	suite.addBatch("Matrix4x4::transformPoints(Vector3Array)", [&](size_t n)
+	{
+		m.transformPoints(ConstVector3View(soa.x(), soa.y(), soa.z(), n), Vector3View(soaOut.x(), soaOut.y(), soaOut.z(), n));
+		escape(soaOut.x());
+	});
+	suite.addBatch("Matrix4x4::transformDirections(Vector3*)", [&](size_t n)
+	{
+		m.transformDirections(v.data(), out.data(), n);
+		escape(out.data());
+	});
+	suite.addBatch("Matrix4x4::transformDirections(Vector3Array)", [&](size_t n)
+	{
+		m.transformDirections(ConstVector3View(soa.x(), soa.y(), soa.z(), n), Vector3View(soaOut.x(), soaOut.y(), soaOut.z(), n));
+		escape(soaOut.x());
+	});
+	suite.addBatch("Matrix4x4::transformHomogeneous(Vector3*)", [&](size_t n)
+	{
+		projection.transformHomogeneous(v.data(), out.data(), n);
+		escape(out.data());
+	});
+	suite.addBatch("Matrix4x4::transformHomogeneous(Vector3Array)", [&](size_t n)
+	{
+		projection.transformHomogeneous(ConstVector3View(soa.x(), soa.y(), soa.z(), n),
+			Vector3View(soaOut.x(), soaOut.y(), soaOut.z(), n));
+		escape(soaOut.x());
+	});
+}
+
+static void benchTransform(Suite& suite)
+{
+	std::vector<Transform> t = randomTransforms();
+	std::vector<Quaternion> q = randomQuaternions();
+	std::vector<Vector3> v = randomVector3s();
+
+	suite.add("Transform::Transform(position, rotation, scale)", v, q, [](const Vector3& u, const Quaternion& r)
+	{
+		return Transform(u, r, u);
+	});
+	suite.add("Transform::getTransformation", t, v, [](const Transform& x, const Vector3&) { return x.getTransformation(); });
+	suite.add("Transform::getAffineTransformation", t, v, [](const Transform& x, const Vector3&)
+	{
+		return x.getAffineTransformation();
+	});
+	suite.add("Transform::translateBy(x, y, z)", t, v, [](Transform x, const Vector3& u) { return x.translateBy(u.x, u.y, u.z); });
+	suite.add("Transform::translateBy(Vector3)", t, v, [](Transform x, const Vector3& u) { return x.translateBy(u); });
+	suite.add("Transform::rotateBy", t, q, [](Transform x, const Quaternion& r) { return x.rotateBy(r); });
+	suite.add("Transform::lookAt(x, y, z)", t, v, [](Transform x, const Vector3& u) { return x.lookAt(u.x, u.y, u.z); });
+	suite.add("Transform::lookAt(Vector3)", t, v, [](Transform x, const Vector3& u) { return x.lookAt(u); });
+}
+
+int main(int argc, char** argv)
+{
+	const char* jsonPath = NULL;
+	const char* filter = NULL;
+	double minTimeMs = 2;
+	bool useCounters = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+		{
+			jsonPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+		{
+			minTimeMs = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--counters") == 0)
+		{
+			useCounters = true;
+		}
+		else
+		{
+			printf("Usage: %s [--json file] [--filter text] [--min-time ms] [--counters]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	printf("Math3D Suite (%s, %s)\n", BUILD_MODE, Suite::simdLevel());
+
+	PerfCounters counters;
+
+	if (useCounters && !counters.available())
+	{
+		printf("Hardware counters are unavailable (%s), reporting times only\n", counters.getError().c_str());
+	}
+
+	Suite suite(filter, minTimeMs * 1e6, useCounters ? &counters : NULL);
+
+	benchVector2(suite);
+	benchVector3(suite);
+	benchQuaternion(suite);
+	benchMatrix4x4(suite);
+	benchTransform(suite);
+
+	if (jsonPath)
+	{
+		if (!suite.writeJson(jsonPath))
+		{
+			printf("Could not write %s\n", jsonPath);
+			return 1;
+		}
+
+		printf("Wrote %s\n", jsonPath);
+	}
+
+	return 0;
+}
@@ -0,0 +1,137 @@
+#ifndef AABB_HPP
+#define AABB_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include "vector3.hpp"
+#include <cstddef>
+
+/**
+ * An axis-aligned bounding box, stored as its smallest and largest
+ * corners
+ *
+ * Transforming a box transforms its center as a point and its extents by
+ * the absolute values of the matrix, which gives the smallest box around
+ * the transformed box without transforming its eight corners.
+ */
+template <typename T>
+class AABBT
+{
+	public:
+		/**
+		 * Creates an empty box, with min at +infinity and max at -infinity,
+		 * which merging with a point or box turns into that point or box
+		 */
+		static AABBT empty();
+		/**
+		 * Creates a new box from its center and extents
+		 *
+		 * @param center the center of the box
+		 * @param extents half of the size of the box along each axis
+		 */
+		static AABBT fromCenterExtents(const Vector3T<T>& center, const Vector3T<T>& extents);
+		/** @brief creates the smallest box containing count points, or an empty box if there are none */
+		static AABBT fromPoints(const Vector3T<T>* points, size_t count);
+
+		/**
+		 * Creates a new box from its corners
+		 *
+		 * @param min the smallest coordinates of the box
+		 * @param max the largest coordinates of the box
+		 */
+		AABBT(const Vector3T<T>& min, const Vector3T<T>& max);
+		/** @brief creates a new box by copying the corners of box */
+		AABBT(const AABBT& box) = default;
+		/**
+		 * Creates a new box by converting the components of a box with
+		 * another scalar type, e.g. an AABBd
+		 */
+		template <typename U>
+		explicit AABBT(const AABBT<U>& box);
+
+		/** @brief gets the center of the box */
+		Vector3T<T> getCenter() const;
+		/** @brief gets half of the size of the box along each axis */
+		Vector3T<T> getExtents() const;
+		/** @brief gets the size of the box along each axis */
+		Vector3T<T> getSize() const;
+		/** @brief gets the area of the surface of the box, or 0 if it is empty */
+		T surfaceArea() const;
+		/** @brief whether the box contains no points, i.e. min is greater than max along an axis */
+		bool isEmpty() const;
+
+		/** @brief creates the smallest box containing this box and another */
+		AABBT merge(const AABBT& box) const;
+		/** @brief creates the smallest box containing this box and a point */
+		AABBT merge(const Vector3T<T>& point) const;
+
+		/** @brief tests whether a point is inside of the box or on its boundary */
+		bool contains(const Vector3T<T>& point) const;
+		/** @brief tests whether another box is entirely inside of this one */
+		bool contains(const AABBT& box) const;
+		/** @brief tests whether two boxes overlap or touch */
+		bool overlaps(const AABBT& box) const;
+		/** @brief tests whether the box and a sphere overlap or touch */
+		bool overlaps(const SphereT<T>& sphere) const;
+		/**
+		 * Tests whether the box and a triangle overlap or touch, by
+		 * testing for a separating axis among the axes of the box, the
+		 * normal of the triangle, and the cross products of their edges
+		 */
+		bool overlapsTriangle(const Vector3T<T>& a, const Vector3T<T>& b, const Vector3T<T>& c) const;
+
+		/**
+		 * Creates the smallest box around this box transformed by a matrix
+		 *
+		 * Note: the box must not be empty, and the bottom row of the matrix
+		 * is ignored, so it must be an affine transformation
+		 */
+		AABBT transform(const Matrix4x4T<T>& m) const;
+		/**
+		 * Creates the smallest box around this box transformed by a matrix
+		 *
+		 * Note: the box must not be empty
+		 */
+		AABBT transform(const Affine3x4T<T>& m) const;
+
+		/**
+		 * Transforms count boxes by a matrix each, e.g. the local bounds
+		 * of the objects of a scene by their world matrices, in one pass
+		 *
+		 * Note: the boxes must not be empty, and out may be the same as in
+		 *
+		 * @param in the boxes
+		 * @param matrices the matrix of each box
+		 * @param out receives the transformed boxes
+		 * @param count the number of boxes
+		 */
+		static void transformBatch(const AABBT* in, const Affine3x4T<T>* matrices, AABBT* out, size_t count);
+		/** @brief transforms count boxes by a matrix each, ignoring the bottom rows of the matrices */
+		static void transformBatch(const AABBT* in, const Matrix4x4T<T>* matrices, AABBT* out, size_t count);
+		/** @brief transforms count boxes by the same matrix */
+		static void transformBatch(const AABBT* in, const Affine3x4T<T>& m, AABBT* out, size_t count);
+
+		/**
+		 * Compares whether two boxes are equal by testing
+		 * whether their corners are equal
+		 */
+		bool operator==(const AABBT&) const;
+		bool operator!=(const AABBT&) const;
+
+		Vector3T<T> min;
+		Vector3T<T> max;
+	private:
+};
+
+#include "sphere.hpp"
+#include "matrix4x4.hpp"
+#include "affine3x4.hpp"
+
+#ifdef MATH3D_HEADER_ONLY
+#include "aabb.inl"
+#else
+extern template class AABBT<float>;
+extern template class AABBT<double>;
+#endif
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef AABB_INL
+#define AABB_INL
+
+#include "config.hpp"
+#include "aabb.hpp"
+#include "kernels/table.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static_assert(sizeof(AABB) == 6 * sizeof(float), "AABB arrays must be tightly packed");
+static_assert(sizeof(Affine3x4) == 12 * sizeof(float), "Affine3x4 arrays must be tightly packed");
+static_assert(sizeof(Matrix4x4) == 16 * sizeof(float), "Matrix4x4 arrays must be tightly packed");
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::empty()
+{
+	T inf = std::numeric_limits<T>::infinity();
+
+	return AABBT<T>(Vector3T<T>(inf, inf, inf), Vector3T<T>(-inf, -inf, -inf));
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::fromCenterExtents(const Vector3T<T>& center, const Vector3T<T>& extents)
+{
+	return AABBT<T>(center - extents, center + extents);
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::fromPoints(const Vector3T<T>* points, size_t count)
+{
+	AABBT<T> box = empty();
+
+	for (size_t i = 0; i < count; i++)
+	{
+		box = box.merge(points[i]);
+	}
+
+	return box;
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T>::AABBT(const Vector3T<T>& min, const Vector3T<T>& max)
+: min(min), max(max)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_INLINE AABBT<T>::AABBT(const AABBT<U>& box)
+: min(box.min), max(box.max)
+{
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> AABBT<T>::getCenter() const
+{
+	return (min + max) * T(0.5);
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> AABBT<T>::getExtents() const
+{
+	return (max - min) * T(0.5);
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> AABBT<T>::getSize() const
+{
+	return max - min;
+}
+
+template <typename T>
+MATH3D_INLINE T AABBT<T>::surfaceArea() const
+{
+	if (isEmpty())
+	{
+		return 0;
+	}
+
+	Vector3T<T> size = max - min;
+
+	return 2 * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::isEmpty() const
+{
+	return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::merge(const AABBT<T>& box) const
+{
+	return AABBT<T>(Vector3T<T>(std::min(min.x, box.min.x), std::min(min.y, box.min.y), std::min(min.z, box.min.z)),
+		Vector3T<T>(std::max(max.x, box.max.x), std::max(max.y, box.max.y), std::max(max.z, box.max.z)));
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::merge(const Vector3T<T>& point) const
+{
+	return AABBT<T>(Vector3T<T>(std::min(min.x, point.x), std::min(min.y, point.y), std::min(min.z, point.z)),
+		Vector3T<T>(std::max(max.x, point.x), std::max(max.y, point.y), std::max(max.z, point.z)));
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::contains(const Vector3T<T>& point) const
+{
+	return point.x >= min.x && point.x <= max.x &&
+		point.y >= min.y && point.y <= max.y &&
+		point.z >= min.z && point.z <= max.z;
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::contains(const AABBT<T>& box) const
+{
+	return box.min.x >= min.x && box.max.x <= max.x &&
+		box.min.y >= min.y && box.max.y <= max.y &&
+		box.min.z >= min.z && box.max.z <= max.z;
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::overlaps(const AABBT<T>& box) const
+{
+	return min.x <= box.max.x && max.x >= box.min.x &&
+		min.y <= box.max.y && max.y >= box.min.y &&
+		min.z <= box.max.z && max.z >= box.min.z;
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::overlaps(const SphereT<T>& sphere) const
+{
+	return sphere.overlaps(*this);
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::overlapsTriangle(const Vector3T<T>& a, const Vector3T<T>& b, const Vector3T<T>& c) const
+{
+	// the axes of the box
+	if (!overlaps(AABBT<T>::empty().merge(a).merge(b).merge(c)))
+	{
+		return false;
+	}
+
+	// the rest of the tests are relative to the center of the box
+	Vector3T<T> center = getCenter();
+	Vector3T<T> e = getExtents();
+	Vector3T<T> v[3] = {a - center, b - center, c - center};
+	Vector3T<T> edges[3] = {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+
+	// the normal of the triangle, onto which the whole triangle projects to one point
+	Vector3T<T> normal = edges[0].cross(edges[1]);
+	T distance = normal.dot(v[0]);
+
+	if (std::fabs(distance) > std::fabs(normal.x) * e.x + std::fabs(normal.y) * e.y + std::fabs(normal.z) * e.z)
+	{
+		return false;
+	}
+
+	// each edge crossed with each axis of the box
+	for (int i = 0; i < 3; i++)
+	{
+		const Vector3T<T>& edge = edges[i];
+		Vector3T<T> axes[3] = {Vector3T<T>(0, -edge.z, edge.y), Vector3T<T>(edge.z, 0, -edge.x),
+			Vector3T<T>(-edge.y, edge.x, 0)};
+
+		for (const Vector3T<T>& axis : axes)
+		{
+			T p0 = axis.dot(v[0]);
+			T p1 = axis.dot(v[1]);
+			T p2 = axis.dot(v[2]);
+			T radius = std::fabs(axis.x) * e.x + std::fabs(axis.y) * e.y + std::fabs(axis.z) * e.z;
+
+			if (std::min(p0, std::min(p1, p2)) > radius || std::max(p0, std::max(p1, p2)) < -radius)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::transform(const Matrix4x4T<T>& m) const
+{
+	AABBT<T> out = *this;
+
+	math3d::detail::aabbTransformScalar(&out.min.x, &min.x, &m.matrix[0][0], 0, 1);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> AABBT<T>::transform(const Affine3x4T<T>& m) const
+{
+	AABBT<T> out = *this;
+
+	math3d::detail::aabbTransformScalar(&out.min.x, &min.x, &m.matrix[0][0], 0, 1);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE void AABBT<T>::transformBatch(const AABBT<T>* in, const Affine3x4T<T>* matrices, AABBT<T>* out, size_t count)
+{
+	math3d::detail::aabbTransform(&out->min.x, &in->min.x, &matrices->matrix[0][0], 12, count);
+}
+
+template <typename T>
+MATH3D_INLINE void AABBT<T>::transformBatch(const AABBT<T>* in, const Matrix4x4T<T>* matrices, AABBT<T>* out, size_t count)
+{
+	math3d::detail::aabbTransform(&out->min.x, &in->min.x, &matrices->matrix[0][0], 16, count);
+}
+
+template <typename T>
+MATH3D_INLINE void AABBT<T>::transformBatch(const AABBT<T>* in, const Affine3x4T<T>& m, AABBT<T>* out, size_t count)
+{
+	math3d::detail::aabbTransform(&out->min.x, &in->min.x, &m.matrix[0][0], 0, count);
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::operator==(const AABBT<T>& box) const
+{
+	return min == box.min && max == box.max;
+}
+
+template <typename T>
+MATH3D_INLINE bool AABBT<T>::operator!=(const AABBT<T>& box) const
+{
+	return min != box.min || max != box.max;
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef AFFINE3X4_HPP
+#define AFFINE3X4_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include <cstddef>
+
+class ConstVector3View;
+class Vector3View;
+class ThreadPool;
+
+/**
+ * An affine transformation matrix, stored as the top 3 rows of a
+ * Matrix4x4 whose bottom row is always (0, 0, 0, 1)
+ *
+ * Position, rotation, and scale matrices (and any product of them)
+ * are affine, so they can be stored in 48 bytes instead of 64 and
+ * multiplied with 36 multiplies instead of 64.
+ */
+template <typename T>
+class Affine3x4T
+{
+	public:
+		/**
+		 * Creates a new Affine3x4 object and initializes it so that it
+		 * contains the identity matrix
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T identity();
+
+		/**
+		 * Creates a new Affine3x4 object and initializes it with
+		 * an (x, y, z) position
+		 *
+		 * @param x the x component of the position
+		 * @param y the y component of the position
+		 * @param z the z component of the position
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T position(T x, T y, T z);
+		/**
+		 * Creates a new Affine3x4 object and initializes it with
+		 * an (x, y, z) position
+		 *
+		 * @param pos the vector containing the position
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T position(const Vector3T<T>& pos);
+
+		/**
+		 * Creates a new Affine3x4 object and initializes it with
+		 * an (x, y, z) scale
+		 *
+		 * @param x the x component of the scale
+		 * @param y the y component of the scale
+		 * @param z the z component of the scale
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T scale(T x, T y, T z);
+		/**
+		 * Creates a new Affine3x4 object and initializes it with
+		 * an (x, y, z) scale
+		 *
+		 * @param scale the vector containing the scale
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T scale(const Vector3T<T>& scale);
+
+		/**
+		 * Creates a new Affine3x4 object and initializes it with
+		 * a quaternion (x, y, z, w) rotation
+		 *
+		 * @param rot the rotation quaternion
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T rotation(const QuaternionT<T>& rot);
+
+		/**
+		 * Creates a new Affine3x4 object and initializes it with a
+		 * position, rotation, and scale, equivalent to
+		 * position(pos) * rotation(rot) * scale(scl)
+		 *
+		 * @param pos the position
+		 * @param rot the rotation quaternion
+		 * @param scl the scale
+		 */
+		static MATH3D_CONSTEXPR Affine3x4T fromPositionRotationScale(const Vector3T<T>& pos, const QuaternionT<T>& rot, const Vector3T<T>& scl);
+
+		/**
+		 * Creates a new Affine3x4 and initializes all of its
+		 * components to 0
+		 */
+		MATH3D_CONSTEXPR Affine3x4T();
+		/**
+		 * Creates a new Affine3x4 from the top 3 rows of a Matrix4x4,
+		 * dropping its bottom row
+		 */
+		MATH3D_CONSTEXPR explicit Affine3x4T(const Matrix4x4T<T>&);
+		/**
+		 * Creates a new Affine3x4 by converting the components of a
+		 * matrix with another scalar type, e.g. a Affine3x4d
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit Affine3x4T(const Affine3x4T<U>& a);
+
+		/** @brief creates a Matrix4x4 with a bottom row of (0, 0, 0, 1) */
+		MATH3D_CONSTEXPR Matrix4x4T<T> toMatrix4x4() const;
+
+		/** @brief calculates the determinant of the matrix */
+		T determinant() const;
+		/** @brief calculates the inverse of the matrix */
+		Affine3x4T inverse() const;
+		/**
+		 * Calculates the inverse of the matrix by transposing its
+		 * rotation, which is cheaper than inverse()
+		 *
+		 * Note: the matrix must only contain a rotation and a
+		 * position (no scale)
+		 */
+		Affine3x4T inverseRigid() const;
+
+		/** @brief combines two transformations using matrix multiplication */
+		Affine3x4T operator*(const Affine3x4T&) const;
+
+		/** @brief transforms a point by the matrix */
+		Vector3T<T> operator*(const Vector3T<T>&) const;
+		/** @brief transforms a point (x, y, z, 1) by the matrix */
+		Vector3T<T> transformPoint(const Vector3T<T>&) const;
+		/** @brief transforms a direction (x, y, z, 0) by the matrix, ignoring its position */
+		Vector3T<T> transformDirection(const Vector3T<T>&) const;
+
+		/**
+		 * Transforms a batch of points like Matrix4x4::transformPoints
+		 *
+		 * @param in the points, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param out receives the transformed points; may be the same as in
+		 */
+		void transformPoints(ConstVector3View in, Vector3View out) const;
+		/** @brief transforms count points of an array of Vector3 objects, which may be the same array */
+		void transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const;
+		/** @brief transforms a batch of points on the threads of a pool, like Matrix4x4::transformPoints */
+		void transformPoints(ConstVector3View in, Vector3View out, ThreadPool& pool) const;
+		/** @brief transforms count points of an array of Vector3 objects on the threads of a pool */
+		void transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count, ThreadPool& pool) const;
+
+		/**
+		 * Transforms a batch of directions like Matrix4x4::transformDirections
+		 *
+		 * @param in the directions, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param out receives the transformed directions; may be the same as in
+		 */
+		void transformDirections(ConstVector3View in, Vector3View out) const;
+		/** @brief transforms count directions of an array of Vector3 objects, which may be the same array */
+		void transformDirections(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const;
+
+		/** @brief indexes the components of the matrix in [y][x] format */
+		MATH3D_CONSTEXPR T* operator[](int);
+		MATH3D_CONSTEXPR const T* operator[](int) const;
+
+		/** @brief the top 3 rows of the matrix, aligned for SIMD loads */
+		alignas(16) T matrix[3][4];
+	private:
+};
+
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "matrix4x4.hpp"
+#include "vector3array.hpp"
+
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in affine3x4.inl
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T>::Affine3x4T()
+: matrix()
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T>::Affine3x4T(const Matrix4x4T<T>& m4)
+: matrix()
+{
+	for (int y = 0; y < 3; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			matrix[y][x] = m4.matrix[y][x];
+		}
+	}
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR Affine3x4T<T>::Affine3x4T(const Affine3x4T<U>& a)
+: matrix()
+{
+	for (int y = 0; y < 3; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			matrix[y][x] = (T)a.matrix[y][x];
+		}
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Affine3x4T<T>::toMatrix4x4() const
+{
+	Matrix4x4T<T> out;
+
+	for (int y = 0; y < 3; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			out.matrix[y][x] = matrix[y][x];
+		}
+	}
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::identity()
+{
+	Affine3x4T<T> out;
+
+	out[0][0] = 1;
+	out[1][1] = 1;
+	out[2][2] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::position(T x, T y, T z)
+{
+	Affine3x4T<T> out = identity();
+
+	out[0][3] = x;
+	out[1][3] = y;
+	out[2][3] = z;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::position(const Vector3T<T>& pos)
+{
+	return position(pos.x, pos.y, pos.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::scale(T x, T y, T z)
+{
+	Affine3x4T<T> out;
+
+	out[0][0] = x;
+	out[1][1] = y;
+	out[2][2] = z;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::scale(const Vector3T<T>& scale)
+{
+	return Affine3x4T<T>::scale(scale.x, scale.y, scale.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::rotation(const QuaternionT<T>& rot)
+{
+	Affine3x4T<T> out;
+
+	out[0][0] = 1.0f - 2.0f * (rot.y * rot.y + rot.z * rot.z);
+	out[0][1] = 2.0f * (rot.x * rot.y - rot.w * rot.z);
+	out[0][2] = 2.0f * (rot.x * rot.z + rot.w * rot.y);
+
+	out[1][0] = 2.0f * (rot.x * rot.y + rot.w * rot.z);
+	out[1][1] = 1.0f - 2.0f * (rot.x * rot.x + rot.z * rot.z);
+	out[1][2] = 2.0f * (rot.y * rot.z - rot.w * rot.x);
+
+	out[2][0] = 2.0f * (rot.x * rot.z - rot.w * rot.y);
+	out[2][1] = 2.0f * (rot.y * rot.z + rot.w * rot.x);
+	out[2][2] = 1.0f - 2.0f * (rot.x * rot.x + rot.y * rot.y);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Affine3x4T<T> Affine3x4T<T>::fromPositionRotationScale(const Vector3T<T>& pos, const QuaternionT<T>& rot,
+	const Vector3T<T>& scl)
+{
+	Affine3x4T<T> out = rotation(rot);
+
+	for (int y = 0; y < 3; y++)
+	{
+		out[y][0] *= scl.x;
+		out[y][1] *= scl.y;
+		out[y][2] *= scl.z;
+	}
+
+	out[0][3] = pos.x;
+	out[1][3] = pos.y;
+	out[2][3] = pos.z;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T* Affine3x4T<T>::operator[](int y)
+{
+	return matrix[y];
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T* Affine3x4T<T>::operator[](int y) const
+{
+	return matrix[y];
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "affine3x4.inl"
+#else
+extern template class Affine3x4T<float>;
+extern template class Affine3x4T<double>;
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef AFFINE3X4_INL
+#define AFFINE3X4_INL
+
+#include "config.hpp"
+#include "affine3x4.hpp"
+#include "kernels/table.hpp"
+#include "streams.hpp"
+#include "threadpool.hpp"
+
+static_assert(sizeof(Affine3x4) == 12 * sizeof(float), "Affine3x4 must be exactly 3 rows of 4 floats");
+
+template <typename T>
+MATH3D_INLINE T Affine3x4T<T>::determinant() const
+{
+	return math3d::detail::mat4DeterminantScalar(&matrix[0][0]);
+}
+
+template <typename T>
+MATH3D_INLINE Affine3x4T<T> Affine3x4T<T>::inverse() const
+{
+	Affine3x4T<T> out;
+
+	math3d::detail::affineInverse(&out.matrix[0][0], &matrix[0][0]);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Affine3x4T<T> Affine3x4T<T>::inverseRigid() const
+{
+	Affine3x4T<T> out;
+
+	math3d::detail::affineInverseRigidScalar(&out.matrix[0][0], &matrix[0][0]);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Affine3x4T<T> Affine3x4T<T>::operator*(const Affine3x4T<T>& a) const
+{
+	Affine3x4T<T> out;
+
+	math3d::detail::affineMul(&out.matrix[0][0], &matrix[0][0], &a.matrix[0][0]);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> Affine3x4T<T>::operator*(const Vector3T<T>& v3) const
+{
+	return transformPoint(v3);
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> Affine3x4T<T>::transformPoint(const Vector3T<T>& v3) const
+{
+	Vector3T<T> out;
+
+	math3d::detail::mat4TransformPointsScalar(&out.x, &out.y, &out.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> Affine3x4T<T>::transformDirection(const Vector3T<T>& v3) const
+{
+	Vector3T<T> out;
+
+	math3d::detail::mat4TransformDirectionsScalar(&out.x, &out.y, &out.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+
+	return out;
+}
+
+// the point and direction kernels only read the top 3 rows of the matrix
+
+template <typename T>
+MATH3D_INLINE void Affine3x4T<T>::transformPoints(ConstVector3View in, Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	float storage[12];
+	const float* m = math3d::detail::floatMatrix(&matrix[0][0], storage, 12);
+
+	math3d::detail::forEachBlock(in, out, [&k, m](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.mat4TransformPoints(so.x, so.y, so.z, m, sa.x, sa.y, sa.z, n);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Affine3x4T<T>::transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const
+{
+	math3d::detail::forEachVector(in, out, count, [this](ConstVector3View a, Vector3View o)
+	{
+		transformPoints(a, o);
+	}, [this](const Vector3T<T>& v3, Vector3T<T>& o)
+	{
+		math3d::detail::mat4TransformPointsScalar(&o.x, &o.y, &o.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Affine3x4T<T>::transformPoints(ConstVector3View in, Vector3View out, ThreadPool& pool) const
+{
+	pool.parallelFor(in.count, ThreadPool::chunkSize(6 * sizeof(float)), [this, &in, &out](size_t begin, size_t end)
+	{
+		transformPoints(in.subview(begin, end - begin), out.subview(begin, end - begin));
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Affine3x4T<T>::transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count,
+	ThreadPool& pool) const
+{
+	pool.parallelFor(count, ThreadPool::chunkSize(2 * sizeof(Vector3T<T>)), [this, in, out](size_t begin, size_t end)
+	{
+		transformPoints(in + begin, out + begin, end - begin);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Affine3x4T<T>::transformDirections(ConstVector3View in, Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	float storage[12];
+	const float* m = math3d::detail::floatMatrix(&matrix[0][0], storage, 12);
+
+	math3d::detail::forEachBlock(in, out, [&k, m](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.mat4TransformDirections(so.x, so.y, so.z, m, sa.x, sa.y, sa.z, n);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Affine3x4T<T>::transformDirections(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const
+{
+	math3d::detail::forEachVector(in, out, count, [this](ConstVector3View a, Vector3View o)
+	{
+		transformDirections(a, o);
+	}, [this](const Vector3T<T>& v3, Vector3T<T>& o)
+	{
+		math3d::detail::mat4TransformDirectionsScalar(&o.x, &o.y, &o.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+	});
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef ALIGNED_HPP
+#define ALIGNED_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace math3d
+{
+	namespace detail
+	{
+		/** @brief the alignment of batch data, wide enough for a full AVX-512 register or cache line */
+		static const size_t BATCH_ALIGNMENT = 64;
+
+		/**
+		 * Allocates a block of memory aligned to the given power of two,
+		 * throwing std::bad_alloc on failure
+		 */
+		static inline void* alignedAlloc(size_t size, size_t alignment = BATCH_ALIGNMENT)
+		{
+			void* ptr = nullptr;
+
+			if (size == 0)
+			{
+				size = alignment;
+			}
+
+#ifdef _WIN32
+			ptr = _aligned_malloc(size, alignment);
+#else
+			if (posix_memalign(&ptr, alignment, size) != 0)
+			{
+				ptr = nullptr;
+			}
+#endif
+
+			if (ptr == nullptr)
+			{
+				throw std::bad_alloc();
+			}
+
+			return ptr;
+		}
+
+		/** @brief frees memory returned by alignedAlloc */
+		static inline void alignedFree(void* ptr)
+		{
+#ifdef _WIN32
+			_aligned_free(ptr);
+#else
+			free(ptr);
+#endif
+		}
+
+		/** @brief rounds count up to a whole number of aligned blocks of T */
+		template <typename T>
+		static inline size_t alignedCount(size_t count, size_t alignment = BATCH_ALIGNMENT)
+		{
+			size_t perBlock = alignment / sizeof(T);
+
+			return (count + perBlock - 1) / perBlock * perBlock;
+		}
+	}
+}
+
+#endif
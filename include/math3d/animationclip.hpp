@@ -0,0 +1,148 @@
+#ifndef ANIMATIONCLIP_HPP
+#define ANIMATIONCLIP_HPP
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Keyframes of a Vector3 value over time, such as the translation or the
+ * scale of a bone, stored as separate streams of times and x, y, and z
+ * components
+ */
+class Vector3Track
+{
+	public:
+		/** @brief creates a track with no keyframes */
+		Vector3Track();
+
+		/**
+		 * Adds a keyframe to the end of the track
+		 *
+		 * Note: keyframes must be added in order of increasing time
+		 *
+		 * @param time the time of the keyframe
+		 * @param value the value at that time
+		 */
+		void add(float time, const Vector3& value);
+		/** @brief removes all of the keyframes */
+		void clear();
+		/** @brief reserves space for the given number of keyframes */
+		void reserve(size_t count);
+
+		/** @brief gets the number of keyframes */
+		size_t size() const;
+		/** @brief gets the time of the last keyframe, or 0 if there are none */
+		float getDuration() const;
+		/** @brief gets the value of a keyframe */
+		Vector3 getValue(size_t key) const;
+
+		/** @brief gets the stream of keyframe times, in increasing order */
+		const float* times() const;
+		/** @brief gets the streams of the components of the keyframe values */
+		const float* x() const;
+		const float* y() const;
+		const float* z() const;
+	private:
+		std::vector<float> keyTimes;
+		std::vector<float> keyX, keyY, keyZ;
+};
+
+/**
+ * Keyframes of a rotation over time, stored as separate streams of times
+ * and x, y, z, and w components
+ */
+class QuaternionTrack
+{
+	public:
+		/** @brief creates a track with no keyframes */
+		QuaternionTrack();
+
+		/**
+		 * Adds a keyframe to the end of the track
+		 *
+		 * Note: keyframes must be added in order of increasing time, and
+		 * the rotations must be unit quaternions
+		 *
+		 * @param time the time of the keyframe
+		 * @param value the rotation at that time
+		 */
+		void add(float time, const Quaternion& value);
+		/** @brief removes all of the keyframes */
+		void clear();
+		/** @brief reserves space for the given number of keyframes */
+		void reserve(size_t count);
+
+		/** @brief gets the number of keyframes */
+		size_t size() const;
+		/** @brief gets the time of the last keyframe, or 0 if there are none */
+		float getDuration() const;
+		/** @brief gets the value of a keyframe */
+		Quaternion getValue(size_t key) const;
+
+		/** @brief gets the stream of keyframe times, in increasing order */
+		const float* times() const;
+		/** @brief gets the streams of the components of the keyframe values */
+		const float* x() const;
+		const float* y() const;
+		const float* z() const;
+		const float* w() const;
+	private:
+		std::vector<float> keyTimes;
+		std::vector<float> keyX, keyY, keyZ, keyW;
+};
+
+/**
+ * The translation, rotation, and scale keyframes of one bone. Each channel
+ * has its own keyframe times, and a channel without keyframes samples as
+ * the matching component of a default Transform.
+ */
+class TransformTrack
+{
+	public:
+		/** @brief gets the time of the last keyframe of any channel */
+		float getDuration() const;
+
+		Vector3Track translation;
+		QuaternionTrack rotation;
+		Vector3Track scale;
+	private:
+};
+
+/**
+ * An animation of a whole skeleton, with one TransformTrack per bone,
+ * which AnimationSampler samples all at once
+ */
+class AnimationClip
+{
+	public:
+		/** @brief creates a clip with no tracks */
+		AnimationClip();
+		/** @brief creates a clip with the given number of empty tracks */
+		explicit AnimationClip(size_t trackCount);
+
+		/**
+		 * Adds an empty track to the clip
+		 *
+		 * @return the index of the new track
+		 */
+		size_t addTrack();
+		/** @brief gets the number of tracks */
+		size_t size() const;
+		/** @brief gets the time of the last keyframe of any track */
+		float getDuration() const;
+
+		/** @brief gets the track of a bone */
+		TransformTrack& operator[](size_t track);
+		const TransformTrack& operator[](size_t track) const;
+	private:
+		std::vector<TransformTrack> tracks;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "animationclip.inl"
+#endif
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef ANIMATIONCLIP_INL
+#define ANIMATIONCLIP_INL
+
+#include "config.hpp"
+#include "animationclip.hpp"
+
+MATH3D_INLINE Vector3Track::Vector3Track()
+{
+}
+
+MATH3D_INLINE void Vector3Track::add(float time, const Vector3& value)
+{
+	keyTimes.push_back(time);
+	keyX.push_back(value.x);
+	keyY.push_back(value.y);
+	keyZ.push_back(value.z);
+}
+
+MATH3D_INLINE void Vector3Track::clear()
+{
+	keyTimes.clear();
+	keyX.clear();
+	keyY.clear();
+	keyZ.clear();
+}
+
+MATH3D_INLINE void Vector3Track::reserve(size_t count)
+{
+	keyTimes.reserve(count);
+	keyX.reserve(count);
+	keyY.reserve(count);
+	keyZ.reserve(count);
+}
+
+MATH3D_INLINE size_t Vector3Track::size() const
+{
+	return keyTimes.size();
+}
+
+MATH3D_INLINE float Vector3Track::getDuration() const
+{
+	return keyTimes.empty() ? 0 : keyTimes.back();
+}
+
+MATH3D_INLINE Vector3 Vector3Track::getValue(size_t key) const
+{
+	return Vector3(keyX[key], keyY[key], keyZ[key]);
+}
+
+MATH3D_INLINE const float* Vector3Track::times() const
+{
+	return keyTimes.data();
+}
+
+MATH3D_INLINE const float* Vector3Track::x() const
+{
+	return keyX.data();
+}
+
+MATH3D_INLINE const float* Vector3Track::y() const
+{
+	return keyY.data();
+}
+
+MATH3D_INLINE const float* Vector3Track::z() const
+{
+	return keyZ.data();
+}
+
+MATH3D_INLINE QuaternionTrack::QuaternionTrack()
+{
+}
+
+MATH3D_INLINE void QuaternionTrack::add(float time, const Quaternion& value)
+{
+	keyTimes.push_back(time);
+	keyX.push_back(value.x);
+	keyY.push_back(value.y);
+	keyZ.push_back(value.z);
+	keyW.push_back(value.w);
+}
+
+MATH3D_INLINE void QuaternionTrack::clear()
+{
+	keyTimes.clear();
+	keyX.clear();
+	keyY.clear();
+	keyZ.clear();
+	keyW.clear();
+}
+
+MATH3D_INLINE void QuaternionTrack::reserve(size_t count)
+{
+	keyTimes.reserve(count);
+	keyX.reserve(count);
+	keyY.reserve(count);
+	keyZ.reserve(count);
+	keyW.reserve(count);
+}
+
+MATH3D_INLINE size_t QuaternionTrack::size() const
+{
+	return keyTimes.size();
+}
+
+MATH3D_INLINE float QuaternionTrack::getDuration() const
+{
+	return keyTimes.empty() ? 0 : keyTimes.back();
+}
+
+MATH3D_INLINE Quaternion QuaternionTrack::getValue(size_t key) const
+{
+	return Quaternion(keyX[key], keyY[key], keyZ[key], keyW[key]);
+}
+
+MATH3D_INLINE const float* QuaternionTrack::times() const
+{
+	return keyTimes.data();
+}
+
+MATH3D_INLINE const float* QuaternionTrack::x() const
+{
+	return keyX.data();
+}
+
+MATH3D_INLINE const float* QuaternionTrack::y() const
+{
+	return keyY.data();
+}
+
+MATH3D_INLINE const float* QuaternionTrack::z() const
+{
+	return keyZ.data();
+}
+
+MATH3D_INLINE const float* QuaternionTrack::w() const
+{
+	return keyW.data();
+}
+
+MATH3D_INLINE float TransformTrack::getDuration() const
+{
+	float duration = translation.getDuration();
+
+	if (rotation.getDuration() > duration)
+	{
+		duration = rotation.getDuration();
+	}
+
+	if (scale.getDuration() > duration)
+	{
+		duration = scale.getDuration();
+	}
+
+	return duration;
+}
+
+MATH3D_INLINE AnimationClip::AnimationClip()
+{
+}
+
+MATH3D_INLINE AnimationClip::AnimationClip(size_t trackCount)
+: tracks(trackCount)
+{
+}
+
+MATH3D_INLINE size_t AnimationClip::addTrack()
+{
+	tracks.push_back(TransformTrack());
+
+	return tracks.size() - 1;
+}
+
+MATH3D_INLINE size_t AnimationClip::size() const
+{
+	return tracks.size();
+}
+
+MATH3D_INLINE float AnimationClip::getDuration() const
+{
+	float duration = 0;
+
+	for (size_t i = 0; i < tracks.size(); i++)
+	{
+		if (tracks[i].getDuration() > duration)
+		{
+			duration = tracks[i].getDuration();
+		}
+	}
+
+	return duration;
+}
+
+MATH3D_INLINE TransformTrack& AnimationClip::operator[](size_t track)
+{
+	return tracks[track];
+}
+
+MATH3D_INLINE const TransformTrack& AnimationClip::operator[](size_t track) const
+{
+	return tracks[track];
+}
+
+#endif
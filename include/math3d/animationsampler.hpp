@@ -0,0 +1,83 @@
+#ifndef ANIMATIONSAMPLER_HPP
+#define ANIMATIONSAMPLER_HPP
+
+#include "config.hpp"
+#include "animationclip.hpp"
+#include "transform.hpp"
+#include <cstddef>
+#include <vector>
+
+/** @brief how AnimationSampler interpolates between rotation keyframes */
+enum class RotationInterpolation
+{
+	Nlerp,
+	Slerp
+};
+
+/**
+ * Samples every track of an AnimationClip at once, producing the local
+ * Transform of each bone of a skeleton
+ *
+ * Each channel of each track keeps a cursor at the keyframe it last
+ * sampled. During playback time only moves forward, so finding the
+ * keyframes around the new time is a short forward scan from the cursor
+ * rather than a binary search. Sampling an earlier time than the previous
+ * call rewinds the cursors to the first keyframe.
+ *
+ * The keyframes of all of the bones are gathered into streams so that the
+ * translations and scales are interpolated with batch lerps, and the
+ * rotations with a batch nlerp or slerp, instead of one bone at a time.
+ */
+class AnimationSampler
+{
+	public:
+		/**
+		 * Creates a sampler for a clip
+		 *
+		 * Note: the clip must outlive the sampler
+		 *
+		 * @param clip the clip to sample
+		 * @param interpolation how to interpolate between rotations
+		 */
+		explicit AnimationSampler(const AnimationClip& clip,
+			RotationInterpolation interpolation = RotationInterpolation::Slerp);
+
+		/** @brief gets how rotations are interpolated */
+		RotationInterpolation getInterpolation() const;
+		/** @brief sets how rotations are interpolated */
+		void setInterpolation(RotationInterpolation interpolation);
+
+		/** @brief rewinds the cursors to the first keyframe of every channel */
+		void reset();
+
+		/**
+		 * Samples every track of the clip
+		 *
+		 * Note: out must have room for one Transform per track of the clip
+		 *
+		 * @param time the time to sample at; times outside of a channel's
+		 * keyframes clamp to its first or last keyframe
+		 * @param out receives the transform of track i at out[i]
+		 */
+		void sample(float time, Transform* out);
+	private:
+		void sampleVector3s(Vector3Track TransformTrack::* channel, size_t channelIndex,
+			Vector3 Transform::* field, const Vector3& defaultValue, float time, Transform* out);
+		void sampleRotations(float time, Transform* out);
+
+		const AnimationClip* clip;
+		RotationInterpolation interpolation;
+
+		// the translation, rotation, and scale cursors of each track
+		std::vector<size_t> cursors;
+		// the keyframe streams gathered for the batch kernels
+		std::vector<float> scratch;
+
+		float lastTime;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "animationsampler.inl"
+#endif
+
+#endif
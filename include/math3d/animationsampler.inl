@@ -0,0 +1,198 @@
+#ifndef ANIMATIONSAMPLER_INL
+#define ANIMATIONSAMPLER_INL
+
+#include "config.hpp"
+#include "animationsampler.hpp"
+#include "kernels/table.hpp"
+#include <algorithm>
+
+/**
+ * Moves cursor forward to the last keyframe at or before time, and gets
+ * the keyframe after it and the interpolation factor between the two.
+ * Times outside of the keyframes clamp to the first or last one. A cursor
+ * past the last keyframe, left by a track that was cleared and refilled
+ * with fewer, searches again from the first one.
+ */
+MATH3D_INLINE static float seekKeyframe(const float* times, size_t count, float time, size_t& cursor, size_t& next)
+{
+	if (cursor >= count)
+	{
+		cursor = 0;
+	}
+
+	while (cursor + 1 < count && times[cursor + 1] <= time)
+	{
+		cursor++;
+	}
+
+	if (cursor + 1 >= count || time <= times[cursor])
+	{
+		next = cursor;
+		return 0;
+	}
+
+	next = cursor + 1;
+
+	return (time - times[cursor]) / (times[next] - times[cursor]);
+}
+
+MATH3D_INLINE AnimationSampler::AnimationSampler(const AnimationClip& clip, RotationInterpolation interpolation)
+: clip(&clip), interpolation(interpolation), lastTime(0)
+{
+}
+
+MATH3D_INLINE RotationInterpolation AnimationSampler::getInterpolation() const
+{
+	return interpolation;
+}
+
+MATH3D_INLINE void AnimationSampler::setInterpolation(RotationInterpolation interpolation)
+{
+	this->interpolation = interpolation;
+}
+
+MATH3D_INLINE void AnimationSampler::reset()
+{
+	std::fill(cursors.begin(), cursors.end(), 0);
+	lastTime = 0;
+}
+
+MATH3D_INLINE void AnimationSampler::sample(float time, Transform* out)
+{
+	size_t count = clip->size();
+
+	if (cursors.size() != 3 * count)
+	{
+		cursors.assign(3 * count, 0);
+		scratch.resize(9 * count);
+	}
+	else if (time < lastTime)
+	{
+		reset();
+	}
+
+	lastTime = time;
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	sampleVector3s(&TransformTrack::translation, 0, &Transform::position, Vector3(0, 0, 0), time, out);
+	sampleRotations(time, out);
+	sampleVector3s(&TransformTrack::scale, 2, &Transform::scale, Vector3(1, 1, 1), time, out);
+}
+
+MATH3D_INLINE void AnimationSampler::sampleVector3s(Vector3Track TransformTrack::* channel, size_t channelIndex,
+	Vector3 Transform::* field, const Vector3& defaultValue, float time, Transform* out)
+{
+	size_t count = clip->size();
+
+	float* ax = scratch.data();
+	float* ay = ax + count;
+	float* az = ay + count;
+	float* bx = az + count;
+	float* by = bx + count;
+	float* bz = by + count;
+	float* t = bz + count;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const Vector3Track& track = (*clip)[i].*channel;
+
+		if (track.size() == 0)
+		{
+			ax[i] = bx[i] = defaultValue.x;
+			ay[i] = by[i] = defaultValue.y;
+			az[i] = bz[i] = defaultValue.z;
+			t[i] = 0;
+			continue;
+		}
+
+		size_t& cursor = cursors[3 * i + channelIndex];
+		size_t next;
+
+		t[i] = seekKeyframe(track.times(), track.size(), time, cursor, next);
+
+		ax[i] = track.x()[cursor];
+		ay[i] = track.y()[cursor];
+		az[i] = track.z()[cursor];
+		bx[i] = track.x()[next];
+		by[i] = track.y()[next];
+		bz[i] = track.z()[next];
+	}
+
+	const Kernels& k = math3d::detail::kernels();
+
+	// the results overwrite the first keyframe of each pair
+	k.streamLerp(ax, ax, bx, t, count);
+	k.streamLerp(ay, ay, by, t, count);
+	k.streamLerp(az, az, bz, t, count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i].*field = Vector3(ax[i], ay[i], az[i]);
+	}
+}
+
+MATH3D_INLINE void AnimationSampler::sampleRotations(float time, Transform* out)
+{
+	size_t count = clip->size();
+
+	float* ax = scratch.data();
+	float* ay = ax + count;
+	float* az = ay + count;
+	float* aw = az + count;
+	float* bx = aw + count;
+	float* by = bx + count;
+	float* bz = by + count;
+	float* bw = bz + count;
+	float* t = bw + count;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const QuaternionTrack& track = (*clip)[i].rotation;
+
+		if (track.size() == 0)
+		{
+			ax[i] = bx[i] = 0;
+			ay[i] = by[i] = 0;
+			az[i] = bz[i] = 0;
+			aw[i] = bw[i] = 1;
+			t[i] = 0;
+			continue;
+		}
+
+		size_t& cursor = cursors[3 * i + 1];
+		size_t next;
+
+		t[i] = seekKeyframe(track.times(), track.size(), time, cursor, next);
+
+		ax[i] = track.x()[cursor];
+		ay[i] = track.y()[cursor];
+		az[i] = track.z()[cursor];
+		aw[i] = track.w()[cursor];
+		bx[i] = track.x()[next];
+		by[i] = track.y()[next];
+		bz[i] = track.z()[next];
+		bw[i] = track.w()[next];
+	}
+
+	const Kernels& k = math3d::detail::kernels();
+
+	if (interpolation == RotationInterpolation::Slerp)
+	{
+		k.quatSlerp(ax, ay, az, aw, ax, ay, az, aw, bx, by, bz, bw, t, count);
+	}
+	else
+	{
+		k.quatNlerp(ax, ay, az, aw, ax, ay, az, aw, bx, by, bz, bw, t, count);
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i].rotation = Quaternion(ax[i], ay[i], az[i], aw[i]);
+	}
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include "aabb.hpp"
+#include "ray.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A bounding volume hierarchy over a triangle soup, such as the static
+ * geometry of a level, for finding the triangles hit by a ray or
+ * overlapped by a box without testing all of them
+ *
+ * The tree is built top-down with a binned surface area heuristic, and
+ * large subtrees are built on separate threads. Its nodes are stored in
+ * a flat array of 32 bytes each, with the two children of a node next to
+ * each other, so that a traversal step loads both of them together. The
+ * triangles are copied into the order of the leaves as streams of their
+ * first vertex and two edges, which is what the ray intersection test
+ * reads, so the original vertices are no longer needed after the build.
+ */
+class BVH
+{
+	public:
+		/** @brief the largest number of triangles in a leaf */
+		static const size_t MAX_LEAF_SIZE = 8;
+		/** @brief the number of bins along each axis in which split positions are evaluated */
+		static const int BIN_COUNT = 16;
+
+		/** @brief creates an empty hierarchy */
+		BVH();
+
+		/**
+		 * Builds the hierarchy, replacing any previous one
+		 *
+		 * Note: triangles with a vertex that is not finite must not be
+		 * given
+		 *
+		 * @param vertices 3 vertices for each triangle
+		 * @param triangleCount the number of triangles
+		 * @param threads the largest number of threads building the tree
+		 * at once, or 0 for the number of hardware threads; the tree is
+		 * the same for any number of threads
+		 */
+		void build(const Vector3* vertices, size_t triangleCount, unsigned threads = 0);
+		/** @brief removes all of the triangles */
+		void clear();
+
+		/** @brief gets the number of triangles */
+		size_t getTriangleCount() const;
+		/** @brief gets the number of nodes, including the leaves */
+		size_t getNodeCount() const;
+		/** @brief gets the box around all of the triangles, which is empty if there are none */
+		AABB getBounds() const;
+
+		/**
+		 * Finds the closest triangle hit by a ray
+		 *
+		 * @param ray the ray
+		 * @param maxDistance hits at a t of maxDistance or more are ignored
+		 * @param hit receives the closest hit, if there is one
+		 * @return whether a triangle is hit at a t greater than 0 and less
+		 * than maxDistance
+		 */
+		bool intersect(const Ray& ray, float maxDistance, RayHit& hit) const;
+		/**
+		 * Tests whether a ray hits any triangle, stopping at the first one
+		 * found, e.g. for line of sight tests
+		 *
+		 * @return whether a triangle is hit at a t greater than 0 and less
+		 * than maxDistance
+		 */
+		bool intersectsAny(const Ray& ray, float maxDistance) const;
+		/**
+		 * Finds the triangles that overlap or touch a box
+		 *
+		 * @param box the box
+		 * @param triangles receives the indices of the triangles, which
+		 * are appended in no particular order
+		 * @return the number of indices appended to triangles
+		 */
+		size_t overlap(const AABB& box, std::vector<uint32_t>& triangles) const;
+	private:
+		/**
+		 * A node, which is a leaf of count triangles starting at first if
+		 * count is not 0, or has two children at first and first + 1
+		 */
+		struct Node
+		{
+			float min[3];
+			uint32_t first;
+			float max[3];
+			uint32_t count;
+		};
+
+		struct Builder;
+
+		/** @brief gets the v0, edge1, and edge2 of a triangle, in leaf order */
+		void getTriangle(size_t index, Vector3& v0, Vector3& edge1, Vector3& edge2) const;
+
+		std::vector<Node> nodes;
+
+		// TRIANGLE_STREAMS streams of stride floats each, in leaf order,
+		// and the original index of each triangle
+		std::vector<float> triangles;
+		std::vector<uint32_t> indices;
+		size_t stride;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "bvh.inl"
+#endif
+
+#endif
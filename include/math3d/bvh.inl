@@ -0,0 +1,676 @@
+#ifndef BVH_INL
+#define BVH_INL
+
+#include "config.hpp"
+#include "bvh.hpp"
+#include "kernels/scalar.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 arrays must be tightly packed");
+
+/** @brief the cost of visiting a node relative to that of intersecting a triangle */
+static const float BVH_TRAVERSAL_COST = 1.0f;
+/** @brief the depth below which nodes are split at their median instead, which bounds the depth of the tree */
+static const int BVH_MAX_SAH_DEPTH = 64;
+/** @brief the most nodes that a traversal has to come back to, enough for the deepest tree of 2^32 triangles */
+static const int BVH_STACK_SIZE = BVH_MAX_SAH_DEPTH + 64;
+/** @brief the fewest triangles under a node for which its second child is built on another thread */
+static const uint32_t BVH_PARALLEL_THRESHOLD = 16384;
+
+/**
+ * Builds the nodes of a BVH over the bounds of its triangles, sorting
+ * order (the triangle indices) so that every node covers a contiguous
+ * range of it
+ */
+struct BVH::Builder
+{
+	/**
+	 * A box as plain arrays, which the loops over every triangle grow
+	 * inline, where AABB::merge would be a call in the library build
+	 */
+	struct Bounds
+	{
+		static Bounds empty()
+		{
+			float inf = std::numeric_limits<float>::infinity();
+			Bounds box = {{inf, inf, inf}, {-inf, -inf, -inf}};
+
+			return box;
+		}
+
+		void grow(const Bounds& box)
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				min[i] = std::min(min[i], box.min[i]);
+				max[i] = std::max(max[i], box.max[i]);
+			}
+		}
+
+		void grow(const float* point)
+		{
+			for (int i = 0; i < 3; i++)
+			{
+				min[i] = std::min(min[i], point[i]);
+				max[i] = std::max(max[i], point[i]);
+			}
+		}
+
+		/** @brief half of the surface area, which the SAH only compares; the box must not be empty */
+		float halfArea() const
+		{
+			float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+
+			return x * y + y * z + z * x;
+		}
+
+		float min[3];
+		float max[3];
+	};
+
+	/** @brief the triangles whose centroids fall into a bin */
+	struct Bin
+	{
+		Bin()
+		: bounds(Bounds::empty()), count(0)
+		{
+		}
+
+		Bounds bounds;
+		uint32_t count;
+	};
+
+	Builder(std::vector<Node>& nodes, const std::vector<Bounds>& bounds, const std::vector<float>& centroids,
+		std::vector<uint32_t>& order, unsigned threads)
+	: nodes(nodes), bounds(bounds), centroids(centroids), order(order), nodeCount(1), spareThreads((int)threads - 1)
+	{
+	}
+
+	/** @brief builds the subtree of a node whose bounds are already set, covering order[begin, end) */
+	void build(uint32_t node, uint32_t begin, uint32_t end, int depth)
+	{
+		uint32_t count = end - begin;
+		Bounds centroidBounds = Bounds::empty();
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			centroidBounds.grow(&centroids[3 * order[i]]);
+		}
+
+		Bin bins[3][BIN_COUNT];
+		float scales[3];
+		int axis = -1;
+		int split = 0;
+		float bestCost = 0;
+
+		if (count > 1 && depth < BVH_MAX_SAH_DEPTH)
+		{
+			findSplit(centroidBounds, begin, end, bins, scales, axis, split, bestCost);
+		}
+
+		// the SAH cost of a leaf is count, and that of a split is
+		// BVH_TRAVERSAL_COST + bestCost / area, compared multiplied by area
+		Bounds nodeBounds;
+
+		std::copy(nodes[node].min, nodes[node].min + 3, nodeBounds.min);
+		std::copy(nodes[node].max, nodes[node].max + 3, nodeBounds.max);
+
+		float area = nodeBounds.halfArea();
+
+		if (count <= MAX_LEAF_SIZE && (axis < 0 || count * area <= BVH_TRAVERSAL_COST * area + bestCost))
+		{
+			nodes[node].first = begin;
+			nodes[node].count = count;
+
+			return;
+		}
+
+		uint32_t children = nodeCount.fetch_add(2);
+		uint32_t middle;
+
+		if (axis >= 0)
+		{
+			middle = (uint32_t)(std::partition(order.begin() + begin, order.begin() + end,
+				[this, &centroidBounds, &scales, axis, split](uint32_t triangle)
+				{
+					return getBin(centroids[3 * triangle + axis], centroidBounds.min[axis], scales[axis]) < split;
+				}) - order.begin());
+
+			Bounds left = Bounds::empty();
+			Bounds right = Bounds::empty();
+
+			for (int b = 0; b < BIN_COUNT; b++)
+			{
+				(b < split ? left : right).grow(bins[axis][b].bounds);
+			}
+
+			setBounds(children, left);
+			setBounds(children + 1, right);
+		}
+		else
+		{
+			// the centroids are all in one place (or the tree is too deep),
+			// so any split is as good as another
+			middle = begin + count / 2;
+
+			setBounds(children, rangeBounds(begin, middle));
+			setBounds(children + 1, rangeBounds(middle, end));
+		}
+
+		nodes[node].first = children;
+		nodes[node].count = 0;
+
+		if (count >= BVH_PARALLEL_THRESHOLD && takeThread())
+		{
+			std::thread thread([this, children, middle, end, depth]()
+			{
+				build(children + 1, middle, end, depth + 1);
+			});
+
+			build(children, begin, middle, depth + 1);
+			thread.join();
+			spareThreads++;
+		}
+		else
+		{
+			build(children, begin, middle, depth + 1);
+			build(children + 1, middle, end, depth + 1);
+		}
+	}
+
+	static int getBin(float centroid, float min, float scale)
+	{
+		return std::min((int)((centroid - min) * scale), BIN_COUNT - 1);
+	}
+
+	/**
+	 * Bins the centroids along each axis and finds the split between two
+	 * bins with the lowest area * count summed over both sides, leaving
+	 * axis at -1 if the centroids cannot be split along any axis
+	 */
+	void findSplit(const Bounds& centroidBounds, uint32_t begin, uint32_t end, Bin (&bins)[3][BIN_COUNT],
+		float (&scales)[3], int& axis, int& split, float& bestCost) const
+	{
+		for (int a = 0; a < 3; a++)
+		{
+			float extent = centroidBounds.max[a] - centroidBounds.min[a];
+
+			scales[a] = extent > 0 ? BIN_COUNT / extent : 0;
+		}
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			uint32_t triangle = order[i];
+
+			for (int a = 0; a < 3; a++)
+			{
+				Bin& bin = bins[a][getBin(centroids[3 * triangle + a], centroidBounds.min[a], scales[a])];
+
+				bin.bounds.grow(bounds[triangle]);
+				bin.count++;
+			}
+		}
+
+		for (int a = 0; a < 3; a++)
+		{
+			// an axis along which every centroid is the same (or nearly, so
+			// that the scale overflows) has all of them in bin 0
+			if (!(scales[a] > 0) || !std::isfinite(scales[a]))
+			{
+				continue;
+			}
+
+			// the cost of the right side of each split, summed from the last bin
+			float rightCosts[BIN_COUNT];
+			Bounds right = Bounds::empty();
+			uint32_t rightCount = 0;
+
+			for (int b = BIN_COUNT - 1; b > 0; b--)
+			{
+				right.grow(bins[a][b].bounds);
+				rightCount += bins[a][b].count;
+				rightCosts[b] = rightCount > 0 ? right.halfArea() * rightCount : -1;
+			}
+
+			Bounds left = Bounds::empty();
+			uint32_t leftCount = 0;
+
+			for (int b = 1; b < BIN_COUNT; b++)
+			{
+				left.grow(bins[a][b - 1].bounds);
+				leftCount += bins[a][b - 1].count;
+
+				if (leftCount == 0 || rightCosts[b] < 0)
+				{
+					continue;
+				}
+
+				float cost = left.halfArea() * leftCount + rightCosts[b];
+
+				if (axis < 0 || cost < bestCost)
+				{
+					axis = a;
+					split = b;
+					bestCost = cost;
+				}
+			}
+		}
+	}
+
+	Bounds rangeBounds(uint32_t begin, uint32_t end) const
+	{
+		Bounds box = Bounds::empty();
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			box.grow(bounds[order[i]]);
+		}
+
+		return box;
+	}
+
+	void setBounds(uint32_t node, const Bounds& box)
+	{
+		std::copy(box.min, box.min + 3, nodes[node].min);
+		std::copy(box.max, box.max + 3, nodes[node].max);
+	}
+
+	/** @brief claims one of the spare threads, if there are any left */
+	bool takeThread()
+	{
+		int spare = spareThreads.load();
+
+		while (spare > 0)
+		{
+			if (spareThreads.compare_exchange_weak(spare, spare - 1))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	std::vector<Node>& nodes;
+	const std::vector<Bounds>& bounds;
+	const std::vector<float>& centroids;
+	std::vector<uint32_t>& order;
+
+	std::atomic<uint32_t> nodeCount;
+	std::atomic<int> spareThreads;
+};
+
+/**
+ * Intersects a ray with the box of a node by the slab method, with
+ * invDir the reciprocal of its direction, setting entry to the t at which
+ * the ray enters the box
+ */
+MATH3D_INLINE static bool intersectNodeBounds(const float* min, const float* max, const float* origin,
+	const float* invDir, float maxDistance, float& entry)
+{
+	float tMin = 0;
+	float tMax = maxDistance;
+
+	// an origin on a slab of a parallel ray gives 0 * inf = NaN, which the
+	// argument order of std::min and std::max skips
+	for (int i = 0; i < 3; i++)
+	{
+		float t1 = (min[i] - origin[i]) * invDir[i];
+		float t2 = (max[i] - origin[i]) * invDir[i];
+
+		tMin = std::max(tMin, std::min(t1, t2));
+		tMax = std::min(tMax, std::max(t1, t2));
+	}
+
+	entry = tMin;
+
+	// widened by a few rounding errors, so that the box of a flat triangle
+	// (whose slab has no thickness) is not missed by the rays that hit it
+	return tMin <= tMax * 1.0000004f;
+}
+
+MATH3D_INLINE BVH::BVH()
+: stride(0)
+{
+}
+
+MATH3D_INLINE void BVH::build(const Vector3* vertices, size_t triangleCount, unsigned threads)
+{
+	clear();
+
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	if (threads == 0)
+	{
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+
+	std::vector<Builder::Bounds> bounds(triangleCount);
+	std::vector<float> centroids(3 * triangleCount);
+	std::vector<uint32_t> order(triangleCount);
+	Builder::Bounds root = Builder::Bounds::empty();
+
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		Builder::Bounds& box = bounds[i];
+
+		box = Builder::Bounds::empty();
+
+		for (int v = 0; v < 3; v++)
+		{
+			box.grow(&vertices[3 * i + v].x);
+		}
+
+		for (int a = 0; a < 3; a++)
+		{
+			centroids[3 * i + a] = (box.min[a] + box.max[a]) * 0.5f;
+		}
+
+		order[i] = (uint32_t)i;
+		root.grow(box);
+	}
+
+	// a binary tree with a leaf for every triangle has 2 * triangleCount - 1
+	// nodes, so the builder's threads can share the array without resizing it
+	std::vector<Node> built(2 * triangleCount - 1);
+	Builder builder(built, bounds, centroids, order, threads);
+
+	builder.setBounds(0, root);
+	builder.build(0, 0, (uint32_t)triangleCount, 0);
+
+	// lay the nodes out depth first, which is the order in which a single
+	// thread allocates them, whichever threads built them
+	nodes.resize(builder.nodeCount);
+	nodes[0] = built[0];
+
+	uint32_t stack[BVH_STACK_SIZE];
+	int stackSize = 0;
+	uint32_t next = 1;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		Node& node = nodes[stack[--stackSize]];
+
+		if (node.count == 0)
+		{
+			nodes[next] = built[node.first];
+			nodes[next + 1] = built[node.first + 1];
+			node.first = next;
+
+			stack[stackSize++] = next + 1;
+			stack[stackSize++] = next;
+			next += 2;
+		}
+	}
+
+	// copy the triangles into the order of the leaves
+	stride = triangleCount;
+	triangles.resize(math3d::detail::TRIANGLE_STREAMS * stride);
+	indices.swap(order);
+
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		const Vector3* v = vertices + 3 * (size_t)indices[i];
+		Vector3 edge1 = v[1] - v[0];
+		Vector3 edge2 = v[2] - v[0];
+		float values[math3d::detail::TRIANGLE_STREAMS] = {v[0].x, v[0].y, v[0].z,
+			edge1.x, edge1.y, edge1.z, edge2.x, edge2.y, edge2.z};
+
+		for (int s = 0; s < math3d::detail::TRIANGLE_STREAMS; s++)
+		{
+			triangles[s * stride + i] = values[s];
+		}
+	}
+}
+
+MATH3D_INLINE void BVH::clear()
+{
+	nodes.clear();
+	triangles.clear();
+	indices.clear();
+	stride = 0;
+}
+
+MATH3D_INLINE size_t BVH::getTriangleCount() const
+{
+	return indices.size();
+}
+
+MATH3D_INLINE size_t BVH::getNodeCount() const
+{
+	return nodes.size();
+}
+
+MATH3D_INLINE AABB BVH::getBounds() const
+{
+	if (nodes.empty())
+	{
+		return AABB::empty();
+	}
+
+	const Node& root = nodes[0];
+
+	return AABB(Vector3(root.min[0], root.min[1], root.min[2]), Vector3(root.max[0], root.max[1], root.max[2]));
+}
+
+MATH3D_INLINE bool BVH::intersect(const Ray& ray, float maxDistance, RayHit& hit) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+
+	const float r[6] = {ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z};
+	const float invDir[3] = {1.0f / r[3], 1.0f / r[4], 1.0f / r[5]};
+	float distance = maxDistance;
+	float entry;
+
+	if (!intersectNodeBounds(nodes[0].min, nodes[0].max, r, invDir, distance, entry))
+	{
+		return false;
+	}
+
+	// the nodes still to visit, with the t at which the ray enters them
+	const Node* stack[BVH_STACK_SIZE];
+	float entries[BVH_STACK_SIZE];
+	int stackSize = 0;
+	const Node* node = &nodes[0];
+	size_t found = indices.size();
+	float foundU = 0, foundV = 0;
+
+	for (;;)
+	{
+		if (node->count > 0)
+		{
+			float u, v;
+			size_t i = math3d::detail::rayTrianglesScalar(r, &triangles[node->first], stride, node->count,
+				distance, u, v);
+
+			if (i < node->count)
+			{
+				found = node->first + i;
+				foundU = u;
+				foundV = v;
+			}
+		}
+		else
+		{
+			const Node* closer = &nodes[node->first];
+			const Node* farther = closer + 1;
+			float closerEntry, fartherEntry;
+			bool hitCloser = intersectNodeBounds(closer->min, closer->max, r, invDir, distance, closerEntry);
+			bool hitFarther = intersectNodeBounds(farther->min, farther->max, r, invDir, distance, fartherEntry);
+
+			if (hitCloser && hitFarther)
+			{
+				// visit the closer child first, whose hits may cull the other one
+				if (fartherEntry < closerEntry)
+				{
+					std::swap(closer, farther);
+					std::swap(closerEntry, fartherEntry);
+				}
+
+				stack[stackSize] = farther;
+				entries[stackSize] = fartherEntry;
+				stackSize++;
+				node = closer;
+
+				continue;
+			}
+
+			if (hitCloser || hitFarther)
+			{
+				node = hitCloser ? closer : farther;
+
+				continue;
+			}
+		}
+
+		// skip the nodes that the ray enters beyond the closest hit so far
+		while (stackSize > 0 && entries[stackSize - 1] > distance)
+		{
+			stackSize--;
+		}
+
+		if (stackSize == 0)
+		{
+			break;
+		}
+
+		node = stack[--stackSize];
+	}
+
+	if (found == indices.size())
+	{
+		return false;
+	}
+
+	hit.distance = distance;
+	hit.triangle = indices[found];
+	hit.u = foundU;
+	hit.v = foundV;
+
+	return true;
+}
+
+MATH3D_INLINE bool BVH::intersectsAny(const Ray& ray, float maxDistance) const
+{
+	if (nodes.empty())
+	{
+		return false;
+	}
+
+	const float r[6] = {ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z};
+	const float invDir[3] = {1.0f / r[3], 1.0f / r[4], 1.0f / r[5]};
+	const Node* stack[BVH_STACK_SIZE];
+	int stackSize = 0;
+	float entry;
+
+	if (!intersectNodeBounds(nodes[0].min, nodes[0].max, r, invDir, maxDistance, entry))
+	{
+		return false;
+	}
+
+	stack[stackSize++] = &nodes[0];
+
+	while (stackSize > 0)
+	{
+		const Node* node = stack[--stackSize];
+
+		if (node->count > 0)
+		{
+			float distance = maxDistance;
+			float u, v;
+
+			if (math3d::detail::rayTrianglesScalar(r, &triangles[node->first], stride, node->count,
+				distance, u, v) < node->count)
+			{
+				return true;
+			}
+		}
+		else
+		{
+			for (uint32_t c = 0; c < 2; c++)
+			{
+				const Node* child = &nodes[node->first + c];
+
+				if (intersectNodeBounds(child->min, child->max, r, invDir, maxDistance, entry))
+				{
+					stack[stackSize++] = child;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+MATH3D_INLINE size_t BVH::overlap(const AABB& box, std::vector<uint32_t>& triangles) const
+{
+	if (nodes.empty())
+	{
+		return 0;
+	}
+
+	const Node* stack[BVH_STACK_SIZE];
+	int stackSize = 0;
+	size_t initialSize = triangles.size();
+
+	stack[stackSize++] = &nodes[0];
+
+	while (stackSize > 0)
+	{
+		const Node* node = stack[--stackSize];
+
+		if (node->min[0] > box.max.x || node->max[0] < box.min.x ||
+			node->min[1] > box.max.y || node->max[1] < box.min.y ||
+			node->min[2] > box.max.z || node->max[2] < box.min.z)
+		{
+			continue;
+		}
+
+		if (node->count > 0)
+		{
+			for (uint32_t i = node->first; i < node->first + node->count; i++)
+			{
+				Vector3 v0, edge1, edge2;
+
+				getTriangle(i, v0, edge1, edge2);
+
+				// the vertices are rebuilt from the stored edges, so they can
+				// differ from the original ones by a rounding error
+				if (box.overlapsTriangle(v0, v0 + edge1, v0 + edge2))
+				{
+					triangles.push_back(indices[i]);
+				}
+			}
+		}
+		else
+		{
+			stack[stackSize++] = &nodes[node->first + 1];
+			stack[stackSize++] = &nodes[node->first];
+		}
+	}
+
+	return triangles.size() - initialSize;
+}
+
+MATH3D_INLINE void BVH::getTriangle(size_t index, Vector3& v0, Vector3& edge1, Vector3& edge2) const
+{
+	const float* t = &triangles[index];
+
+	v0 = Vector3(t[0], t[stride], t[2 * stride]);
+	edge1 = Vector3(t[3 * stride], t[4 * stride], t[5 * stride]);
+	edge2 = Vector3(t[6 * stride], t[7 * stride], t[8 * stride]);
+}
+
+#endif
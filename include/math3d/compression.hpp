@@ -0,0 +1,174 @@
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "transform.hpp"
+#include "vector3array.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Smallest-three packing of unit quaternions. The largest component of a
+ * unit quaternion can be rebuilt from the other three, which all lie in
+ * [-1 / sqrt(2), 1 / sqrt(2)], so only its index and the other three are
+ * stored, after negating the quaternion if needed (q and -q are the same
+ * rotation) so that the rebuilt component is positive.
+ *
+ * The 32-bit encoding stores the three components with 10 bits each, for
+ * an error of at most 6.9e-4 in each of them, and the 48-bit encoding uses
+ * 15 bits each, for at most 2.2e-5. The errors add up in the rebuilt
+ * component, which can be off by up to 3 times as much.
+ *
+ * Note: the quaternions must be normalized
+ */
+class QuaternionPacking
+{
+	public:
+		/** @brief packs a quaternion into 32 bits */
+		static uint32_t pack32(const Quaternion& q);
+		/** @brief unpacks a quaternion packed by pack32 */
+		static Quaternion unpack32(uint32_t packed);
+		/**
+		 * Packs a quaternion into 48 bits
+		 *
+		 * @param q the quaternion
+		 * @param out receives 3 16-bit words
+		 */
+		static void pack48(const Quaternion& q, uint16_t* out);
+		/** @brief unpacks a quaternion from the 3 words written by pack48 */
+		static Quaternion unpack48(const uint16_t* packed);
+
+		/** @brief packs count quaternions into 32 bits each */
+		static void pack32(const Quaternion* in, uint32_t* out, size_t count);
+		/** @brief packs count quaternions stored as separate x, y, z, and w streams into 32 bits each */
+		static void pack32(const float* x, const float* y, const float* z, const float* w, uint32_t* out, size_t count);
+		/** @brief unpacks count quaternions packed by pack32 */
+		static void unpack32(const uint32_t* in, Quaternion* out, size_t count);
+		/** @brief unpacks count quaternions packed by pack32 into separate x, y, z, and w streams */
+		static void unpack32(const uint32_t* in, float* x, float* y, float* z, float* w, size_t count);
+
+		/** @brief packs count quaternions into 3 words each */
+		static void pack48(const Quaternion* in, uint16_t* out, size_t count);
+		/** @brief packs count quaternions stored as separate x, y, z, and w streams into 3 words each */
+		static void pack48(const float* x, const float* y, const float* z, const float* w, uint16_t* out, size_t count);
+		/** @brief unpacks count quaternions packed by pack48 */
+		static void unpack48(const uint16_t* in, Quaternion* out, size_t count);
+		/** @brief unpacks count quaternions packed by pack48 into separate x, y, z, and w streams */
+		static void unpack48(const uint16_t* in, float* x, float* y, float* z, float* w, size_t count);
+};
+
+/**
+ * Quantizes 3-dimensional vectors, such as positions or scales, to 16 bits
+ * per component over a fixed range. Each axis is divided into 65535 equal
+ * steps, so the error is at most half a step, see getMaxError.
+ */
+class Vector3Quantizer
+{
+	public:
+		/**
+		 * Creates a quantizer for vectors between min and max; components
+		 * outside of the range clamp to its ends
+		 *
+		 * Note: each component of min must not be greater than the
+		 * matching component of max
+		 *
+		 * @param min the smallest value of each component
+		 * @param max the largest value of each component
+		 */
+		Vector3Quantizer(const Vector3& min, const Vector3& max);
+
+		/** @brief gets the smallest value of each component */
+		const Vector3& getMin() const;
+		/** @brief gets the largest value of each component */
+		const Vector3& getMax() const;
+		/** @brief gets the largest error of each component within the range, half of a step */
+		Vector3 getMaxError() const;
+
+		/**
+		 * Quantizes a vector
+		 *
+		 * @param v the vector
+		 * @param out receives the 3 quantized components
+		 */
+		void pack(const Vector3& v, uint16_t* out) const;
+		/** @brief rebuilds a vector from the 3 components written by pack */
+		Vector3 unpack(const uint16_t* packed) const;
+
+		/**
+		 * Quantizes a batch of vectors into separate streams of components
+		 *
+		 * @param in the vectors, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param x receives the quantized x components
+		 * @param y receives the quantized y components
+		 * @param z receives the quantized z components
+		 */
+		void pack(ConstVector3View in, uint16_t* x, uint16_t* y, uint16_t* z) const;
+		/** @brief rebuilds out.count vectors from streams written by pack */
+		void unpack(const uint16_t* x, const uint16_t* y, const uint16_t* z, Vector3View out) const;
+	private:
+		Vector3 min;
+		Vector3 max;
+		// the width of a step of each axis, and its inverse
+		Vector3 step;
+		Vector3 invStep;
+};
+
+/**
+ * A Transform packed into 18 bytes instead of 40: the rotation with
+ * 48-bit smallest-three packing and the position and scale quantized to
+ * 16 bits per component by a TransformQuantizer
+ */
+class PackedTransform
+{
+	public:
+		uint16_t rotation[3];
+		uint16_t position[3];
+		uint16_t scale[3];
+	private:
+};
+
+/**
+ * Packs transforms into PackedTransform using a range for positions and
+ * a range for scales, e.g. the bounds of the tracks of an animation clip
+ */
+class TransformQuantizer
+{
+	public:
+		/**
+		 * Creates a quantizer for transforms
+		 *
+		 * @param position the quantizer for positions
+		 * @param scale the quantizer for scales
+		 */
+		TransformQuantizer(const Vector3Quantizer& position, const Vector3Quantizer& scale);
+
+		/** @brief gets the quantizer for positions */
+		const Vector3Quantizer& getPositionQuantizer() const;
+		/** @brief gets the quantizer for scales */
+		const Vector3Quantizer& getScaleQuantizer() const;
+
+		/**
+		 * Packs a transform
+		 *
+		 * Note: the rotation must be normalized
+		 */
+		PackedTransform pack(const Transform& t) const;
+		/** @brief unpacks a transform packed by pack */
+		Transform unpack(const PackedTransform& packed) const;
+
+		/** @brief packs count transforms */
+		void pack(const Transform* in, PackedTransform* out, size_t count) const;
+		/** @brief unpacks count transforms packed by pack */
+		void unpack(const PackedTransform* in, Transform* out, size_t count) const;
+	private:
+		Vector3Quantizer position;
+		Vector3Quantizer scale;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "compression.inl"
+#endif
+
+#endif
@@ -0,0 +1,345 @@
+#ifndef COMPRESSION_INL
+#define COMPRESSION_INL
+
+#include "config.hpp"
+#include "compression.hpp"
+#include "kernels/table.hpp"
+#include "streams.hpp"
+
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion arrays must be tightly packed");
+static_assert(sizeof(Transform) == 10 * sizeof(float), "Transform arrays must be tightly packed");
+
+/** @brief the number of quaternions or transforms converted at a time by the batch functions */
+static const size_t PACK_BLOCK_SIZE = 256;
+
+/** @brief copies n quaternions into separate x, y, z, and w streams of PACK_BLOCK_SIZE floats */
+MATH3D_INLINE static void splitQuaternions(const Quaternion* in, float* streams, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		streams[i] = in[i].x;
+		streams[PACK_BLOCK_SIZE + i] = in[i].y;
+		streams[2 * PACK_BLOCK_SIZE + i] = in[i].z;
+		streams[3 * PACK_BLOCK_SIZE + i] = in[i].w;
+	}
+}
+
+/** @brief copies n quaternions out of streams written like splitQuaternions */
+MATH3D_INLINE static void joinQuaternions(const float* streams, Quaternion* out, size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+	{
+		out[i] = Quaternion(streams[i], streams[PACK_BLOCK_SIZE + i], streams[2 * PACK_BLOCK_SIZE + i],
+			streams[3 * PACK_BLOCK_SIZE + i]);
+	}
+}
+
+MATH3D_INLINE uint32_t QuaternionPacking::pack32(const Quaternion& q)
+{
+	uint32_t packed;
+
+	math3d::detail::quatPack32Scalar(&packed, &q.x, &q.y, &q.z, &q.w, 1);
+
+	return packed;
+}
+
+MATH3D_INLINE Quaternion QuaternionPacking::unpack32(uint32_t packed)
+{
+	Quaternion q(0, 0, 0, 1);
+
+	math3d::detail::quatUnpack32Scalar(&q.x, &q.y, &q.z, &q.w, &packed, 1);
+
+	return q;
+}
+
+MATH3D_INLINE void QuaternionPacking::pack48(const Quaternion& q, uint16_t* out)
+{
+	math3d::detail::quatPack48Scalar(out, &q.x, &q.y, &q.z, &q.w, 1);
+}
+
+MATH3D_INLINE Quaternion QuaternionPacking::unpack48(const uint16_t* packed)
+{
+	Quaternion q(0, 0, 0, 1);
+
+	math3d::detail::quatUnpack48Scalar(&q.x, &q.y, &q.z, &q.w, packed, 1);
+
+	return q;
+}
+
+MATH3D_INLINE void QuaternionPacking::pack32(const Quaternion* in, uint32_t* out, size_t count)
+{
+	alignas(math3d::detail::BATCH_ALIGNMENT) float streams[4 * PACK_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += PACK_BLOCK_SIZE)
+	{
+		size_t n = count - start < PACK_BLOCK_SIZE ? count - start : PACK_BLOCK_SIZE;
+
+		splitQuaternions(in + start, streams, n);
+		pack32(streams, streams + PACK_BLOCK_SIZE, streams + 2 * PACK_BLOCK_SIZE, streams + 3 * PACK_BLOCK_SIZE,
+			out + start, n);
+	}
+}
+
+MATH3D_INLINE void QuaternionPacking::pack32(const float* x, const float* y, const float* z, const float* w,
+	uint32_t* out, size_t count)
+{
+	math3d::detail::kernels().quatPack32(out, x, y, z, w, count);
+}
+
+MATH3D_INLINE void QuaternionPacking::unpack32(const uint32_t* in, Quaternion* out, size_t count)
+{
+	alignas(math3d::detail::BATCH_ALIGNMENT) float streams[4 * PACK_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += PACK_BLOCK_SIZE)
+	{
+		size_t n = count - start < PACK_BLOCK_SIZE ? count - start : PACK_BLOCK_SIZE;
+
+		unpack32(in + start, streams, streams + PACK_BLOCK_SIZE, streams + 2 * PACK_BLOCK_SIZE,
+			streams + 3 * PACK_BLOCK_SIZE, n);
+		joinQuaternions(streams, out + start, n);
+	}
+}
+
+MATH3D_INLINE void QuaternionPacking::unpack32(const uint32_t* in, float* x, float* y, float* z, float* w,
+	size_t count)
+{
+	math3d::detail::kernels().quatUnpack32(x, y, z, w, in, count);
+}
+
+MATH3D_INLINE void QuaternionPacking::pack48(const Quaternion* in, uint16_t* out, size_t count)
+{
+	alignas(math3d::detail::BATCH_ALIGNMENT) float streams[4 * PACK_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += PACK_BLOCK_SIZE)
+	{
+		size_t n = count - start < PACK_BLOCK_SIZE ? count - start : PACK_BLOCK_SIZE;
+
+		splitQuaternions(in + start, streams, n);
+		pack48(streams, streams + PACK_BLOCK_SIZE, streams + 2 * PACK_BLOCK_SIZE, streams + 3 * PACK_BLOCK_SIZE,
+			out + 3 * start, n);
+	}
+}
+
+MATH3D_INLINE void QuaternionPacking::pack48(const float* x, const float* y, const float* z, const float* w,
+	uint16_t* out, size_t count)
+{
+	math3d::detail::kernels().quatPack48(out, x, y, z, w, count);
+}
+
+MATH3D_INLINE void QuaternionPacking::unpack48(const uint16_t* in, Quaternion* out, size_t count)
+{
+	alignas(math3d::detail::BATCH_ALIGNMENT) float streams[4 * PACK_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += PACK_BLOCK_SIZE)
+	{
+		size_t n = count - start < PACK_BLOCK_SIZE ? count - start : PACK_BLOCK_SIZE;
+
+		unpack48(in + 3 * start, streams, streams + PACK_BLOCK_SIZE, streams + 2 * PACK_BLOCK_SIZE,
+			streams + 3 * PACK_BLOCK_SIZE, n);
+		joinQuaternions(streams, out + start, n);
+	}
+}
+
+MATH3D_INLINE void QuaternionPacking::unpack48(const uint16_t* in, float* x, float* y, float* z, float* w,
+	size_t count)
+{
+	math3d::detail::kernels().quatUnpack48(x, y, z, w, in, count);
+}
+
+MATH3D_INLINE Vector3Quantizer::Vector3Quantizer(const Vector3& min, const Vector3& max)
+: min(min), max(max)
+{
+	Vector3 range = max - min;
+
+	// a flat axis quantizes everything to min rather than dividing by 0
+	step = Vector3(range.x / 65535, range.y / 65535, range.z / 65535);
+	invStep = Vector3(range.x > 0 ? 65535 / range.x : 0, range.y > 0 ? 65535 / range.y : 0,
+		range.z > 0 ? 65535 / range.z : 0);
+}
+
+MATH3D_INLINE const Vector3& Vector3Quantizer::getMin() const
+{
+	return min;
+}
+
+MATH3D_INLINE const Vector3& Vector3Quantizer::getMax() const
+{
+	return max;
+}
+
+MATH3D_INLINE Vector3 Vector3Quantizer::getMaxError() const
+{
+	return step * 0.5f;
+}
+
+MATH3D_INLINE void Vector3Quantizer::pack(const Vector3& v, uint16_t* out) const
+{
+	math3d::detail::streamQuantize16Scalar(out, &v.x, min.x, invStep.x, 1);
+	math3d::detail::streamQuantize16Scalar(out + 1, &v.y, min.y, invStep.y, 1);
+	math3d::detail::streamQuantize16Scalar(out + 2, &v.z, min.z, invStep.z, 1);
+}
+
+MATH3D_INLINE Vector3 Vector3Quantizer::unpack(const uint16_t* packed) const
+{
+	Vector3 v;
+
+	math3d::detail::streamDequantize16Scalar(&v.x, packed, min.x, step.x, 1);
+	math3d::detail::streamDequantize16Scalar(&v.y, packed + 1, min.y, step.y, 1);
+	math3d::detail::streamDequantize16Scalar(&v.z, packed + 2, min.z, step.z, 1);
+
+	return v;
+}
+
+MATH3D_INLINE void Vector3Quantizer::pack(ConstVector3View in, uint16_t* x, uint16_t* y, uint16_t* z) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	size_t blockSize = in.isPacked() ? in.count : math3d::detail::VECTOR3_BLOCK_SIZE;
+
+	alignas(math3d::detail::BATCH_ALIGNMENT) float scratch[3 * math3d::detail::VECTOR3_BLOCK_SIZE];
+
+	for (size_t start = 0; start < in.count; start += blockSize)
+	{
+		size_t n = in.count - start < blockSize ? in.count - start : blockSize;
+		math3d::detail::Vector3Streams s = math3d::detail::packStreams(in, start, n, scratch);
+
+		k.streamQuantize16(x + start, s.x, min.x, invStep.x, n);
+		k.streamQuantize16(y + start, s.y, min.y, invStep.y, n);
+		k.streamQuantize16(z + start, s.z, min.z, invStep.z, n);
+	}
+}
+
+MATH3D_INLINE void Vector3Quantizer::unpack(const uint16_t* x, const uint16_t* y, const uint16_t* z,
+	Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	size_t blockSize = out.isPacked() ? out.count : math3d::detail::VECTOR3_BLOCK_SIZE;
+
+	alignas(math3d::detail::BATCH_ALIGNMENT) float scratch[3 * math3d::detail::VECTOR3_BLOCK_SIZE];
+
+	for (size_t start = 0; start < out.count; start += blockSize)
+	{
+		size_t n = out.count - start < blockSize ? out.count - start : blockSize;
+		math3d::detail::Vector3Streams s = math3d::detail::outputStreams(out, start, scratch);
+
+		k.streamDequantize16(s.x, x + start, min.x, step.x, n);
+		k.streamDequantize16(s.y, y + start, min.y, step.y, n);
+		k.streamDequantize16(s.z, z + start, min.z, step.z, n);
+		math3d::detail::unpackStreams(s, out, start, n);
+	}
+}
+
+MATH3D_INLINE TransformQuantizer::TransformQuantizer(const Vector3Quantizer& position, const Vector3Quantizer& scale)
+: position(position), scale(scale)
+{
+}
+
+MATH3D_INLINE const Vector3Quantizer& TransformQuantizer::getPositionQuantizer() const
+{
+	return position;
+}
+
+MATH3D_INLINE const Vector3Quantizer& TransformQuantizer::getScaleQuantizer() const
+{
+	return scale;
+}
+
+MATH3D_INLINE PackedTransform TransformQuantizer::pack(const Transform& t) const
+{
+	PackedTransform packed;
+
+	QuaternionPacking::pack48(t.rotation, packed.rotation);
+	position.pack(t.position, packed.position);
+	scale.pack(t.scale, packed.scale);
+
+	return packed;
+}
+
+MATH3D_INLINE Transform TransformQuantizer::unpack(const PackedTransform& packed) const
+{
+	return Transform(position.unpack(packed.position), QuaternionPacking::unpack48(packed.rotation),
+		scale.unpack(packed.scale));
+}
+
+MATH3D_INLINE void TransformQuantizer::pack(const Transform* in, PackedTransform* out, size_t count) const
+{
+	const size_t stride = sizeof(Transform) / sizeof(float);
+
+	alignas(math3d::detail::BATCH_ALIGNMENT) float rotations[4 * PACK_BLOCK_SIZE];
+	uint16_t words[9 * PACK_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += PACK_BLOCK_SIZE)
+	{
+		size_t n = count - start < PACK_BLOCK_SIZE ? count - start : PACK_BLOCK_SIZE;
+		const Transform* t = in + start;
+
+		// the positions and scales are read in place through strided views
+		position.pack(ConstVector3View(&t->position.x, &t->position.y, &t->position.z, n, stride),
+			words, words + PACK_BLOCK_SIZE, words + 2 * PACK_BLOCK_SIZE);
+		scale.pack(ConstVector3View(&t->scale.x, &t->scale.y, &t->scale.z, n, stride),
+			words + 3 * PACK_BLOCK_SIZE, words + 4 * PACK_BLOCK_SIZE, words + 5 * PACK_BLOCK_SIZE);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			rotations[i] = t[i].rotation.x;
+			rotations[PACK_BLOCK_SIZE + i] = t[i].rotation.y;
+			rotations[2 * PACK_BLOCK_SIZE + i] = t[i].rotation.z;
+			rotations[3 * PACK_BLOCK_SIZE + i] = t[i].rotation.w;
+		}
+
+		QuaternionPacking::pack48(rotations, rotations + PACK_BLOCK_SIZE, rotations + 2 * PACK_BLOCK_SIZE,
+			rotations + 3 * PACK_BLOCK_SIZE, words + 6 * PACK_BLOCK_SIZE, n);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			PackedTransform& p = out[start + i];
+
+			for (int c = 0; c < 3; c++)
+			{
+				p.position[c] = words[c * PACK_BLOCK_SIZE + i];
+				p.scale[c] = words[(3 + c) * PACK_BLOCK_SIZE + i];
+				p.rotation[c] = words[6 * PACK_BLOCK_SIZE + 3 * i + c];
+			}
+		}
+	}
+}
+
+MATH3D_INLINE void TransformQuantizer::unpack(const PackedTransform* in, Transform* out, size_t count) const
+{
+	const size_t stride = sizeof(Transform) / sizeof(float);
+
+	alignas(math3d::detail::BATCH_ALIGNMENT) float rotations[4 * PACK_BLOCK_SIZE];
+	uint16_t words[9 * PACK_BLOCK_SIZE];
+
+	for (size_t start = 0; start < count; start += PACK_BLOCK_SIZE)
+	{
+		size_t n = count - start < PACK_BLOCK_SIZE ? count - start : PACK_BLOCK_SIZE;
+		Transform* t = out + start;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const PackedTransform& p = in[start + i];
+
+			for (int c = 0; c < 3; c++)
+			{
+				words[c * PACK_BLOCK_SIZE + i] = p.position[c];
+				words[(3 + c) * PACK_BLOCK_SIZE + i] = p.scale[c];
+				words[6 * PACK_BLOCK_SIZE + 3 * i + c] = p.rotation[c];
+			}
+		}
+
+		position.unpack(words, words + PACK_BLOCK_SIZE, words + 2 * PACK_BLOCK_SIZE,
+			Vector3View(&t->position.x, &t->position.y, &t->position.z, n, stride));
+		scale.unpack(words + 3 * PACK_BLOCK_SIZE, words + 4 * PACK_BLOCK_SIZE, words + 5 * PACK_BLOCK_SIZE,
+			Vector3View(&t->scale.x, &t->scale.y, &t->scale.z, n, stride));
+		QuaternionPacking::unpack48(words + 6 * PACK_BLOCK_SIZE, rotations, rotations + PACK_BLOCK_SIZE,
+			rotations + 2 * PACK_BLOCK_SIZE, rotations + 3 * PACK_BLOCK_SIZE, n);
+
+		for (size_t i = 0; i < n; i++)
+		{
+			t[i].rotation = Quaternion(rotations[i], rotations[PACK_BLOCK_SIZE + i],
+				rotations[2 * PACK_BLOCK_SIZE + i], rotations[3 * PACK_BLOCK_SIZE + i]);
+		}
+	}
+}
+
+#endif
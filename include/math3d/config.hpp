@@ -0,0 +1,61 @@
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+
+/**
+ * Build configuration for the library
+ *
+ * By default the classes are declared in the headers and defined in
+ * libmath3d.a. Defining MATH3D_HEADER_ONLY before including any of the
+ * headers (or passing -DMATH3D_HEADER_ONLY to the compiler) pulls every
+ * definition into the including translation unit as an inline function,
+ * so no library needs to be linked and the compiler is free to inline and
+ * vectorize across calls such as Vector3::operator+ and Vector3::dot.
+ */
+#ifdef MATH3D_HEADER_ONLY
+	#define MATH3D_INLINE inline
+#else
+	#define MATH3D_INLINE
+#endif
+
+/**
+ * Constructors, factories and arithmetic that only need +, -, * and / are
+ * constexpr in C++14 and later, so that constant vectors, quaternions and
+ * matrices are folded at compile time. They are defined in the headers
+ * in both build modes; before C++14 they are ordinary inline functions.
+ */
+#if __cplusplus >= 201402L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+	#define MATH3D_CONSTEXPR constexpr
+#else
+	#define MATH3D_CONSTEXPR inline
+#endif
+
+#if defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define MATH3D_HAS_CONSTANT_EVALUATED
+	#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+	#define MATH3D_HAS_CONSTANT_EVALUATED
+#endif
+
+namespace math3d
+{
+	namespace detail
+	{
+		/**
+		 * Whether the call is being evaluated at compile time, so that
+		 * operators backed by SIMD kernels can take a scalar path instead.
+		 * Without compiler support this is always false, and those
+		 * operators can only be evaluated at runtime.
+		 */
+		MATH3D_CONSTEXPR bool isConstantEvaluated()
+		{
+#ifdef MATH3D_HAS_CONSTANT_EVALUATED
+			return __builtin_is_constant_evaluated();
+#else
+			return false;
+#endif
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,162 @@
+#ifndef DISPATCH_HPP
+#define DISPATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Instruction set levels that the library has kernels for,
+ * ordered from least to most capable
+ */
+enum class SIMDLevel
+{
+	Scalar,
+	SSE2,
+	SSE42,
+	AVX2,
+	AVX512
+};
+
+/**
+ * Table of the kernels used by the static library. Each kernel operates
+ * on raw floats laid out like the members of the corresponding class
+ * (Matrix4x4::matrix, Quaternion::x, ...). All implementations of an
+ * entry produce the same results as the scalar one.
+ */
+struct Kernels
+{
+	void (*mat4Mul)(float* out, const float* a, const float* b);
+	void (*mat4Inverse)(float* out, const float* m);
+	void (*mat4InverseAffine)(float* out, const float* m);
+	void (*mat4TransformPoint)(float* out, const float* m, const float* v);
+
+	void (*affineMul)(float* out, const float* a, const float* b);
+	void (*affineInverse)(float* out, const float* m);
+
+	void (*quatMul)(float* out, const float* a, const float* b);
+	void (*quatNormalize)(float* out, const float* q);
+
+	void (*streamAdd)(float* out, const float* a, const float* b, size_t n);
+	void (*streamSub)(float* out, const float* a, const float* b, size_t n);
+	void (*streamMul)(float* out, const float* a, const float* b, size_t n);
+	void (*streamScale)(float* out, const float* a, float s, size_t n);
+	void (*streamLerp)(float* out, const float* a, const float* b, const float* t, size_t n);
+
+	void (*vec3Dot)(float* out, const float* ax, const float* ay, const float* az,
+		const float* bx, const float* by, const float* bz, size_t n);
+	void (*vec3Cross)(float* ox, float* oy, float* oz, const float* ax, const float* ay, const float* az,
+		const float* bx, const float* by, const float* bz, size_t n);
+	void (*vec3MagSq)(float* out, const float* ax, const float* ay, const float* az, size_t n);
+	void (*vec3Magnitude)(float* out, const float* ax, const float* ay, const float* az, size_t n);
+	void (*vec3Normalize)(float* ox, float* oy, float* oz, const float* ax, const float* ay, const float* az, size_t n);
+	void (*vec3NormalizeFast)(float* ox, float* oy, float* oz, const float* ax, const float* ay, const float* az, size_t n);
+
+	void (*mat4TransformPoints)(float* ox, float* oy, float* oz, const float* m,
+		const float* ax, const float* ay, const float* az, size_t n);
+	void (*mat4TransformDirections)(float* ox, float* oy, float* oz, const float* m,
+		const float* ax, const float* ay, const float* az, size_t n);
+	void (*mat4TransformHomogeneous)(float* ox, float* oy, float* oz, const float* m,
+		const float* ax, const float* ay, const float* az, size_t n);
+
+	void (*quatRotateVectors)(float* ox, float* oy, float* oz, const float* q,
+		const float* ax, const float* ay, const float* az, size_t n);
+	void (*quatsRotateVectors)(float* ox, float* oy, float* oz,
+		const float* qx, const float* qy, const float* qz, const float* qw,
+		const float* ax, const float* ay, const float* az, size_t n);
+
+	void (*quatNlerp)(float* ox, float* oy, float* oz, float* ow,
+		const float* ax, const float* ay, const float* az, const float* aw,
+		const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n);
+	void (*quatSlerp)(float* ox, float* oy, float* oz, float* ow,
+		const float* ax, const float* ay, const float* az, const float* aw,
+		const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n);
+
+	void (*streamSinCos)(float* s, float* c, const float* a, size_t n);
+	void (*streamAtan2)(float* out, const float* y, const float* x, size_t n);
+	void (*quatFromEulerAngles)(float* ox, float* oy, float* oz, float* ow,
+		const float* ax, const float* ay, const float* az, size_t n);
+	void (*quatFromAxisAngle)(float* ox, float* oy, float* oz, float* ow,
+		const float* axisX, const float* axisY, const float* axisZ, const float* angle, size_t n);
+
+	void (*skinLinear)(float* ox, float* oy, float* oz, const float* px, const float* py, const float* pz,
+		const uint16_t* const* indices, const float* const* weights, int influences,
+		const float* palette, size_t stride, size_t n);
+	void (*skinDualQuat)(float* ox, float* oy, float* oz, const float* px, const float* py, const float* pz,
+		const uint16_t* const* indices, const float* const* weights, int influences,
+		const float* palette, size_t n);
+
+	void (*quatPack32)(uint32_t* out, const float* x, const float* y, const float* z, const float* w, size_t n);
+	void (*quatUnpack32)(float* x, float* y, float* z, float* w, const uint32_t* in, size_t n);
+	void (*quatPack48)(uint16_t* out, const float* x, const float* y, const float* z, const float* w, size_t n);
+	void (*quatUnpack48)(float* x, float* y, float* z, float* w, const uint16_t* in, size_t n);
+	void (*streamQuantize16)(uint16_t* out, const float* a, float min, float invStep, size_t n);
+	void (*streamDequantize16)(float* out, const uint16_t* a, float min, float step, size_t n);
+
+	void (*vec3Deinterleave)(float* ox, float* oy, float* oz, const float* src, size_t n);
+	void (*vec3Interleave)(float* dst, const float* x, const float* y, const float* z, size_t n);
+
+	size_t (*frustumCullSpheres)(uint32_t* visible, const float* planes,
+		const float* x, const float* y, const float* z, const float* r, uint32_t base, size_t n);
+	size_t (*frustumCullBoxes)(uint32_t* visible, const float* planes,
+		const float* cx, const float* cy, const float* cz, const float* ex, const float* ey, const float* ez,
+		uint32_t base, size_t n);
+	void (*aabbTransform)(float* out, const float* boxes, const float* matrices, size_t stride, size_t n);
+
+	size_t (*rayTriangles)(const float* ray, const float* triangles, size_t stride, size_t n,
+		float& distance, float& u, float& v);
+	size_t (*raysTriangle)(uint32_t* hitTriangles, float* distance, float* u, float* v,
+		const float* triangle, uint32_t id, const float* ox, const float* oy, const float* oz,
+		const float* dx, const float* dy, const float* dz, size_t n);
+};
+
+/**
+ * Routes the library's math kernels to the best implementation the
+ * CPU supports. The CPU is queried with cpuid the first time a kernel
+ * is needed, so a single build of libmath3d.a runs everywhere from
+ * SSE2-only hosts to AVX-512 ones.
+ *
+ * Setting the MATH3D_SIMD environment variable to one of "scalar",
+ * "sse2", "sse4.2", "avx2" or "avx512" caps the level that is selected,
+ * which is useful for benchmarking the kernels against each other.
+ *
+ * Note: in header-only mode (MATH3D_HEADER_ONLY) the classes choose their
+ * kernels at compile time instead, since the target is already known
+ */
+class Dispatch
+{
+	public:
+		/** @brief queries the CPU for the highest level it supports */
+		static SIMDLevel detect();
+
+		/** @brief gets the level of the kernels currently in use */
+		static SIMDLevel level();
+		/**
+		 * Selects the kernels for the given level, capped to what the
+		 * CPU supports. This is not thread-safe and should be done
+		 * before any other threads use the library.
+		 *
+		 * @param level the desired level
+		 * @return the level that was selected
+		 */
+		static SIMDLevel setLevel(SIMDLevel level);
+
+		/** @brief gets the kernels currently in use */
+		static const Kernels& kernels();
+		/** @brief gets the kernels for a level, regardless of CPU support */
+		static const Kernels& kernels(SIMDLevel level);
+
+		/** @brief gets the name of a level as accepted by MATH3D_SIMD */
+		static const char* levelName(SIMDLevel level);
+		/**
+		 * Parses the name of a level
+		 *
+		 * @param name the name of the level, e.g. "avx2"
+		 * @param level set to the parsed level on success
+		 * @return whether the name was recognized
+		 */
+		static bool parseLevel(const char* name, SIMDLevel& level);
+	private:
+		static const Kernels*& active();
+};
+
+#endif
\ No newline at end of file
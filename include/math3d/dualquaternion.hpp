@@ -0,0 +1,131 @@
+#ifndef DUALQUATERNION_HPP
+#define DUALQUATERNION_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include "quaternion.hpp"
+
+/**
+ * A rigid transformation (a rotation followed by a translation) stored as
+ * a dual quaternion: a real part holding the rotation and a dual part
+ * holding half of the translation multiplied by the rotation
+ *
+ * Unlike matrices, weighted sums of unit dual quaternions still describe
+ * rigid transformations once normalized, which is what makes them useful
+ * for skinning (see Skinning::dualQuaternionBlend).
+ */
+template <typename T>
+class DualQuaternionT
+{
+	public:
+		/**
+		 * Creates a new DualQuaternion with no rotation and no
+		 * translation
+		 */
+		static DualQuaternionT identity();
+
+		/**
+		 * Creates a new DualQuaternion that rotates and then
+		 * translates
+		 *
+		 * @param rotation the rotation, which must be a unit quaternion
+		 * @param translation the translation applied after the rotation
+		 */
+		static DualQuaternionT fromRotationTranslation(const QuaternionT<T>& rotation, const Vector3T<T>& translation);
+		/**
+		 * Creates a new DualQuaternion from the rotation and position of
+		 * a transform
+		 *
+		 * Note: dual quaternions cannot represent scale, so the scale
+		 * of the transform is ignored
+		 */
+		static DualQuaternionT fromTransform(const TransformT<T>& transform);
+
+		/**
+		 * Creates a new DualQuaternion from its real and dual
+		 * parts
+		 *
+		 * @param real the real (rotation) part
+		 * @param dual the dual (translation) part
+		 */
+		DualQuaternionT(const QuaternionT<T>& real, const QuaternionT<T>& dual);
+		/**
+		 * Creates a new DualQuaternion by copying the real and dual
+		 * parts of DualQuaternion dq
+		 */
+		DualQuaternionT(const DualQuaternionT& dq);
+		/**
+		 * Creates a new DualQuaternion by converting the components of a
+		 * dual quaternion with another scalar type, e.g. a DualQuaterniond
+		 */
+		template <typename U>
+		explicit DualQuaternionT(const DualQuaternionT<U>& dq);
+
+		/** @brief gets the rotation, assuming the dual quaternion is normalized */
+		QuaternionT<T> getRotation() const;
+		/** @brief gets the translation, assuming the dual quaternion is normalized */
+		Vector3T<T> getTranslation() const;
+		/** @brief creates a Transform with the rotation and translation and a scale of (1, 1, 1) */
+		TransformT<T> toTransform() const;
+		/** @brief creates the matrix of the rotation and translation */
+		Affine3x4T<T> toAffine3x4() const;
+
+		/**
+		 * Divides both parts by the magnitude of the real part, so that
+		 * a blend of dual quaternions becomes a rigid transformation
+		 */
+		DualQuaternionT normalize() const;
+		/**
+		 * Calculates the conjugate of both parts, which is the inverse
+		 * of a normalized dual quaternion
+		 */
+		DualQuaternionT conjugate() const;
+
+		/**
+		 * Transforms a point by the rotation and then the translation
+		 *
+		 * Note: the dual quaternion must be normalized
+		 */
+		Vector3T<T> transformPoint(const Vector3T<T>& point) const;
+		/**
+		 * Transforms a direction by the rotation only
+		 *
+		 * Note: the dual quaternion must be normalized
+		 */
+		Vector3T<T> transformDirection(const Vector3T<T>& direction) const;
+
+		/**
+		 * Compares whether two dual quaternions are equal by testing
+		 * whether all of their corresponding components are equal
+		 */
+		bool operator==(const DualQuaternionT&) const;
+		bool operator!=(const DualQuaternionT&) const;
+
+		/**
+		 * Combines two transformations, like multiplying their matrices:
+		 * the result applies the right-hand side first
+		 */
+		DualQuaternionT operator*(const DualQuaternionT&) const;
+
+		/** @brief adds two dual quaternions, e.g. to blend weighted transformations */
+		DualQuaternionT operator+(const DualQuaternionT&) const;
+		/** @brief multiplies both parts by a number, e.g. a blend weight */
+		DualQuaternionT operator*(T) const;
+
+		QuaternionT<T> real;
+		QuaternionT<T> dual;
+	private:
+};
+
+#include "vector3.hpp"
+#include "transform.hpp"
+#include "affine3x4.hpp"
+
+#ifdef MATH3D_HEADER_ONLY
+#include "dualquaternion.inl"
+#else
+extern template class DualQuaternionT<float>;
+extern template class DualQuaternionT<double>;
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+#ifndef DUALQUATERNION_INL
+#define DUALQUATERNION_INL
+
+#include "config.hpp"
+#include "dualquaternion.hpp"
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::identity()
+{
+	return DualQuaternionT<T>(QuaternionT<T>(0, 0, 0, 1), QuaternionT<T>(0, 0, 0, 0));
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::fromRotationTranslation(const QuaternionT<T>& rotation,
+	const Vector3T<T>& translation)
+{
+	QuaternionT<T> dual = QuaternionT<T>(translation.x, translation.y, translation.z, 0) * rotation * 0.5f;
+
+	return DualQuaternionT<T>(rotation, dual);
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::fromTransform(const TransformT<T>& transform)
+{
+	return fromRotationTranslation(transform.rotation, transform.position);
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T>::DualQuaternionT(const QuaternionT<T>& real, const QuaternionT<T>& dual)
+: real(real), dual(dual)
+{
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T>::DualQuaternionT(const DualQuaternionT<T>& dq)
+: real(dq.real), dual(dq.dual)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_INLINE DualQuaternionT<T>::DualQuaternionT(const DualQuaternionT<U>& dq)
+: real(dq.real), dual(dq.dual)
+{
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> DualQuaternionT<T>::getRotation() const
+{
+	return real;
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> DualQuaternionT<T>::getTranslation() const
+{
+	QuaternionT<T> t = dual * real.conjugate() * 2;
+
+	return Vector3T<T>(t.x, t.y, t.z);
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T> DualQuaternionT<T>::toTransform() const
+{
+	return TransformT<T>(getTranslation(), real, Vector3T<T>(1, 1, 1));
+}
+
+template <typename T>
+MATH3D_INLINE Affine3x4T<T> DualQuaternionT<T>::toAffine3x4() const
+{
+	return Affine3x4T<T>::fromPositionRotationScale(getTranslation(), real, Vector3T<T>(1, 1, 1));
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::normalize() const
+{
+	T mag = real.magnitude();
+
+	return DualQuaternionT<T>(QuaternionT<T>(real.x / mag, real.y / mag, real.z / mag, real.w / mag),
+		QuaternionT<T>(dual.x / mag, dual.y / mag, dual.z / mag, dual.w / mag));
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::conjugate() const
+{
+	return DualQuaternionT<T>(real.conjugate(), dual.conjugate());
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> DualQuaternionT<T>::transformPoint(const Vector3T<T>& p) const
+{
+	const QuaternionT<T>& r = real;
+	const QuaternionT<T>& d = dual;
+
+	// rotating p is p + 2 * (r.xyz x (r.xyz x p + r.w * p)), and the
+	// translation is 2 * (r.w * d.xyz - d.w * r.xyz + r.xyz x d.xyz)
+	T tx = (r.y * p.z - r.z * p.y) + r.w * p.x;
+	T ty = (r.z * p.x - r.x * p.z) + r.w * p.y;
+	T tz = (r.x * p.y - r.y * p.x) + r.w * p.z;
+
+	T cx = r.y * tz - r.z * ty;
+	T cy = r.z * tx - r.x * tz;
+	T cz = r.x * ty - r.y * tx;
+
+	T ux = (r.w * d.x - d.w * r.x) + (r.y * d.z - r.z * d.y);
+	T uy = (r.w * d.y - d.w * r.y) + (r.z * d.x - r.x * d.z);
+	T uz = (r.w * d.z - d.w * r.z) + (r.x * d.y - r.y * d.x);
+
+	return Vector3T<T>(p.x + (cx + ux) * 2, p.y + (cy + uy) * 2, p.z + (cz + uz) * 2);
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> DualQuaternionT<T>::transformDirection(const Vector3T<T>& v) const
+{
+	const QuaternionT<T>& r = real;
+
+	T tx = (r.y * v.z - r.z * v.y) + r.w * v.x;
+	T ty = (r.z * v.x - r.x * v.z) + r.w * v.y;
+	T tz = (r.x * v.y - r.y * v.x) + r.w * v.z;
+
+	T cx = r.y * tz - r.z * ty;
+	T cy = r.z * tx - r.x * tz;
+	T cz = r.x * ty - r.y * tx;
+
+	return Vector3T<T>(v.x + cx * 2, v.y + cy * 2, v.z + cz * 2);
+}
+
+template <typename T>
+MATH3D_INLINE bool DualQuaternionT<T>::operator==(const DualQuaternionT<T>& dq) const
+{
+	return real == dq.real && dual == dq.dual;
+}
+
+template <typename T>
+MATH3D_INLINE bool DualQuaternionT<T>::operator!=(const DualQuaternionT<T>& dq) const
+{
+	return real != dq.real || dual != dq.dual;
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::operator*(const DualQuaternionT<T>& dq) const
+{
+	return DualQuaternionT<T>(real * dq.real, real * dq.dual + dual * dq.real);
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::operator+(const DualQuaternionT<T>& dq) const
+{
+	return DualQuaternionT<T>(real + dq.real, dual + dq.dual);
+}
+
+template <typename T>
+MATH3D_INLINE DualQuaternionT<T> DualQuaternionT<T>::operator*(T n) const
+{
+	return DualQuaternionT<T>(real * n, dual * n);
+}
+
+#endif
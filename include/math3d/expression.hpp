@@ -0,0 +1,767 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "vector3array.hpp"
+#include <cstddef>
+
+/**
+ * Opt-in expression templates for Vector3 and Quaternion arithmetic
+ *
+ * Wrapping an operand in lazy() makes the operators that use it build a
+ * small tree of the operations instead of a temporary object for each
+ * of them. The tree is evaluated when it is converted to a Vector3 or
+ * Quaternion, each node computing all of its components from a single
+ * evaluation of each of its operands, so a chain such as
+ *
+ *     Vector3 r = lazy(axis) * sinA + lazy(v) * cosA + axis * (dot(lazy(axis), v) * (1 - cosA));
+ *
+ * compiles to the arithmetic of the components alone. An operation
+ * between two plain values, such as v * cosA, is still done by the
+ * Vector3 operator, so each chain should be lazy from its first
+ * operation. evaluate() stores the result into an existing object. Every
+ * operation is done in the same order as by the Vector3 and Quaternion
+ * operators, so the results are the same bit for bit. The operators are
+ * constexpr and inline themselves, so single chains compile to nearly
+ * the same code as them; the gain is in the batch expressions below.
+ *
+ * Lazy views of streams, such as a Vector3Array, make batch expressions,
+ * which evaluate() computes for every element in a single pass, instead
+ * of one pass per operation with an array for each intermediate result.
+ *
+ * Note: the trees hold copies of their operands, so they may be stored,
+ * but lazy views and streams must outlive the evaluation
+ */
+namespace math3d
+{
+	namespace expr
+	{
+		/** @brief selects element i of a batch operand as if it had a stride of 1 */
+		struct Packed {};
+		/** @brief selects element i of a batch operand at the stride of its view */
+		struct Strided {};
+
+		/** @brief keeps T from being deduced from an argument, so that e.g. doubles convert to float */
+		template <typename T>
+		struct Identity
+		{
+			typedef T type;
+		};
+
+		struct Add
+		{
+			template <typename T>
+			static T apply(T a, T b) { return a + b; }
+		};
+
+		struct Subtract
+		{
+			template <typename T>
+			static T apply(T a, T b) { return a - b; }
+		};
+
+		struct Multiply
+		{
+			template <typename T>
+			static T apply(T a, T b) { return a * b; }
+		};
+
+		struct Divide
+		{
+			template <typename T>
+			static T apply(T a, T b) { return a / b; }
+		};
+
+		/**
+		 * The base of the vector expressions E, which have an eval function
+		 * computing the x, y and z components of the element at an index,
+		 * BATCH if any operand is a batch, and packed() if every batch
+		 * operand has a stride of 1
+		 */
+		template <typename E, typename T>
+		struct Vector3Expression
+		{
+			const E& derived() const { return static_cast<const E&>(*this); }
+
+			/** @brief evaluates a single vector expression */
+			operator Vector3T<T>() const
+			{
+				static_assert(!E::BATCH, "batch expressions are evaluated with evaluate()");
+
+				T x, y, z;
+
+				derived().eval(0, Packed(), x, y, z);
+
+				return Vector3T<T>(x, y, z);
+			}
+		};
+
+		/** @brief the base of the scalar expressions E, which have a value function of the element index */
+		template <typename E, typename T>
+		struct ScalarExpression
+		{
+			const E& derived() const { return static_cast<const E&>(*this); }
+
+			/** @brief evaluates a single scalar expression */
+			operator T() const
+			{
+				static_assert(!E::BATCH, "batch expressions are evaluated with evaluate()");
+
+				return derived().value(0, Packed());
+			}
+		};
+
+		/** @brief the base of the quaternion expressions E, which have an eval function computing x, y, z and w */
+		template <typename E, typename T>
+		struct QuaternionExpression
+		{
+			const E& derived() const { return static_cast<const E&>(*this); }
+
+			/** @brief evaluates a quaternion expression */
+			operator QuaternionT<T>() const
+			{
+				T x, y, z, w;
+
+				derived().eval(x, y, z, w);
+
+				return QuaternionT<T>(x, y, z, w);
+			}
+		};
+
+		/** @brief a vector operand, whose components are copied into the tree */
+		template <typename T>
+		struct Vector3Value : Vector3Expression<Vector3Value<T>, T>
+		{
+			static const bool BATCH = false;
+
+			explicit Vector3Value(const Vector3T<T>& v) : vx(v.x), vy(v.y), vz(v.z) {}
+
+			template <typename L> void eval(size_t, L, T& x, T& y, T& z) const
+			{
+				x = vx;
+				y = vy;
+				z = vz;
+			}
+
+			bool packed() const { return true; }
+
+			T vx, vy, vz;
+		};
+
+		/** @brief the vectors of a view, e.g. of a Vector3Array */
+		struct Vector3Stream : Vector3Expression<Vector3Stream, float>
+		{
+			static const bool BATCH = true;
+
+			explicit Vector3Stream(ConstVector3View view) : view(view) {}
+
+			void eval(size_t i, Packed, float& x, float& y, float& z) const
+			{
+				x = view.x[i];
+				y = view.y[i];
+				z = view.z[i];
+			}
+
+			void eval(size_t i, Strided, float& x, float& y, float& z) const
+			{
+				x = view.x[i * view.stride];
+				y = view.y[i * view.stride];
+				z = view.z[i * view.stride];
+			}
+
+			bool packed() const { return view.stride == 1; }
+
+			ConstVector3View view;
+		};
+
+		template <typename T>
+		struct ScalarValue : ScalarExpression<ScalarValue<T>, T>
+		{
+			static const bool BATCH = false;
+
+			explicit ScalarValue(T v) : v(v) {}
+
+			template <typename L> T value(size_t, L) const { return v; }
+			bool packed() const { return true; }
+
+			T v;
+		};
+
+		/** @brief a stream of scalars, one per element of a batch */
+		template <typename T>
+		struct ScalarStream : ScalarExpression<ScalarStream<T>, T>
+		{
+			static const bool BATCH = true;
+
+			explicit ScalarStream(const T* values) : values(values) {}
+
+			template <typename L> T value(size_t i, L) const { return values[i]; }
+			bool packed() const { return true; }
+
+			const T* values;
+		};
+
+		/** @brief a quaternion operand, whose components are copied like those of a Vector3Value */
+		template <typename T>
+		struct QuaternionValue : QuaternionExpression<QuaternionValue<T>, T>
+		{
+			explicit QuaternionValue(const QuaternionT<T>& q) : qx(q.x), qy(q.y), qz(q.z), qw(q.w) {}
+
+			void eval(T& x, T& y, T& z, T& w) const
+			{
+				x = qx;
+				y = qy;
+				z = qz;
+				w = qw;
+			}
+
+			T qx, qy, qz, qw;
+		};
+
+		/** @brief a component-wise operation on two vectors */
+		template <typename Op, typename A, typename B, typename T>
+		struct Vector3Binary : Vector3Expression<Vector3Binary<Op, A, B, T>, T>
+		{
+			static const bool BATCH = A::BATCH || B::BATCH;
+
+			Vector3Binary(const A& a, const B& b) : a(a), b(b) {}
+
+			template <typename L> void eval(size_t i, L l, T& x, T& y, T& z) const
+			{
+				T ax, ay, az, bx, by, bz;
+
+				a.eval(i, l, ax, ay, az);
+				b.eval(i, l, bx, by, bz);
+
+				x = Op::apply(ax, bx);
+				y = Op::apply(ay, by);
+				z = Op::apply(az, bz);
+			}
+
+			bool packed() const { return a.packed() && b.packed(); }
+
+			A a;
+			B b;
+		};
+
+		/** @brief an operation on each component of a vector and a scalar */
+		template <typename Op, typename A, typename S, typename T>
+		struct Vector3Scalar : Vector3Expression<Vector3Scalar<Op, A, S, T>, T>
+		{
+			static const bool BATCH = A::BATCH || S::BATCH;
+
+			Vector3Scalar(const A& a, const S& s) : a(a), s(s) {}
+
+			template <typename L> void eval(size_t i, L l, T& x, T& y, T& z) const
+			{
+				T n = s.value(i, l);
+				T ax, ay, az;
+
+				a.eval(i, l, ax, ay, az);
+
+				x = Op::apply(ax, n);
+				y = Op::apply(ay, n);
+				z = Op::apply(az, n);
+			}
+
+			bool packed() const { return a.packed() && s.packed(); }
+
+			A a;
+			S s;
+		};
+
+		template <typename A, typename T>
+		struct Vector3Negate : Vector3Expression<Vector3Negate<A, T>, T>
+		{
+			static const bool BATCH = A::BATCH;
+
+			explicit Vector3Negate(const A& a) : a(a) {}
+
+			template <typename L> void eval(size_t i, L l, T& x, T& y, T& z) const
+			{
+				T ax, ay, az;
+
+				a.eval(i, l, ax, ay, az);
+
+				x = -ax;
+				y = -ay;
+				z = -az;
+			}
+
+			bool packed() const { return a.packed(); }
+
+			A a;
+		};
+
+		template <typename A, typename B, typename T>
+		struct Vector3Cross : Vector3Expression<Vector3Cross<A, B, T>, T>
+		{
+			static const bool BATCH = A::BATCH || B::BATCH;
+
+			Vector3Cross(const A& a, const B& b) : a(a), b(b) {}
+
+			template <typename L> void eval(size_t i, L l, T& x, T& y, T& z) const
+			{
+				T ax, ay, az, bx, by, bz;
+
+				a.eval(i, l, ax, ay, az);
+				b.eval(i, l, bx, by, bz);
+
+				x = ay * bz - az * by;
+				y = az * bx - ax * bz;
+				z = ax * by - ay * bx;
+			}
+
+			bool packed() const { return a.packed() && b.packed(); }
+
+			A a;
+			B b;
+		};
+
+		template <typename A, typename B, typename T>
+		struct Vector3Dot : ScalarExpression<Vector3Dot<A, B, T>, T>
+		{
+			static const bool BATCH = A::BATCH || B::BATCH;
+
+			Vector3Dot(const A& a, const B& b) : a(a), b(b) {}
+
+			template <typename L> T value(size_t i, L l) const
+			{
+				T ax, ay, az, bx, by, bz;
+
+				a.eval(i, l, ax, ay, az);
+				b.eval(i, l, bx, by, bz);
+
+				return ax * bx + ay * by + az * bz;
+			}
+
+			bool packed() const { return a.packed() && b.packed(); }
+
+			A a;
+			B b;
+		};
+
+		template <typename Op, typename A, typename B, typename T>
+		struct ScalarBinary : ScalarExpression<ScalarBinary<Op, A, B, T>, T>
+		{
+			static const bool BATCH = A::BATCH || B::BATCH;
+
+			ScalarBinary(const A& a, const B& b) : a(a), b(b) {}
+
+			template <typename L> T value(size_t i, L l) const { return Op::apply(a.value(i, l), b.value(i, l)); }
+			bool packed() const { return a.packed() && b.packed(); }
+
+			A a;
+			B b;
+		};
+
+		template <typename Op, typename A, typename B, typename T>
+		struct QuaternionBinary : QuaternionExpression<QuaternionBinary<Op, A, B, T>, T>
+		{
+			QuaternionBinary(const A& a, const B& b) : a(a), b(b) {}
+
+			void eval(T& x, T& y, T& z, T& w) const
+			{
+				T ax, ay, az, aw, bx, by, bz, bw;
+
+				a.eval(ax, ay, az, aw);
+				b.eval(bx, by, bz, bw);
+
+				x = Op::apply(ax, bx);
+				y = Op::apply(ay, by);
+				z = Op::apply(az, bz);
+				w = Op::apply(aw, bw);
+			}
+
+			A a;
+			B b;
+		};
+
+		template <typename A, typename S, typename T>
+		struct QuaternionScale : QuaternionExpression<QuaternionScale<A, S, T>, T>
+		{
+			QuaternionScale(const A& a, const S& s) : a(a), s(s) {}
+
+			void eval(T& x, T& y, T& z, T& w) const
+			{
+				T n = s.value(0, Packed());
+				T ax, ay, az, aw;
+
+				a.eval(ax, ay, az, aw);
+
+				x = ax * n;
+				y = ay * n;
+				z = az * n;
+				w = aw * n;
+			}
+
+			A a;
+			S s;
+		};
+
+		template <typename A, typename T>
+		struct QuaternionNegate : QuaternionExpression<QuaternionNegate<A, T>, T>
+		{
+			explicit QuaternionNegate(const A& a) : a(a) {}
+
+			void eval(T& x, T& y, T& z, T& w) const
+			{
+				T ax, ay, az, aw;
+
+				a.eval(ax, ay, az, aw);
+
+				x = -ax;
+				y = -ay;
+				z = -az;
+				w = -aw;
+			}
+
+			A a;
+		};
+
+		template <typename A, typename B, typename T>
+		struct QuaternionDot : ScalarExpression<QuaternionDot<A, B, T>, T>
+		{
+			static const bool BATCH = false;
+
+			QuaternionDot(const A& a, const B& b) : a(a), b(b) {}
+
+			template <typename L> T value(size_t, L) const
+			{
+				T ax, ay, az, aw, bx, by, bz, bw;
+
+				a.eval(ax, ay, az, aw);
+				b.eval(bx, by, bz, bw);
+
+				return ax * bx + ay * by + az * bz + aw * bw;
+			}
+
+			bool packed() const { return true; }
+
+			A a;
+			B b;
+		};
+
+		/** @brief makes the operators that use a vector build an expression */
+		template <typename T>
+		inline Vector3Value<T> lazy(const Vector3T<T>& v)
+		{
+			return Vector3Value<T>(v);
+		}
+
+		/** @brief makes the operators that use the vectors of a view build a batch expression */
+		inline Vector3Stream lazy(ConstVector3View view)
+		{
+			return Vector3Stream(view);
+		}
+
+		/** @brief makes the operators that use a stream of scalars build a batch expression */
+		template <typename T>
+		inline ScalarStream<T> lazy(const T* values)
+		{
+			return ScalarStream<T>(values);
+		}
+
+		/** @brief makes the operators that use a quaternion build an expression */
+		template <typename T>
+		inline QuaternionValue<T> lazy(const QuaternionT<T>& q)
+		{
+			return QuaternionValue<T>(q);
+		}
+
+// the operators taking an expression and another expression or a plain value
+#define MATH3D_EXPR_VECTOR3_BINARY(op, Op) \
+		template <typename A, typename B, typename T> \
+		inline Vector3Binary<Op, A, B, T> operator op(const Vector3Expression<A, T>& a, const Vector3Expression<B, T>& b) \
+		{ \
+			return Vector3Binary<Op, A, B, T>(a.derived(), b.derived()); \
+		} \
+		template <typename A, typename T> \
+		inline Vector3Binary<Op, A, Vector3Value<T>, T> operator op(const Vector3Expression<A, T>& a, const Vector3T<T>& b) \
+		{ \
+			return Vector3Binary<Op, A, Vector3Value<T>, T>(a.derived(), Vector3Value<T>(b)); \
+		} \
+		template <typename B, typename T> \
+		inline Vector3Binary<Op, Vector3Value<T>, B, T> operator op(const Vector3T<T>& a, const Vector3Expression<B, T>& b) \
+		{ \
+			return Vector3Binary<Op, Vector3Value<T>, B, T>(Vector3Value<T>(a), b.derived()); \
+		}
+
+#define MATH3D_EXPR_VECTOR3_SCALAR(op, Op) \
+		template <typename A, typename T> \
+		inline Vector3Scalar<Op, A, ScalarValue<T>, T> operator op(const Vector3Expression<A, T>& a, \
+			typename Identity<T>::type s) \
+		{ \
+			return Vector3Scalar<Op, A, ScalarValue<T>, T>(a.derived(), ScalarValue<T>(s)); \
+		} \
+		template <typename A, typename S, typename T> \
+		inline Vector3Scalar<Op, A, S, T> operator op(const Vector3Expression<A, T>& a, const ScalarExpression<S, T>& s) \
+		{ \
+			return Vector3Scalar<Op, A, S, T>(a.derived(), s.derived()); \
+		} \
+		template <typename S, typename T> \
+		inline Vector3Scalar<Op, Vector3Value<T>, S, T> operator op(const Vector3T<T>& a, const ScalarExpression<S, T>& s) \
+		{ \
+			return Vector3Scalar<Op, Vector3Value<T>, S, T>(Vector3Value<T>(a), s.derived()); \
+		}
+
+#define MATH3D_EXPR_SCALAR_BINARY(op, Op) \
+		template <typename A, typename B, typename T> \
+		inline ScalarBinary<Op, A, B, T> operator op(const ScalarExpression<A, T>& a, const ScalarExpression<B, T>& b) \
+		{ \
+			return ScalarBinary<Op, A, B, T>(a.derived(), b.derived()); \
+		} \
+		template <typename A, typename T> \
+		inline ScalarBinary<Op, A, ScalarValue<T>, T> operator op(const ScalarExpression<A, T>& a, \
+			typename Identity<T>::type b) \
+		{ \
+			return ScalarBinary<Op, A, ScalarValue<T>, T>(a.derived(), ScalarValue<T>(b)); \
+		} \
+		template <typename B, typename T> \
+		inline ScalarBinary<Op, ScalarValue<T>, B, T> operator op(typename Identity<T>::type a, \
+			const ScalarExpression<B, T>& b) \
+		{ \
+			return ScalarBinary<Op, ScalarValue<T>, B, T>(ScalarValue<T>(a), b.derived()); \
+		}
+
+#define MATH3D_EXPR_QUATERNION_BINARY(op, Op) \
+		template <typename A, typename B, typename T> \
+		inline QuaternionBinary<Op, A, B, T> operator op(const QuaternionExpression<A, T>& a, \
+			const QuaternionExpression<B, T>& b) \
+		{ \
+			return QuaternionBinary<Op, A, B, T>(a.derived(), b.derived()); \
+		} \
+		template <typename A, typename T> \
+		inline QuaternionBinary<Op, A, QuaternionValue<T>, T> operator op(const QuaternionExpression<A, T>& a, \
+			const QuaternionT<T>& b) \
+		{ \
+			return QuaternionBinary<Op, A, QuaternionValue<T>, T>(a.derived(), QuaternionValue<T>(b)); \
+		} \
+		template <typename B, typename T> \
+		inline QuaternionBinary<Op, QuaternionValue<T>, B, T> operator op(const QuaternionT<T>& a, \
+			const QuaternionExpression<B, T>& b) \
+		{ \
+			return QuaternionBinary<Op, QuaternionValue<T>, B, T>(QuaternionValue<T>(a), b.derived()); \
+		}
+
+		MATH3D_EXPR_VECTOR3_BINARY(+, Add)
+		MATH3D_EXPR_VECTOR3_BINARY(-, Subtract)
+		MATH3D_EXPR_VECTOR3_BINARY(*, Multiply)
+		MATH3D_EXPR_VECTOR3_BINARY(/, Divide)
+
+		MATH3D_EXPR_VECTOR3_SCALAR(+, Add)
+		MATH3D_EXPR_VECTOR3_SCALAR(-, Subtract)
+		MATH3D_EXPR_VECTOR3_SCALAR(*, Multiply)
+		MATH3D_EXPR_VECTOR3_SCALAR(/, Divide)
+
+		MATH3D_EXPR_SCALAR_BINARY(+, Add)
+		MATH3D_EXPR_SCALAR_BINARY(-, Subtract)
+		MATH3D_EXPR_SCALAR_BINARY(*, Multiply)
+		MATH3D_EXPR_SCALAR_BINARY(/, Divide)
+
+		MATH3D_EXPR_QUATERNION_BINARY(+, Add)
+		MATH3D_EXPR_QUATERNION_BINARY(-, Subtract)
+
+#undef MATH3D_EXPR_VECTOR3_BINARY
+#undef MATH3D_EXPR_VECTOR3_SCALAR
+#undef MATH3D_EXPR_SCALAR_BINARY
+#undef MATH3D_EXPR_QUATERNION_BINARY
+
+		/** @brief s * v, which gives the same components as v * s */
+		template <typename A, typename T>
+		inline Vector3Scalar<Multiply, A, ScalarValue<T>, T> operator*(typename Identity<T>::type s,
+			const Vector3Expression<A, T>& a)
+		{
+			return Vector3Scalar<Multiply, A, ScalarValue<T>, T>(a.derived(), ScalarValue<T>(s));
+		}
+
+		template <typename A, typename S, typename T>
+		inline Vector3Scalar<Multiply, A, S, T> operator*(const ScalarExpression<S, T>& s, const Vector3Expression<A, T>& a)
+		{
+			return Vector3Scalar<Multiply, A, S, T>(a.derived(), s.derived());
+		}
+
+		template <typename S, typename T>
+		inline Vector3Scalar<Multiply, Vector3Value<T>, S, T> operator*(const ScalarExpression<S, T>& s,
+			const Vector3T<T>& a)
+		{
+			return Vector3Scalar<Multiply, Vector3Value<T>, S, T>(Vector3Value<T>(a), s.derived());
+		}
+
+		template <typename A, typename T>
+		inline Vector3Negate<A, T> operator-(const Vector3Expression<A, T>& a)
+		{
+			return Vector3Negate<A, T>(a.derived());
+		}
+
+		template <typename A, typename B, typename T>
+		inline Vector3Dot<A, B, T> dot(const Vector3Expression<A, T>& a, const Vector3Expression<B, T>& b)
+		{
+			return Vector3Dot<A, B, T>(a.derived(), b.derived());
+		}
+
+		template <typename A, typename T>
+		inline Vector3Dot<A, Vector3Value<T>, T> dot(const Vector3Expression<A, T>& a, const Vector3T<T>& b)
+		{
+			return Vector3Dot<A, Vector3Value<T>, T>(a.derived(), Vector3Value<T>(b));
+		}
+
+		template <typename B, typename T>
+		inline Vector3Dot<Vector3Value<T>, B, T> dot(const Vector3T<T>& a, const Vector3Expression<B, T>& b)
+		{
+			return Vector3Dot<Vector3Value<T>, B, T>(Vector3Value<T>(a), b.derived());
+		}
+
+		template <typename A, typename B, typename T>
+		inline Vector3Cross<A, B, T> cross(const Vector3Expression<A, T>& a, const Vector3Expression<B, T>& b)
+		{
+			return Vector3Cross<A, B, T>(a.derived(), b.derived());
+		}
+
+		template <typename A, typename T>
+		inline Vector3Cross<A, Vector3Value<T>, T> cross(const Vector3Expression<A, T>& a, const Vector3T<T>& b)
+		{
+			return Vector3Cross<A, Vector3Value<T>, T>(a.derived(), Vector3Value<T>(b));
+		}
+
+		template <typename B, typename T>
+		inline Vector3Cross<Vector3Value<T>, B, T> cross(const Vector3T<T>& a, const Vector3Expression<B, T>& b)
+		{
+			return Vector3Cross<Vector3Value<T>, B, T>(Vector3Value<T>(a), b.derived());
+		}
+
+		template <typename A, typename T>
+		inline QuaternionScale<A, ScalarValue<T>, T> operator*(const QuaternionExpression<A, T>& a,
+			typename Identity<T>::type s)
+		{
+			return QuaternionScale<A, ScalarValue<T>, T>(a.derived(), ScalarValue<T>(s));
+		}
+
+		template <typename A, typename S, typename T>
+		inline QuaternionScale<A, S, T> operator*(const QuaternionExpression<A, T>& a, const ScalarExpression<S, T>& s)
+		{
+			static_assert(!S::BATCH, "quaternion expressions have no batch form");
+
+			return QuaternionScale<A, S, T>(a.derived(), s.derived());
+		}
+
+		template <typename A, typename T>
+		inline QuaternionNegate<A, T> operator-(const QuaternionExpression<A, T>& a)
+		{
+			return QuaternionNegate<A, T>(a.derived());
+		}
+
+		template <typename A, typename B, typename T>
+		inline QuaternionDot<A, B, T> dot(const QuaternionExpression<A, T>& a, const QuaternionExpression<B, T>& b)
+		{
+			return QuaternionDot<A, B, T>(a.derived(), b.derived());
+		}
+
+		template <typename A, typename T>
+		inline QuaternionDot<A, QuaternionValue<T>, T> dot(const QuaternionExpression<A, T>& a, const QuaternionT<T>& b)
+		{
+			return QuaternionDot<A, QuaternionValue<T>, T>(a.derived(), QuaternionValue<T>(b));
+		}
+
+		/** @brief evaluates a single vector expression into the components of out */
+		template <typename E, typename T>
+		inline void evaluate(const Vector3Expression<E, T>& expression, Vector3T<T>& out)
+		{
+			static_assert(!E::BATCH, "batch expressions are evaluated into a Vector3View");
+
+			T x, y, z;
+
+			expression.derived().eval(0, Packed(), x, y, z);
+
+			out.x = x;
+			out.y = y;
+			out.z = z;
+		}
+
+		/** @brief evaluates a quaternion expression into the components of out */
+		template <typename E, typename T>
+		inline void evaluate(const QuaternionExpression<E, T>& expression, QuaternionT<T>& out)
+		{
+			T x, y, z, w;
+
+			expression.derived().eval(x, y, z, w);
+
+			out.x = x;
+			out.y = y;
+			out.z = z;
+			out.w = w;
+		}
+
+		/** @brief computes every element of a batch vector expression, storing them at the given stride */
+		template <typename E, typename L>
+		inline void evaluateRange(const E& e, const Vector3View& out, size_t stride, L l)
+		{
+			for (size_t i = 0; i < out.count; i++)
+			{
+				// all of the components are computed before any is stored, so that
+				// the output may be one of the inputs
+				float x, y, z;
+
+				e.eval(i, l, x, y, z);
+
+				out.x[i * stride] = x;
+				out.y[i * stride] = y;
+				out.z[i * stride] = z;
+			}
+		}
+
+		/**
+		 * Computes a batch vector expression for every element of out in a
+		 * single pass
+		 *
+		 * Note: every lazy view and stream in the expression must hold at
+		 * least out.count elements
+		 *
+		 * @param expression the expression, e.g. lazy(a) * 0.5f + cross(lazy(a), lazy(b))
+		 * @param out receives the vectors; may be one of the views in the expression
+		 */
+		template <typename E>
+		inline void evaluate(const Vector3Expression<E, float>& expression, Vector3View out)
+		{
+			const E& e = expression.derived();
+
+			if (e.packed() && out.stride == 1)
+			{
+				evaluateRange(e, out, 1, Packed());
+			}
+			else
+			{
+				evaluateRange(e, out, out.stride, Strided());
+			}
+		}
+
+		/**
+		 * Computes a batch scalar expression, e.g. a dot product of two
+		 * lazy views, for count elements in a single pass
+		 */
+		template <typename E>
+		inline void evaluate(const ScalarExpression<E, float>& expression, float* out, size_t count)
+		{
+			const E& e = expression.derived();
+
+			if (e.packed())
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					out[i] = e.value(i, Packed());
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					out[i] = e.value(i, Strided());
+				}
+			}
+		}
+	}
+}
+
+#endif
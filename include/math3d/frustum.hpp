@@ -0,0 +1,124 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include "matrix4x4.hpp"
+#include "vector3array.hpp"
+#include "aabb.hpp"
+#include "sphere.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/** @brief the planes bounding a Frustum */
+enum class FrustumPlane
+{
+	Left,
+	Right,
+	Bottom,
+	Top,
+	Near,
+	Far
+};
+
+/**
+ * The volume seen by a camera, bounded by six planes whose normals point
+ * inwards, for culling objects that cannot be visible
+ *
+ * The planes are extracted from a view-projection matrix (e.g. a
+ * Matrix4x4::perspective multiplied by the inverse of the camera's
+ * transformation), whose clip space is -w <= x, y, z <= w as produced by
+ * Matrix4x4::perspective. They are normalized, so that plane distances
+ * are in world units.
+ *
+ * The culling tests are conservative: a sphere or box is only culled when
+ * it lies entirely behind one of the planes, so a few objects near the
+ * corners of the frustum are kept even though they are outside of it.
+ */
+class Frustum
+{
+	public:
+		/** @brief the number of planes, one for each FrustumPlane */
+		static const int PLANE_COUNT = 6;
+
+		/**
+		 * Extracts the planes of a view-projection matrix
+		 *
+		 * @param viewProjection the matrix transforming world space points to clip space
+		 */
+		explicit Frustum(const Matrix4x4& viewProjection);
+
+		/** @brief gets the unit normal of a plane, pointing into the frustum */
+		Vector3 getNormal(FrustumPlane plane) const;
+		/** @brief gets the distance d of a plane, which contains the points p where normal.dot(p) + d = 0 */
+		float getDistance(FrustumPlane plane) const;
+
+		/** @brief tests whether a point is inside of the frustum or on its boundary */
+		bool containsPoint(const Vector3& point) const;
+		/** @brief tests whether a sphere may be visible, i.e. is not entirely behind any plane */
+		bool intersectsSphere(const Vector3& center, float radius) const;
+		/**
+		 * Tests whether an axis-aligned box may be visible, i.e. is not
+		 * entirely behind any plane
+		 *
+		 * @param center the center of the box
+		 * @param extents half of the size of the box along each axis
+		 */
+		bool intersectsBox(const Vector3& center, const Vector3& extents) const;
+		/** @brief tests whether a box may be visible, see intersectsBox */
+		bool intersects(const AABB& box) const;
+		/** @brief tests whether a sphere may be visible, see intersectsSphere */
+		bool intersects(const Sphere& sphere) const;
+
+		/**
+		 * Culls a batch of spheres, testing a SIMD register of spheres
+		 * against each plane at a time
+		 *
+		 * Note: radii must hold centers.count radii, and visible must have
+		 * room for centers.count indices, even if fewer are visible
+		 *
+		 * @param centers the centers of the spheres, e.g. a Vector3Array
+		 * @param radii the radius of each sphere
+		 * @param visible receives the indices of the spheres that may be
+		 * visible, in increasing order
+		 * @return the number of indices written to visible
+		 */
+		size_t cullSpheres(ConstVector3View centers, const float* radii, uint32_t* visible) const;
+		/**
+		 * Culls a batch of axis-aligned boxes like cullSpheres
+		 *
+		 * Note: extents must hold as many vectors as centers, and visible
+		 * must have room for centers.count indices
+		 *
+		 * @param centers the centers of the boxes
+		 * @param extents half of the size of each box along each axis
+		 * @param visible receives the indices of the boxes that may be
+		 * visible, in increasing order
+		 * @return the number of indices written to visible
+		 */
+		size_t cullBoxes(ConstVector3View centers, ConstVector3View extents, uint32_t* visible) const;
+		/**
+		 * Culls an array of spheres like cullSpheres, converting them to
+		 * streams a block at a time
+		 *
+		 * Note: visible must have room for count indices
+		 */
+		size_t cullSpheres(const Sphere* spheres, size_t count, uint32_t* visible) const;
+		/**
+		 * Culls an array of boxes like cullBoxes, converting them to
+		 * centers and extents a block at a time
+		 *
+		 * Note: the boxes must not be empty, and visible must have room
+		 * for count indices
+		 */
+		size_t cullBoxes(const AABB* boxes, size_t count, uint32_t* visible) const;
+	private:
+		// (a, b, c, d) of each plane, with the points inside where a x + b y + c z + d >= 0
+		alignas(16) float planes[PLANE_COUNT][4];
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "frustum.inl"
+#endif
+
+#endif
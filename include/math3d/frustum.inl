@@ -0,0 +1,174 @@
+#ifndef FRUSTUM_INL
+#define FRUSTUM_INL
+
+#include "config.hpp"
+#include "frustum.hpp"
+#include "kernels/table.hpp"
+#include "streams.hpp"
+
+/** @brief the number of spheres or boxes converted to streams at a time */
+static const size_t CULL_BLOCK_SIZE = 256;
+
+MATH3D_INLINE Frustum::Frustum(const Matrix4x4& viewProjection)
+{
+	const Matrix4x4& m = viewProjection;
+
+	// a point is inside when -w <= x, y, z <= w, where w is the dot product
+	// of row 3 and the point and x, y, z those of rows 0, 1, 2, so each
+	// plane is row 3 plus or minus one of the other rows (Gribb & Hartmann)
+	for (int p = 0; p < PLANE_COUNT; p++)
+	{
+		int row = p / 2;
+		float sign = p % 2 == 0 ? 1.0f : -1.0f;
+
+		for (int i = 0; i < 4; i++)
+		{
+			planes[p][i] = m[3][i] + sign * m[row][i];
+		}
+
+		float length = std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+
+		// degenerate planes, e.g. the far plane of an infinite projection, are left as they are
+		if (length > 0)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				planes[p][i] /= length;
+			}
+		}
+	}
+}
+
+MATH3D_INLINE Vector3 Frustum::getNormal(FrustumPlane plane) const
+{
+	const float* p = planes[(int)plane];
+
+	return Vector3(p[0], p[1], p[2]);
+}
+
+MATH3D_INLINE float Frustum::getDistance(FrustumPlane plane) const
+{
+	return planes[(int)plane][3];
+}
+
+MATH3D_INLINE bool Frustum::containsPoint(const Vector3& point) const
+{
+	return intersectsSphere(point, 0);
+}
+
+MATH3D_INLINE bool Frustum::intersectsSphere(const Vector3& center, float radius) const
+{
+	uint32_t index;
+
+	return math3d::detail::frustumCullSpheresScalar(&index, &planes[0][0], &center.x, &center.y, &center.z,
+		&radius, 0, 1) == 1;
+}
+
+MATH3D_INLINE bool Frustum::intersectsBox(const Vector3& center, const Vector3& extents) const
+{
+	uint32_t index;
+
+	return math3d::detail::frustumCullBoxesScalar(&index, &planes[0][0], &center.x, &center.y, &center.z,
+		&extents.x, &extents.y, &extents.z, 0, 1) == 1;
+}
+
+MATH3D_INLINE bool Frustum::intersects(const AABB& box) const
+{
+	return intersectsBox(box.getCenter(), box.getExtents());
+}
+
+MATH3D_INLINE bool Frustum::intersects(const Sphere& sphere) const
+{
+	return intersectsSphere(sphere.center, sphere.radius);
+}
+
+MATH3D_INLINE size_t Frustum::cullSpheres(ConstVector3View centers, const float* radii, uint32_t* visible) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	const float* p = &planes[0][0];
+	size_t count = 0;
+
+	math3d::detail::forEachBlock(centers, centers, nullptr, [&k, &count, p, radii, visible](
+		const math3d::detail::Vector3Streams& sc, const math3d::detail::Vector3Streams&,
+		const math3d::detail::Vector3Streams&, size_t start, size_t n)
+	{
+		count += k.frustumCullSpheres(visible + count, p, sc.x, sc.y, sc.z, radii + start, (uint32_t)start, n);
+	});
+
+	return count;
+}
+
+MATH3D_INLINE size_t Frustum::cullBoxes(ConstVector3View centers, ConstVector3View extents, uint32_t* visible) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	const float* p = &planes[0][0];
+	size_t count = 0;
+
+	math3d::detail::forEachBlock(centers, extents, nullptr, [&k, &count, p, visible](
+		const math3d::detail::Vector3Streams& sc, const math3d::detail::Vector3Streams& se,
+		const math3d::detail::Vector3Streams&, size_t start, size_t n)
+	{
+		count += k.frustumCullBoxes(visible + count, p, sc.x, sc.y, sc.z, se.x, se.y, se.z, (uint32_t)start, n);
+	});
+
+	return count;
+}
+
+MATH3D_INLINE size_t Frustum::cullSpheres(const Sphere* spheres, size_t count, uint32_t* visible) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	alignas(math3d::detail::BATCH_ALIGNMENT) float streams[4][CULL_BLOCK_SIZE];
+	size_t visibleCount = 0;
+
+	for (size_t start = 0; start < count; start += CULL_BLOCK_SIZE)
+	{
+		size_t n = count - start < CULL_BLOCK_SIZE ? count - start : CULL_BLOCK_SIZE;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const Sphere& s = spheres[start + i];
+
+			streams[0][i] = s.center.x;
+			streams[1][i] = s.center.y;
+			streams[2][i] = s.center.z;
+			streams[3][i] = s.radius;
+		}
+
+		visibleCount += k.frustumCullSpheres(visible + visibleCount, &planes[0][0],
+			streams[0], streams[1], streams[2], streams[3], (uint32_t)start, n);
+	}
+
+	return visibleCount;
+}
+
+MATH3D_INLINE size_t Frustum::cullBoxes(const AABB* boxes, size_t count, uint32_t* visible) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	alignas(math3d::detail::BATCH_ALIGNMENT) float streams[6][CULL_BLOCK_SIZE];
+	size_t visibleCount = 0;
+
+	for (size_t start = 0; start < count; start += CULL_BLOCK_SIZE)
+	{
+		size_t n = count - start < CULL_BLOCK_SIZE ? count - start : CULL_BLOCK_SIZE;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			Vector3 center = boxes[start + i].getCenter();
+			Vector3 extents = boxes[start + i].getExtents();
+
+			streams[0][i] = center.x;
+			streams[1][i] = center.y;
+			streams[2][i] = center.z;
+			streams[3][i] = extents.x;
+			streams[4][i] = extents.y;
+			streams[5][i] = extents.z;
+		}
+
+		visibleCount += k.frustumCullBoxes(visible + visibleCount, &planes[0][0],
+			streams[0], streams[1], streams[2], streams[3], streams[4], streams[5], (uint32_t)start, n);
+	}
+
+	return visibleCount;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef FWD_HPP
+#define FWD_HPP
+
+/**
+ * Forward declarations of the class templates, which are parameterized on
+ * their scalar type, and the names of their float and double versions
+ *
+ * The library instantiates every template for float and double. Any other
+ * scalar type can be used by including the matching .inl files (or by
+ * defining MATH3D_HEADER_ONLY); its operations always use the scalar
+ * kernels, since the SIMD kernels only process floats.
+ */
+template <typename T> class Vector2T;
+template <typename T> class Vector3T;
+template <typename T> class Vector3AT;
+template <typename T> class Vector4T;
+template <typename T> class QuaternionT;
+template <typename T> class Matrix4x4T;
+template <typename T> class Affine3x4T;
+template <typename T> class TransformT;
+template <typename T> class DualQuaternionT;
+template <typename T> class AABBT;
+template <typename T> class SphereT;
+template <typename T> class RayT;
+template <typename T> struct RayHitT;
+
+typedef Vector2T<float> Vector2;
+typedef Vector3T<float> Vector3;
+typedef Vector3AT<float> Vector3A;
+typedef Vector4T<float> Vector4;
+typedef QuaternionT<float> Quaternion;
+typedef Matrix4x4T<float> Matrix4x4;
+typedef Affine3x4T<float> Affine3x4;
+typedef TransformT<float> Transform;
+typedef DualQuaternionT<float> DualQuaternion;
+typedef AABBT<float> AABB;
+typedef SphereT<float> Sphere;
+typedef RayT<float> Ray;
+typedef RayHitT<float> RayHit;
+
+typedef Vector2T<double> Vector2d;
+typedef Vector3T<double> Vector3d;
+typedef Vector3AT<double> Vector3Ad;
+typedef Vector4T<double> Vector4d;
+typedef QuaternionT<double> Quaterniond;
+typedef Matrix4x4T<double> Matrix4x4d;
+typedef Affine3x4T<double> Affine3x4d;
+typedef TransformT<double> Transformd;
+typedef DualQuaternionT<double> DualQuaterniond;
+typedef AABBT<double> AABBd;
+typedef SphereT<double> Sphered;
+typedef RayT<double> Rayd;
+typedef RayHitT<double> RayHitd;
+
+#endif
@@ -0,0 +1,770 @@
+#ifndef KERNELS_AVX_HPP
+#define KERNELS_AVX_HPP
+
+#include <immintrin.h>
+#include "scalar.hpp"
+#include "sse.hpp"
+
+/**
+ * AVX versions of the kernels in kernels/scalar.hpp, producing
+ * bit-identical results
+ */
+namespace math3d
+{
+	namespace detail
+	{
+		/** @brief out = a * b for two 4x4 matrices, two output rows per iteration */
+		static inline void mat4MulAVX(float* out, const float* a, const float* b)
+		{
+			__m256 b0 = _mm256_broadcast_ps((const __m128*)(b + 0));
+			__m256 b1 = _mm256_broadcast_ps((const __m128*)(b + 4));
+			__m256 b2 = _mm256_broadcast_ps((const __m128*)(b + 8));
+			__m256 b3 = _mm256_broadcast_ps((const __m128*)(b + 12));
+
+			for (int y = 0; y < 4; y += 2)
+			{
+				// two 128-bit loads forward from the stores of a previous result
+				__m256 rows = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a + y * 4)),
+					_mm_loadu_ps(a + y * 4 + 4), 1);
+
+				__m256 r = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+				r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+				r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+				r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+
+				_mm256_storeu_ps(out + y * 4, r);
+			}
+		}
+
+		/** @brief out[i] = a[i] + b[i] for n floats, 8 at a time */
+		static inline void streamAddAVX(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] - b[i] for n floats, 8 at a time */
+		static inline void streamSubAVX(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] - b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * b[i] for n floats, 8 at a time */
+		static inline void streamMulAVX(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * s for n floats, 8 at a time */
+		static inline void streamScaleAVX(float* out, const float* a, float s, size_t n)
+		{
+			__m256 vs = _mm256_set1_ps(s);
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), vs));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] * s;
+			}
+		}
+
+		/** @brief out[i] = a[i] + (b[i] - a[i]) * t[i] for n floats, 8 at a time */
+		static inline void streamLerpAVX(float* out, const float* a, const float* b, const float* t, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 va = _mm256_loadu_ps(a + i);
+
+				_mm256_storeu_ps(out + i, _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b + i), va), _mm256_loadu_ps(t + i))));
+			}
+
+			streamLerpScalar(out + i, a + i, b + i, t + i, n - i);
+		}
+
+		/** @brief out[i] = dot(a[i], b[i]) for n SoA vectors, 8 at a time */
+		static inline void vec3DotAVX(float* out, const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 d = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i)));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(az + i), _mm256_loadu_ps(bz + i)));
+
+				_mm256_storeu_ps(out + i, d);
+			}
+
+			vec3DotScalar(out + i, ax + i, ay + i, az + i, bx + i, by + i, bz + i, n - i);
+		}
+
+		/** @brief o[i] = cross(a[i], b[i]) for n SoA vectors, 8 at a time; o may alias a or b */
+		static inline void vec3CrossAVX(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x1 = _mm256_loadu_ps(ax + i), y1 = _mm256_loadu_ps(ay + i), z1 = _mm256_loadu_ps(az + i);
+				__m256 x2 = _mm256_loadu_ps(bx + i), y2 = _mm256_loadu_ps(by + i), z2 = _mm256_loadu_ps(bz + i);
+
+				_mm256_storeu_ps(ox + i, _mm256_sub_ps(_mm256_mul_ps(y1, z2), _mm256_mul_ps(z1, y2)));
+				_mm256_storeu_ps(oy + i, _mm256_sub_ps(_mm256_mul_ps(z1, x2), _mm256_mul_ps(x1, z2)));
+				_mm256_storeu_ps(oz + i, _mm256_sub_ps(_mm256_mul_ps(x1, y2), _mm256_mul_ps(y1, x2)));
+			}
+
+			vec3CrossScalar(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, bx + i, by + i, bz + i, n - i);
+		}
+
+		/** @brief out[i] = magSq(a[i]) for n SoA vectors, 8 at a time */
+		static inline void vec3MagSqAVX(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+				__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+
+				_mm256_storeu_ps(out + i, sq);
+			}
+
+			vec3MagSqScalar(out + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief out[i] = magnitude(a[i]) for n SoA vectors, 8 at a time */
+		static inline void vec3MagnitudeAVX(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+				__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+
+				_mm256_storeu_ps(out + i, _mm256_sqrt_ps(sq));
+			}
+
+			vec3MagnitudeScalar(out + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = normalize(a[i]) for n SoA vectors, 8 at a time; o may alias a */
+		static inline void vec3NormalizeAVX(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+				__m256 mag = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+
+				_mm256_storeu_ps(ox + i, _mm256_div_ps(x, mag));
+				_mm256_storeu_ps(oy + i, _mm256_div_ps(y, mag));
+				_mm256_storeu_ps(oz + i, _mm256_div_ps(z, mag));
+			}
+
+			vec3NormalizeScalar(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief vec3NormalizeFastSSE for n SoA vectors, 8 at a time */
+		static inline void vec3NormalizeFastAVX(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 threeHalves = _mm256_set1_ps(1.5f);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+				__m256 magSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+				__m256 r = _mm256_rsqrt_ps(magSq);
+				__m256 invMag = _mm256_mul_ps(r, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(half, magSq), r), r)));
+
+				_mm256_storeu_ps(ox + i, _mm256_mul_ps(x, invMag));
+				_mm256_storeu_ps(oy + i, _mm256_mul_ps(y, invMag));
+				_mm256_storeu_ps(oz + i, _mm256_mul_ps(z, invMag));
+			}
+
+			vec3NormalizeFastSSE(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 1) for n SoA points, 8 at a time; o may alias a */
+		static inline void mat4TransformPointsAVX(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m256 m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[1]), m02 = _mm256_set1_ps(m[2]), m03 = _mm256_set1_ps(m[3]);
+			__m256 m10 = _mm256_set1_ps(m[4]), m11 = _mm256_set1_ps(m[5]), m12 = _mm256_set1_ps(m[6]), m13 = _mm256_set1_ps(m[7]);
+			__m256 m20 = _mm256_set1_ps(m[8]), m21 = _mm256_set1_ps(m[9]), m22 = _mm256_set1_ps(m[10]), m23 = _mm256_set1_ps(m[11]);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+
+				_mm256_storeu_ps(ox + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z)), m03));
+				_mm256_storeu_ps(oy + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z)), m13));
+				_mm256_storeu_ps(oz + i, _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z)), m23));
+			}
+
+			mat4TransformPointsScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 0) for n SoA directions, 8 at a time; o may alias a */
+		static inline void mat4TransformDirectionsAVX(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m256 m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[1]), m02 = _mm256_set1_ps(m[2]);
+			__m256 m10 = _mm256_set1_ps(m[4]), m11 = _mm256_set1_ps(m[5]), m12 = _mm256_set1_ps(m[6]);
+			__m256 m20 = _mm256_set1_ps(m[8]), m21 = _mm256_set1_ps(m[9]), m22 = _mm256_set1_ps(m[10]);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+
+				_mm256_storeu_ps(ox + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z)));
+				_mm256_storeu_ps(oy + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z)));
+				_mm256_storeu_ps(oz + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z)));
+			}
+
+			mat4TransformDirectionsScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 1) divided by w for n SoA points, 8 at a time; o may alias a */
+		static inline void mat4TransformHomogeneousAVX(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m256 m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[1]), m02 = _mm256_set1_ps(m[2]), m03 = _mm256_set1_ps(m[3]);
+			__m256 m10 = _mm256_set1_ps(m[4]), m11 = _mm256_set1_ps(m[5]), m12 = _mm256_set1_ps(m[6]), m13 = _mm256_set1_ps(m[7]);
+			__m256 m20 = _mm256_set1_ps(m[8]), m21 = _mm256_set1_ps(m[9]), m22 = _mm256_set1_ps(m[10]), m23 = _mm256_set1_ps(m[11]);
+			__m256 m30 = _mm256_set1_ps(m[12]), m31 = _mm256_set1_ps(m[13]), m32 = _mm256_set1_ps(m[14]), m33 = _mm256_set1_ps(m[15]);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+				__m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m30, x), _mm256_mul_ps(m31, y)), _mm256_mul_ps(m32, z)), m33);
+
+				_mm256_storeu_ps(ox + i, _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z)), m03), w));
+				_mm256_storeu_ps(oy + i, _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z)), m13), w));
+				_mm256_storeu_ps(oz + i, _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z)), m23), w));
+			}
+
+			mat4TransformHomogeneousScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatRotateScalar for 8 vectors and quaternions at a time */
+		static inline void quatRotateAVX(__m256& x, __m256& y, __m256& z, __m256 qx, __m256 qy, __m256 qz, __m256 qw)
+		{
+			__m256 two = _mm256_set1_ps(2.0f);
+			__m256 tx = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y)), two);
+			__m256 ty = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z)), two);
+			__m256 tz = _mm256_mul_ps(_mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x)), two);
+
+			x = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(tx, qw)), _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+			y = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(ty, qw)), _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+			z = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(tz, qw)), _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q) for n SoA vectors, 8 at a time; o may alias a */
+		static inline void quatRotateVectorsAVX(float* ox, float* oy, float* oz, const float* q,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m256 qx = _mm256_set1_ps(q[0]), qy = _mm256_set1_ps(q[1]), qz = _mm256_set1_ps(q[2]), qw = _mm256_set1_ps(q[3]);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+
+				quatRotateAVX(x, y, z, qx, qy, qz, qw);
+
+				_mm256_storeu_ps(ox + i, x);
+				_mm256_storeu_ps(oy + i, y);
+				_mm256_storeu_ps(oz + i, z);
+			}
+
+			quatRotateVectorsScalar(ox + i, oy + i, oz + i, q, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q[i]) for n SoA vectors and quaternions, 8 at a time; o may alias a */
+		static inline void quatsRotateVectorsAVX(float* ox, float* oy, float* oz,
+			const float* qx, const float* qy, const float* qz, const float* qw,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(ax + i), y = _mm256_loadu_ps(ay + i), z = _mm256_loadu_ps(az + i);
+
+				quatRotateAVX(x, y, z, _mm256_loadu_ps(qx + i), _mm256_loadu_ps(qy + i), _mm256_loadu_ps(qz + i), _mm256_loadu_ps(qw + i));
+
+				_mm256_storeu_ps(ox + i, x);
+				_mm256_storeu_ps(oy + i, y);
+				_mm256_storeu_ps(oz + i, z);
+			}
+
+			quatsRotateVectorsScalar(ox + i, oy + i, oz + i, qx + i, qy + i, qz + i, qw + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatNlerpScalar for n SoA quaternions, 8 at a time; o may alias a or b */
+		static inline void quatNlerpAVX(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, const float* aw,
+			const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x1 = _mm256_loadu_ps(ax + i), y1 = _mm256_loadu_ps(ay + i), z1 = _mm256_loadu_ps(az + i), w1 = _mm256_loadu_ps(aw + i);
+				__m256 x2 = _mm256_loadu_ps(bx + i), y2 = _mm256_loadu_ps(by + i), z2 = _mm256_loadu_ps(bz + i), w2 = _mm256_loadu_ps(bw + i);
+				__m256 vt = _mm256_loadu_ps(t + i);
+
+				__m256 cs = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x1, x2), _mm256_mul_ps(y1, y2)), _mm256_mul_ps(z1, z2)), _mm256_mul_ps(w1, w2));
+				__m256 flip = _mm256_and_ps(_mm256_cmp_ps(cs, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+
+				x2 = _mm256_xor_ps(x2, flip);
+				y2 = _mm256_xor_ps(y2, flip);
+				z2 = _mm256_xor_ps(z2, flip);
+				w2 = _mm256_xor_ps(w2, flip);
+
+				__m256 x = _mm256_add_ps(x1, _mm256_mul_ps(_mm256_sub_ps(x2, x1), vt));
+				__m256 y = _mm256_add_ps(y1, _mm256_mul_ps(_mm256_sub_ps(y2, y1), vt));
+				__m256 z = _mm256_add_ps(z1, _mm256_mul_ps(_mm256_sub_ps(z2, z1), vt));
+				__m256 w = _mm256_add_ps(w1, _mm256_mul_ps(_mm256_sub_ps(w2, w1), vt));
+				__m256 mag = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)), _mm256_mul_ps(w, w)));
+
+				_mm256_storeu_ps(ox + i, _mm256_div_ps(x, mag));
+				_mm256_storeu_ps(oy + i, _mm256_div_ps(y, mag));
+				_mm256_storeu_ps(oz + i, _mm256_div_ps(z, mag));
+				_mm256_storeu_ps(ow + i, _mm256_div_ps(w, mag));
+			}
+
+			quatNlerpScalar(ox + i, oy + i, oz + i, ow + i, ax + i, ay + i, az + i, aw + i,
+				bx + i, by + i, bz + i, bw + i, t + i, n - i);
+		}
+		/** @brief whether each lane of v, a non-negative whole number below 2^24, is odd */
+		static inline __m256 isOddAVX(__m256 v)
+		{
+			__m256 half = _mm256_round_ps(_mm256_mul_ps(v, _mm256_set1_ps(0.5f)), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+
+			return _mm256_cmp_ps(_mm256_sub_ps(v, _mm256_add_ps(half, half)), _mm256_set1_ps(1.0f), _CMP_EQ_OQ);
+		}
+
+		/**
+		 * sincosScalar for 8 floats. AVX has no 256-bit integer arithmetic,
+		 * so the octant is kept as a whole float and its bits are tested
+		 * with isOddAVX, which is exact in the supported range.
+		 */
+		static inline void sincosAVX(__m256 a, __m256& s, __m256& c)
+		{
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 one = _mm256_set1_ps(1.0f);
+
+			__m256 x = _mm256_andnot_ps(signBit, a);
+			__m256 y = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(TRIG_4_OVER_PI)), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+			y = _mm256_add_ps(y, _mm256_and_ps(isOddAVX(y), one));
+
+			x = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(TRIG_PI_4_A))),
+				_mm256_mul_ps(y, _mm256_set1_ps(TRIG_PI_4_B))), _mm256_mul_ps(y, _mm256_set1_ps(TRIG_PI_4_C)));
+
+			__m256 z = _mm256_mul_ps(x, x);
+			__m256 sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(TRIG_SIN_0), z), _mm256_set1_ps(TRIG_SIN_1)), z), _mm256_set1_ps(TRIG_SIN_2)), z), x), x);
+			__m256 cosPoly = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(TRIG_COS_0), z), _mm256_set1_ps(TRIG_COS_1)), z), _mm256_set1_ps(TRIG_COS_2)), z), z),
+				_mm256_mul_ps(half, z)), one);
+
+			// with q = j / 2, j & 2 is bit 0 of q, j & 4 is bit 1 of q, and (j + 2) & 4 is bit 1 of q + 1
+			__m256 q = _mm256_mul_ps(y, half);
+			__m256 swap = isOddAVX(q);
+			__m256 sinNegative = _mm256_xor_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_LT_OQ),
+				isOddAVX(_mm256_round_ps(_mm256_mul_ps(q, half), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)));
+			__m256 cosNegative = isOddAVX(_mm256_round_ps(_mm256_mul_ps(_mm256_add_ps(q, one), half),
+				_MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+
+			s = _mm256_xor_ps(_mm256_blendv_ps(sinPoly, cosPoly, swap), _mm256_and_ps(sinNegative, signBit));
+			c = _mm256_xor_ps(_mm256_blendv_ps(cosPoly, sinPoly, swap), _mm256_and_ps(cosNegative, signBit));
+		}
+
+		/** @brief atanScalar for 8 floats */
+		static inline __m256 atanAVX(__m256 a)
+		{
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+			const __m256 one = _mm256_set1_ps(1.0f);
+
+			__m256 x = _mm256_andnot_ps(signBit, a);
+			__m256 large = _mm256_cmp_ps(x, _mm256_set1_ps(TRIG_TAN_3PI_8), _CMP_GT_OQ);
+			__m256 medium = _mm256_cmp_ps(x, _mm256_set1_ps(TRIG_TAN_PI_8), _CMP_GT_OQ);
+
+			__m256 num = _mm256_blendv_ps(_mm256_blendv_ps(x, _mm256_sub_ps(x, one), medium), _mm256_set1_ps(-1.0f), large);
+			__m256 den = _mm256_blendv_ps(_mm256_blendv_ps(one, _mm256_add_ps(x, one), medium), x, large);
+			__m256 offset = _mm256_blendv_ps(_mm256_and_ps(medium, _mm256_set1_ps(TRIG_PI_4)), _mm256_set1_ps(TRIG_PI_2), large);
+
+			x = _mm256_div_ps(num, den);
+
+			__m256 z = _mm256_mul_ps(x, x);
+			__m256 poly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(TRIG_ATAN_0), z), _mm256_set1_ps(TRIG_ATAN_1)), z), _mm256_set1_ps(TRIG_ATAN_2)), z),
+				_mm256_set1_ps(TRIG_ATAN_3)), z), x), x);
+			__m256 r = _mm256_add_ps(offset, poly);
+
+			return _mm256_xor_ps(r, _mm256_and_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_LT_OQ), signBit));
+		}
+
+		/** @brief atan2Scalar for 8 pairs of floats */
+		static inline __m256 atan2AVX(__m256 y, __m256 x)
+		{
+			const __m256 zero = _mm256_setzero_ps();
+
+			__m256 pi = _mm256_xor_ps(_mm256_set1_ps(TRIG_PI), _mm256_and_ps(_mm256_cmp_ps(y, zero, _CMP_LT_OQ), _mm256_set1_ps(-0.0f)));
+			__m256 offset = _mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), pi);
+			__m256 r = _mm256_add_ps(offset, atanAVX(_mm256_div_ps(y, x)));
+
+			return _mm256_andnot_ps(_mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_EQ_OQ), _mm256_cmp_ps(y, zero, _CMP_EQ_OQ)), r);
+		}
+
+		/** @brief streamSinCosScalar for n floats, 8 at a time */
+		static inline void streamSinCosAVX(float* s, float* c, const float* a, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 vs, vc;
+
+				sincosAVX(_mm256_loadu_ps(a + i), vs, vc);
+
+				_mm256_storeu_ps(s + i, vs);
+				_mm256_storeu_ps(c + i, vc);
+			}
+
+			streamSinCosScalar(s + i, c + i, a + i, n - i);
+		}
+
+		/** @brief streamAtan2Scalar for n floats, 8 at a time */
+		static inline void streamAtan2AVX(float* out, const float* y, const float* x, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_ps(out + i, atan2AVX(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+			}
+
+			streamAtan2Scalar(out + i, y + i, x + i, n - i);
+		}
+
+		/** @brief quatFromEulerAnglesScalar for n SoA euler angles, 8 at a time */
+		static inline void quatFromEulerAnglesAVX(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			const __m256 half = _mm256_set1_ps(0.5f);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 sin1, cos1, sin2, cos2, sin3, cos3;
+
+				sincosAVX(_mm256_mul_ps(_mm256_loadu_ps(ax + i), half), sin1, cos1);
+				sincosAVX(_mm256_mul_ps(_mm256_loadu_ps(az + i), half), sin2, cos2);
+				sincosAVX(_mm256_mul_ps(_mm256_loadu_ps(ay + i), half), sin3, cos3);
+
+				__m256 s1s2 = _mm256_mul_ps(sin1, sin2);
+				__m256 c1c2 = _mm256_mul_ps(cos1, cos2);
+				__m256 s1c2 = _mm256_mul_ps(sin1, cos2);
+				__m256 c1s2 = _mm256_mul_ps(cos1, sin2);
+
+				_mm256_storeu_ps(ox + i, _mm256_add_ps(_mm256_mul_ps(s1c2, cos3), _mm256_mul_ps(c1s2, sin3)));
+				_mm256_storeu_ps(oy + i, _mm256_add_ps(_mm256_mul_ps(c1c2, sin3), _mm256_mul_ps(s1s2, cos3)));
+				_mm256_storeu_ps(oz + i, _mm256_sub_ps(_mm256_mul_ps(c1s2, cos3), _mm256_mul_ps(s1c2, sin3)));
+				_mm256_storeu_ps(ow + i, _mm256_sub_ps(_mm256_mul_ps(c1c2, cos3), _mm256_mul_ps(s1s2, sin3)));
+			}
+
+			quatFromEulerAnglesScalar(ox + i, oy + i, oz + i, ow + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatFromAxisAngleScalar for n SoA axes and angles, 8 at a time */
+		static inline void quatFromAxisAngleAVX(float* ox, float* oy, float* oz, float* ow,
+			const float* axisX, const float* axisY, const float* axisZ, const float* angle, size_t n)
+		{
+			const __m256 half = _mm256_set1_ps(0.5f);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 sinHalfA, cosHalfA;
+
+				sincosAVX(_mm256_mul_ps(_mm256_loadu_ps(angle + i), half), sinHalfA, cosHalfA);
+
+				_mm256_storeu_ps(ox + i, _mm256_mul_ps(_mm256_loadu_ps(axisX + i), sinHalfA));
+				_mm256_storeu_ps(oy + i, _mm256_mul_ps(_mm256_loadu_ps(axisY + i), sinHalfA));
+				_mm256_storeu_ps(oz + i, _mm256_mul_ps(_mm256_loadu_ps(axisZ + i), sinHalfA));
+				_mm256_storeu_ps(ow + i, cosHalfA);
+			}
+
+			quatFromAxisAngleScalar(ox + i, oy + i, oz + i, ow + i, axisX + i, axisY + i, axisZ + i, angle + i, n - i);
+		}
+
+		/** @brief compactIndicesSSE for an 8-bit mask */
+		static inline size_t compactIndicesAVX(uint32_t* visible, size_t count, int mask, uint32_t first)
+		{
+			for (int k = 0; k < 8; k++)
+			{
+				visible[count] = first + k;
+				count += (mask >> k) & 1;
+			}
+
+			return count;
+		}
+
+		/** @brief frustumCullSpheresScalar, testing 8 spheres against each plane at a time */
+		static inline size_t frustumCullSpheresAVX(uint32_t* visible, const float* planes,
+			const float* x, const float* y, const float* z, const float* r, uint32_t base, size_t n)
+		{
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+			__m256 pa[FRUSTUM_PLANES], pb[FRUSTUM_PLANES], pc[FRUSTUM_PLANES], pd[FRUSTUM_PLANES];
+
+			for (int p = 0; p < FRUSTUM_PLANES; p++)
+			{
+				pa[p] = _mm256_set1_ps(planes[4 * p + 0]);
+				pb[p] = _mm256_set1_ps(planes[4 * p + 1]);
+				pc[p] = _mm256_set1_ps(planes[4 * p + 2]);
+				pd[p] = _mm256_set1_ps(planes[4 * p + 3]);
+			}
+
+			size_t count = 0;
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i), vz = _mm256_loadu_ps(z + i);
+				__m256 negR = _mm256_xor_ps(_mm256_loadu_ps(r + i), signBit);
+				__m256 outside = _mm256_setzero_ps();
+
+				for (int p = 0; p < FRUSTUM_PLANES; p++)
+				{
+					__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pa[p], vx),
+						_mm256_mul_ps(pb[p], vy)), _mm256_mul_ps(pc[p], vz)), pd[p]);
+
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, negR, _CMP_LT_OQ));
+				}
+
+				count = compactIndicesAVX(visible, count, ~_mm256_movemask_ps(outside) & 0xFF, base + (uint32_t)i);
+			}
+
+			return count + frustumCullSpheresSSE(visible + count, planes, x + i, y + i, z + i, r + i,
+				base + (uint32_t)i, n - i);
+		}
+
+		/** @brief frustumCullBoxesScalar, testing 8 boxes against each plane at a time */
+		static inline size_t frustumCullBoxesAVX(uint32_t* visible, const float* planes,
+			const float* cx, const float* cy, const float* cz, const float* ex, const float* ey, const float* ez,
+			uint32_t base, size_t n)
+		{
+			const __m256 signBit = _mm256_set1_ps(-0.0f);
+			__m256 pa[FRUSTUM_PLANES], pb[FRUSTUM_PLANES], pc[FRUSTUM_PLANES], pd[FRUSTUM_PLANES];
+
+			for (int p = 0; p < FRUSTUM_PLANES; p++)
+			{
+				pa[p] = _mm256_set1_ps(planes[4 * p + 0]);
+				pb[p] = _mm256_set1_ps(planes[4 * p + 1]);
+				pc[p] = _mm256_set1_ps(planes[4 * p + 2]);
+				pd[p] = _mm256_set1_ps(planes[4 * p + 3]);
+			}
+
+			size_t count = 0;
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 x = _mm256_loadu_ps(cx + i), y = _mm256_loadu_ps(cy + i), z = _mm256_loadu_ps(cz + i);
+				__m256 sx = _mm256_loadu_ps(ex + i), sy = _mm256_loadu_ps(ey + i), sz = _mm256_loadu_ps(ez + i);
+				__m256 outside = _mm256_setzero_ps();
+
+				for (int p = 0; p < FRUSTUM_PLANES; p++)
+				{
+					__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pa[p], x),
+						_mm256_mul_ps(pb[p], y)), _mm256_mul_ps(pc[p], z)), pd[p]);
+					__m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(signBit, pa[p]), sx),
+						_mm256_mul_ps(_mm256_andnot_ps(signBit, pb[p]), sy)), _mm256_mul_ps(_mm256_andnot_ps(signBit, pc[p]), sz));
+
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_xor_ps(radius, signBit), _CMP_LT_OQ));
+				}
+
+				count = compactIndicesAVX(visible, count, ~_mm256_movemask_ps(outside) & 0xFF, base + (uint32_t)i);
+			}
+
+			return count + frustumCullBoxesSSE(visible + count, planes, cx + i, cy + i, cz + i, ex + i, ey + i, ez + i,
+				base + (uint32_t)i, n - i);
+		}
+		/** @brief rayTrianglesScalar, testing the ray against 8 triangles at a time */
+		static inline size_t rayTrianglesAVX(const float* ray, const float* triangles, size_t stride, size_t n,
+			float& distance, float& u, float& v)
+		{
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.0f);
+			__m256 ox = _mm256_set1_ps(ray[0]), oy = _mm256_set1_ps(ray[1]), oz = _mm256_set1_ps(ray[2]);
+			__m256 dx = _mm256_set1_ps(ray[3]), dy = _mm256_set1_ps(ray[4]), dz = _mm256_set1_ps(ray[5]);
+			size_t hit = n;
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				const float* t = triangles + i;
+				__m256 e1x = _mm256_loadu_ps(t + 3 * stride), e1y = _mm256_loadu_ps(t + 4 * stride), e1z = _mm256_loadu_ps(t + 5 * stride);
+				__m256 e2x = _mm256_loadu_ps(t + 6 * stride), e2y = _mm256_loadu_ps(t + 7 * stride), e2z = _mm256_loadu_ps(t + 8 * stride);
+
+				__m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+				__m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+				__m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+				__m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+				__m256 inv = _mm256_div_ps(one, det);
+
+				__m256 sx = _mm256_sub_ps(ox, _mm256_loadu_ps(t));
+				__m256 sy = _mm256_sub_ps(oy, _mm256_loadu_ps(t + stride));
+				__m256 sz = _mm256_sub_ps(oz, _mm256_loadu_ps(t + 2 * stride));
+				__m256 hitU = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)),
+					_mm256_mul_ps(sz, pz)), inv);
+
+				__m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+				__m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+				__m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+				__m256 hitV = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)),
+					_mm256_mul_ps(dz, qz)), inv);
+				__m256 hitT = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)),
+					_mm256_mul_ps(e2z, qz)), inv);
+
+				__m256 mask = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(det, zero, _CMP_NEQ_UQ), _mm256_cmp_ps(hitU, zero, _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(hitV, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(hitU, hitV), one, _CMP_LE_OQ)));
+				mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(hitT, zero, _CMP_GT_OQ),
+					_mm256_cmp_ps(hitT, _mm256_set1_ps(distance), _CMP_LT_OQ)));
+
+				int bits = _mm256_movemask_ps(mask);
+
+				if (bits != 0)
+				{
+					alignas(32) float ts[8], us[8], vs[8];
+
+					_mm256_store_ps(ts, hitT);
+					_mm256_store_ps(us, hitU);
+					_mm256_store_ps(vs, hitV);
+
+					hit = i + closestLane(bits, 8, ts, us, vs, distance, u, v);
+				}
+			}
+
+			size_t rest = rayTrianglesSSE(ray, triangles + i, stride, n - i, distance, u, v);
+
+			return rest < n - i ? i + rest : hit;
+		}
+
+		/** @brief raysTriangleScalar, testing 8 rays against the triangle at a time */
+		static inline size_t raysTriangleAVX(uint32_t* hitTriangles, float* distance, float* u, float* v,
+			const float* triangle, uint32_t id, const float* ox, const float* oy, const float* oz,
+			const float* dx, const float* dy, const float* dz, size_t n)
+		{
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 ids = _mm256_castsi256_ps(_mm256_set1_epi32((int)id));
+			__m256 v0x = _mm256_set1_ps(triangle[0]), v0y = _mm256_set1_ps(triangle[1]), v0z = _mm256_set1_ps(triangle[2]);
+			__m256 e1x = _mm256_set1_ps(triangle[3]), e1y = _mm256_set1_ps(triangle[4]), e1z = _mm256_set1_ps(triangle[5]);
+			__m256 e2x = _mm256_set1_ps(triangle[6]), e2y = _mm256_set1_ps(triangle[7]), e2z = _mm256_set1_ps(triangle[8]);
+			size_t hits = 0;
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m256 rdx = _mm256_loadu_ps(dx + i), rdy = _mm256_loadu_ps(dy + i), rdz = _mm256_loadu_ps(dz + i);
+
+				__m256 px = _mm256_sub_ps(_mm256_mul_ps(rdy, e2z), _mm256_mul_ps(rdz, e2y));
+				__m256 py = _mm256_sub_ps(_mm256_mul_ps(rdz, e2x), _mm256_mul_ps(rdx, e2z));
+				__m256 pz = _mm256_sub_ps(_mm256_mul_ps(rdx, e2y), _mm256_mul_ps(rdy, e2x));
+				__m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+				__m256 inv = _mm256_div_ps(one, det);
+
+				__m256 sx = _mm256_sub_ps(_mm256_loadu_ps(ox + i), v0x);
+				__m256 sy = _mm256_sub_ps(_mm256_loadu_ps(oy + i), v0y);
+				__m256 sz = _mm256_sub_ps(_mm256_loadu_ps(oz + i), v0z);
+				__m256 hitU = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)),
+					_mm256_mul_ps(sz, pz)), inv);
+
+				__m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+				__m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+				__m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+				__m256 hitV = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rdx, qx), _mm256_mul_ps(rdy, qy)),
+					_mm256_mul_ps(rdz, qz)), inv);
+				__m256 hitT = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)),
+					_mm256_mul_ps(e2z, qz)), inv);
+
+				__m256 previous = _mm256_loadu_ps(distance + i);
+				__m256 mask = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(det, zero, _CMP_NEQ_UQ), _mm256_cmp_ps(hitU, zero, _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(hitV, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(hitU, hitV), one, _CMP_LE_OQ)));
+				mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(hitT, zero, _CMP_GT_OQ),
+					_mm256_cmp_ps(hitT, previous, _CMP_LT_OQ)));
+
+				_mm256_storeu_ps(distance + i, _mm256_blendv_ps(previous, hitT, mask));
+				_mm256_storeu_ps(u + i, _mm256_blendv_ps(_mm256_loadu_ps(u + i), hitU, mask));
+				_mm256_storeu_ps(v + i, _mm256_blendv_ps(_mm256_loadu_ps(v + i), hitV, mask));
+				_mm256_storeu_ps((float*)(hitTriangles + i), _mm256_blendv_ps(_mm256_loadu_ps((const float*)(hitTriangles + i)),
+					ids, mask));
+
+				hits += __builtin_popcount(_mm256_movemask_ps(mask));
+			}
+
+			return hits + raysTriangleSSE(hitTriangles + i, distance + i, u + i, v + i, triangle, id,
+				ox + i, oy + i, oz + i, dx + i, dy + i, dz + i, n - i);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,737 @@
+#ifndef KERNELS_AVX512_HPP
+#define KERNELS_AVX512_HPP
+
+#include <immintrin.h>
+#include "scalar.hpp"
+
+/**
+ * AVX-512 versions of the batch kernels in kernels/scalar.hpp, producing
+ * bit-identical results
+ */
+namespace math3d
+{
+	namespace detail
+	{
+		/** @brief out[i] = a[i] + b[i] for n floats, 16 at a time */
+		static inline void streamAddAVX512(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				_mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] - b[i] for n floats, 16 at a time */
+		static inline void streamSubAVX512(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				_mm512_storeu_ps(out + i, _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] - b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * b[i] for n floats, 16 at a time */
+		static inline void streamMulAVX512(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				_mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * s for n floats, 16 at a time */
+		static inline void streamScaleAVX512(float* out, const float* a, float s, size_t n)
+		{
+			__m512 vs = _mm512_set1_ps(s);
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				_mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), vs));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] * s;
+			}
+		}
+
+		/** @brief out[i] = a[i] + (b[i] - a[i]) * t[i] for n floats, 16 at a time */
+		static inline void streamLerpAVX512(float* out, const float* a, const float* b, const float* t, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 va = _mm512_loadu_ps(a + i);
+
+				_mm512_storeu_ps(out + i, _mm512_add_ps(va, _mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(b + i), va), _mm512_loadu_ps(t + i))));
+			}
+
+			streamLerpScalar(out + i, a + i, b + i, t + i, n - i);
+		}
+
+		/** @brief out[i] = dot(a[i], b[i]) for n SoA vectors, 16 at a time */
+		static inline void vec3DotAVX512(float* out, const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 d = _mm512_mul_ps(_mm512_loadu_ps(ax + i), _mm512_loadu_ps(bx + i));
+				d = _mm512_add_ps(d, _mm512_mul_ps(_mm512_loadu_ps(ay + i), _mm512_loadu_ps(by + i)));
+				d = _mm512_add_ps(d, _mm512_mul_ps(_mm512_loadu_ps(az + i), _mm512_loadu_ps(bz + i)));
+
+				_mm512_storeu_ps(out + i, d);
+			}
+
+			vec3DotScalar(out + i, ax + i, ay + i, az + i, bx + i, by + i, bz + i, n - i);
+		}
+
+		/** @brief o[i] = cross(a[i], b[i]) for n SoA vectors, 16 at a time; o may alias a or b */
+		static inline void vec3CrossAVX512(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x1 = _mm512_loadu_ps(ax + i), y1 = _mm512_loadu_ps(ay + i), z1 = _mm512_loadu_ps(az + i);
+				__m512 x2 = _mm512_loadu_ps(bx + i), y2 = _mm512_loadu_ps(by + i), z2 = _mm512_loadu_ps(bz + i);
+
+				_mm512_storeu_ps(ox + i, _mm512_sub_ps(_mm512_mul_ps(y1, z2), _mm512_mul_ps(z1, y2)));
+				_mm512_storeu_ps(oy + i, _mm512_sub_ps(_mm512_mul_ps(z1, x2), _mm512_mul_ps(x1, z2)));
+				_mm512_storeu_ps(oz + i, _mm512_sub_ps(_mm512_mul_ps(x1, y2), _mm512_mul_ps(y1, x2)));
+			}
+
+			vec3CrossScalar(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, bx + i, by + i, bz + i, n - i);
+		}
+
+		/** @brief out[i] = magSq(a[i]) for n SoA vectors, 16 at a time */
+		static inline void vec3MagSqAVX512(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+				__m512 sq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z));
+
+				_mm512_storeu_ps(out + i, sq);
+			}
+
+			vec3MagSqScalar(out + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief out[i] = magnitude(a[i]) for n SoA vectors, 16 at a time */
+		static inline void vec3MagnitudeAVX512(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+				__m512 sq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z));
+
+				_mm512_storeu_ps(out + i, _mm512_sqrt_ps(sq));
+			}
+
+			vec3MagnitudeScalar(out + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = normalize(a[i]) for n SoA vectors, 16 at a time; o may alias a */
+		static inline void vec3NormalizeAVX512(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+				__m512 mag = _mm512_sqrt_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z)));
+
+				_mm512_storeu_ps(ox + i, _mm512_div_ps(x, mag));
+				_mm512_storeu_ps(oy + i, _mm512_div_ps(y, mag));
+				_mm512_storeu_ps(oz + i, _mm512_div_ps(z, mag));
+			}
+
+			vec3NormalizeScalar(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/**
+		 * vec3NormalizeFastScalar for n SoA vectors, 16 at a time, using
+		 * the 14-bit rsqrt14 estimate and one Newton-Raphson step. The
+		 * tail is loaded and stored with masks so that every vector gets
+		 * the same approximation.
+		 */
+		static inline void vec3NormalizeFastAVX512(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			const __m512 half = _mm512_set1_ps(0.5f);
+			const __m512 threeHalves = _mm512_set1_ps(1.5f);
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 x = _mm512_maskz_loadu_ps(mask, ax + i);
+				__m512 y = _mm512_maskz_loadu_ps(mask, ay + i);
+				__m512 z = _mm512_maskz_loadu_ps(mask, az + i);
+				__m512 magSq = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z));
+				__m512 r = _mm512_rsqrt14_ps(magSq);
+				__m512 invMag = _mm512_mul_ps(r, _mm512_sub_ps(threeHalves, _mm512_mul_ps(_mm512_mul_ps(_mm512_mul_ps(half, magSq), r), r)));
+
+				_mm512_mask_storeu_ps(ox + i, mask, _mm512_mul_ps(x, invMag));
+				_mm512_mask_storeu_ps(oy + i, mask, _mm512_mul_ps(y, invMag));
+				_mm512_mask_storeu_ps(oz + i, mask, _mm512_mul_ps(z, invMag));
+			}
+		}
+
+		/** @brief o[i] = m * (a[i], 1) for n SoA points, 16 at a time; o may alias a */
+		static inline void mat4TransformPointsAVX512(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m512 m00 = _mm512_set1_ps(m[0]), m01 = _mm512_set1_ps(m[1]), m02 = _mm512_set1_ps(m[2]), m03 = _mm512_set1_ps(m[3]);
+			__m512 m10 = _mm512_set1_ps(m[4]), m11 = _mm512_set1_ps(m[5]), m12 = _mm512_set1_ps(m[6]), m13 = _mm512_set1_ps(m[7]);
+			__m512 m20 = _mm512_set1_ps(m[8]), m21 = _mm512_set1_ps(m[9]), m22 = _mm512_set1_ps(m[10]), m23 = _mm512_set1_ps(m[11]);
+
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+
+				_mm512_storeu_ps(ox + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m00, x), _mm512_mul_ps(m01, y)), _mm512_mul_ps(m02, z)), m03));
+				_mm512_storeu_ps(oy + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m10, x), _mm512_mul_ps(m11, y)), _mm512_mul_ps(m12, z)), m13));
+				_mm512_storeu_ps(oz + i, _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m20, x), _mm512_mul_ps(m21, y)), _mm512_mul_ps(m22, z)), m23));
+			}
+
+			mat4TransformPointsScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 0) for n SoA directions, 16 at a time; o may alias a */
+		static inline void mat4TransformDirectionsAVX512(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m512 m00 = _mm512_set1_ps(m[0]), m01 = _mm512_set1_ps(m[1]), m02 = _mm512_set1_ps(m[2]);
+			__m512 m10 = _mm512_set1_ps(m[4]), m11 = _mm512_set1_ps(m[5]), m12 = _mm512_set1_ps(m[6]);
+			__m512 m20 = _mm512_set1_ps(m[8]), m21 = _mm512_set1_ps(m[9]), m22 = _mm512_set1_ps(m[10]);
+
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+
+				_mm512_storeu_ps(ox + i, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m00, x), _mm512_mul_ps(m01, y)), _mm512_mul_ps(m02, z)));
+				_mm512_storeu_ps(oy + i, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m10, x), _mm512_mul_ps(m11, y)), _mm512_mul_ps(m12, z)));
+				_mm512_storeu_ps(oz + i, _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m20, x), _mm512_mul_ps(m21, y)), _mm512_mul_ps(m22, z)));
+			}
+
+			mat4TransformDirectionsScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 1) divided by w for n SoA points, 16 at a time; o may alias a */
+		static inline void mat4TransformHomogeneousAVX512(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m512 m00 = _mm512_set1_ps(m[0]), m01 = _mm512_set1_ps(m[1]), m02 = _mm512_set1_ps(m[2]), m03 = _mm512_set1_ps(m[3]);
+			__m512 m10 = _mm512_set1_ps(m[4]), m11 = _mm512_set1_ps(m[5]), m12 = _mm512_set1_ps(m[6]), m13 = _mm512_set1_ps(m[7]);
+			__m512 m20 = _mm512_set1_ps(m[8]), m21 = _mm512_set1_ps(m[9]), m22 = _mm512_set1_ps(m[10]), m23 = _mm512_set1_ps(m[11]);
+			__m512 m30 = _mm512_set1_ps(m[12]), m31 = _mm512_set1_ps(m[13]), m32 = _mm512_set1_ps(m[14]), m33 = _mm512_set1_ps(m[15]);
+
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+				__m512 w = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m30, x), _mm512_mul_ps(m31, y)), _mm512_mul_ps(m32, z)), m33);
+
+				_mm512_storeu_ps(ox + i, _mm512_div_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m00, x), _mm512_mul_ps(m01, y)), _mm512_mul_ps(m02, z)), m03), w));
+				_mm512_storeu_ps(oy + i, _mm512_div_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m10, x), _mm512_mul_ps(m11, y)), _mm512_mul_ps(m12, z)), m13), w));
+				_mm512_storeu_ps(oz + i, _mm512_div_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m20, x), _mm512_mul_ps(m21, y)), _mm512_mul_ps(m22, z)), m23), w));
+			}
+
+			mat4TransformHomogeneousScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief negates the lanes of v selected by mask (AVX-512F has no float xor) */
+		static inline __m512 negateAVX512(__m512 v, __mmask16 mask)
+		{
+			__m512i bits = _mm512_castps_si512(v);
+
+			return _mm512_castsi512_ps(_mm512_mask_xor_epi32(bits, mask, bits, _mm512_set1_epi32(0x80000000)));
+		}
+
+		/** @brief quatRotateScalar for 16 vectors and quaternions at a time */
+		static inline void quatRotateAVX512(__m512& x, __m512& y, __m512& z, __m512 qx, __m512 qy, __m512 qz, __m512 qw)
+		{
+			__m512 two = _mm512_set1_ps(2.0f);
+			__m512 tx = _mm512_mul_ps(_mm512_sub_ps(_mm512_mul_ps(qy, z), _mm512_mul_ps(qz, y)), two);
+			__m512 ty = _mm512_mul_ps(_mm512_sub_ps(_mm512_mul_ps(qz, x), _mm512_mul_ps(qx, z)), two);
+			__m512 tz = _mm512_mul_ps(_mm512_sub_ps(_mm512_mul_ps(qx, y), _mm512_mul_ps(qy, x)), two);
+
+			x = _mm512_add_ps(_mm512_add_ps(x, _mm512_mul_ps(tx, qw)), _mm512_sub_ps(_mm512_mul_ps(qy, tz), _mm512_mul_ps(qz, ty)));
+			y = _mm512_add_ps(_mm512_add_ps(y, _mm512_mul_ps(ty, qw)), _mm512_sub_ps(_mm512_mul_ps(qz, tx), _mm512_mul_ps(qx, tz)));
+			z = _mm512_add_ps(_mm512_add_ps(z, _mm512_mul_ps(tz, qw)), _mm512_sub_ps(_mm512_mul_ps(qx, ty), _mm512_mul_ps(qy, tx)));
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q) for n SoA vectors, 16 at a time; o may alias a */
+		static inline void quatRotateVectorsAVX512(float* ox, float* oy, float* oz, const float* q,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m512 qx = _mm512_set1_ps(q[0]), qy = _mm512_set1_ps(q[1]), qz = _mm512_set1_ps(q[2]), qw = _mm512_set1_ps(q[3]);
+
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+
+				quatRotateAVX512(x, y, z, qx, qy, qz, qw);
+
+				_mm512_storeu_ps(ox + i, x);
+				_mm512_storeu_ps(oy + i, y);
+				_mm512_storeu_ps(oz + i, z);
+			}
+
+			quatRotateVectorsScalar(ox + i, oy + i, oz + i, q, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q[i]) for n SoA vectors and quaternions, 16 at a time; o may alias a */
+		static inline void quatsRotateVectorsAVX512(float* ox, float* oy, float* oz,
+			const float* qx, const float* qy, const float* qz, const float* qw,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x = _mm512_loadu_ps(ax + i), y = _mm512_loadu_ps(ay + i), z = _mm512_loadu_ps(az + i);
+
+				quatRotateAVX512(x, y, z, _mm512_loadu_ps(qx + i), _mm512_loadu_ps(qy + i), _mm512_loadu_ps(qz + i), _mm512_loadu_ps(qw + i));
+
+				_mm512_storeu_ps(ox + i, x);
+				_mm512_storeu_ps(oy + i, y);
+				_mm512_storeu_ps(oz + i, z);
+			}
+
+			quatsRotateVectorsScalar(ox + i, oy + i, oz + i, qx + i, qy + i, qz + i, qw + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatNlerpScalar for n SoA quaternions, 16 at a time; o may alias a or b */
+		static inline void quatNlerpAVX512(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, const float* aw,
+			const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m512 x1 = _mm512_loadu_ps(ax + i), y1 = _mm512_loadu_ps(ay + i), z1 = _mm512_loadu_ps(az + i), w1 = _mm512_loadu_ps(aw + i);
+				__m512 x2 = _mm512_loadu_ps(bx + i), y2 = _mm512_loadu_ps(by + i), z2 = _mm512_loadu_ps(bz + i), w2 = _mm512_loadu_ps(bw + i);
+				__m512 vt = _mm512_loadu_ps(t + i);
+
+				__m512 cs = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x1, x2), _mm512_mul_ps(y1, y2)), _mm512_mul_ps(z1, z2)), _mm512_mul_ps(w1, w2));
+				__mmask16 flip = _mm512_cmp_ps_mask(cs, _mm512_setzero_ps(), _CMP_LT_OQ);
+
+				x2 = negateAVX512(x2, flip);
+				y2 = negateAVX512(y2, flip);
+				z2 = negateAVX512(z2, flip);
+				w2 = negateAVX512(w2, flip);
+
+				__m512 x = _mm512_add_ps(x1, _mm512_mul_ps(_mm512_sub_ps(x2, x1), vt));
+				__m512 y = _mm512_add_ps(y1, _mm512_mul_ps(_mm512_sub_ps(y2, y1), vt));
+				__m512 z = _mm512_add_ps(z1, _mm512_mul_ps(_mm512_sub_ps(z2, z1), vt));
+				__m512 w = _mm512_add_ps(w1, _mm512_mul_ps(_mm512_sub_ps(w2, w1), vt));
+				__m512 mag = _mm512_sqrt_ps(_mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z)), _mm512_mul_ps(w, w)));
+
+				_mm512_storeu_ps(ox + i, _mm512_div_ps(x, mag));
+				_mm512_storeu_ps(oy + i, _mm512_div_ps(y, mag));
+				_mm512_storeu_ps(oz + i, _mm512_div_ps(z, mag));
+				_mm512_storeu_ps(ow + i, _mm512_div_ps(w, mag));
+			}
+
+			quatNlerpScalar(ox + i, oy + i, oz + i, ow + i, ax + i, ay + i, az + i, aw + i,
+				bx + i, by + i, bz + i, bw + i, t + i, n - i);
+		}
+		/** @brief sincosScalar for 16 floats */
+		static inline void sincosAVX512(__m512 a, __m512& s, __m512& c)
+		{
+			const __m512i two = _mm512_set1_epi32(2);
+			const __m512i four = _mm512_set1_epi32(4);
+
+			__m512 x = _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF)));
+			__m512i j = _mm512_cvttps_epi32(_mm512_mul_ps(x, _mm512_set1_ps(TRIG_4_OVER_PI)));
+			j = _mm512_and_epi32(_mm512_add_epi32(j, _mm512_set1_epi32(1)), _mm512_set1_epi32(~1));
+
+			__m512 y = _mm512_cvtepi32_ps(j);
+			x = _mm512_sub_ps(_mm512_sub_ps(_mm512_sub_ps(x, _mm512_mul_ps(y, _mm512_set1_ps(TRIG_PI_4_A))),
+				_mm512_mul_ps(y, _mm512_set1_ps(TRIG_PI_4_B))), _mm512_mul_ps(y, _mm512_set1_ps(TRIG_PI_4_C)));
+
+			__m512 z = _mm512_mul_ps(x, x);
+			__m512 sinPoly = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(
+				_mm512_mul_ps(_mm512_set1_ps(TRIG_SIN_0), z), _mm512_set1_ps(TRIG_SIN_1)), z), _mm512_set1_ps(TRIG_SIN_2)), z), x), x);
+			__m512 cosPoly = _mm512_add_ps(_mm512_sub_ps(_mm512_mul_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(
+				_mm512_mul_ps(_mm512_set1_ps(TRIG_COS_0), z), _mm512_set1_ps(TRIG_COS_1)), z), _mm512_set1_ps(TRIG_COS_2)), z), z),
+				_mm512_mul_ps(_mm512_set1_ps(0.5f), z)), _mm512_set1_ps(1.0f));
+
+			__mmask16 swap = _mm512_test_epi32_mask(j, two);
+			__mmask16 sinNegative = _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_LT_OQ) ^ _mm512_test_epi32_mask(j, four);
+			__mmask16 cosNegative = _mm512_test_epi32_mask(_mm512_add_epi32(j, two), four);
+
+			s = negateAVX512(_mm512_mask_blend_ps(swap, sinPoly, cosPoly), sinNegative);
+			c = negateAVX512(_mm512_mask_blend_ps(swap, cosPoly, sinPoly), cosNegative);
+		}
+
+		/** @brief atanScalar for 16 floats */
+		static inline __m512 atanAVX512(__m512 a)
+		{
+			const __m512 one = _mm512_set1_ps(1.0f);
+
+			__m512 x = _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF)));
+			__mmask16 large = _mm512_cmp_ps_mask(x, _mm512_set1_ps(TRIG_TAN_3PI_8), _CMP_GT_OQ);
+			__mmask16 medium = _mm512_cmp_ps_mask(x, _mm512_set1_ps(TRIG_TAN_PI_8), _CMP_GT_OQ);
+
+			__m512 num = _mm512_mask_blend_ps(large, _mm512_mask_blend_ps(medium, x, _mm512_sub_ps(x, one)), _mm512_set1_ps(-1.0f));
+			__m512 den = _mm512_mask_blend_ps(large, _mm512_mask_blend_ps(medium, one, _mm512_add_ps(x, one)), x);
+			__m512 offset = _mm512_mask_blend_ps(large, _mm512_maskz_mov_ps(medium, _mm512_set1_ps(TRIG_PI_4)),
+				_mm512_set1_ps(TRIG_PI_2));
+
+			x = _mm512_div_ps(num, den);
+
+			__m512 z = _mm512_mul_ps(x, x);
+			__m512 poly = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(
+				_mm512_mul_ps(_mm512_set1_ps(TRIG_ATAN_0), z), _mm512_set1_ps(TRIG_ATAN_1)), z), _mm512_set1_ps(TRIG_ATAN_2)), z),
+				_mm512_set1_ps(TRIG_ATAN_3)), z), x), x);
+
+			return negateAVX512(_mm512_add_ps(offset, poly), _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_LT_OQ));
+		}
+
+		/** @brief atan2Scalar for 16 pairs of floats */
+		static inline __m512 atan2AVX512(__m512 y, __m512 x)
+		{
+			const __m512 zero = _mm512_setzero_ps();
+
+			__m512 pi = negateAVX512(_mm512_set1_ps(TRIG_PI), _mm512_cmp_ps_mask(y, zero, _CMP_LT_OQ));
+			__m512 offset = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(x, zero, _CMP_LT_OQ), pi);
+			__m512 r = _mm512_add_ps(offset, atanAVX512(_mm512_div_ps(y, x)));
+			__mmask16 origin = _mm512_cmp_ps_mask(x, zero, _CMP_EQ_OQ) & _mm512_cmp_ps_mask(y, zero, _CMP_EQ_OQ);
+
+			return _mm512_maskz_mov_ps(~origin, r);
+		}
+
+		/** @brief streamSinCosScalar for n floats, 16 at a time with a masked tail */
+		static inline void streamSinCosAVX512(float* s, float* c, const float* a, size_t n)
+		{
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 vs, vc;
+
+				sincosAVX512(_mm512_maskz_loadu_ps(mask, a + i), vs, vc);
+
+				_mm512_mask_storeu_ps(s + i, mask, vs);
+				_mm512_mask_storeu_ps(c + i, mask, vc);
+			}
+		}
+
+		/** @brief streamAtan2Scalar for n floats, 16 at a time with a masked tail */
+		static inline void streamAtan2AVX512(float* out, const float* y, const float* x, size_t n)
+		{
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+
+				_mm512_mask_storeu_ps(out + i, mask, atan2AVX512(_mm512_maskz_loadu_ps(mask, y + i),
+					_mm512_maskz_loadu_ps(mask, x + i)));
+			}
+		}
+
+		/** @brief quatFromEulerAnglesScalar for n SoA euler angles, 16 at a time with a masked tail */
+		static inline void quatFromEulerAnglesAVX512(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			const __m512 half = _mm512_set1_ps(0.5f);
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 sin1, cos1, sin2, cos2, sin3, cos3;
+
+				sincosAVX512(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, ax + i), half), sin1, cos1);
+				sincosAVX512(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, az + i), half), sin2, cos2);
+				sincosAVX512(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, ay + i), half), sin3, cos3);
+
+				__m512 s1s2 = _mm512_mul_ps(sin1, sin2);
+				__m512 c1c2 = _mm512_mul_ps(cos1, cos2);
+				__m512 s1c2 = _mm512_mul_ps(sin1, cos2);
+				__m512 c1s2 = _mm512_mul_ps(cos1, sin2);
+
+				_mm512_mask_storeu_ps(ox + i, mask, _mm512_add_ps(_mm512_mul_ps(s1c2, cos3), _mm512_mul_ps(c1s2, sin3)));
+				_mm512_mask_storeu_ps(oy + i, mask, _mm512_add_ps(_mm512_mul_ps(c1c2, sin3), _mm512_mul_ps(s1s2, cos3)));
+				_mm512_mask_storeu_ps(oz + i, mask, _mm512_sub_ps(_mm512_mul_ps(c1s2, cos3), _mm512_mul_ps(s1c2, sin3)));
+				_mm512_mask_storeu_ps(ow + i, mask, _mm512_sub_ps(_mm512_mul_ps(c1c2, cos3), _mm512_mul_ps(s1s2, sin3)));
+			}
+		}
+
+		/** @brief quatFromAxisAngleScalar for n SoA axes and angles, 16 at a time with a masked tail */
+		static inline void quatFromAxisAngleAVX512(float* ox, float* oy, float* oz, float* ow,
+			const float* axisX, const float* axisY, const float* axisZ, const float* angle, size_t n)
+		{
+			const __m512 half = _mm512_set1_ps(0.5f);
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 sinHalfA, cosHalfA;
+
+				sincosAVX512(_mm512_mul_ps(_mm512_maskz_loadu_ps(mask, angle + i), half), sinHalfA, cosHalfA);
+
+				_mm512_mask_storeu_ps(ox + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, axisX + i), sinHalfA));
+				_mm512_mask_storeu_ps(oy + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, axisY + i), sinHalfA));
+				_mm512_mask_storeu_ps(oz + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, axisZ + i), sinHalfA));
+				_mm512_mask_storeu_ps(ow + i, mask, cosHalfA);
+			}
+		}
+
+		/**
+		 * frustumCullSpheresScalar, testing 16 spheres against each plane
+		 * at a time with a masked tail, and compacting the indices of the
+		 * visible ones with a compress store
+		 */
+		static inline size_t frustumCullSpheresAVX512(uint32_t* visible, const float* planes,
+			const float* x, const float* y, const float* z, const float* r, uint32_t base, size_t n)
+		{
+			const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			__m512 pa[FRUSTUM_PLANES], pb[FRUSTUM_PLANES], pc[FRUSTUM_PLANES], pd[FRUSTUM_PLANES];
+
+			for (int p = 0; p < FRUSTUM_PLANES; p++)
+			{
+				pa[p] = _mm512_set1_ps(planes[4 * p + 0]);
+				pb[p] = _mm512_set1_ps(planes[4 * p + 1]);
+				pc[p] = _mm512_set1_ps(planes[4 * p + 2]);
+				pd[p] = _mm512_set1_ps(planes[4 * p + 3]);
+			}
+
+			size_t count = 0;
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 vx = _mm512_maskz_loadu_ps(mask, x + i);
+				__m512 vy = _mm512_maskz_loadu_ps(mask, y + i);
+				__m512 vz = _mm512_maskz_loadu_ps(mask, z + i);
+				__m512 negR = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_maskz_loadu_ps(mask, r + i));
+				__mmask16 inside = mask;
+
+				for (int p = 0; p < FRUSTUM_PLANES; p++)
+				{
+					__m512 distance = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(pa[p], vx),
+						_mm512_mul_ps(pb[p], vy)), _mm512_mul_ps(pc[p], vz)), pd[p]);
+
+					inside &= ~_mm512_cmp_ps_mask(distance, negR, _CMP_LT_OQ);
+				}
+
+				_mm512_mask_compressstoreu_epi32(visible + count, inside,
+					_mm512_add_epi32(_mm512_set1_epi32((int)(base + (uint32_t)i)), lanes));
+				count += __builtin_popcount(inside);
+			}
+
+			return count;
+		}
+
+		/** @brief frustumCullBoxesScalar, testing 16 boxes against each plane at a time like frustumCullSpheresAVX512 */
+		static inline size_t frustumCullBoxesAVX512(uint32_t* visible, const float* planes,
+			const float* cx, const float* cy, const float* cz, const float* ex, const float* ey, const float* ez,
+			uint32_t base, size_t n)
+		{
+			const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			__m512 pa[FRUSTUM_PLANES], pb[FRUSTUM_PLANES], pc[FRUSTUM_PLANES], pd[FRUSTUM_PLANES];
+			__m512 aa[FRUSTUM_PLANES], ab[FRUSTUM_PLANES], ac[FRUSTUM_PLANES];
+
+			for (int p = 0; p < FRUSTUM_PLANES; p++)
+			{
+				pa[p] = _mm512_set1_ps(planes[4 * p + 0]);
+				pb[p] = _mm512_set1_ps(planes[4 * p + 1]);
+				pc[p] = _mm512_set1_ps(planes[4 * p + 2]);
+				pd[p] = _mm512_set1_ps(planes[4 * p + 3]);
+				aa[p] = _mm512_set1_ps(std::fabs(planes[4 * p + 0]));
+				ab[p] = _mm512_set1_ps(std::fabs(planes[4 * p + 1]));
+				ac[p] = _mm512_set1_ps(std::fabs(planes[4 * p + 2]));
+			}
+
+			size_t count = 0;
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 x = _mm512_maskz_loadu_ps(mask, cx + i);
+				__m512 y = _mm512_maskz_loadu_ps(mask, cy + i);
+				__m512 z = _mm512_maskz_loadu_ps(mask, cz + i);
+				__m512 sx = _mm512_maskz_loadu_ps(mask, ex + i);
+				__m512 sy = _mm512_maskz_loadu_ps(mask, ey + i);
+				__m512 sz = _mm512_maskz_loadu_ps(mask, ez + i);
+				__mmask16 inside = mask;
+
+				for (int p = 0; p < FRUSTUM_PLANES; p++)
+				{
+					__m512 distance = _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(pa[p], x),
+						_mm512_mul_ps(pb[p], y)), _mm512_mul_ps(pc[p], z)), pd[p]);
+					__m512 radius = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(aa[p], sx), _mm512_mul_ps(ab[p], sy)),
+						_mm512_mul_ps(ac[p], sz));
+
+					inside &= ~_mm512_cmp_ps_mask(distance, _mm512_sub_ps(_mm512_setzero_ps(), radius), _CMP_LT_OQ);
+				}
+
+				_mm512_mask_compressstoreu_epi32(visible + count, inside,
+					_mm512_add_epi32(_mm512_set1_epi32((int)(base + (uint32_t)i)), lanes));
+				count += __builtin_popcount(inside);
+			}
+
+			return count;
+		}
+		/** @brief rayTrianglesScalar, testing the ray against 16 triangles at a time */
+		static inline size_t rayTrianglesAVX512(const float* ray, const float* triangles, size_t stride, size_t n,
+			float& distance, float& u, float& v)
+		{
+			const __m512 zero = _mm512_setzero_ps();
+			const __m512 one = _mm512_set1_ps(1.0f);
+			__m512 ox = _mm512_set1_ps(ray[0]), oy = _mm512_set1_ps(ray[1]), oz = _mm512_set1_ps(ray[2]);
+			__m512 dx = _mm512_set1_ps(ray[3]), dy = _mm512_set1_ps(ray[4]), dz = _mm512_set1_ps(ray[5]);
+			size_t hit = n;
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				const float* t = triangles + i;
+				__mmask16 lanes = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 e1x = _mm512_maskz_loadu_ps(lanes, t + 3 * stride);
+				__m512 e1y = _mm512_maskz_loadu_ps(lanes, t + 4 * stride);
+				__m512 e1z = _mm512_maskz_loadu_ps(lanes, t + 5 * stride);
+				__m512 e2x = _mm512_maskz_loadu_ps(lanes, t + 6 * stride);
+				__m512 e2y = _mm512_maskz_loadu_ps(lanes, t + 7 * stride);
+				__m512 e2z = _mm512_maskz_loadu_ps(lanes, t + 8 * stride);
+
+				__m512 px = _mm512_sub_ps(_mm512_mul_ps(dy, e2z), _mm512_mul_ps(dz, e2y));
+				__m512 py = _mm512_sub_ps(_mm512_mul_ps(dz, e2x), _mm512_mul_ps(dx, e2z));
+				__m512 pz = _mm512_sub_ps(_mm512_mul_ps(dx, e2y), _mm512_mul_ps(dy, e2x));
+				__m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e1x, px), _mm512_mul_ps(e1y, py)), _mm512_mul_ps(e1z, pz));
+				__m512 inv = _mm512_div_ps(one, det);
+
+				__m512 sx = _mm512_sub_ps(ox, _mm512_maskz_loadu_ps(lanes, t));
+				__m512 sy = _mm512_sub_ps(oy, _mm512_maskz_loadu_ps(lanes, t + stride));
+				__m512 sz = _mm512_sub_ps(oz, _mm512_maskz_loadu_ps(lanes, t + 2 * stride));
+				__m512 hitU = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(sx, px), _mm512_mul_ps(sy, py)),
+					_mm512_mul_ps(sz, pz)), inv);
+
+				__m512 qx = _mm512_sub_ps(_mm512_mul_ps(sy, e1z), _mm512_mul_ps(sz, e1y));
+				__m512 qy = _mm512_sub_ps(_mm512_mul_ps(sz, e1x), _mm512_mul_ps(sx, e1z));
+				__m512 qz = _mm512_sub_ps(_mm512_mul_ps(sx, e1y), _mm512_mul_ps(sy, e1x));
+				__m512 hitV = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(dx, qx), _mm512_mul_ps(dy, qy)),
+					_mm512_mul_ps(dz, qz)), inv);
+				__m512 hitT = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e2x, qx), _mm512_mul_ps(e2y, qy)),
+					_mm512_mul_ps(e2z, qz)), inv);
+
+				__mmask16 mask = lanes & _mm512_cmp_ps_mask(det, zero, _CMP_NEQ_UQ) &
+					_mm512_cmp_ps_mask(hitU, zero, _CMP_GE_OQ) & _mm512_cmp_ps_mask(hitV, zero, _CMP_GE_OQ) &
+					_mm512_cmp_ps_mask(_mm512_add_ps(hitU, hitV), one, _CMP_LE_OQ) &
+					_mm512_cmp_ps_mask(hitT, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(hitT, _mm512_set1_ps(distance), _CMP_LT_OQ);
+
+				if (mask != 0)
+				{
+					alignas(64) float ts[16], us[16], vs[16];
+
+					_mm512_store_ps(ts, hitT);
+					_mm512_store_ps(us, hitU);
+					_mm512_store_ps(vs, hitV);
+
+					hit = i + closestLane(mask, 16, ts, us, vs, distance, u, v);
+				}
+			}
+
+			return hit;
+		}
+
+		/** @brief raysTriangleScalar, testing 16 rays against the triangle at a time */
+		static inline size_t raysTriangleAVX512(uint32_t* hitTriangles, float* distance, float* u, float* v,
+			const float* triangle, uint32_t id, const float* ox, const float* oy, const float* oz,
+			const float* dx, const float* dy, const float* dz, size_t n)
+		{
+			const __m512 zero = _mm512_setzero_ps();
+			const __m512 one = _mm512_set1_ps(1.0f);
+			const __m512i ids = _mm512_set1_epi32((int)id);
+			__m512 v0x = _mm512_set1_ps(triangle[0]), v0y = _mm512_set1_ps(triangle[1]), v0z = _mm512_set1_ps(triangle[2]);
+			__m512 e1x = _mm512_set1_ps(triangle[3]), e1y = _mm512_set1_ps(triangle[4]), e1z = _mm512_set1_ps(triangle[5]);
+			__m512 e2x = _mm512_set1_ps(triangle[6]), e2y = _mm512_set1_ps(triangle[7]), e2z = _mm512_set1_ps(triangle[8]);
+			size_t hits = 0;
+
+			for (size_t i = 0; i < n; i += 16)
+			{
+				__mmask16 lanes = n - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (n - i)) - 1);
+				__m512 rdx = _mm512_maskz_loadu_ps(lanes, dx + i);
+				__m512 rdy = _mm512_maskz_loadu_ps(lanes, dy + i);
+				__m512 rdz = _mm512_maskz_loadu_ps(lanes, dz + i);
+
+				__m512 px = _mm512_sub_ps(_mm512_mul_ps(rdy, e2z), _mm512_mul_ps(rdz, e2y));
+				__m512 py = _mm512_sub_ps(_mm512_mul_ps(rdz, e2x), _mm512_mul_ps(rdx, e2z));
+				__m512 pz = _mm512_sub_ps(_mm512_mul_ps(rdx, e2y), _mm512_mul_ps(rdy, e2x));
+				__m512 det = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e1x, px), _mm512_mul_ps(e1y, py)), _mm512_mul_ps(e1z, pz));
+				__m512 inv = _mm512_div_ps(one, det);
+
+				__m512 sx = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, ox + i), v0x);
+				__m512 sy = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, oy + i), v0y);
+				__m512 sz = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, oz + i), v0z);
+				__m512 hitU = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(sx, px), _mm512_mul_ps(sy, py)),
+					_mm512_mul_ps(sz, pz)), inv);
+
+				__m512 qx = _mm512_sub_ps(_mm512_mul_ps(sy, e1z), _mm512_mul_ps(sz, e1y));
+				__m512 qy = _mm512_sub_ps(_mm512_mul_ps(sz, e1x), _mm512_mul_ps(sx, e1z));
+				__m512 qz = _mm512_sub_ps(_mm512_mul_ps(sx, e1y), _mm512_mul_ps(sy, e1x));
+				__m512 hitV = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(rdx, qx), _mm512_mul_ps(rdy, qy)),
+					_mm512_mul_ps(rdz, qz)), inv);
+				__m512 hitT = _mm512_mul_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(e2x, qx), _mm512_mul_ps(e2y, qy)),
+					_mm512_mul_ps(e2z, qz)), inv);
+
+				__m512 previous = _mm512_maskz_loadu_ps(lanes, distance + i);
+				__mmask16 mask = lanes & _mm512_cmp_ps_mask(det, zero, _CMP_NEQ_UQ) &
+					_mm512_cmp_ps_mask(hitU, zero, _CMP_GE_OQ) & _mm512_cmp_ps_mask(hitV, zero, _CMP_GE_OQ) &
+					_mm512_cmp_ps_mask(_mm512_add_ps(hitU, hitV), one, _CMP_LE_OQ) &
+					_mm512_cmp_ps_mask(hitT, zero, _CMP_GT_OQ) & _mm512_cmp_ps_mask(hitT, previous, _CMP_LT_OQ);
+
+				// only the lanes that hit are written
+				_mm512_mask_storeu_ps(distance + i, mask, hitT);
+				_mm512_mask_storeu_ps(u + i, mask, hitU);
+				_mm512_mask_storeu_ps(v + i, mask, hitV);
+				_mm512_mask_storeu_epi32(hitTriangles + i, mask, ids);
+
+				hits += __builtin_popcount(mask);
+			}
+
+			return hits;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,1260 @@
+#ifndef KERNELS_SCALAR_HPP
+#define KERNELS_SCALAR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Portable scalar kernels operating on raw float arrays. Matrices are
+ * 16 floats in the same row-major [y][x] layout as Matrix4x4::matrix.
+ * The matrix and quaternion kernels are templates over the scalar type
+ * so that the double versions of the classes can share them; the kernel
+ * table only ever instantiates them for float.
+ *
+ * These are the reference implementations that every SIMD kernel must
+ * reproduce. Kernels have internal linkage so that translation units
+ * built for different instruction sets never share a definition.
+ */
+namespace math3d
+{
+	namespace detail
+	{
+		/** @brief out = a * b for two 4x4 matrices; out must not alias a or b */
+		template <typename T>
+		static inline void mat4MulScalar(T* out, const T* a, const T* b)
+		{
+			for (int y = 0; y < 4; y++)
+			{
+				for (int x = 0; x < 4; x++)
+				{
+					out[y * 4 + x] = a[y * 4 + 0] * b[0 * 4 + x] +
+									a[y * 4 + 1] * b[1 * 4 + x] +
+									a[y * 4 + 2] * b[2 * 4 + x] +
+									a[y * 4 + 3] * b[3 * 4 + x];
+				}
+			}
+		}
+
+		/** @brief transforms the point v (x, y, z, 1) by m, writing (x, y, z) to out */
+		template <typename T>
+		static inline void mat4TransformPointScalar(T* out, const T* m, const T* v)
+		{
+			T x = v[0];
+			T y = v[1];
+			T z = v[2];
+
+			out[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+			out[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+			out[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+		}
+
+		/** @brief calculates the determinant of the upper 3x3 of m */
+		template <typename T>
+		static inline T mat4DeterminantScalar(const T* m)
+		{
+			return -m[2] * m[5] * m[8] + m[1] * m[6] * m[8]
+				+ m[2] * m[4] * m[9] - m[0] * m[6] * m[9]
+				- m[1] * m[4] * m[10] + m[0] * m[5] * m[10];
+		}
+
+		/**
+		 * Inverts the affine 3x4 matrix m (an upper 3x3 and a translation
+		 * in its last column); out must not alias m
+		 */
+		template <typename T>
+		static inline void affineInverseScalar(T* out, const T* m)
+		{
+			T k = 1.0f / mat4DeterminantScalar(m);
+
+			out[0] = (m[5] * m[10] - m[9] * m[6]) * k;
+			out[1] = (m[9] * m[2] - m[1] * m[10]) * k;
+			out[2] = (m[1] * m[6] - m[5] * m[2]) * k;
+			out[4] = (m[6] * m[8] - m[10] * m[4]) * k;
+			out[5] = (m[10] * m[0] - m[2] * m[8]) * k;
+			out[6] = (m[2] * m[4] - m[6] * m[0]) * k;
+			out[8] = (m[4] * m[9] - m[8] * m[5]) * k;
+			out[9] = (m[8] * m[1] - m[0] * m[9]) * k;
+			out[10] = (m[0] * m[5] - m[4] * m[1]) * k;
+
+			out[3] = -(out[0] * m[3] + out[1] * m[7] + out[2] * m[11]);
+			out[7] = -(out[4] * m[3] + out[5] * m[7] + out[6] * m[11]);
+			out[11] = -(out[8] * m[3] + out[9] * m[7] + out[10] * m[11]);
+		}
+
+		/**
+		 * Inverts the affine 3x4 matrix m assuming its upper 3x3 is a pure
+		 * rotation, by transposing it; out must not alias m
+		 */
+		template <typename T>
+		static inline void affineInverseRigidScalar(T* out, const T* m)
+		{
+			out[0] = m[0];
+			out[1] = m[4];
+			out[2] = m[8];
+			out[4] = m[1];
+			out[5] = m[5];
+			out[6] = m[9];
+			out[8] = m[2];
+			out[9] = m[6];
+			out[10] = m[10];
+
+			out[3] = -(out[0] * m[3] + out[1] * m[7] + out[2] * m[11]);
+			out[7] = -(out[4] * m[3] + out[5] * m[7] + out[6] * m[11]);
+			out[11] = -(out[8] * m[3] + out[9] * m[7] + out[10] * m[11]);
+		}
+
+		/**
+		 * out = a * b for two affine 3x4 matrices, treating their bottom
+		 * rows as (0, 0, 0, 1); out may alias a or b
+		 */
+		template <typename T>
+		static inline void affineMulScalar(T* out, const T* a, const T* b)
+		{
+			T result[12];
+
+			for (int y = 0; y < 3; y++)
+			{
+				for (int x = 0; x < 4; x++)
+				{
+					result[y * 4 + x] = a[y * 4 + 0] * b[x] + a[y * 4 + 1] * b[4 + x] + a[y * 4 + 2] * b[8 + x];
+				}
+
+				result[y * 4 + 3] += a[y * 4 + 3];
+			}
+
+			for (int i = 0; i < 12; i++)
+			{
+				out[i] = result[i];
+			}
+		}
+
+		/**
+		 * Inverts the general 4x4 matrix m from its adjugate, built out of the
+		 * 2x2 determinants of its top two rows (s) and bottom two rows (c).
+		 * Each element of the adjugate is (x * k1 - y * k2 + z * k3), possibly
+		 * negated, in the order that mat4InverseSSE computes its lanes.
+		 * out may alias m.
+		 */
+		template <typename T>
+		static inline void mat4InverseScalar(T* out, const T* m)
+		{
+			T s[6], c[6], adj[16];
+
+			s[0] = m[0] * m[5] - m[1] * m[4];
+			s[1] = m[0] * m[6] - m[2] * m[4];
+			s[2] = m[0] * m[7] - m[3] * m[4];
+			s[3] = m[1] * m[6] - m[2] * m[5];
+			s[4] = m[1] * m[7] - m[3] * m[5];
+			s[5] = m[2] * m[7] - m[3] * m[6];
+
+			c[0] = m[8] * m[13] - m[9] * m[12];
+			c[1] = m[8] * m[14] - m[10] * m[12];
+			c[2] = m[8] * m[15] - m[11] * m[12];
+			c[3] = m[9] * m[14] - m[10] * m[13];
+			c[4] = m[9] * m[15] - m[11] * m[13];
+			c[5] = m[10] * m[15] - m[11] * m[14];
+
+			adj[0] = m[5] * c[5] - m[6] * c[4] + m[7] * c[3];
+			adj[1] = -(m[1] * c[5] - m[2] * c[4] + m[3] * c[3]);
+			adj[2] = m[13] * s[5] - m[14] * s[4] + m[15] * s[3];
+			adj[3] = -(m[9] * s[5] - m[10] * s[4] + m[11] * s[3]);
+
+			adj[4] = -(m[4] * c[5] - m[6] * c[2] + m[7] * c[1]);
+			adj[5] = m[0] * c[5] - m[2] * c[2] + m[3] * c[1];
+			adj[6] = -(m[12] * s[5] - m[14] * s[2] + m[15] * s[1]);
+			adj[7] = m[8] * s[5] - m[10] * s[2] + m[11] * s[1];
+
+			adj[8] = m[4] * c[4] - m[5] * c[2] + m[7] * c[0];
+			adj[9] = -(m[0] * c[4] - m[1] * c[2] + m[3] * c[0]);
+			adj[10] = m[12] * s[4] - m[13] * s[2] + m[15] * s[0];
+			adj[11] = -(m[8] * s[4] - m[9] * s[2] + m[11] * s[0]);
+
+			adj[12] = -(m[4] * c[3] - m[5] * c[1] + m[6] * c[0]);
+			adj[13] = m[0] * c[3] - m[1] * c[1] + m[2] * c[0];
+			adj[14] = -(m[12] * s[3] - m[13] * s[1] + m[14] * s[0]);
+			adj[15] = m[8] * s[3] - m[9] * s[1] + m[10] * s[0];
+
+			// expand the determinant along the first row of m
+			T det = m[0] * adj[0] + m[1] * adj[4] + m[2] * adj[8] + m[3] * adj[12];
+			T k = 1.0f / det;
+
+			for (int i = 0; i < 16; i++)
+			{
+				out[i] = adj[i] * k;
+			}
+		}
+
+		/**
+		 * Inverts the upper 3x3 of m and the translation in its last column,
+		 * copying the bottom row; out must not alias m
+		 */
+		template <typename T>
+		static inline void mat4InverseAffineScalar(T* out, const T* m)
+		{
+			affineInverseScalar(out, m);
+
+			out[12] = m[12];
+			out[13] = m[13];
+			out[14] = m[14];
+			out[15] = m[15];
+		}
+
+		/** @brief out = a * b for two (x, y, z, w) quaternions */
+		template <typename T>
+		static inline void quatMulScalar(T* out, const T* a, const T* b)
+		{
+			T nx = a[0] * b[3] + a[3] * b[0] + a[1] * b[2] - a[2] * b[1];
+			T ny = a[1] * b[3] + a[3] * b[1] + a[2] * b[0] - a[0] * b[2];
+			T nz = a[2] * b[3] + a[3] * b[2] + a[0] * b[1] - a[1] * b[0];
+			T nw = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+
+			out[0] = nx;
+			out[1] = ny;
+			out[2] = nz;
+			out[3] = nw;
+		}
+
+		/** @brief divides the (x, y, z, w) quaternion q by its magnitude */
+		template <typename T>
+		static inline void quatNormalizeScalar(T* out, const T* q)
+		{
+			T mag = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+			out[0] = q[0] / mag;
+			out[1] = q[1] / mag;
+			out[2] = q[2] / mag;
+			out[3] = q[3] / mag;
+		}
+
+		/**
+		 * 1 / sqrt(x), which Precision::Fast uses in place of a hardware
+		 * estimate on targets without one or for types other than float
+		 */
+		template <typename T>
+		static inline T rsqrtScalar(T x)
+		{
+			return 1 / std::sqrt(x);
+		}
+
+		/**
+		 * quatNormalizeScalar with Precision::Fast: one reciprocal square
+		 * root and 4 multiplications instead of 4 divisions
+		 */
+		template <typename T>
+		static inline void quatNormalizeFastScalar(T* out, const T* q)
+		{
+			T invMag = rsqrtScalar(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+			out[0] = q[0] * invMag;
+			out[1] = q[1] * invMag;
+			out[2] = q[2] * invMag;
+			out[3] = q[3] * invMag;
+		}
+
+		/**
+		 * Constants of the float sine, cosine and arctangent approximations
+		 * (the Cephes sinf/cosf/atanf polynomials). Arguments are reduced
+		 * to [-pi/4, pi/4] by subtracting a multiple of pi/4 in three parts
+		 * (Cody-Waite), so that the reduction stays exact for |a| <= 8192.
+		 */
+		static const float TRIG_4_OVER_PI = 1.27323954473516f;
+		static const float TRIG_PI_4_A = 0.78515625f;
+		static const float TRIG_PI_4_B = 2.4187564849853515625e-4f;
+		static const float TRIG_PI_4_C = 3.77489497744594108e-8f;
+		static const float TRIG_SIN_0 = -1.9515295891e-4f;
+		static const float TRIG_SIN_1 = 8.3321608736e-3f;
+		static const float TRIG_SIN_2 = -1.6666654611e-1f;
+		static const float TRIG_COS_0 = 2.443315711809948e-5f;
+		static const float TRIG_COS_1 = -1.388731625493765e-3f;
+		static const float TRIG_COS_2 = 4.166664568298827e-2f;
+		static const float TRIG_TAN_PI_8 = 0.4142135623730950f;
+		static const float TRIG_TAN_3PI_8 = 2.414213562373095f;
+		static const float TRIG_ATAN_0 = 8.05374449538e-2f;
+		static const float TRIG_ATAN_1 = -1.38776856032e-1f;
+		static const float TRIG_ATAN_2 = 1.99777106478e-1f;
+		static const float TRIG_ATAN_3 = -3.33329491539e-1f;
+		static const float TRIG_PI = 3.14159265358979f;
+		static const float TRIG_PI_2 = 1.57079632679490f;
+		static const float TRIG_PI_4 = 0.78539816339745f;
+
+		/**
+		 * Calculates sin(a) and cos(a) with float arithmetic only, to within
+		 * a few ulp of the exact values
+		 *
+		 * Note: a must be finite and |a| <= 8192, beyond which the reduction
+		 * loses accuracy
+		 */
+		static inline void sincosScalar(float a, float& s, float& c)
+		{
+			float x = std::fabs(a);
+			// the octant, rounded up to even so that x ends up in [-pi/4, pi/4]
+			int j = (int)(x * TRIG_4_OVER_PI);
+			j = (j + 1) & ~1;
+
+			float y = (float)j;
+			x = ((x - y * TRIG_PI_4_A) - y * TRIG_PI_4_B) - y * TRIG_PI_4_C;
+
+			float z = x * x;
+			float sinPoly = ((TRIG_SIN_0 * z + TRIG_SIN_1) * z + TRIG_SIN_2) * z * x + x;
+			float cosPoly = ((TRIG_COS_0 * z + TRIG_COS_1) * z + TRIG_COS_2) * z * z - 0.5f * z + 1;
+
+			// odd quadrants swap the polynomials, and the quadrant sets the signs
+			bool swap = (j & 2) != 0;
+			s = swap ? cosPoly : sinPoly;
+			c = swap ? sinPoly : cosPoly;
+
+			if ((a < 0) != ((j & 4) != 0))
+			{
+				s = -s;
+			}
+
+			if (((j + 2) & 4) != 0)
+			{
+				c = -c;
+			}
+		}
+
+		/** @brief sin and cos for types other than float, which keep the standard library */
+		template <typename T>
+		static inline void sincosScalar(T a, T& s, T& c)
+		{
+			s = std::sin(a);
+			c = std::cos(a);
+		}
+
+		/** @brief calculates atan(a) with float arithmetic only, to within a few ulp */
+		static inline float atanScalar(float a)
+		{
+			float x = std::fabs(a);
+			bool large = x > TRIG_TAN_3PI_8;
+			bool medium = x > TRIG_TAN_PI_8;
+
+			// reduces x to [-tan(pi/8), tan(pi/8)] with a single division:
+			// atan(x) = pi/2 + atan(-1/x) = pi/4 + atan((x - 1) / (x + 1))
+			float num = large ? -1.0f : (medium ? x - 1 : x);
+			float den = large ? x : (medium ? x + 1 : 1.0f);
+			float offset = large ? TRIG_PI_2 : (medium ? TRIG_PI_4 : 0.0f);
+
+			x = num / den;
+
+			float z = x * x;
+			float r = offset + ((((TRIG_ATAN_0 * z + TRIG_ATAN_1) * z + TRIG_ATAN_2) * z + TRIG_ATAN_3) * z * x + x);
+
+			return a < 0 ? -r : r;
+		}
+
+		/**
+		 * Calculates atan2(y, x) with float arithmetic only, to within a few
+		 * ulp. atan2(0, 0) is 0.
+		 */
+		static inline float atan2Scalar(float y, float x)
+		{
+			float offset = x < 0 ? (y < 0 ? -TRIG_PI : TRIG_PI) : 0.0f;
+			float r = offset + atanScalar(y / x);
+
+			return x == 0 && y == 0 ? 0.0f : r;
+		}
+
+		/** @brief out[i] = a[i] + b[i] for n floats */
+		static inline void streamAddScalar(float* out, const float* a, const float* b, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] - b[i] for n floats */
+		static inline void streamSubScalar(float* out, const float* a, const float* b, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = a[i] - b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * b[i] for n floats */
+		static inline void streamMulScalar(float* out, const float* a, const float* b, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * s for n floats */
+		static inline void streamScaleScalar(float* out, const float* a, float s, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = a[i] * s;
+			}
+		}
+
+		/** @brief out[i] = a[i] + (b[i] - a[i]) * t[i] for n floats */
+		static inline void streamLerpScalar(float* out, const float* a, const float* b, const float* t, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = a[i] + (b[i] - a[i]) * t[i];
+			}
+		}
+
+		/**
+		 * Batch kernels for n vectors stored as separate x, y and z streams
+		 * (structure-of-arrays). Outputs may alias inputs element-for-element.
+		 */
+
+		/** @brief out[i] = dot(a[i], b[i]) */
+		static inline void vec3DotScalar(float* out, const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+			}
+		}
+
+		/** @brief o[i] = cross(a[i], b[i]) */
+		static inline void vec3CrossScalar(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				float x1 = ax[i], y1 = ay[i], z1 = az[i];
+				float x2 = bx[i], y2 = by[i], z2 = bz[i];
+
+				ox[i] = y1 * z2 - z1 * y2;
+				oy[i] = z1 * x2 - x1 * z2;
+				oz[i] = x1 * y2 - y1 * x2;
+			}
+		}
+
+		/** @brief out[i] = magSq(a[i]) */
+		static inline void vec3MagSqScalar(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i];
+			}
+		}
+
+		/** @brief out[i] = magnitude(a[i]) */
+		static inline void vec3MagnitudeScalar(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = sqrtf(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+			}
+		}
+
+		/** @brief o[i] = normalize(a[i]) */
+		static inline void vec3NormalizeScalar(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				float x = ax[i], y = ay[i], z = az[i];
+				float mag = sqrtf(x * x + y * y + z * z);
+
+				ox[i] = x / mag;
+				oy[i] = y / mag;
+				oz[i] = z / mag;
+			}
+		}
+
+		/**
+		 * vec3NormalizeScalar with Precision::Fast: one reciprocal square
+		 * root and 3 multiplications instead of 3 divisions
+		 */
+		static inline void vec3NormalizeFastScalar(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				float x = ax[i], y = ay[i], z = az[i];
+				float invMag = rsqrtScalar(x * x + y * y + z * z);
+
+				ox[i] = x * invMag;
+				oy[i] = y * invMag;
+				oz[i] = z * invMag;
+			}
+		}
+
+		/** @brief o[i] = m * (a[i], 1) for n SoA points; o may alias a */
+		template <typename T>
+		static inline void mat4TransformPointsScalar(T* ox, T* oy, T* oz, const T* m,
+			const T* ax, const T* ay, const T* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T x = ax[i], y = ay[i], z = az[i];
+
+				ox[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+				oy[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+				oz[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+			}
+		}
+
+		/** @brief o[i] = m * (a[i], 0) for n SoA directions, ignoring translation; o may alias a */
+		template <typename T>
+		static inline void mat4TransformDirectionsScalar(T* ox, T* oy, T* oz, const T* m,
+			const T* ax, const T* ay, const T* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T x = ax[i], y = ay[i], z = az[i];
+
+				ox[i] = m[0] * x + m[1] * y + m[2] * z;
+				oy[i] = m[4] * x + m[5] * y + m[6] * z;
+				oz[i] = m[8] * x + m[9] * y + m[10] * z;
+			}
+		}
+
+		/**
+		 * o[i] = m * (a[i], 1) divided by its w component, for n SoA points
+		 * such as those transformed by a projection matrix; o may alias a
+		 */
+		template <typename T>
+		static inline void mat4TransformHomogeneousScalar(T* ox, T* oy, T* oz, const T* m,
+			const T* ax, const T* ay, const T* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T x = ax[i], y = ay[i], z = az[i];
+				T w = m[12] * x + m[13] * y + m[14] * z + m[15];
+
+				ox[i] = (m[0] * x + m[1] * y + m[2] * z + m[3]) / w;
+				oy[i] = (m[4] * x + m[5] * y + m[6] * z + m[7]) / w;
+				oz[i] = (m[8] * x + m[9] * y + m[10] * z + m[11]) / w;
+			}
+		}
+
+		/**
+		 * Rotates (x, y, z) by the unit quaternion (qx, qy, qz, qw) like
+		 * Vector3::rotateBy: with u = (qx, qy, qz) and t = cross(u, v) * 2,
+		 * the result is v + t * qw + cross(u, t)
+		 */
+		template <typename T>
+		static inline void quatRotateScalar(T& ox, T& oy, T& oz, T qx, T qy, T qz, T qw, T x, T y, T z)
+		{
+			T tx = (qy * z - qz * y) * 2;
+			T ty = (qz * x - qx * z) * 2;
+			T tz = (qx * y - qy * x) * 2;
+
+			ox = x + tx * qw + (qy * tz - qz * ty);
+			oy = y + ty * qw + (qz * tx - qx * tz);
+			oz = z + tz * qw + (qx * ty - qy * tx);
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q) for n SoA vectors and one (x, y, z, w) quaternion; o may alias a */
+		template <typename T>
+		static inline void quatRotateVectorsScalar(T* ox, T* oy, T* oz, const T* q,
+			const T* ax, const T* ay, const T* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				quatRotateScalar(ox[i], oy[i], oz[i], q[0], q[1], q[2], q[3], ax[i], ay[i], az[i]);
+			}
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q[i]) for n SoA vectors and quaternions; o may alias a */
+		template <typename T>
+		static inline void quatsRotateVectorsScalar(T* ox, T* oy, T* oz,
+			const T* qx, const T* qy, const T* qz, const T* qw, const T* ax, const T* ay, const T* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				quatRotateScalar(ox[i], oy[i], oz[i], qx[i], qy[i], qz[i], qw[i], ax[i], ay[i], az[i]);
+			}
+		}
+
+		/** @brief the cosine above which quatSlerp falls back to nlerp, as sin(angle) approaches 0 */
+		static const float QUAT_SLERP_THRESHOLD = 1 - 1e-3f;
+
+		/**
+		 * o[i] = a[i].nlerp(b[i], t[i]) for n SoA (x, y, z, w) quaternions,
+		 * taking the shortest path like Quaternion::nlerp; o may alias a or b
+		 */
+		static inline void quatNlerpScalar(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, const float* aw,
+			const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				float x1 = ax[i], y1 = ay[i], z1 = az[i], w1 = aw[i];
+				float x2 = bx[i], y2 = by[i], z2 = bz[i], w2 = bw[i];
+
+				if (x1 * x2 + y1 * y2 + z1 * z2 + w1 * w2 < 0)
+				{
+					x2 = -x2;
+					y2 = -y2;
+					z2 = -z2;
+					w2 = -w2;
+				}
+
+				float x = x1 + (x2 - x1) * t[i];
+				float y = y1 + (y2 - y1) * t[i];
+				float z = z1 + (z2 - z1) * t[i];
+				float w = w1 + (w2 - w1) * t[i];
+				float mag = sqrtf(x * x + y * y + z * z + w * w);
+
+				ox[i] = x / mag;
+				oy[i] = y / mag;
+				oz[i] = z / mag;
+				ow[i] = w / mag;
+			}
+		}
+
+		/**
+		 * o[i] = a[i].slerp(b[i], t[i]) for n SoA (x, y, z, w) unit quaternions,
+		 * taking the shortest path like Quaternion::slerp; o may alias a or b.
+		 * The angles and sines use the float approximations of sincosScalar
+		 * and atan2Scalar so that the SIMD kernels can match them.
+		 */
+		static inline void quatSlerpScalar(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, const float* aw,
+			const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				float x1 = ax[i], y1 = ay[i], z1 = az[i], w1 = aw[i];
+				float x2 = bx[i], y2 = by[i], z2 = bz[i], w2 = bw[i];
+				float cs = x1 * x2 + y1 * y2 + z1 * z2 + w1 * w2;
+
+				if (cs < 0)
+				{
+					cs = -cs;
+					x2 = -x2;
+					y2 = -y2;
+					z2 = -z2;
+					w2 = -w2;
+				}
+
+				if (cs >= QUAT_SLERP_THRESHOLD)
+				{
+					quatNlerpScalar(ox + i, oy + i, oz + i, ow + i, &x1, &y1, &z1, &w1, &x2, &y2, &z2, &w2, t + i, 1);
+					continue;
+				}
+
+				float sn = sqrtf(1 - cs * cs);
+				float invSin = 1 / sn;
+				float angle = atan2Scalar(sn, cs);
+				float srcSin, destSin, unused;
+
+				sincosScalar((1 - t[i]) * angle, srcSin, unused);
+				sincosScalar(t[i] * angle, destSin, unused);
+
+				float srcFactor = srcSin * invSin;
+				float destFactor = destSin * invSin;
+
+				ox[i] = x1 * srcFactor + x2 * destFactor;
+				oy[i] = y1 * srcFactor + y2 * destFactor;
+				oz[i] = z1 * srcFactor + z2 * destFactor;
+				ow[i] = w1 * srcFactor + w2 * destFactor;
+			}
+		}
+
+		/** @brief s[i] = sin(a[i]) and c[i] = cos(a[i]) for n floats, see sincosScalar */
+		static inline void streamSinCosScalar(float* s, float* c, const float* a, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				sincosScalar(a[i], s[i], c[i]);
+			}
+		}
+
+		/** @brief out[i] = atan2(y[i], x[i]) for n floats, see atan2Scalar */
+		static inline void streamAtan2Scalar(float* out, const float* y, const float* x, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = atan2Scalar(y[i], x[i]);
+			}
+		}
+
+		/**
+		 * o[i] = Quaternion::fromEulerAngles(a[i]) for n SoA (x, y, z) euler
+		 * angles, with the sines and cosines of sincosScalar for float
+		 */
+		template <typename T>
+		static inline void quatFromEulerAnglesScalar(T* ox, T* oy, T* oz, T* ow,
+			const T* ax, const T* ay, const T* az, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T sin1, cos1, sin2, cos2, sin3, cos3;
+
+				sincosScalar(ax[i] / 2, sin1, cos1);
+				sincosScalar(az[i] / 2, sin2, cos2);
+				sincosScalar(ay[i] / 2, sin3, cos3);
+
+				T s1s2 = sin1 * sin2;
+				T c1c2 = cos1 * cos2;
+				T s1c2 = sin1 * cos2;
+				T c1s2 = cos1 * sin2;
+
+				ox[i] = s1c2 * cos3 + c1s2 * sin3;
+				oy[i] = c1c2 * sin3 + s1s2 * cos3;
+				oz[i] = c1s2 * cos3 - s1c2 * sin3;
+				ow[i] = c1c2 * cos3 - s1s2 * sin3;
+			}
+		}
+
+		/**
+		 * o[i] = Quaternion::fromAxisAngle(axis[i], angle[i]) for n SoA unit
+		 * axes, with the sines and cosines of sincosScalar for float
+		 */
+		template <typename T>
+		static inline void quatFromAxisAngleScalar(T* ox, T* oy, T* oz, T* ow,
+			const T* axisX, const T* axisY, const T* axisZ, const T* angle, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T sinHalfA, cosHalfA;
+
+				sincosScalar(angle[i] / 2, sinHalfA, cosHalfA);
+
+				ox[i] = axisX[i] * sinHalfA;
+				oy[i] = axisY[i] * sinHalfA;
+				oz[i] = axisZ[i] * sinHalfA;
+				ow[i] = cosHalfA;
+			}
+		}
+
+		/**
+		 * Linear blend skinning of n SoA points: each point is transformed by
+		 * the weighted sum of the bone matrices selected by its influences
+		 * (1 to 4) streams of bone indices and weights. The palette holds 3x4
+		 * matrices stride floats apart, so 12 for Affine3x4 and 16 for
+		 * Matrix4x4. o may alias p.
+		 */
+		static inline void skinLinearScalar(float* ox, float* oy, float* oz,
+			const float* px, const float* py, const float* pz,
+			const uint16_t* const* indices, const float* const* weights, int influences,
+			const float* palette, size_t stride, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				const float* bone = palette + indices[0][i] * stride;
+				float w = weights[0][i];
+				float m[12];
+
+				for (int j = 0; j < 12; j++)
+				{
+					m[j] = bone[j] * w;
+				}
+
+				for (int k = 1; k < influences; k++)
+				{
+					bone = palette + indices[k][i] * stride;
+					w = weights[k][i];
+
+					for (int j = 0; j < 12; j++)
+					{
+						m[j] = m[j] + bone[j] * w;
+					}
+				}
+
+				float x = px[i], y = py[i], z = pz[i];
+
+				ox[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+				oy[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+				oz[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+			}
+		}
+
+		/**
+		 * Dual quaternion skinning of n SoA points, with the influences of
+		 * skinLinearScalar. The palette holds 8 floats per bone, the real
+		 * and then the dual (x, y, z, w) quaternion of a unit DualQuaternion.
+		 * o may alias p.
+		 */
+		static inline void skinDualQuatScalar(float* ox, float* oy, float* oz,
+			const float* px, const float* py, const float* pz,
+			const uint16_t* const* indices, const float* const* weights, int influences,
+			const float* palette, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				const float* pivot = palette + indices[0][i] * 8;
+				float w = weights[0][i];
+				float q[8];
+
+				for (int j = 0; j < 8; j++)
+				{
+					q[j] = pivot[j] * w;
+				}
+
+				for (int k = 1; k < influences; k++)
+				{
+					const float* bone = palette + indices[k][i] * 8;
+					w = weights[k][i];
+
+					// q and -q are the same rotation; blend the one nearest the first bone
+					if (bone[0] * pivot[0] + bone[1] * pivot[1] + bone[2] * pivot[2] + bone[3] * pivot[3] < 0)
+					{
+						w = -w;
+					}
+
+					for (int j = 0; j < 8; j++)
+					{
+						q[j] = q[j] + bone[j] * w;
+					}
+				}
+
+				float mag = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+				float rx = q[0] / mag, ry = q[1] / mag, rz = q[2] / mag, rw = q[3] / mag;
+				float dx = q[4] / mag, dy = q[5] / mag, dz = q[6] / mag, dw = q[7] / mag;
+				float x = px[i], y = py[i], z = pz[i];
+
+				// the same steps as DualQuaternion::transformPoint
+				float tx = (ry * z - rz * y) + rw * x;
+				float ty = (rz * x - rx * z) + rw * y;
+				float tz = (rx * y - ry * x) + rw * z;
+
+				float cx = ry * tz - rz * ty;
+				float cy = rz * tx - rx * tz;
+				float cz = rx * ty - ry * tx;
+
+				float ux = (rw * dx - dw * rx) + (ry * dz - rz * dy);
+				float uy = (rw * dy - dw * ry) + (rz * dx - rx * dz);
+				float uz = (rw * dz - dw * rz) + (rx * dy - ry * dx);
+
+				ox[i] = x + (cx + ux) * 2;
+				oy[i] = y + (cy + uy) * 2;
+				oz[i] = z + (cz + uz) * 2;
+			}
+		}
+
+		/**
+		 * The largest magnitude that the 3 smallest components of a unit
+		 * quaternion can have, 1 / sqrt(2), which sets the range they are
+		 * quantized over
+		 */
+		static const float QUAT_PACK_RANGE = 0.70710678f;
+
+		/** @brief maps a component in [-QUAT_PACK_RANGE, QUAT_PACK_RANGE] to an integer in [0, max] */
+		static inline int quantizeQuatComponentScalar(float v, float max)
+		{
+			float t = (v * (0.5f / QUAT_PACK_RANGE) + 0.5f) * max;
+
+			t = t > 0 ? t : 0;
+			t = t < max ? t : max;
+
+			return (int)(t + 0.5f);
+		}
+
+		/** @brief maps an integer from quantizeQuatComponentScalar back to a component */
+		static inline float dequantizeQuatComponentScalar(int v, float invMax)
+		{
+			return ((float)v * invMax - 0.5f) * (2 * QUAT_PACK_RANGE);
+		}
+
+		/**
+		 * Quantizes the 3 smallest components of a unit quaternion to
+		 * integers in [0, max], negating them if the largest component is
+		 * negative since q and -q are the same rotation
+		 *
+		 * @return the index (0 to 3 for x to w) of the largest component
+		 */
+		static inline int quatSmallestThreeScalar(float x, float y, float z, float w, float max, int& a, int& b, int& c)
+		{
+			int index = 0;
+			float largest = x, m = fabsf(x);
+
+			if (fabsf(y) > m)
+			{
+				index = 1;
+				largest = y;
+				m = fabsf(y);
+			}
+
+			if (fabsf(z) > m)
+			{
+				index = 2;
+				largest = z;
+				m = fabsf(z);
+			}
+
+			if (fabsf(w) > m)
+			{
+				index = 3;
+				largest = w;
+			}
+
+			float sa = index == 0 ? y : x;
+			float sb = index <= 1 ? z : y;
+			float sc = index <= 2 ? w : z;
+
+			if (largest < 0)
+			{
+				sa = -sa;
+				sb = -sb;
+				sc = -sc;
+			}
+
+			a = quantizeQuatComponentScalar(sa, max);
+			b = quantizeQuatComponentScalar(sb, max);
+			c = quantizeQuatComponentScalar(sc, max);
+
+			return index;
+		}
+
+		/**
+		 * Rebuilds a unit quaternion from its 3 smallest components and the
+		 * index of the largest, which is recovered as the positive square
+		 * root of 1 minus the squares of the others
+		 */
+		static inline void quatFromSmallestThreeScalar(float& x, float& y, float& z, float& w,
+			int index, float a, float b, float c)
+		{
+			float s = 1 - (a * a + b * b + c * c);
+			float largest = sqrtf(s > 0 ? s : 0);
+
+			x = index == 0 ? largest : a;
+			y = index == 0 ? a : index == 1 ? largest : b;
+			z = index <= 1 ? b : index == 2 ? largest : c;
+			w = index == 3 ? largest : c;
+		}
+
+		/**
+		 * Packs n SoA unit quaternions into 32 bits each: the index of the
+		 * largest component in the top 2 bits, then the other 3 as 10 bits
+		 */
+		static inline void quatPack32Scalar(uint32_t* out, const float* x, const float* y, const float* z,
+			const float* w, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				int a, b, c;
+				int index = quatSmallestThreeScalar(x[i], y[i], z[i], w[i], 1023, a, b, c);
+
+				out[i] = (uint32_t)index << 30 | (uint32_t)a << 20 | (uint32_t)b << 10 | (uint32_t)c;
+			}
+		}
+
+		/** @brief unpacks n quaternions packed by quatPack32Scalar into SoA streams */
+		static inline void quatUnpack32Scalar(float* x, float* y, float* z, float* w, const uint32_t* in, size_t n)
+		{
+			const float invMax = 1.0f / 1023;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				uint32_t v = in[i];
+
+				quatFromSmallestThreeScalar(x[i], y[i], z[i], w[i], (int)(v >> 30),
+					dequantizeQuatComponentScalar((int)(v >> 20 & 1023), invMax),
+					dequantizeQuatComponentScalar((int)(v >> 10 & 1023), invMax),
+					dequantizeQuatComponentScalar((int)(v & 1023), invMax));
+			}
+		}
+
+		/**
+		 * Packs n SoA unit quaternions into 3 16-bit words each, with the 3
+		 * smallest components as 15 bits in the low bits of each word and
+		 * the index of the largest in the top bits of the first two
+		 */
+		static inline void quatPack48Scalar(uint16_t* out, const float* x, const float* y, const float* z,
+			const float* w, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				int a, b, c;
+				int index = quatSmallestThreeScalar(x[i], y[i], z[i], w[i], 32767, a, b, c);
+
+				out[3 * i] = (uint16_t)((index >> 1) << 15 | a);
+				out[3 * i + 1] = (uint16_t)((index & 1) << 15 | b);
+				out[3 * i + 2] = (uint16_t)c;
+			}
+		}
+
+		/** @brief unpacks n quaternions packed by quatPack48Scalar into SoA streams */
+		static inline void quatUnpack48Scalar(float* x, float* y, float* z, float* w, const uint16_t* in, size_t n)
+		{
+			const float invMax = 1.0f / 32767;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				int w0 = in[3 * i], w1 = in[3 * i + 1], w2 = in[3 * i + 2];
+
+				quatFromSmallestThreeScalar(x[i], y[i], z[i], w[i], (w0 >> 15) << 1 | w1 >> 15,
+					dequantizeQuatComponentScalar(w0 & 32767, invMax),
+					dequantizeQuatComponentScalar(w1 & 32767, invMax),
+					dequantizeQuatComponentScalar(w2 & 32767, invMax));
+			}
+		}
+
+		/**
+		 * out[i] = a[i] quantized to 16 bits over a range starting at min,
+		 * where invStep is 65535 divided by the width of the range; values
+		 * outside of the range clamp to its ends
+		 */
+		static inline void streamQuantize16Scalar(uint16_t* out, const float* a, float min, float invStep, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				float t = (a[i] - min) * invStep;
+
+				t = t > 0 ? t : 0;
+				t = t < 65535 ? t : 65535;
+
+				out[i] = (uint16_t)(int)(t + 0.5f);
+			}
+		}
+
+		/** @brief out[i] = min + a[i] * step, the inverse of streamQuantize16Scalar */
+		static inline void streamDequantize16Scalar(float* out, const uint16_t* a, float min, float step, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				out[i] = min + (float)a[i] * step;
+			}
+		}
+
+		/** @brief splits n interleaved (x, y, z) vectors into separate streams */
+		static inline void vec3DeinterleaveScalar(float* ox, float* oy, float* oz, const float* src, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				ox[i] = src[i * 3 + 0];
+				oy[i] = src[i * 3 + 1];
+				oz[i] = src[i * 3 + 2];
+			}
+		}
+
+		/** @brief merges n vectors from separate streams into interleaved (x, y, z) vectors */
+		static inline void vec3InterleaveScalar(float* dst, const float* x, const float* y, const float* z, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				dst[i * 3 + 0] = x[i];
+				dst[i * 3 + 1] = y[i];
+				dst[i * 3 + 2] = z[i];
+			}
+		}
+
+		/** @brief the number of planes of a frustum, each stored as (a, b, c, d) */
+		static const int FRUSTUM_PLANES = 6;
+
+		/**
+		 * Writes base + i to visible for each of n spheres that is not
+		 * entirely behind one of the 6 planes, i.e. for which no plane has
+		 * a * x[i] + b * y[i] + c * z[i] + d < -r[i], and returns the
+		 * number of indices written
+		 *
+		 * Note: visible must have room for n indices, since the index of
+		 * every sphere is written before deciding whether to keep it
+		 */
+		static inline size_t frustumCullSpheresScalar(uint32_t* visible, const float* planes,
+			const float* x, const float* y, const float* z, const float* r, uint32_t base, size_t n)
+		{
+			size_t count = 0;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				bool inside = true;
+
+				for (int p = 0; p < FRUSTUM_PLANES && inside; p++)
+				{
+					const float* plane = planes + 4 * p;
+					float distance = plane[0] * x[i] + plane[1] * y[i] + plane[2] * z[i] + plane[3];
+
+					inside = !(distance < -r[i]);
+				}
+
+				// branchless, since visibility is rarely predictable
+				visible[count] = base + (uint32_t)i;
+				count += inside;
+			}
+
+			return count;
+		}
+
+		/**
+		 * frustumCullSpheresScalar for n boxes given by their centers and
+		 * their extents (half sizes) along each axis: the radius of a box
+		 * towards a plane is |a| * ex[i] + |b| * ey[i] + |c| * ez[i]
+		 */
+		static inline size_t frustumCullBoxesScalar(uint32_t* visible, const float* planes,
+			const float* cx, const float* cy, const float* cz, const float* ex, const float* ey, const float* ez,
+			uint32_t base, size_t n)
+		{
+			size_t count = 0;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				bool inside = true;
+
+				for (int p = 0; p < FRUSTUM_PLANES && inside; p++)
+				{
+					const float* plane = planes + 4 * p;
+					float distance = plane[0] * cx[i] + plane[1] * cy[i] + plane[2] * cz[i] + plane[3];
+					float radius = std::fabs(plane[0]) * ex[i] + std::fabs(plane[1]) * ey[i] + std::fabs(plane[2]) * ez[i];
+
+					inside = !(distance < -radius);
+				}
+
+				visible[count] = base + (uint32_t)i;
+				count += inside;
+			}
+
+			return count;
+		}
+
+		/**
+		 * Transforms n boxes stored as (min x, y, z, max x, y, z) by
+		 * matrices stride components apart, of which only the top 3 rows
+		 * are read (a stride of 0 uses the same matrix for every box). The
+		 * center is transformed as a point and the extents by the absolute
+		 * values of the matrix (Arvo's method), which gives the smallest
+		 * box around the transformed box. out may alias boxes.
+		 */
+		template <typename T>
+		static inline void aabbTransformScalar(T* out, const T* boxes, const T* matrices, size_t stride, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				const T* b = boxes + 6 * i;
+				const T* m = matrices + stride * i;
+				T c[3], e[3];
+
+				for (int k = 0; k < 3; k++)
+				{
+					c[k] = (b[k] + b[k + 3]) * T(0.5);
+					e[k] = (b[k + 3] - b[k]) * T(0.5);
+				}
+
+				T* o = out + 6 * i;
+
+				for (int r = 0; r < 3; r++)
+				{
+					const T* row = m + 4 * r;
+					T center = row[0] * c[0] + row[1] * c[1] + row[2] * c[2] + row[3];
+					T extent = std::fabs(row[0]) * e[0] + std::fabs(row[1]) * e[1] + std::fabs(row[2]) * e[2];
+
+					o[r] = center - extent;
+					o[r + 3] = center + extent;
+				}
+			}
+		}
+
+		/** @brief the number of streams of a triangle: its first vertex and its two edges from it */
+		static const int TRIANGLE_STREAMS = 9;
+
+		/**
+		 * Intersects a ray, stored as (origin x, y, z, direction x, y, z),
+		 * with n double-sided triangles stored as 9 streams stride floats
+		 * apart: the x, y, z of the first vertex v0, of the edge v1 - v0,
+		 * and of the edge v2 - v0 (Moller-Trumbore). Hits at a distance
+		 * t <= 0 or t >= distance are ignored.
+		 *
+		 * Returns the index of the closest hit, setting distance to its t
+		 * and u and v to its barycentric coordinates (the weights of v1
+		 * and v2), or n if no triangle is hit. Of equally close hits, the
+		 * first one is kept.
+		 */
+		template <typename T>
+		static inline size_t rayTrianglesScalar(const T* ray, const T* triangles, size_t stride, size_t n,
+			T& distance, T& u, T& v)
+		{
+			T ox = ray[0], oy = ray[1], oz = ray[2];
+			T dx = ray[3], dy = ray[4], dz = ray[5];
+			size_t hit = n;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				const T* t = triangles + i;
+				T e1x = t[3 * stride], e1y = t[4 * stride], e1z = t[5 * stride];
+				T e2x = t[6 * stride], e2y = t[7 * stride], e2z = t[8 * stride];
+
+				// p = direction x edge2, whose dot product with edge1 is the determinant
+				T px = dy * e2z - dz * e2y;
+				T py = dz * e2x - dx * e2z;
+				T pz = dx * e2y - dy * e2x;
+				T det = e1x * px + e1y * py + e1z * pz;
+				T inv = T(1) / det;
+
+				T sx = ox - t[0], sy = oy - t[stride], sz = oz - t[2 * stride];
+				T hitU = (sx * px + sy * py + sz * pz) * inv;
+
+				// q = s x edge1
+				T qx = sy * e1z - sz * e1y;
+				T qy = sz * e1x - sx * e1z;
+				T qz = sx * e1y - sy * e1x;
+				T hitV = (dx * qx + dy * qy + dz * qz) * inv;
+				T hitT = (e2x * qx + e2y * qy + e2z * qz) * inv;
+
+				// a ray parallel to the triangle has a determinant of 0 and never hits it
+				if (det != 0 && hitU >= 0 && hitV >= 0 && hitU + hitV <= 1 && hitT > 0 && hitT < distance)
+				{
+					distance = hitT;
+					u = hitU;
+					v = hitV;
+					hit = i;
+				}
+			}
+
+			return hit;
+		}
+
+		/**
+		 * The closest of the lanes of a register of Moller-Trumbore hits
+		 * set in mask, in lane order so that ties keep the first one like
+		 * rayTrianglesScalar, updating distance, u and v and returning the
+		 * lane, or lanes if no lane is closer than distance
+		 */
+		static inline int closestLane(int mask, int lanes, const float* t, const float* hitU, const float* hitV,
+			float& distance, float& u, float& v)
+		{
+			int closest = lanes;
+
+			for (int k = 0; k < lanes; k++)
+			{
+				if (((mask >> k) & 1) && t[k] < distance)
+				{
+					distance = t[k];
+					u = hitU[k];
+					v = hitV[k];
+					closest = k;
+				}
+			}
+
+			return closest;
+		}
+
+		/**
+		 * Intersects n rays, stored as streams of their origins and
+		 * directions, with a single triangle stored as (v0 x, y, z,
+		 * edge1 x, y, z, edge2 x, y, z) like in rayTrianglesScalar. For
+		 * each ray that hits it at a t greater than 0 and less than
+		 * distance[i], sets distance[i], u[i], and v[i] to the hit and
+		 * hitTriangles[i] to id. Returns the number of rays that hit it.
+		 */
+		template <typename T>
+		static inline size_t raysTriangleScalar(uint32_t* hitTriangles, T* distance, T* u, T* v,
+			const T* triangle, uint32_t id, const T* ox, const T* oy, const T* oz,
+			const T* dx, const T* dy, const T* dz, size_t n)
+		{
+			size_t hits = 0;
+
+			for (size_t i = 0; i < n; i++)
+			{
+				const T ray[6] = {ox[i], oy[i], oz[i], dx[i], dy[i], dz[i]};
+
+				// a triangle is 9 streams of 1 component each
+				if (rayTrianglesScalar(ray, triangle, 1, 1, distance[i], u[i], v[i]) == 0)
+				{
+					hitTriangles[i] = id;
+					hits++;
+				}
+			}
+
+			return hits;
+		}
+	}
+}
+
+#endif
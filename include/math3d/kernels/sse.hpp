@@ -0,0 +1,1610 @@
+#ifndef KERNELS_SSE_HPP
+#define KERNELS_SSE_HPP
+
+#include <emmintrin.h>
+#include "scalar.hpp"
+
+/**
+ * SSE2 versions of the kernels in kernels/scalar.hpp, producing
+ * bit-identical results
+ */
+namespace math3d
+{
+	namespace detail
+	{
+		/** @brief calculates the cross product of the (x, y, z) lanes of a and b */
+		static inline __m128 cross3SSE(__m128 a, __m128 b)
+		{
+			__m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+			__m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+
+			return _mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX));
+		}
+
+		/** @brief mask ? a : b for each lane */
+		static inline __m128 selectSSE(__m128 mask, __m128 a, __m128 b)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		/** @brief mask ? a : b for each 32-bit integer lane */
+		static inline __m128i selectSSE(__m128i mask, __m128i a, __m128i b)
+		{
+			return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+		}
+
+		/** @brief out = a * b for two 4x4 matrices, one output row per iteration */
+		static inline void mat4MulSSE(float* out, const float* a, const float* b)
+		{
+			__m128 b0 = _mm_loadu_ps(b + 0);
+			__m128 b1 = _mm_loadu_ps(b + 4);
+			__m128 b2 = _mm_loadu_ps(b + 8);
+			__m128 b3 = _mm_loadu_ps(b + 12);
+
+			for (int y = 0; y < 4; y++)
+			{
+				__m128 row = _mm_mul_ps(_mm_set1_ps(a[y * 4 + 0]), b0);
+				row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[y * 4 + 1]), b1));
+				row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[y * 4 + 2]), b2));
+				row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[y * 4 + 3]), b3));
+
+				_mm_storeu_ps(out + y * 4, row);
+			}
+		}
+
+		/**
+		 * Transforms the point v (x, y, z, 1) by m using the columns of
+		 * the matrix, writing (x, y, z) to out
+		 */
+		static inline void mat4TransformPointSSE(float* out, const float* m, const float* v)
+		{
+			__m128 c0 = _mm_loadu_ps(m + 0);
+			__m128 c1 = _mm_loadu_ps(m + 4);
+			__m128 c2 = _mm_loadu_ps(m + 8);
+			__m128 c3 = _mm_loadu_ps(m + 12);
+
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			__m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+			r = _mm_add_ps(r, c3);
+
+			float result[4];
+			_mm_storeu_ps(result, r);
+
+			out[0] = result[0];
+			out[1] = result[1];
+			out[2] = result[2];
+		}
+
+		/**
+		 * Inverts the affine 3x4 matrix m. Each row of the inverse is the
+		 * cross product of two columns of m, matching affineInverseScalar.
+		 */
+		static inline void affineInverseSSE(float* out, const float* m)
+		{
+			__m128 c0 = _mm_loadu_ps(m + 0);
+			__m128 c1 = _mm_loadu_ps(m + 4);
+			__m128 c2 = _mm_loadu_ps(m + 8);
+			__m128 c3 = _mm_setzero_ps();
+
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			__m128 k = _mm_set1_ps(1.0f / mat4DeterminantScalar(m));
+
+			__m128 r0 = _mm_mul_ps(cross3SSE(c1, c2), k);
+			__m128 r1 = _mm_mul_ps(cross3SSE(c2, c0), k);
+			__m128 r2 = _mm_mul_ps(cross3SSE(c0, c1), k);
+			__m128 r3 = _mm_setzero_ps();
+
+			__m128 o0 = r0, o1 = r1, o2 = r2, o3 = r3;
+			_MM_TRANSPOSE4_PS(o0, o1, o2, o3);
+
+			__m128 t = _mm_mul_ps(o0, _mm_shuffle_ps(c3, c3, _MM_SHUFFLE(0, 0, 0, 0)));
+			t = _mm_add_ps(t, _mm_mul_ps(o1, _mm_shuffle_ps(c3, c3, _MM_SHUFFLE(1, 1, 1, 1))));
+			t = _mm_add_ps(t, _mm_mul_ps(o2, _mm_shuffle_ps(c3, c3, _MM_SHUFFLE(2, 2, 2, 2))));
+			t = _mm_xor_ps(t, _mm_set1_ps(-0.0f));
+
+			// put the translation in the last column with full-width stores,
+			// so that reading the result back does not stall on store forwarding
+			__m128 lastColumn = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+			r0 = _mm_or_ps(_mm_andnot_ps(lastColumn, r0), _mm_and_ps(lastColumn, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))));
+			r1 = _mm_or_ps(_mm_andnot_ps(lastColumn, r1), _mm_and_ps(lastColumn, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+			r2 = _mm_or_ps(_mm_andnot_ps(lastColumn, r2), _mm_and_ps(lastColumn, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+
+			_mm_storeu_ps(out + 0, r0);
+			_mm_storeu_ps(out + 4, r1);
+			_mm_storeu_ps(out + 8, r2);
+		}
+
+		/** @brief multiplies one row of an affine 3x4 matrix by the rows b0, b1, and b2 of another */
+		static inline __m128 affineRowSSE(__m128 row, __m128 b0, __m128 b1, __m128 b2)
+		{
+			// (-0, -0, -0, row[3])
+			__m128 translation = _mm_or_ps(_mm_and_ps(row, _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1))),
+				_mm_setr_ps(-0.0f, -0.0f, -0.0f, 0.0f));
+
+			__m128 r = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+			r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+
+			return _mm_add_ps(r, translation);
+		}
+
+		/**
+		 * out = a * b for two affine 3x4 matrices. Adding -0 to the first
+		 * three columns leaves them unchanged, matching affineMulScalar.
+		 */
+		static inline void affineMulSSE(float* out, const float* a, const float* b)
+		{
+			__m128 b0 = _mm_loadu_ps(b + 0);
+			__m128 b1 = _mm_loadu_ps(b + 4);
+			__m128 b2 = _mm_loadu_ps(b + 8);
+
+			__m128 r0 = affineRowSSE(_mm_loadu_ps(a + 0), b0, b1, b2);
+			__m128 r1 = affineRowSSE(_mm_loadu_ps(a + 4), b0, b1, b2);
+			__m128 r2 = affineRowSSE(_mm_loadu_ps(a + 8), b0, b1, b2);
+
+			_mm_storeu_ps(out + 0, r0);
+			_mm_storeu_ps(out + 4, r1);
+			_mm_storeu_ps(out + 8, r2);
+		}
+
+		/** @brief (a0 * b1 - a1 * b0) for the 2x2 determinants of two rows, as in mat4InverseScalar */
+		static inline __m128 det2x2SSE(__m128 a0, __m128 b1, __m128 a1, __m128 b0)
+		{
+			return _mm_sub_ps(_mm_mul_ps(a0, b1), _mm_mul_ps(a1, b0));
+		}
+
+		/** @brief (x * k1 - y * k2 + z * k3) ^ sign for one row of the adjugate */
+		static inline __m128 adjugateRowSSE(__m128 x, __m128 k1, __m128 y, __m128 k2, __m128 z, __m128 k3, __m128 sign)
+		{
+			__m128 r = _mm_sub_ps(_mm_mul_ps(x, k1), _mm_mul_ps(y, k2));
+			r = _mm_add_ps(r, _mm_mul_ps(z, k3));
+
+			return _mm_xor_ps(r, sign);
+		}
+
+		/**
+		 * Inverts the general 4x4 matrix m from its adjugate, computing a
+		 * row of it at a time; matches mat4InverseScalar and out may alias m
+		 */
+		static inline void mat4InverseSSE(float* out, const float* m)
+		{
+			__m128 r0 = _mm_loadu_ps(m + 0);
+			__m128 r1 = _mm_loadu_ps(m + 4);
+			__m128 r2 = _mm_loadu_ps(m + 8);
+			__m128 r3 = _mm_loadu_ps(m + 12);
+
+			// (s0, s1, s2, s3), (s4, s5, -, -), and the same for c
+			__m128 sLo = det2x2SSE(_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(2, 3, 2, 1)),
+				_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(2, 3, 2, 1)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(1, 0, 0, 0)));
+			__m128 sHi = det2x2SSE(_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 3, 3, 3)),
+				_mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(2, 1, 2, 1)));
+			__m128 cLo = det2x2SSE(_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(r3, r3, _MM_SHUFFLE(2, 3, 2, 1)),
+				_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(2, 3, 2, 1)), _mm_shuffle_ps(r3, r3, _MM_SHUFFLE(1, 0, 0, 0)));
+			__m128 cHi = det2x2SSE(_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(2, 1, 2, 1)), _mm_shuffle_ps(r3, r3, _MM_SHUFFLE(3, 3, 3, 3)),
+				_mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(r3, r3, _MM_SHUFFLE(2, 1, 2, 1)));
+
+			// (c[n], c[n], s[n], s[n])
+			__m128 k0 = _mm_shuffle_ps(cLo, sLo, _MM_SHUFFLE(0, 0, 0, 0));
+			__m128 k1 = _mm_shuffle_ps(cLo, sLo, _MM_SHUFFLE(1, 1, 1, 1));
+			__m128 k2 = _mm_shuffle_ps(cLo, sLo, _MM_SHUFFLE(2, 2, 2, 2));
+			__m128 k3 = _mm_shuffle_ps(cLo, sLo, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 k4 = _mm_shuffle_ps(cHi, sHi, _MM_SHUFFLE(0, 0, 0, 0));
+			__m128 k5 = _mm_shuffle_ps(cHi, sHi, _MM_SHUFFLE(1, 1, 1, 1));
+
+			// (m[1][n], m[0][n], m[3][n], m[2][n])
+			__m128 t0 = r0, t1 = r1, t2 = r2, t3 = r3;
+			_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+
+			__m128 col0 = _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128 col1 = _mm_shuffle_ps(t1, t1, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128 col2 = _mm_shuffle_ps(t2, t2, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128 col3 = _mm_shuffle_ps(t3, t3, _MM_SHUFFLE(2, 3, 0, 1));
+
+			__m128 signEven = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+			__m128 signOdd = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+			__m128 adj0 = adjugateRowSSE(col1, k5, col2, k4, col3, k3, signEven);
+			__m128 adj1 = adjugateRowSSE(col0, k5, col2, k2, col3, k1, signOdd);
+			__m128 adj2 = adjugateRowSSE(col0, k4, col1, k2, col3, k0, signEven);
+			__m128 adj3 = adjugateRowSSE(col0, k3, col1, k1, col2, k0, signOdd);
+
+			// expand the determinant along the first row of m
+			__m128 firstColumn = _mm_movelh_ps(_mm_unpacklo_ps(adj0, adj1), _mm_unpacklo_ps(adj2, adj3));
+			float products[4];
+			_mm_storeu_ps(products, _mm_mul_ps(r0, firstColumn));
+
+			__m128 k = _mm_set1_ps(1.0f / (products[0] + products[1] + products[2] + products[3]));
+
+			_mm_storeu_ps(out + 0, _mm_mul_ps(adj0, k));
+			_mm_storeu_ps(out + 4, _mm_mul_ps(adj1, k));
+			_mm_storeu_ps(out + 8, _mm_mul_ps(adj2, k));
+			_mm_storeu_ps(out + 12, _mm_mul_ps(adj3, k));
+		}
+
+		/**
+		 * Inverts the upper 3x3 of m and the translation in its last column,
+		 * copying the bottom row; out must not alias m
+		 */
+		static inline void mat4InverseAffineSSE(float* out, const float* m)
+		{
+			affineInverseSSE(out, m);
+
+			_mm_storeu_ps(out + 12, _mm_loadu_ps(m + 12));
+		}
+
+		/** @brief out = a * b for two (x, y, z, w) quaternions */
+		static inline void quatMulSSE(float* out, const float* a, const float* b)
+		{
+			__m128 qa = _mm_loadu_ps(a);
+			__m128 qb = _mm_loadu_ps(b);
+			__m128 signW = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+
+			__m128 r = _mm_mul_ps(qa, _mm_shuffle_ps(qb, qb, _MM_SHUFFLE(3, 3, 3, 3)));
+
+			__m128 t = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(0, 3, 3, 3)),
+				_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(0, 2, 1, 0)));
+			r = _mm_add_ps(r, _mm_xor_ps(t, signW));
+
+			t = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(1, 0, 2, 1)),
+				_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(1, 1, 0, 2)));
+			r = _mm_add_ps(r, _mm_xor_ps(t, signW));
+
+			t = _mm_mul_ps(_mm_shuffle_ps(qa, qa, _MM_SHUFFLE(2, 1, 0, 2)),
+				_mm_shuffle_ps(qb, qb, _MM_SHUFFLE(2, 0, 2, 1)));
+			r = _mm_sub_ps(r, t);
+
+			_mm_storeu_ps(out, r);
+		}
+
+		/** @brief divides the (x, y, z, w) quaternion q by its magnitude */
+		static inline void quatNormalizeSSE(float* out, const float* q)
+		{
+			__m128 v = _mm_loadu_ps(q);
+			__m128 sq = _mm_mul_ps(v, v);
+
+			__m128 sum = _mm_add_ss(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(3, 3, 3, 3)));
+
+			__m128 mag = _mm_sqrt_ss(sum);
+
+			_mm_storeu_ps(out, _mm_div_ps(v, _mm_shuffle_ps(mag, mag, 0)));
+		}
+
+		/** @brief out[i] = a[i] + b[i] for n floats, 4 at a time */
+		static inline void streamAddSSE(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] - b[i] for n floats, 4 at a time */
+		static inline void streamSubSSE(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				_mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] - b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * b[i] for n floats, 4 at a time */
+		static inline void streamMulSSE(float* out, const float* a, const float* b, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		/** @brief out[i] = a[i] * s for n floats, 4 at a time */
+		static inline void streamScaleSSE(float* out, const float* a, float s, size_t n)
+		{
+			__m128 vs = _mm_set1_ps(s);
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), vs));
+			}
+
+			for (; i < n; i++)
+			{
+				out[i] = a[i] * s;
+			}
+		}
+
+		/** @brief out[i] = a[i] + (b[i] - a[i]) * t[i] for n floats, 4 at a time */
+		static inline void streamLerpSSE(float* out, const float* a, const float* b, const float* t, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 va = _mm_loadu_ps(a + i);
+
+				_mm_storeu_ps(out + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b + i), va), _mm_loadu_ps(t + i))));
+			}
+
+			streamLerpScalar(out + i, a + i, b + i, t + i, n - i);
+		}
+
+		/** @brief out[i] = dot(a[i], b[i]) for n SoA vectors, 4 at a time */
+		static inline void vec3DotSSE(float* out, const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 d = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i)));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i)));
+
+				_mm_storeu_ps(out + i, d);
+			}
+
+			vec3DotScalar(out + i, ax + i, ay + i, az + i, bx + i, by + i, bz + i, n - i);
+		}
+
+		/** @brief o[i] = cross(a[i], b[i]) for n SoA vectors, 4 at a time; o may alias a or b */
+		static inline void vec3CrossSSE(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az,
+			const float* bx, const float* by, const float* bz, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x1 = _mm_loadu_ps(ax + i), y1 = _mm_loadu_ps(ay + i), z1 = _mm_loadu_ps(az + i);
+				__m128 x2 = _mm_loadu_ps(bx + i), y2 = _mm_loadu_ps(by + i), z2 = _mm_loadu_ps(bz + i);
+
+				_mm_storeu_ps(ox + i, _mm_sub_ps(_mm_mul_ps(y1, z2), _mm_mul_ps(z1, y2)));
+				_mm_storeu_ps(oy + i, _mm_sub_ps(_mm_mul_ps(z1, x2), _mm_mul_ps(x1, z2)));
+				_mm_storeu_ps(oz + i, _mm_sub_ps(_mm_mul_ps(x1, y2), _mm_mul_ps(y1, x2)));
+			}
+
+			vec3CrossScalar(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, bx + i, by + i, bz + i, n - i);
+		}
+
+		/** @brief out[i] = magSq(a[i]) for n SoA vectors, 4 at a time */
+		static inline void vec3MagSqSSE(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+				__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+				_mm_storeu_ps(out + i, sq);
+			}
+
+			vec3MagSqScalar(out + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief out[i] = magnitude(a[i]) for n SoA vectors, 4 at a time */
+		static inline void vec3MagnitudeSSE(float* out, const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+				__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+				_mm_storeu_ps(out + i, _mm_sqrt_ps(sq));
+			}
+
+			vec3MagnitudeScalar(out + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = normalize(a[i]) for n SoA vectors, 4 at a time; o may alias a */
+		static inline void vec3NormalizeSSE(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+				__m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+
+				_mm_storeu_ps(ox + i, _mm_div_ps(x, mag));
+				_mm_storeu_ps(oy + i, _mm_div_ps(y, mag));
+				_mm_storeu_ps(oz + i, _mm_div_ps(z, mag));
+			}
+
+			vec3NormalizeScalar(ox + i, oy + i, oz + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/**
+		 * Refines reciprocal square root estimates r of x with one
+		 * Newton-Raphson step, r * (1.5 - 0.5 * x * r * r), which takes the
+		 * 12-bit estimate of rsqrtps to nearly full float precision
+		 */
+		static inline __m128 rsqrtNewtonSSE(__m128 x, __m128 r)
+		{
+			return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), r), r)));
+		}
+
+		/** @brief an approximate 1 / sqrt(x) from rsqrtss and one Newton-Raphson step */
+		static inline float rsqrtSSE(float x)
+		{
+			__m128 v = _mm_set_ss(x);
+
+			return _mm_cvtss_f32(rsqrtNewtonSSE(v, _mm_rsqrt_ss(v)));
+		}
+
+		/** @brief quatNormalizeFastScalar using rsqrtss and one Newton-Raphson step, see rsqrtNewtonSSE */
+		static inline void quatNormalizeFastSSE(float* out, const float* q)
+		{
+			__m128 v = _mm_loadu_ps(q);
+			__m128 sq = _mm_mul_ps(v, v);
+
+			__m128 sum = _mm_add_ss(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 1, 1, 1)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 2, 2, 2)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(3, 3, 3, 3)));
+
+			__m128 invMag = rsqrtNewtonSSE(sum, _mm_rsqrt_ss(sum));
+
+			_mm_storeu_ps(out, _mm_mul_ps(v, _mm_shuffle_ps(invMag, invMag, 0)));
+		}
+
+		/**
+		 * vec3NormalizeFastScalar for n SoA vectors, 4 at a time, using
+		 * rsqrtps and one Newton-Raphson step. Unlike the other kernels the
+		 * results are not bit-identical to the scalar kernel, and the tail
+		 * uses rsqrtss so that every vector gets the same approximation.
+		 */
+		static inline void vec3NormalizeFastSSE(float* ox, float* oy, float* oz,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+				__m128 magSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				__m128 invMag = rsqrtNewtonSSE(magSq, _mm_rsqrt_ps(magSq));
+
+				_mm_storeu_ps(ox + i, _mm_mul_ps(x, invMag));
+				_mm_storeu_ps(oy + i, _mm_mul_ps(y, invMag));
+				_mm_storeu_ps(oz + i, _mm_mul_ps(z, invMag));
+			}
+
+			for (; i < n; i++)
+			{
+				float x = ax[i], y = ay[i], z = az[i];
+				float invMag = rsqrtSSE(x * x + y * y + z * z);
+
+				ox[i] = x * invMag;
+				oy[i] = y * invMag;
+				oz[i] = z * invMag;
+			}
+		}
+
+		/** @brief o[i] = m * (a[i], 1) for n SoA points, 4 at a time; o may alias a */
+		static inline void mat4TransformPointsSSE(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]), m03 = _mm_set1_ps(m[3]);
+			__m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]), m13 = _mm_set1_ps(m[7]);
+			__m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]), m23 = _mm_set1_ps(m[11]);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+
+				_mm_storeu_ps(ox + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z)), m03));
+				_mm_storeu_ps(oy + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z)), m13));
+				_mm_storeu_ps(oz + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z)), m23));
+			}
+
+			mat4TransformPointsScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 0) for n SoA directions, 4 at a time; o may alias a */
+		static inline void mat4TransformDirectionsSSE(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]);
+			__m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]);
+			__m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+
+				_mm_storeu_ps(ox + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z)));
+				_mm_storeu_ps(oy + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z)));
+				_mm_storeu_ps(oz + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z)));
+			}
+
+			mat4TransformDirectionsScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = m * (a[i], 1) divided by w for n SoA points, 4 at a time; o may alias a */
+		static inline void mat4TransformHomogeneousSSE(float* ox, float* oy, float* oz, const float* m,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]), m03 = _mm_set1_ps(m[3]);
+			__m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]), m13 = _mm_set1_ps(m[7]);
+			__m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]), m23 = _mm_set1_ps(m[11]);
+			__m128 m30 = _mm_set1_ps(m[12]), m31 = _mm_set1_ps(m[13]), m32 = _mm_set1_ps(m[14]), m33 = _mm_set1_ps(m[15]);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+				__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m30, x), _mm_mul_ps(m31, y)), _mm_mul_ps(m32, z)), m33);
+
+				_mm_storeu_ps(ox + i, _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z)), m03), w));
+				_mm_storeu_ps(oy + i, _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z)), m13), w));
+				_mm_storeu_ps(oz + i, _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z)), m23), w));
+			}
+
+			mat4TransformHomogeneousScalar(ox + i, oy + i, oz + i, m, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatRotateScalar for 4 vectors and quaternions at a time */
+		static inline void quatRotateSSE(__m128& x, __m128& y, __m128& z, __m128 qx, __m128 qy, __m128 qz, __m128 qw)
+		{
+			__m128 two = _mm_set1_ps(2.0f);
+			__m128 tx = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)), two);
+			__m128 ty = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)), two);
+			__m128 tz = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)), two);
+
+			x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(tx, qw)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+			y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(ty, qw)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+			z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(tz, qw)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q) for n SoA vectors, 4 at a time; o may alias a */
+		static inline void quatRotateVectorsSSE(float* ox, float* oy, float* oz, const float* q,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			__m128 qx = _mm_set1_ps(q[0]), qy = _mm_set1_ps(q[1]), qz = _mm_set1_ps(q[2]), qw = _mm_set1_ps(q[3]);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+
+				quatRotateSSE(x, y, z, qx, qy, qz, qw);
+
+				_mm_storeu_ps(ox + i, x);
+				_mm_storeu_ps(oy + i, y);
+				_mm_storeu_ps(oz + i, z);
+			}
+
+			quatRotateVectorsScalar(ox + i, oy + i, oz + i, q, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief o[i] = a[i].rotateBy(q[i]) for n SoA vectors and quaternions, 4 at a time; o may alias a */
+		static inline void quatsRotateVectorsSSE(float* ox, float* oy, float* oz,
+			const float* qx, const float* qy, const float* qz, const float* qw,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(ax + i), y = _mm_loadu_ps(ay + i), z = _mm_loadu_ps(az + i);
+
+				quatRotateSSE(x, y, z, _mm_loadu_ps(qx + i), _mm_loadu_ps(qy + i), _mm_loadu_ps(qz + i), _mm_loadu_ps(qw + i));
+
+				_mm_storeu_ps(ox + i, x);
+				_mm_storeu_ps(oy + i, y);
+				_mm_storeu_ps(oz + i, z);
+			}
+
+			quatsRotateVectorsScalar(ox + i, oy + i, oz + i, qx + i, qy + i, qz + i, qw + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatNlerpScalar for n SoA quaternions, 4 at a time; o may alias a or b */
+		static inline void quatNlerpSSE(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, const float* aw,
+			const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x1 = _mm_loadu_ps(ax + i), y1 = _mm_loadu_ps(ay + i), z1 = _mm_loadu_ps(az + i), w1 = _mm_loadu_ps(aw + i);
+				__m128 x2 = _mm_loadu_ps(bx + i), y2 = _mm_loadu_ps(by + i), z2 = _mm_loadu_ps(bz + i), w2 = _mm_loadu_ps(bw + i);
+				__m128 vt = _mm_loadu_ps(t + i);
+
+				__m128 cs = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x2), _mm_mul_ps(y1, y2)), _mm_mul_ps(z1, z2)), _mm_mul_ps(w1, w2));
+				__m128 flip = _mm_and_ps(_mm_cmplt_ps(cs, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+
+				x2 = _mm_xor_ps(x2, flip);
+				y2 = _mm_xor_ps(y2, flip);
+				z2 = _mm_xor_ps(z2, flip);
+				w2 = _mm_xor_ps(w2, flip);
+
+				__m128 x = _mm_add_ps(x1, _mm_mul_ps(_mm_sub_ps(x2, x1), vt));
+				__m128 y = _mm_add_ps(y1, _mm_mul_ps(_mm_sub_ps(y2, y1), vt));
+				__m128 z = _mm_add_ps(z1, _mm_mul_ps(_mm_sub_ps(z2, z1), vt));
+				__m128 w = _mm_add_ps(w1, _mm_mul_ps(_mm_sub_ps(w2, w1), vt));
+				__m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w)));
+
+				_mm_storeu_ps(ox + i, _mm_div_ps(x, mag));
+				_mm_storeu_ps(oy + i, _mm_div_ps(y, mag));
+				_mm_storeu_ps(oz + i, _mm_div_ps(z, mag));
+				_mm_storeu_ps(ow + i, _mm_div_ps(w, mag));
+			}
+
+			quatNlerpScalar(ox + i, oy + i, oz + i, ow + i, ax + i, ay + i, az + i, aw + i,
+				bx + i, by + i, bz + i, bw + i, t + i, n - i);
+		}
+
+		/** @brief sincosScalar for 4 floats */
+		static inline void sincosSSE(__m128 a, __m128& s, __m128& c)
+		{
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			const __m128i two = _mm_set1_epi32(2);
+			const __m128i four = _mm_set1_epi32(4);
+
+			__m128 x = _mm_andnot_ps(signBit, a);
+			__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(TRIG_4_OVER_PI)));
+			j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+
+			__m128 y = _mm_cvtepi32_ps(j);
+			x = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(TRIG_PI_4_A))),
+				_mm_mul_ps(y, _mm_set1_ps(TRIG_PI_4_B))), _mm_mul_ps(y, _mm_set1_ps(TRIG_PI_4_C)));
+
+			__m128 z = _mm_mul_ps(x, x);
+			__m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(TRIG_SIN_0), z), _mm_set1_ps(TRIG_SIN_1)), z), _mm_set1_ps(TRIG_SIN_2)), z), x), x);
+			__m128 cosPoly = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(TRIG_COS_0), z), _mm_set1_ps(TRIG_COS_1)), z), _mm_set1_ps(TRIG_COS_2)), z), z),
+				_mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_set1_ps(1.0f));
+
+			__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, two), two));
+			__m128 sinNegative = _mm_xor_ps(_mm_cmplt_ps(a, _mm_setzero_ps()),
+				_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, four), four)));
+			__m128 cosNegative = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(j, two), four), four));
+
+			s = _mm_xor_ps(selectSSE(swap, cosPoly, sinPoly), _mm_and_ps(sinNegative, signBit));
+			c = _mm_xor_ps(selectSSE(swap, sinPoly, cosPoly), _mm_and_ps(cosNegative, signBit));
+		}
+
+		/** @brief atanScalar for 4 floats */
+		static inline __m128 atanSSE(__m128 a)
+		{
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			__m128 x = _mm_andnot_ps(signBit, a);
+			__m128 large = _mm_cmpgt_ps(x, _mm_set1_ps(TRIG_TAN_3PI_8));
+			__m128 medium = _mm_cmpgt_ps(x, _mm_set1_ps(TRIG_TAN_PI_8));
+
+			__m128 num = selectSSE(large, _mm_set1_ps(-1.0f), selectSSE(medium, _mm_sub_ps(x, one), x));
+			__m128 den = selectSSE(large, x, selectSSE(medium, _mm_add_ps(x, one), one));
+			__m128 offset = selectSSE(large, _mm_set1_ps(TRIG_PI_2), _mm_and_ps(medium, _mm_set1_ps(TRIG_PI_4)));
+
+			x = _mm_div_ps(num, den);
+
+			__m128 z = _mm_mul_ps(x, x);
+			__m128 poly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(TRIG_ATAN_0), z), _mm_set1_ps(TRIG_ATAN_1)), z), _mm_set1_ps(TRIG_ATAN_2)), z),
+				_mm_set1_ps(TRIG_ATAN_3)), z), x), x);
+			__m128 r = _mm_add_ps(offset, poly);
+
+			return _mm_xor_ps(r, _mm_and_ps(_mm_cmplt_ps(a, _mm_setzero_ps()), signBit));
+		}
+
+		/** @brief atan2Scalar for 4 pairs of floats */
+		static inline __m128 atan2SSE(__m128 y, __m128 x)
+		{
+			const __m128 zero = _mm_setzero_ps();
+
+			__m128 pi = _mm_xor_ps(_mm_set1_ps(TRIG_PI), _mm_and_ps(_mm_cmplt_ps(y, zero), _mm_set1_ps(-0.0f)));
+			__m128 offset = _mm_and_ps(_mm_cmplt_ps(x, zero), pi);
+			__m128 r = _mm_add_ps(offset, atanSSE(_mm_div_ps(y, x)));
+
+			return _mm_andnot_ps(_mm_and_ps(_mm_cmpeq_ps(x, zero), _mm_cmpeq_ps(y, zero)), r);
+		}
+
+		/** @brief streamSinCosScalar for n floats, 4 at a time */
+		static inline void streamSinCosSSE(float* s, float* c, const float* a, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 vs, vc;
+
+				sincosSSE(_mm_loadu_ps(a + i), vs, vc);
+
+				_mm_storeu_ps(s + i, vs);
+				_mm_storeu_ps(c + i, vc);
+			}
+
+			streamSinCosScalar(s + i, c + i, a + i, n - i);
+		}
+
+		/** @brief streamAtan2Scalar for n floats, 4 at a time */
+		static inline void streamAtan2SSE(float* out, const float* y, const float* x, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				_mm_storeu_ps(out + i, atan2SSE(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+			}
+
+			streamAtan2Scalar(out + i, y + i, x + i, n - i);
+		}
+
+		/** @brief quatFromEulerAnglesScalar for n SoA euler angles, 4 at a time */
+		static inline void quatFromEulerAnglesSSE(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, size_t n)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 sin1, cos1, sin2, cos2, sin3, cos3;
+
+				sincosSSE(_mm_mul_ps(_mm_loadu_ps(ax + i), half), sin1, cos1);
+				sincosSSE(_mm_mul_ps(_mm_loadu_ps(az + i), half), sin2, cos2);
+				sincosSSE(_mm_mul_ps(_mm_loadu_ps(ay + i), half), sin3, cos3);
+
+				__m128 s1s2 = _mm_mul_ps(sin1, sin2);
+				__m128 c1c2 = _mm_mul_ps(cos1, cos2);
+				__m128 s1c2 = _mm_mul_ps(sin1, cos2);
+				__m128 c1s2 = _mm_mul_ps(cos1, sin2);
+
+				_mm_storeu_ps(ox + i, _mm_add_ps(_mm_mul_ps(s1c2, cos3), _mm_mul_ps(c1s2, sin3)));
+				_mm_storeu_ps(oy + i, _mm_add_ps(_mm_mul_ps(c1c2, sin3), _mm_mul_ps(s1s2, cos3)));
+				_mm_storeu_ps(oz + i, _mm_sub_ps(_mm_mul_ps(c1s2, cos3), _mm_mul_ps(s1c2, sin3)));
+				_mm_storeu_ps(ow + i, _mm_sub_ps(_mm_mul_ps(c1c2, cos3), _mm_mul_ps(s1s2, sin3)));
+			}
+
+			quatFromEulerAnglesScalar(ox + i, oy + i, oz + i, ow + i, ax + i, ay + i, az + i, n - i);
+		}
+
+		/** @brief quatFromAxisAngleScalar for n SoA axes and angles, 4 at a time */
+		static inline void quatFromAxisAngleSSE(float* ox, float* oy, float* oz, float* ow,
+			const float* axisX, const float* axisY, const float* axisZ, const float* angle, size_t n)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 sinHalfA, cosHalfA;
+
+				sincosSSE(_mm_mul_ps(_mm_loadu_ps(angle + i), half), sinHalfA, cosHalfA);
+
+				_mm_storeu_ps(ox + i, _mm_mul_ps(_mm_loadu_ps(axisX + i), sinHalfA));
+				_mm_storeu_ps(oy + i, _mm_mul_ps(_mm_loadu_ps(axisY + i), sinHalfA));
+				_mm_storeu_ps(oz + i, _mm_mul_ps(_mm_loadu_ps(axisZ + i), sinHalfA));
+				_mm_storeu_ps(ow + i, cosHalfA);
+			}
+
+			quatFromAxisAngleScalar(ox + i, oy + i, oz + i, ow + i, axisX + i, axisY + i, axisZ + i, angle + i, n - i);
+		}
+
+		/** @brief quatSlerpScalar for n SoA unit quaternions, 4 at a time; o may alias a or b */
+		static inline void quatSlerpSSE(float* ox, float* oy, float* oz, float* ow,
+			const float* ax, const float* ay, const float* az, const float* aw,
+			const float* bx, const float* by, const float* bz, const float* bw, const float* t, size_t n)
+		{
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 threshold = _mm_set1_ps(QUAT_SLERP_THRESHOLD);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x1 = _mm_loadu_ps(ax + i), y1 = _mm_loadu_ps(ay + i), z1 = _mm_loadu_ps(az + i), w1 = _mm_loadu_ps(aw + i);
+				__m128 x2 = _mm_loadu_ps(bx + i), y2 = _mm_loadu_ps(by + i), z2 = _mm_loadu_ps(bz + i), w2 = _mm_loadu_ps(bw + i);
+				__m128 vt = _mm_loadu_ps(t + i);
+
+				__m128 cs = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x2), _mm_mul_ps(y1, y2)), _mm_mul_ps(z1, z2)), _mm_mul_ps(w1, w2));
+				__m128 flip = _mm_and_ps(_mm_cmplt_ps(cs, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+
+				cs = _mm_xor_ps(cs, flip);
+				x2 = _mm_xor_ps(x2, flip);
+				y2 = _mm_xor_ps(y2, flip);
+				z2 = _mm_xor_ps(z2, flip);
+				w2 = _mm_xor_ps(w2, flip);
+
+				// the nlerp result, used by the lanes that are too close to slerp
+				__m128 x = _mm_add_ps(x1, _mm_mul_ps(_mm_sub_ps(x2, x1), vt));
+				__m128 y = _mm_add_ps(y1, _mm_mul_ps(_mm_sub_ps(y2, y1), vt));
+				__m128 z = _mm_add_ps(z1, _mm_mul_ps(_mm_sub_ps(z2, z1), vt));
+				__m128 w = _mm_add_ps(w1, _mm_mul_ps(_mm_sub_ps(w2, w1), vt));
+				__m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w)));
+
+				x = _mm_div_ps(x, mag);
+				y = _mm_div_ps(y, mag);
+				z = _mm_div_ps(z, mag);
+				w = _mm_div_ps(w, mag);
+
+				__m128 near = _mm_cmpge_ps(cs, threshold);
+
+				if (_mm_movemask_ps(near) != 0xF)
+				{
+					__m128 sn = _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(cs, cs)));
+					__m128 invSin = _mm_div_ps(one, sn);
+					__m128 angle = atan2SSE(sn, cs);
+					__m128 srcSin, destSin, unused;
+
+					sincosSSE(_mm_mul_ps(_mm_sub_ps(one, vt), angle), srcSin, unused);
+					sincosSSE(_mm_mul_ps(vt, angle), destSin, unused);
+
+					__m128 srcFactor = _mm_mul_ps(srcSin, invSin);
+					__m128 destFactor = _mm_mul_ps(destSin, invSin);
+
+					x = selectSSE(near, x, _mm_add_ps(_mm_mul_ps(x1, srcFactor), _mm_mul_ps(x2, destFactor)));
+					y = selectSSE(near, y, _mm_add_ps(_mm_mul_ps(y1, srcFactor), _mm_mul_ps(y2, destFactor)));
+					z = selectSSE(near, z, _mm_add_ps(_mm_mul_ps(z1, srcFactor), _mm_mul_ps(z2, destFactor)));
+					w = selectSSE(near, w, _mm_add_ps(_mm_mul_ps(w1, srcFactor), _mm_mul_ps(w2, destFactor)));
+				}
+
+				_mm_storeu_ps(ox + i, x);
+				_mm_storeu_ps(oy + i, y);
+				_mm_storeu_ps(oz + i, z);
+				_mm_storeu_ps(ow + i, w);
+			}
+
+			quatSlerpScalar(ox + i, oy + i, oz + i, ow + i, ax + i, ay + i, az + i, aw + i,
+				bx + i, by + i, bz + i, bw + i, t + i, n - i);
+		}
+
+		/**
+		 * Blends the top 3 rows of the bone matrices that point i is bound
+		 * to, like skinLinearScalar
+		 */
+		static inline void blendBoneRowsSSE(__m128& r0, __m128& r1, __m128& r2,
+			const uint16_t* const* indices, const float* const* weights, int influences,
+			const float* palette, size_t stride, size_t i)
+		{
+			const float* bone = palette + indices[0][i] * stride;
+			__m128 w = _mm_set1_ps(weights[0][i]);
+
+			r0 = _mm_mul_ps(_mm_loadu_ps(bone), w);
+			r1 = _mm_mul_ps(_mm_loadu_ps(bone + 4), w);
+			r2 = _mm_mul_ps(_mm_loadu_ps(bone + 8), w);
+
+			for (int k = 1; k < influences; k++)
+			{
+				bone = palette + indices[k][i] * stride;
+				w = _mm_set1_ps(weights[k][i]);
+
+				r0 = _mm_add_ps(r0, _mm_mul_ps(_mm_loadu_ps(bone), w));
+				r1 = _mm_add_ps(r1, _mm_mul_ps(_mm_loadu_ps(bone + 4), w));
+				r2 = _mm_add_ps(r2, _mm_mul_ps(_mm_loadu_ps(bone + 8), w));
+			}
+		}
+
+		/**
+		 * skinLinearScalar for 4 points at a time: the matrix of each point
+		 * is blended a row at a time, then the 4 matrices are transposed so
+		 * that the points are transformed with one component per register
+		 */
+		static inline void skinLinearSSE(float* ox, float* oy, float* oz,
+			const float* px, const float* py, const float* pz,
+			const uint16_t* const* indices, const float* const* weights, int influences,
+			const float* palette, size_t stride, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11;
+
+				blendBoneRowsSSE(m0, m4, m8, indices, weights, influences, palette, stride, i);
+				blendBoneRowsSSE(m1, m5, m9, indices, weights, influences, palette, stride, i + 1);
+				blendBoneRowsSSE(m2, m6, m10, indices, weights, influences, palette, stride, i + 2);
+				blendBoneRowsSSE(m3, m7, m11, indices, weights, influences, palette, stride, i + 3);
+
+				_MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+				_MM_TRANSPOSE4_PS(m4, m5, m6, m7);
+				_MM_TRANSPOSE4_PS(m8, m9, m10, m11);
+
+				__m128 x = _mm_loadu_ps(px + i), y = _mm_loadu_ps(py + i), z = _mm_loadu_ps(pz + i);
+
+				_mm_storeu_ps(ox + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_mul_ps(m2, z)), m3));
+				_mm_storeu_ps(oy + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m4, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m6, z)), m7));
+				_mm_storeu_ps(oz + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m8, x), _mm_mul_ps(m9, y)), _mm_mul_ps(m10, z)), m11));
+			}
+
+			const uint16_t* tailIndices[4];
+			const float* tailWeights[4];
+
+			for (int k = 0; k < influences; k++)
+			{
+				tailIndices[k] = indices[k] + i;
+				tailWeights[k] = weights[k] + i;
+			}
+
+			skinLinearScalar(ox + i, oy + i, oz + i, px + i, py + i, pz + i, tailIndices, tailWeights, influences,
+				palette, stride, n - i);
+		}
+
+		/**
+		 * Blends the dual quaternions that point i is bound to, like
+		 * skinDualQuatScalar, leaving the real part in r and the dual
+		 * part in d
+		 */
+		static inline void blendBoneDualQuatsSSE(__m128& r, __m128& d,
+			const uint16_t* const* indices, const float* const* weights, int influences,
+			const float* palette, size_t i)
+		{
+			const float* pivot = palette + indices[0][i] * 8;
+			__m128 w = _mm_set1_ps(weights[0][i]);
+
+			r = _mm_mul_ps(_mm_loadu_ps(pivot), w);
+			d = _mm_mul_ps(_mm_loadu_ps(pivot + 4), w);
+
+			for (int k = 1; k < influences; k++)
+			{
+				const float* bone = palette + indices[k][i] * 8;
+				float dot = bone[0] * pivot[0] + bone[1] * pivot[1] + bone[2] * pivot[2] + bone[3] * pivot[3];
+
+				// negates the weight without a branch, which mispredicts on bones in opposite hemispheres
+				w = _mm_xor_ps(_mm_set1_ps(weights[k][i]), _mm_and_ps(_mm_cmplt_ps(_mm_set1_ps(dot), _mm_setzero_ps()),
+					_mm_set1_ps(-0.0f)));
+				r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(bone), w));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(bone + 4), w));
+			}
+		}
+
+		/**
+		 * skinDualQuatScalar for 4 points at a time, blending the dual
+		 * quaternion of each point and then transposing the 4 of them
+		 */
+		static inline void skinDualQuatSSE(float* ox, float* oy, float* oz,
+			const float* px, const float* py, const float* pz,
+			const uint16_t* const* indices, const float* const* weights, int influences,
+			const float* palette, size_t n)
+		{
+			const __m128 two = _mm_set1_ps(2.0f);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 q[8];
+
+				blendBoneDualQuatsSSE(q[0], q[4], indices, weights, influences, palette, i);
+				blendBoneDualQuatsSSE(q[1], q[5], indices, weights, influences, palette, i + 1);
+				blendBoneDualQuatsSSE(q[2], q[6], indices, weights, influences, palette, i + 2);
+				blendBoneDualQuatsSSE(q[3], q[7], indices, weights, influences, palette, i + 3);
+
+				_MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+				_MM_TRANSPOSE4_PS(q[4], q[5], q[6], q[7]);
+
+				__m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])),
+					_mm_mul_ps(q[2], q[2])), _mm_mul_ps(q[3], q[3])));
+
+				__m128 rx = _mm_div_ps(q[0], mag), ry = _mm_div_ps(q[1], mag), rz = _mm_div_ps(q[2], mag), rw = _mm_div_ps(q[3], mag);
+				__m128 dx = _mm_div_ps(q[4], mag), dy = _mm_div_ps(q[5], mag), dz = _mm_div_ps(q[6], mag), dw = _mm_div_ps(q[7], mag);
+				__m128 x = _mm_loadu_ps(px + i), y = _mm_loadu_ps(py + i), z = _mm_loadu_ps(pz + i);
+
+				__m128 tx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ry, z), _mm_mul_ps(rz, y)), _mm_mul_ps(rw, x));
+				__m128 ty = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rz, x), _mm_mul_ps(rx, z)), _mm_mul_ps(rw, y));
+				__m128 tz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, y), _mm_mul_ps(ry, x)), _mm_mul_ps(rw, z));
+
+				__m128 cx = _mm_sub_ps(_mm_mul_ps(ry, tz), _mm_mul_ps(rz, ty));
+				__m128 cy = _mm_sub_ps(_mm_mul_ps(rz, tx), _mm_mul_ps(rx, tz));
+				__m128 cz = _mm_sub_ps(_mm_mul_ps(rx, ty), _mm_mul_ps(ry, tx));
+
+				__m128 ux = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dx), _mm_mul_ps(dw, rx)), _mm_sub_ps(_mm_mul_ps(ry, dz), _mm_mul_ps(rz, dy)));
+				__m128 uy = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dy), _mm_mul_ps(dw, ry)), _mm_sub_ps(_mm_mul_ps(rz, dx), _mm_mul_ps(rx, dz)));
+				__m128 uz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dz), _mm_mul_ps(dw, rz)), _mm_sub_ps(_mm_mul_ps(rx, dy), _mm_mul_ps(ry, dx)));
+
+				_mm_storeu_ps(ox + i, _mm_add_ps(x, _mm_mul_ps(_mm_add_ps(cx, ux), two)));
+				_mm_storeu_ps(oy + i, _mm_add_ps(y, _mm_mul_ps(_mm_add_ps(cy, uy), two)));
+				_mm_storeu_ps(oz + i, _mm_add_ps(z, _mm_mul_ps(_mm_add_ps(cz, uz), two)));
+			}
+
+			const uint16_t* tailIndices[4];
+			const float* tailWeights[4];
+
+			for (int k = 0; k < influences; k++)
+			{
+				tailIndices[k] = indices[k] + i;
+				tailWeights[k] = weights[k] + i;
+			}
+
+			skinDualQuatScalar(ox + i, oy + i, oz + i, px + i, py + i, pz + i, tailIndices, tailWeights, influences,
+				palette, n - i);
+		}
+
+		/** @brief quantizeQuatComponentScalar for 4 components */
+		static inline __m128i quantizeQuatComponentSSE(__m128 v, __m128 max)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(0.5f / QUAT_PACK_RANGE)), half), max);
+
+			t = _mm_max_ps(t, _mm_setzero_ps());
+			t = _mm_min_ps(t, max);
+
+			return _mm_cvttps_epi32(_mm_add_ps(t, half));
+		}
+
+		/** @brief dequantizeQuatComponentScalar for 4 components */
+		static inline __m128 dequantizeQuatComponentSSE(__m128i v, __m128 invMax)
+		{
+			return _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(v), invMax), _mm_set1_ps(0.5f)),
+				_mm_set1_ps(2 * QUAT_PACK_RANGE));
+		}
+
+		/** @brief quatSmallestThreeScalar for 4 quaternions, returning the indices of their largest components */
+		static inline __m128i quatSmallestThreeSSE(__m128 x, __m128 y, __m128 z, __m128 w, __m128 max,
+			__m128i& a, __m128i& b, __m128i& c)
+		{
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+
+			__m128 m = _mm_andnot_ps(signMask, x);
+			__m128 largest = x;
+			__m128i index = _mm_setzero_si128();
+
+			__m128 greater = _mm_cmpgt_ps(_mm_andnot_ps(signMask, y), m);
+			largest = selectSSE(greater, y, largest);
+			index = selectSSE(_mm_castps_si128(greater), _mm_set1_epi32(1), index);
+			m = _mm_max_ps(_mm_andnot_ps(signMask, y), m);
+
+			greater = _mm_cmpgt_ps(_mm_andnot_ps(signMask, z), m);
+			largest = selectSSE(greater, z, largest);
+			index = selectSSE(_mm_castps_si128(greater), _mm_set1_epi32(2), index);
+			m = _mm_max_ps(_mm_andnot_ps(signMask, z), m);
+
+			greater = _mm_cmpgt_ps(_mm_andnot_ps(signMask, w), m);
+			largest = selectSSE(greater, w, largest);
+			index = selectSSE(_mm_castps_si128(greater), _mm_set1_epi32(3), index);
+
+			__m128 sa = selectSSE(_mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128())), y, x);
+			__m128 sb = selectSSE(_mm_castsi128_ps(_mm_cmplt_epi32(index, _mm_set1_epi32(2))), z, y);
+			__m128 sc = selectSSE(_mm_castsi128_ps(_mm_cmplt_epi32(index, _mm_set1_epi32(3))), w, z);
+			__m128 flip = _mm_and_ps(_mm_cmplt_ps(largest, _mm_setzero_ps()), signMask);
+
+			a = quantizeQuatComponentSSE(_mm_xor_ps(sa, flip), max);
+			b = quantizeQuatComponentSSE(_mm_xor_ps(sb, flip), max);
+			c = quantizeQuatComponentSSE(_mm_xor_ps(sc, flip), max);
+
+			return index;
+		}
+
+		/** @brief quatFromSmallestThreeScalar for 4 quaternions */
+		static inline void quatFromSmallestThreeSSE(__m128& x, __m128& y, __m128& z, __m128& w,
+			__m128i index, __m128 a, __m128 b, __m128 c)
+		{
+			__m128 s = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b)), _mm_mul_ps(c, c)));
+			__m128 largest = _mm_sqrt_ps(_mm_max_ps(s, _mm_setzero_ps()));
+
+			__m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+			__m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+			__m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+			__m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+
+			x = selectSSE(is0, largest, a);
+			y = selectSSE(is0, a, selectSSE(is1, largest, b));
+			z = selectSSE(_mm_or_ps(is0, is1), b, selectSSE(is2, largest, c));
+			w = selectSSE(is3, largest, c);
+		}
+
+		/** @brief quatPack32Scalar for 4 quaternions at a time */
+		static inline void quatPack32SSE(uint32_t* out, const float* x, const float* y, const float* z,
+			const float* w, size_t n)
+		{
+			const __m128 max = _mm_set1_ps(1023);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128i a, b, c;
+				__m128i index = quatSmallestThreeSSE(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i),
+					_mm_loadu_ps(w + i), max, a, b, c);
+
+				__m128i packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(index, 30), _mm_slli_epi32(a, 20)),
+					_mm_or_si128(_mm_slli_epi32(b, 10), c));
+
+				_mm_storeu_si128((__m128i*)(out + i), packed);
+			}
+
+			quatPack32Scalar(out + i, x + i, y + i, z + i, w + i, n - i);
+		}
+
+		/** @brief quatUnpack32Scalar for 4 quaternions at a time */
+		static inline void quatUnpack32SSE(float* x, float* y, float* z, float* w, const uint32_t* in, size_t n)
+		{
+			const __m128 invMax = _mm_set1_ps(1.0f / 1023);
+			const __m128i mask = _mm_set1_epi32(1023);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+				__m128 qx, qy, qz, qw;
+
+				quatFromSmallestThreeSSE(qx, qy, qz, qw, _mm_srli_epi32(v, 30),
+					dequantizeQuatComponentSSE(_mm_and_si128(_mm_srli_epi32(v, 20), mask), invMax),
+					dequantizeQuatComponentSSE(_mm_and_si128(_mm_srli_epi32(v, 10), mask), invMax),
+					dequantizeQuatComponentSSE(_mm_and_si128(v, mask), invMax));
+
+				_mm_storeu_ps(x + i, qx);
+				_mm_storeu_ps(y + i, qy);
+				_mm_storeu_ps(z + i, qz);
+				_mm_storeu_ps(w + i, qw);
+			}
+
+			quatUnpack32Scalar(x + i, y + i, z + i, w + i, in + i, n - i);
+		}
+
+		/**
+		 * quatPack48Scalar for 4 quaternions at a time; the words are
+		 * computed together and then written out per quaternion
+		 */
+		static inline void quatPack48SSE(uint16_t* out, const float* x, const float* y, const float* z,
+			const float* w, size_t n)
+		{
+			const __m128 max = _mm_set1_ps(32767);
+			const __m128i one = _mm_set1_epi32(1);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128i a, b, c;
+				__m128i index = quatSmallestThreeSSE(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i),
+					_mm_loadu_ps(w + i), max, a, b, c);
+
+				alignas(16) int32_t words[3][4];
+
+				_mm_store_si128((__m128i*)words[0], _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(index, 1), 15), a));
+				_mm_store_si128((__m128i*)words[1], _mm_or_si128(_mm_slli_epi32(_mm_and_si128(index, one), 15), b));
+				_mm_store_si128((__m128i*)words[2], c);
+
+				for (int j = 0; j < 4; j++)
+				{
+					out[3 * (i + j)] = (uint16_t)words[0][j];
+					out[3 * (i + j) + 1] = (uint16_t)words[1][j];
+					out[3 * (i + j) + 2] = (uint16_t)words[2][j];
+				}
+			}
+
+			quatPack48Scalar(out + 3 * i, x + i, y + i, z + i, w + i, n - i);
+		}
+
+		/** @brief quatUnpack48Scalar for 4 quaternions at a time */
+		static inline void quatUnpack48SSE(float* x, float* y, float* z, float* w, const uint16_t* in, size_t n)
+		{
+			const __m128 invMax = _mm_set1_ps(1.0f / 32767);
+			const __m128i mask = _mm_set1_epi32(32767);
+
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const uint16_t* p = in + 3 * i;
+				__m128i w0 = _mm_setr_epi32(p[0], p[3], p[6], p[9]);
+				__m128i w1 = _mm_setr_epi32(p[1], p[4], p[7], p[10]);
+				__m128i w2 = _mm_setr_epi32(p[2], p[5], p[8], p[11]);
+				__m128i index = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(w0, 15), 1), _mm_srli_epi32(w1, 15));
+				__m128 qx, qy, qz, qw;
+
+				quatFromSmallestThreeSSE(qx, qy, qz, qw, index,
+					dequantizeQuatComponentSSE(_mm_and_si128(w0, mask), invMax),
+					dequantizeQuatComponentSSE(_mm_and_si128(w1, mask), invMax),
+					dequantizeQuatComponentSSE(_mm_and_si128(w2, mask), invMax));
+
+				_mm_storeu_ps(x + i, qx);
+				_mm_storeu_ps(y + i, qy);
+				_mm_storeu_ps(z + i, qz);
+				_mm_storeu_ps(w + i, qw);
+			}
+
+			quatUnpack48Scalar(x + i, y + i, z + i, w + i, in + 3 * i, n - i);
+		}
+
+		/**
+		 * streamQuantize16Scalar for 8 values at a time. SSE2 can only pack
+		 * 32-bit integers to signed 16 bits, so the values are offset by
+		 * 32768 before packing and the offset is flipped back afterwards.
+		 */
+		static inline void streamQuantize16SSE(uint16_t* out, const float* a, float min, float invStep, size_t n)
+		{
+			const __m128 vmin = _mm_set1_ps(min);
+			const __m128 vinvStep = _mm_set1_ps(invStep);
+			const __m128 max = _mm_set1_ps(65535);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128i offset = _mm_set1_epi32(32768);
+			const __m128i flip = _mm_set1_epi16((short)0x8000);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(a + i), vmin), vinvStep);
+				__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(a + i + 4), vmin), vinvStep);
+
+				t0 = _mm_min_ps(_mm_max_ps(t0, _mm_setzero_ps()), max);
+				t1 = _mm_min_ps(_mm_max_ps(t1, _mm_setzero_ps()), max);
+
+				__m128i q0 = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(t0, half)), offset);
+				__m128i q1 = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(t1, half)), offset);
+
+				_mm_storeu_si128((__m128i*)(out + i), _mm_xor_si128(_mm_packs_epi32(q0, q1), flip));
+			}
+
+			streamQuantize16Scalar(out + i, a + i, min, invStep, n - i);
+		}
+
+		/** @brief streamDequantize16Scalar for 8 values at a time */
+		static inline void streamDequantize16SSE(float* out, const uint16_t* a, float min, float step, size_t n)
+		{
+			const __m128 vmin = _mm_set1_ps(min);
+			const __m128 vstep = _mm_set1_ps(step);
+
+			size_t i = 0;
+
+			for (; i + 8 <= n; i += 8)
+			{
+				__m128i q = _mm_loadu_si128((const __m128i*)(a + i));
+				__m128 f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(q, _mm_setzero_si128()));
+				__m128 f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(q, _mm_setzero_si128()));
+
+				_mm_storeu_ps(out + i, _mm_add_ps(vmin, _mm_mul_ps(f0, vstep)));
+				_mm_storeu_ps(out + i + 4, _mm_add_ps(vmin, _mm_mul_ps(f1, vstep)));
+			}
+
+			streamDequantize16Scalar(out + i, a + i, min, step, n - i);
+		}
+
+		/** @brief splits n interleaved (x, y, z) vectors into separate streams, 4 at a time */
+		static inline void vec3DeinterleaveSSE(float* ox, float* oy, float* oz, const float* src, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				// a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)
+				__m128 a = _mm_loadu_ps(src + i * 3 + 0);
+				__m128 b = _mm_loadu_ps(src + i * 3 + 4);
+				__m128 c = _mm_loadu_ps(src + i * 3 + 8);
+
+				__m128 x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)),
+					_mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+					_mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+					_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+				_mm_storeu_ps(ox + i, x);
+				_mm_storeu_ps(oy + i, y);
+				_mm_storeu_ps(oz + i, z);
+			}
+
+			vec3DeinterleaveScalar(ox + i, oy + i, oz + i, src + i * 3, n - i);
+		}
+
+		/** @brief merges n vectors from separate streams into interleaved (x, y, z) vectors, 4 at a time */
+		static inline void vec3InterleaveSSE(float* dst, const float* x, const float* y, const float* z, size_t n)
+		{
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 vx = _mm_loadu_ps(x + i);
+				__m128 vy = _mm_loadu_ps(y + i);
+				__m128 vz = _mm_loadu_ps(z + i);
+
+				__m128 a = _mm_shuffle_ps(_mm_unpacklo_ps(vx, vy),
+					_mm_shuffle_ps(vz, vx, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+				__m128 b = _mm_shuffle_ps(_mm_shuffle_ps(vy, vz, _MM_SHUFFLE(1, 1, 1, 1)),
+					_mm_shuffle_ps(vx, vy, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 c = _mm_shuffle_ps(_mm_shuffle_ps(vz, vx, _MM_SHUFFLE(3, 3, 2, 2)),
+					_mm_shuffle_ps(vy, vz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+				_mm_storeu_ps(dst + i * 3 + 0, a);
+				_mm_storeu_ps(dst + i * 3 + 4, b);
+				_mm_storeu_ps(dst + i * 3 + 8, c);
+			}
+
+			vec3InterleaveScalar(dst + i * 3, x + i, y + i, z + i, n - i);
+		}
+
+		/**
+		 * Appends base + i + k to visible for each set bit k of a 4-bit
+		 * mask, without branching on it
+		 */
+		static inline size_t compactIndicesSSE(uint32_t* visible, size_t count, int mask, uint32_t first)
+		{
+			for (int k = 0; k < 4; k++)
+			{
+				visible[count] = first + k;
+				count += (mask >> k) & 1;
+			}
+
+			return count;
+		}
+
+		/** @brief frustumCullSpheresScalar, testing 4 spheres against each plane at a time */
+		static inline size_t frustumCullSpheresSSE(uint32_t* visible, const float* planes,
+			const float* x, const float* y, const float* z, const float* r, uint32_t base, size_t n)
+		{
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			__m128 pa[FRUSTUM_PLANES], pb[FRUSTUM_PLANES], pc[FRUSTUM_PLANES], pd[FRUSTUM_PLANES];
+
+			for (int p = 0; p < FRUSTUM_PLANES; p++)
+			{
+				pa[p] = _mm_set1_ps(planes[4 * p + 0]);
+				pb[p] = _mm_set1_ps(planes[4 * p + 1]);
+				pc[p] = _mm_set1_ps(planes[4 * p + 2]);
+				pd[p] = _mm_set1_ps(planes[4 * p + 3]);
+			}
+
+			size_t count = 0;
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+				__m128 negR = _mm_xor_ps(_mm_loadu_ps(r + i), signBit);
+				__m128 outside = _mm_setzero_ps();
+
+				for (int p = 0; p < FRUSTUM_PLANES; p++)
+				{
+					__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pa[p], vx), _mm_mul_ps(pb[p], vy)),
+						_mm_mul_ps(pc[p], vz)), pd[p]);
+
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negR));
+				}
+
+				count = compactIndicesSSE(visible, count, ~_mm_movemask_ps(outside) & 0xF, base + (uint32_t)i);
+			}
+
+			return count + frustumCullSpheresScalar(visible + count, planes, x + i, y + i, z + i, r + i,
+				base + (uint32_t)i, n - i);
+		}
+
+		/** @brief frustumCullBoxesScalar, testing 4 boxes against each plane at a time */
+		static inline size_t frustumCullBoxesSSE(uint32_t* visible, const float* planes,
+			const float* cx, const float* cy, const float* cz, const float* ex, const float* ey, const float* ez,
+			uint32_t base, size_t n)
+		{
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			__m128 pa[FRUSTUM_PLANES], pb[FRUSTUM_PLANES], pc[FRUSTUM_PLANES], pd[FRUSTUM_PLANES];
+
+			for (int p = 0; p < FRUSTUM_PLANES; p++)
+			{
+				pa[p] = _mm_set1_ps(planes[4 * p + 0]);
+				pb[p] = _mm_set1_ps(planes[4 * p + 1]);
+				pc[p] = _mm_set1_ps(planes[4 * p + 2]);
+				pd[p] = _mm_set1_ps(planes[4 * p + 3]);
+			}
+
+			size_t count = 0;
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 x = _mm_loadu_ps(cx + i), y = _mm_loadu_ps(cy + i), z = _mm_loadu_ps(cz + i);
+				__m128 sx = _mm_loadu_ps(ex + i), sy = _mm_loadu_ps(ey + i), sz = _mm_loadu_ps(ez + i);
+				__m128 outside = _mm_setzero_ps();
+
+				for (int p = 0; p < FRUSTUM_PLANES; p++)
+				{
+					__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pa[p], x), _mm_mul_ps(pb[p], y)),
+						_mm_mul_ps(pc[p], z)), pd[p]);
+					__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signBit, pa[p]), sx),
+						_mm_mul_ps(_mm_andnot_ps(signBit, pb[p]), sy)), _mm_mul_ps(_mm_andnot_ps(signBit, pc[p]), sz));
+
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_xor_ps(radius, signBit)));
+				}
+
+				count = compactIndicesSSE(visible, count, ~_mm_movemask_ps(outside) & 0xF, base + (uint32_t)i);
+			}
+
+			return count + frustumCullBoxesScalar(visible + count, planes, cx + i, cy + i, cz + i, ex + i, ey + i, ez + i,
+				base + (uint32_t)i, n - i);
+		}
+
+		/**
+		 * aabbTransformScalar for float, one box at a time: the matrix is
+		 * transposed so that the 3 components of the center and extents are
+		 * computed together from its columns
+		 */
+		static inline void aabbTransformSSE(float* out, const float* boxes, const float* matrices, size_t stride, size_t n)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+
+			size_t i = 0;
+
+			// the last box is left to the scalar kernel, since its max is loaded with one float past its end
+			for (; i + 1 < n; i++)
+			{
+				const float* b = boxes + 6 * i;
+				const float* m = matrices + stride * i;
+				__m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_setzero_ps();
+
+				_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+				__m128 lo = _mm_loadu_ps(b), hi = _mm_loadu_ps(b + 3);
+				__m128 c = _mm_mul_ps(_mm_add_ps(lo, hi), half);
+				__m128 e = _mm_mul_ps(_mm_sub_ps(hi, lo), half);
+
+				__m128 center = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(c0, _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0))),
+					_mm_mul_ps(c1, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1)))),
+					_mm_mul_ps(c2, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2)))), c3);
+				__m128 extent = _mm_add_ps(_mm_add_ps(
+					_mm_mul_ps(_mm_andnot_ps(signBit, c0), _mm_shuffle_ps(e, e, _MM_SHUFFLE(0, 0, 0, 0))),
+					_mm_mul_ps(_mm_andnot_ps(signBit, c1), _mm_shuffle_ps(e, e, _MM_SHUFFLE(1, 1, 1, 1)))),
+					_mm_mul_ps(_mm_andnot_ps(signBit, c2), _mm_shuffle_ps(e, e, _MM_SHUFFLE(2, 2, 2, 2))));
+
+				__m128 min = _mm_sub_ps(center, extent);
+				__m128 max = _mm_add_ps(center, extent);
+
+				// (min x, y, z, max x) and (max y, z)
+				__m128 t = _mm_shuffle_ps(min, max, _MM_SHUFFLE(0, 0, 2, 2));
+				float* o = out + 6 * i;
+
+				_mm_storeu_ps(o, _mm_shuffle_ps(min, t, _MM_SHUFFLE(2, 0, 1, 0)));
+				_mm_storel_pi((__m64*)(o + 4), _mm_shuffle_ps(max, max, _MM_SHUFFLE(3, 3, 2, 1)));
+			}
+
+			aabbTransformScalar(out + 6 * i, boxes + 6 * i, matrices + stride * i, stride, n - i);
+		}
+		/** @brief rayTrianglesScalar, testing the ray against 4 triangles at a time */
+		static inline size_t rayTrianglesSSE(const float* ray, const float* triangles, size_t stride, size_t n,
+			float& distance, float& u, float& v)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			__m128 ox = _mm_set1_ps(ray[0]), oy = _mm_set1_ps(ray[1]), oz = _mm_set1_ps(ray[2]);
+			__m128 dx = _mm_set1_ps(ray[3]), dy = _mm_set1_ps(ray[4]), dz = _mm_set1_ps(ray[5]);
+			size_t hit = n;
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const float* t = triangles + i;
+				__m128 e1x = _mm_loadu_ps(t + 3 * stride), e1y = _mm_loadu_ps(t + 4 * stride), e1z = _mm_loadu_ps(t + 5 * stride);
+				__m128 e2x = _mm_loadu_ps(t + 6 * stride), e2y = _mm_loadu_ps(t + 7 * stride), e2z = _mm_loadu_ps(t + 8 * stride);
+
+				__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+				__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+				__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+				__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+				__m128 inv = _mm_div_ps(one, det);
+
+				__m128 sx = _mm_sub_ps(ox, _mm_loadu_ps(t));
+				__m128 sy = _mm_sub_ps(oy, _mm_loadu_ps(t + stride));
+				__m128 sz = _mm_sub_ps(oz, _mm_loadu_ps(t + 2 * stride));
+				__m128 hitU = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv);
+
+				__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+				__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+				__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+				__m128 hitV = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inv);
+				__m128 hitT = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+				__m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmpneq_ps(det, zero), _mm_cmpge_ps(hitU, zero)),
+					_mm_and_ps(_mm_cmpge_ps(hitV, zero), _mm_cmple_ps(_mm_add_ps(hitU, hitV), one)));
+				mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(hitT, zero), _mm_cmplt_ps(hitT, _mm_set1_ps(distance))));
+
+				int bits = _mm_movemask_ps(mask);
+
+				if (bits != 0)
+				{
+					alignas(16) float ts[4], us[4], vs[4];
+
+					_mm_store_ps(ts, hitT);
+					_mm_store_ps(us, hitU);
+					_mm_store_ps(vs, hitV);
+
+					hit = i + closestLane(bits, 4, ts, us, vs, distance, u, v);
+				}
+			}
+
+			size_t rest = rayTrianglesScalar(ray, triangles + i, stride, n - i, distance, u, v);
+
+			return rest < n - i ? i + rest : hit;
+		}
+
+		/** @brief raysTriangleScalar, testing 4 rays against the triangle at a time */
+		static inline size_t raysTriangleSSE(uint32_t* hitTriangles, float* distance, float* u, float* v,
+			const float* triangle, uint32_t id, const float* ox, const float* oy, const float* oz,
+			const float* dx, const float* dy, const float* dz, size_t n)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128i ids = _mm_set1_epi32((int)id);
+			__m128 v0x = _mm_set1_ps(triangle[0]), v0y = _mm_set1_ps(triangle[1]), v0z = _mm_set1_ps(triangle[2]);
+			__m128 e1x = _mm_set1_ps(triangle[3]), e1y = _mm_set1_ps(triangle[4]), e1z = _mm_set1_ps(triangle[5]);
+			__m128 e2x = _mm_set1_ps(triangle[6]), e2y = _mm_set1_ps(triangle[7]), e2z = _mm_set1_ps(triangle[8]);
+			size_t hits = 0;
+			size_t i = 0;
+
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 rdx = _mm_loadu_ps(dx + i), rdy = _mm_loadu_ps(dy + i), rdz = _mm_loadu_ps(dz + i);
+
+				__m128 px = _mm_sub_ps(_mm_mul_ps(rdy, e2z), _mm_mul_ps(rdz, e2y));
+				__m128 py = _mm_sub_ps(_mm_mul_ps(rdz, e2x), _mm_mul_ps(rdx, e2z));
+				__m128 pz = _mm_sub_ps(_mm_mul_ps(rdx, e2y), _mm_mul_ps(rdy, e2x));
+				__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+				__m128 inv = _mm_div_ps(one, det);
+
+				__m128 sx = _mm_sub_ps(_mm_loadu_ps(ox + i), v0x);
+				__m128 sy = _mm_sub_ps(_mm_loadu_ps(oy + i), v0y);
+				__m128 sz = _mm_sub_ps(_mm_loadu_ps(oz + i), v0z);
+				__m128 hitU = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), inv);
+
+				__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+				__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+				__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+				__m128 hitV = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rdx, qx), _mm_mul_ps(rdy, qy)), _mm_mul_ps(rdz, qz)), inv);
+				__m128 hitT = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv);
+
+				__m128 previous = _mm_loadu_ps(distance + i);
+				__m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmpneq_ps(det, zero), _mm_cmpge_ps(hitU, zero)),
+					_mm_and_ps(_mm_cmpge_ps(hitV, zero), _mm_cmple_ps(_mm_add_ps(hitU, hitV), one)));
+				mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpgt_ps(hitT, zero), _mm_cmplt_ps(hitT, previous)));
+
+				_mm_storeu_ps(distance + i, selectSSE(mask, hitT, previous));
+				_mm_storeu_ps(u + i, selectSSE(mask, hitU, _mm_loadu_ps(u + i)));
+				_mm_storeu_ps(v + i, selectSSE(mask, hitV, _mm_loadu_ps(v + i)));
+				_mm_storeu_si128((__m128i*)(hitTriangles + i), selectSSE(_mm_castps_si128(mask), ids,
+					_mm_loadu_si128((const __m128i*)(hitTriangles + i))));
+
+				hits += __builtin_popcount(_mm_movemask_ps(mask));
+			}
+
+			return hits + raysTriangleScalar(hitTriangles + i, distance + i, u + i, v + i, triangle, id,
+				ox + i, oy + i, oz + i, dx + i, dy + i, dz + i, n - i);
+		}
+	}
+}
+
+#endif
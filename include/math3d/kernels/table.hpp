@@ -0,0 +1,442 @@
+#ifndef KERNELS_TABLE_HPP
+#define KERNELS_TABLE_HPP
+
+#include "../dispatch.hpp"
+#include "../simd.hpp"
+#include "scalar.hpp"
+
+#ifdef MATH3D_SSE
+#include "sse.hpp"
+#endif
+
+#ifdef MATH3D_AVX
+#include "avx.hpp"
+#endif
+
+#ifdef MATH3D_AVX512
+#include "avx512.hpp"
+#endif
+
+/**
+ * Selects the widest kernels that the current compiler flags allow
+ */
+#if defined(MATH3D_AVX512)
+	#define MATH3D_BEST_KERNEL(name) name##AVX512
+#elif defined(MATH3D_AVX)
+	#define MATH3D_BEST_KERNEL(name) name##AVX
+#elif defined(MATH3D_SSE)
+	#define MATH3D_BEST_KERNEL(name) name##SSE
+#else
+	#define MATH3D_BEST_KERNEL(name) name##Scalar
+#endif
+
+#if defined(MATH3D_AVX)
+	#define MATH3D_BEST_AVX_KERNEL(name) name##AVX
+#else
+	#define MATH3D_BEST_AVX_KERNEL(name) MATH3D_BEST_SSE_KERNEL(name)
+#endif
+
+#if defined(MATH3D_SSE)
+	#define MATH3D_BEST_SSE_KERNEL(name) name##SSE
+#else
+	#define MATH3D_BEST_SSE_KERNEL(name) name##Scalar
+#endif
+
+namespace math3d
+{
+	namespace detail
+	{
+		/**
+		 * The kernel table for the instruction sets enabled at compile time.
+		 * Header-only builds call through it directly (the compiler folds
+		 * the constant function pointers), and each kernels_*.cpp file of
+		 * the static library instantiates it with its own -m flags.
+		 *
+		 * Kernels that only benefit from wider registers when processing
+		 * many elements use MATH3D_BEST_KERNEL; the rest stop at AVX or SSE.
+		 */
+		static constexpr Kernels compileTimeKernels =
+		{
+			MATH3D_BEST_AVX_KERNEL(mat4Mul),
+			MATH3D_BEST_SSE_KERNEL(mat4Inverse),
+			MATH3D_BEST_SSE_KERNEL(mat4InverseAffine),
+			MATH3D_BEST_SSE_KERNEL(mat4TransformPoint),
+
+			MATH3D_BEST_SSE_KERNEL(affineMul),
+			MATH3D_BEST_SSE_KERNEL(affineInverse),
+
+			MATH3D_BEST_SSE_KERNEL(quatMul),
+			MATH3D_BEST_SSE_KERNEL(quatNormalize),
+
+			MATH3D_BEST_KERNEL(streamAdd),
+			MATH3D_BEST_KERNEL(streamSub),
+			MATH3D_BEST_KERNEL(streamMul),
+			MATH3D_BEST_KERNEL(streamScale),
+			MATH3D_BEST_KERNEL(streamLerp),
+
+			MATH3D_BEST_KERNEL(vec3Dot),
+			MATH3D_BEST_KERNEL(vec3Cross),
+			MATH3D_BEST_KERNEL(vec3MagSq),
+			MATH3D_BEST_KERNEL(vec3Magnitude),
+			MATH3D_BEST_KERNEL(vec3Normalize),
+			MATH3D_BEST_KERNEL(vec3NormalizeFast),
+
+			MATH3D_BEST_KERNEL(mat4TransformPoints),
+			MATH3D_BEST_KERNEL(mat4TransformDirections),
+			MATH3D_BEST_KERNEL(mat4TransformHomogeneous),
+
+			MATH3D_BEST_KERNEL(quatRotateVectors),
+			MATH3D_BEST_KERNEL(quatsRotateVectors),
+
+			MATH3D_BEST_KERNEL(quatNlerp),
+			MATH3D_BEST_SSE_KERNEL(quatSlerp),
+
+			MATH3D_BEST_KERNEL(streamSinCos),
+			MATH3D_BEST_KERNEL(streamAtan2),
+			MATH3D_BEST_KERNEL(quatFromEulerAngles),
+			MATH3D_BEST_KERNEL(quatFromAxisAngle),
+
+			MATH3D_BEST_SSE_KERNEL(skinLinear),
+			MATH3D_BEST_SSE_KERNEL(skinDualQuat),
+
+			MATH3D_BEST_SSE_KERNEL(quatPack32),
+			MATH3D_BEST_SSE_KERNEL(quatUnpack32),
+			MATH3D_BEST_SSE_KERNEL(quatPack48),
+			MATH3D_BEST_SSE_KERNEL(quatUnpack48),
+			MATH3D_BEST_SSE_KERNEL(streamQuantize16),
+			MATH3D_BEST_SSE_KERNEL(streamDequantize16),
+
+			MATH3D_BEST_SSE_KERNEL(vec3Deinterleave),
+			MATH3D_BEST_SSE_KERNEL(vec3Interleave),
+
+			MATH3D_BEST_KERNEL(frustumCullSpheres),
+			MATH3D_BEST_KERNEL(frustumCullBoxes),
+			MATH3D_BEST_SSE_KERNEL(aabbTransform),
+
+			MATH3D_BEST_KERNEL(rayTriangles),
+			MATH3D_BEST_KERNEL(raysTriangle)
+		};
+
+		/**
+		 * Gets the kernels used by the classes: the compile-time table in
+		 * header-only mode, or the table chosen by Dispatch at runtime
+		 */
+		static inline const Kernels& kernels()
+		{
+#ifdef MATH3D_HEADER_ONLY
+			return compileTimeKernels;
+#else
+			return Dispatch::kernels();
+#endif
+		}
+
+		/**
+		 * The kernels of the class templates, overloaded on the scalar type:
+		 * float data goes through kernels(), and any other type through the
+		 * scalar kernels
+		 */
+		static inline void mat4Mul(float* out, const float* a, const float* b)
+		{
+			kernels().mat4Mul(out, a, b);
+		}
+
+		template <typename T>
+		static inline void mat4Mul(T* out, const T* a, const T* b)
+		{
+			mat4MulScalar(out, a, b);
+		}
+
+		static inline void mat4Inverse(float* out, const float* m)
+		{
+			kernels().mat4Inverse(out, m);
+		}
+
+		template <typename T>
+		static inline void mat4Inverse(T* out, const T* m)
+		{
+			mat4InverseScalar(out, m);
+		}
+
+		static inline void mat4InverseAffine(float* out, const float* m)
+		{
+			kernels().mat4InverseAffine(out, m);
+		}
+
+		template <typename T>
+		static inline void mat4InverseAffine(T* out, const T* m)
+		{
+			mat4InverseAffineScalar(out, m);
+		}
+
+		static inline void mat4TransformPoint(float* out, const float* m, const float* v)
+		{
+			kernels().mat4TransformPoint(out, m, v);
+		}
+
+		template <typename T>
+		static inline void mat4TransformPoint(T* out, const T* m, const T* v)
+		{
+			mat4TransformPointScalar(out, m, v);
+		}
+
+		static inline void affineMul(float* out, const float* a, const float* b)
+		{
+			kernels().affineMul(out, a, b);
+		}
+
+		template <typename T>
+		static inline void affineMul(T* out, const T* a, const T* b)
+		{
+			affineMulScalar(out, a, b);
+		}
+
+		static inline void affineInverse(float* out, const float* m)
+		{
+			kernels().affineInverse(out, m);
+		}
+
+		template <typename T>
+		static inline void affineInverse(T* out, const T* m)
+		{
+			affineInverseScalar(out, m);
+		}
+
+		static inline void quatMul(float* out, const float* a, const float* b)
+		{
+			kernels().quatMul(out, a, b);
+		}
+
+		template <typename T>
+		static inline void quatMul(T* out, const T* a, const T* b)
+		{
+			quatMulScalar(out, a, b);
+		}
+
+		/**
+		 * An approximate 1 / sqrt(x) for Precision::Fast: a hardware
+		 * estimate refined by a Newton-Raphson step for float when SSE is
+		 * available, and 1 / sqrt(x) otherwise
+		 */
+		static inline float rsqrtFast(float x)
+		{
+#ifdef MATH3D_SSE
+			return rsqrtSSE(x);
+#else
+			return rsqrtScalar(x);
+#endif
+		}
+
+		template <typename T>
+		static inline T rsqrtFast(T x)
+		{
+			return rsqrtScalar(x);
+		}
+
+		static inline void quatNormalize(float* out, const float* q)
+		{
+			kernels().quatNormalize(out, q);
+		}
+
+		template <typename T>
+		static inline void quatNormalize(T* out, const T* q)
+		{
+			quatNormalizeScalar(out, q);
+		}
+
+		/** @brief quatNormalize with Precision::Fast, see rsqrtFast */
+		static inline void quatNormalizeFast(float* out, const float* q)
+		{
+#ifdef MATH3D_SSE
+			quatNormalizeFastSSE(out, q);
+#else
+			quatNormalizeFastScalar(out, q);
+#endif
+		}
+
+		template <typename T>
+		static inline void quatNormalizeFast(T* out, const T* q)
+		{
+			quatNormalizeFastScalar(out, q);
+		}
+
+		/** @brief the number of quaternions the AoS batch overloads convert at a time */
+		static const size_t QUAT_BATCH_BLOCK_SIZE = 256;
+
+		/**
+		 * out[i] = Quaternion::fromEulerAngles(angles[i]) for n (x, y, z)
+		 * angles and n (x, y, z, w) quaternions stored interleaved. Float
+		 * data is split into streams for kernels().quatFromEulerAngles
+		 * one block at a time.
+		 */
+		static inline void quatFromEulerAngles(float* out, const float* angles, size_t n)
+		{
+			const Kernels& k = kernels();
+			alignas(64) float streams[7][QUAT_BATCH_BLOCK_SIZE];
+
+			for (size_t start = 0; start < n; start += QUAT_BATCH_BLOCK_SIZE)
+			{
+				size_t count = n - start < QUAT_BATCH_BLOCK_SIZE ? n - start : QUAT_BATCH_BLOCK_SIZE;
+				float* q = out + 4 * start;
+
+				k.vec3Deinterleave(streams[4], streams[5], streams[6], angles + 3 * start, count);
+				k.quatFromEulerAngles(streams[0], streams[1], streams[2], streams[3],
+					streams[4], streams[5], streams[6], count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					q[4 * i + 0] = streams[0][i];
+					q[4 * i + 1] = streams[1][i];
+					q[4 * i + 2] = streams[2][i];
+					q[4 * i + 3] = streams[3][i];
+				}
+			}
+		}
+
+		template <typename T>
+		static inline void quatFromEulerAngles(T* out, const T* angles, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T* q = out + 4 * i;
+				const T* a = angles + 3 * i;
+
+				quatFromEulerAnglesScalar(q, q + 1, q + 2, q + 3, a, a + 1, a + 2, 1);
+			}
+		}
+
+		/**
+		 * out[i] = Quaternion::fromAxisAngle(axes[i], angles[i]) for n
+		 * interleaved (x, y, z) axes and (x, y, z, w) quaternions, like
+		 * quatFromEulerAngles
+		 */
+		static inline void quatFromAxisAngle(float* out, const float* axes, const float* angles, size_t n)
+		{
+			const Kernels& k = kernels();
+			alignas(64) float streams[7][QUAT_BATCH_BLOCK_SIZE];
+
+			for (size_t start = 0; start < n; start += QUAT_BATCH_BLOCK_SIZE)
+			{
+				size_t count = n - start < QUAT_BATCH_BLOCK_SIZE ? n - start : QUAT_BATCH_BLOCK_SIZE;
+				float* q = out + 4 * start;
+
+				k.vec3Deinterleave(streams[4], streams[5], streams[6], axes + 3 * start, count);
+				k.quatFromAxisAngle(streams[0], streams[1], streams[2], streams[3],
+					streams[4], streams[5], streams[6], angles + start, count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					q[4 * i + 0] = streams[0][i];
+					q[4 * i + 1] = streams[1][i];
+					q[4 * i + 2] = streams[2][i];
+					q[4 * i + 3] = streams[3][i];
+				}
+			}
+		}
+
+		template <typename T>
+		static inline void quatFromAxisAngle(T* out, const T* axes, const T* angles, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				T* q = out + 4 * i;
+				const T* a = axes + 3 * i;
+
+				quatFromAxisAngleScalar(q, q + 1, q + 2, q + 3, a, a + 1, a + 2, angles + i, 1);
+			}
+		}
+
+		/**
+		 * out[i] = from[i].slerp(to[i], inc[i]) along the shortest path for n
+		 * interleaved (x, y, z, w) unit quaternions, like quatFromEulerAngles.
+		 * Float data goes through kernels().quatSlerp one block at a time,
+		 * while any other type is passed to single(i) one quaternion at a time.
+		 */
+		template <typename Single>
+		static inline void quatSlerp(float* out, const float* from, const float* to, const float* inc, size_t n, Single)
+		{
+			const Kernels& k = kernels();
+			alignas(64) float streams[8][QUAT_BATCH_BLOCK_SIZE];
+
+			for (size_t start = 0; start < n; start += QUAT_BATCH_BLOCK_SIZE)
+			{
+				size_t count = n - start < QUAT_BATCH_BLOCK_SIZE ? n - start : QUAT_BATCH_BLOCK_SIZE;
+				const float* a = from + 4 * start;
+				const float* b = to + 4 * start;
+				float* q = out + 4 * start;
+
+				for (size_t i = 0; i < count; i++)
+				{
+					streams[0][i] = a[4 * i + 0];
+					streams[1][i] = a[4 * i + 1];
+					streams[2][i] = a[4 * i + 2];
+					streams[3][i] = a[4 * i + 3];
+					streams[4][i] = b[4 * i + 0];
+					streams[5][i] = b[4 * i + 1];
+					streams[6][i] = b[4 * i + 2];
+					streams[7][i] = b[4 * i + 3];
+				}
+
+				k.quatSlerp(streams[0], streams[1], streams[2], streams[3], streams[0], streams[1], streams[2], streams[3],
+					streams[4], streams[5], streams[6], streams[7], inc + start, count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					q[4 * i + 0] = streams[0][i];
+					q[4 * i + 1] = streams[1][i];
+					q[4 * i + 2] = streams[2][i];
+					q[4 * i + 3] = streams[3][i];
+				}
+			}
+		}
+
+		template <typename T, typename Single>
+		static inline void quatSlerp(T*, const T*, const T*, const T*, size_t n, Single single)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				single(i);
+			}
+		}
+
+		static inline void aabbTransform(float* out, const float* boxes, const float* matrices, size_t stride, size_t n)
+		{
+			kernels().aabbTransform(out, boxes, matrices, stride, n);
+		}
+
+		template <typename T>
+		static inline void aabbTransform(T* out, const T* boxes, const T* matrices, size_t stride, size_t n)
+		{
+			aabbTransformScalar(out, boxes, matrices, stride, n);
+		}
+
+		static inline size_t rayTriangles(const float* ray, const float* triangles, size_t stride, size_t n,
+			float& distance, float& u, float& v)
+		{
+			return kernels().rayTriangles(ray, triangles, stride, n, distance, u, v);
+		}
+
+		template <typename T>
+		static inline size_t rayTriangles(const T* ray, const T* triangles, size_t stride, size_t n,
+			T& distance, T& u, T& v)
+		{
+			return rayTrianglesScalar(ray, triangles, stride, n, distance, u, v);
+		}
+
+		static inline size_t raysTriangle(uint32_t* hitTriangles, float* distance, float* u, float* v,
+			const float* triangle, uint32_t id, const float* ox, const float* oy, const float* oz,
+			const float* dx, const float* dy, const float* dz, size_t n)
+		{
+			return kernels().raysTriangle(hitTriangles, distance, u, v, triangle, id, ox, oy, oz, dx, dy, dz, n);
+		}
+
+		template <typename T>
+		static inline size_t raysTriangle(uint32_t* hitTriangles, T* distance, T* u, T* v,
+			const T* triangle, uint32_t id, const T* ox, const T* oy, const T* oz,
+			const T* dx, const T* dy, const T* dz, size_t n)
+		{
+			return raysTriangleScalar(hitTriangles, distance, u, v, triangle, id, ox, oy, oz, dx, dy, dz, n);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef KERNELS_VEC4_HPP
+#define KERNELS_VEC4_HPP
+
+#include "../simd.hpp"
+
+#ifdef MATH3D_SSE
+#include "sse.hpp"
+#endif
+
+/**
+ * Register-level operations on 4 packed components, such as the x, y, z,
+ * and w of a Vector4 or the x, y, z, and padding of a Vector3A, which
+ * must be 16-byte aligned
+ *
+ * Each float operation is a handful of SSE2 instructions, which every
+ * x86-64 CPU has, so they are inlined into the operators in both build
+ * modes instead of being dispatched through the kernel table. The
+ * templates are the scalar versions for other scalar types and for
+ * targets without SSE. Both perform the same operations in the same
+ * order as the corresponding Vector3 and Matrix4x4 operators.
+ *
+ * The padded vec3 operations keep the fourth lane of a Vector3A 0: they
+ * never divide it by 0, and they ignore it in dot products.
+ */
+namespace math3d
+{
+	namespace detail
+	{
+		template <typename T>
+		static inline void vec4Add(T* out, const T* a, const T* b)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				out[i] = a[i] + b[i];
+			}
+		}
+
+		template <typename T>
+		static inline void vec4Sub(T* out, const T* a, const T* b)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				out[i] = a[i] - b[i];
+			}
+		}
+
+		template <typename T>
+		static inline void vec4Mul(T* out, const T* a, const T* b)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				out[i] = a[i] * b[i];
+			}
+		}
+
+		template <typename T>
+		static inline void vec4Div(T* out, const T* a, const T* b)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				out[i] = a[i] / b[i];
+			}
+		}
+
+		template <typename T>
+		static inline void vec4Negate(T* out, const T* a)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				out[i] = -a[i];
+			}
+		}
+
+		/** @brief out = a + (n, n, n, w) */
+		template <typename T>
+		static inline void vec4AddBroadcast(T* out, const T* a, T n, T w)
+		{
+			out[0] = a[0] + n;
+			out[1] = a[1] + n;
+			out[2] = a[2] + n;
+			out[3] = a[3] + w;
+		}
+
+		/** @brief out = a - (n, n, n, w) */
+		template <typename T>
+		static inline void vec4SubBroadcast(T* out, const T* a, T n, T w)
+		{
+			out[0] = a[0] - n;
+			out[1] = a[1] - n;
+			out[2] = a[2] - n;
+			out[3] = a[3] - w;
+		}
+
+		/** @brief out = a * (n, n, n, w) */
+		template <typename T>
+		static inline void vec4MulBroadcast(T* out, const T* a, T n, T w)
+		{
+			out[0] = a[0] * n;
+			out[1] = a[1] * n;
+			out[2] = a[2] * n;
+			out[3] = a[3] * w;
+		}
+
+		/** @brief out = a / (n, n, n, w) */
+		template <typename T>
+		static inline void vec4DivBroadcast(T* out, const T* a, T n, T w)
+		{
+			out[0] = a[0] / n;
+			out[1] = a[1] / n;
+			out[2] = a[2] / n;
+			out[3] = a[3] / w;
+		}
+
+		template <typename T>
+		static inline T vec4Dot(const T* a, const T* b)
+		{
+			return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+		}
+
+		/** @brief out = a / (b0, b1, b2, 1), so that a padding lane of 0 stays 0 */
+		template <typename T>
+		static inline void vec3PaddedDiv(T* out, const T* a, const T* b)
+		{
+			out[0] = a[0] / b[0];
+			out[1] = a[1] / b[1];
+			out[2] = a[2] / b[2];
+			out[3] = a[3];
+		}
+
+		template <typename T>
+		static inline T vec3PaddedDot(const T* a, const T* b)
+		{
+			return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+		}
+
+		template <typename T>
+		static inline void vec3PaddedCross(T* out, const T* a, const T* b)
+		{
+			T nx = a[1] * b[2] - a[2] * b[1];
+			T ny = a[2] * b[0] - a[0] * b[2];
+			T nz = a[0] * b[1] - a[1] * b[0];
+
+			out[0] = nx;
+			out[1] = ny;
+			out[2] = nz;
+			out[3] = 0;
+		}
+
+		/** @brief transforms the (x, y, z, w) vector v by the row-major 4x4 matrix m */
+		template <typename T>
+		static inline void mat4TransformVec4(T* out, const T* m, const T* v)
+		{
+			T x = v[0];
+			T y = v[1];
+			T z = v[2];
+			T w = v[3];
+
+			out[0] = m[0] * x + m[1] * y + m[2] * z + m[3] * w;
+			out[1] = m[4] * x + m[5] * y + m[6] * z + m[7] * w;
+			out[2] = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+			out[3] = m[12] * x + m[13] * y + m[14] * z + m[15] * w;
+		}
+
+#ifdef MATH3D_SSE
+		static inline void vec4Add(float* out, const float* a, const float* b)
+		{
+			_mm_store_ps(out, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+		}
+
+		static inline void vec4Sub(float* out, const float* a, const float* b)
+		{
+			_mm_store_ps(out, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+		}
+
+		static inline void vec4Mul(float* out, const float* a, const float* b)
+		{
+			_mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)));
+		}
+
+		static inline void vec4Div(float* out, const float* a, const float* b)
+		{
+			_mm_store_ps(out, _mm_div_ps(_mm_load_ps(a), _mm_load_ps(b)));
+		}
+
+		static inline void vec4Negate(float* out, const float* a)
+		{
+			_mm_store_ps(out, _mm_xor_ps(_mm_load_ps(a), _mm_set1_ps(-0.0f)));
+		}
+
+		static inline void vec4AddBroadcast(float* out, const float* a, float n, float w)
+		{
+			_mm_store_ps(out, _mm_add_ps(_mm_load_ps(a), _mm_setr_ps(n, n, n, w)));
+		}
+
+		static inline void vec4SubBroadcast(float* out, const float* a, float n, float w)
+		{
+			_mm_store_ps(out, _mm_sub_ps(_mm_load_ps(a), _mm_setr_ps(n, n, n, w)));
+		}
+
+		static inline void vec4MulBroadcast(float* out, const float* a, float n, float w)
+		{
+			_mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_setr_ps(n, n, n, w)));
+		}
+
+		static inline void vec4DivBroadcast(float* out, const float* a, float n, float w)
+		{
+			_mm_store_ps(out, _mm_div_ps(_mm_load_ps(a), _mm_setr_ps(n, n, n, w)));
+		}
+
+		/** @brief adds lanes 0 to count - 1 of p from left to right, into lane 0 */
+		static inline float horizontalSumSSE(__m128 p, int count)
+		{
+			__m128 sum = _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+
+			if (count == 4)
+			{
+				sum = _mm_add_ss(sum, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)));
+			}
+
+			return _mm_cvtss_f32(sum);
+		}
+
+		static inline float vec4Dot(const float* a, const float* b)
+		{
+			return horizontalSumSSE(_mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)), 4);
+		}
+
+		static inline void vec3PaddedDiv(float* out, const float* a, const float* b)
+		{
+			__m128 vb = _mm_load_ps(b);
+			// (b2, b2, 1, 1), then (b0, b1, b2, 1)
+			__m128 high = _mm_shuffle_ps(vb, _mm_set1_ps(1.0f), _MM_SHUFFLE(0, 0, 2, 2));
+
+			_mm_store_ps(out, _mm_div_ps(_mm_load_ps(a), _mm_shuffle_ps(vb, high, _MM_SHUFFLE(2, 0, 1, 0))));
+		}
+
+		static inline float vec3PaddedDot(const float* a, const float* b)
+		{
+			return horizontalSumSSE(_mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)), 3);
+		}
+
+		static inline void vec3PaddedCross(float* out, const float* a, const float* b)
+		{
+			// lane 3 is a3 * b3 - a3 * b3, which is 0 for a padding of 0
+			_mm_store_ps(out, cross3SSE(_mm_load_ps(a), _mm_load_ps(b)));
+		}
+
+		static inline void mat4TransformVec4(float* out, const float* m, const float* v)
+		{
+			__m128 c0 = _mm_loadu_ps(m + 0);
+			__m128 c1 = _mm_loadu_ps(m + 4);
+			__m128 c2 = _mm_loadu_ps(m + 8);
+			__m128 c3 = _mm_loadu_ps(m + 12);
+			__m128 vv = _mm_load_ps(v);
+
+			_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+			__m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(vv, vv, _MM_SHUFFLE(0, 0, 0, 0)));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(vv, vv, _MM_SHUFFLE(1, 1, 1, 1))));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(vv, vv, _MM_SHUFFLE(2, 2, 2, 2))));
+			r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(vv, vv, _MM_SHUFFLE(3, 3, 3, 3))));
+
+			_mm_store_ps(out, r);
+		}
+#endif
+	}
+}
+
+#endif
@@ -7,8 +7,25 @@
 
 #include "vector2.hpp"
 #include "vector3.hpp"
+#include "vector3a.hpp"
+#include "vector4.hpp"
 #include "quaternion.hpp"
 #include "matrix4x4.hpp"
+#include "affine3x4.hpp"
 #include "transform.hpp"
+#include "transformhierarchy.hpp"
+#include "vector3array.hpp"
+#include "animationclip.hpp"
+#include "animationsampler.hpp"
+#include "dualquaternion.hpp"
+#include "skinning.hpp"
+#include "compression.hpp"
+#include "trigonometry.hpp"
+#include "aabb.hpp"
+#include "sphere.hpp"
+#include "frustum.hpp"
+#include "ray.hpp"
+#include "bvh.hpp"
+#include "threadpool.hpp"
 
 #endif
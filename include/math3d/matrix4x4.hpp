@@ -1,21 +1,27 @@
 #ifndef MATRIX4X4_HPP
 #define MATRIX4X4_HPP
 
-#include "vector3.hpp"
-#include "quaternion.hpp"
+#include "config.hpp"
+#include "fwd.hpp"
+#include <cstddef>
+
+class ConstVector3View;
+class Vector3View;
+class ThreadPool;
 
 /**
  * A 4x4 transformation matrix representing a
  * position and a rotation in 3-dimensional space
  */
-class Matrix4x4
+template <typename T>
+class Matrix4x4T
 {
 	public:
 		/**
 		 * Creates a new Matrix4x4 object and initializes so that it
 		 * contains the 4x4 identity matrix
 		 */
-		static Matrix4x4 identity();
+		static MATH3D_CONSTEXPR Matrix4x4T identity();
 		
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
@@ -25,14 +31,14 @@ class Matrix4x4
 		 * @param y the y component of the position
 		 * @param z the z component of the position
 		 */
-		static Matrix4x4 position(float x, float y, float z);
+		static MATH3D_CONSTEXPR Matrix4x4T position(T x, T y, T z);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * an (x, y, z) position
 		 *
 		 * @param pos the vector containing the position
 		 */
-		static Matrix4x4 position(const Vector3& pos);
+		static MATH3D_CONSTEXPR Matrix4x4T position(const Vector3T<T>& pos);
 
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
@@ -42,14 +48,14 @@ class Matrix4x4
 		 * @param y the y component of the scale
 		 * @param z the z component of the scale
 		 */
-		static Matrix4x4 scale(float x, float y, float z);
+		static MATH3D_CONSTEXPR Matrix4x4T scale(T x, T y, T z);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * an (x, y, z) scale
 		 *
 		 * @param scale the vector containing the scale
 		 */
-		static Matrix4x4 scale(const Vector3& scale);
+		static MATH3D_CONSTEXPR Matrix4x4T scale(const Vector3T<T>& scale);
 
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
@@ -59,14 +65,14 @@ class Matrix4x4
 		 * @param y the y axis rotation
 		 * @param z the z axis rotation
 		 */
-		static Matrix4x4 rotation(float x, float y, float z);
+		static Matrix4x4T rotation(T x, T y, T z);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * a rotation consisting of (x, y, z) euler angles
 		 *
 		 * @param rot the rotations for the x, y, and z axes
 		 */
-		static Matrix4x4 rotation(const Vector3& rot);
+		static Matrix4x4T rotation(const Vector3T<T>& rot);
 
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
@@ -77,14 +83,14 @@ class Matrix4x4
 		 * @param z the z component of the rotation
 		 * @param w the w component of the rotation
 		 */
-		static Matrix4x4 rotation(float x, float y, float z, float w);
+		static MATH3D_CONSTEXPR Matrix4x4T rotation(T x, T y, T z, T w);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * a quaternion (x, y, z, w) rotation
 		 *
 		 * @param rot the rotation quaternion
 		 */
-		static Matrix4x4 rotation(const Quaternion& rot);	
+		static MATH3D_CONSTEXPR Matrix4x4T rotation(const QuaternionT<T>& rot);	
 
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
@@ -97,7 +103,7 @@ class Matrix4x4
 		 * @param z the z component of the axis
 		 * @param angle the angle of rotation
 		 */
-		static Matrix4x4 fromAxisAngle(float x, float y, float z, float angle);
+		static Matrix4x4T fromAxisAngle(T x, T y, T z, T angle);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * a rotation from an (x, y, z) vector axis and an angle
@@ -107,7 +113,7 @@ class Matrix4x4
 		 * @param axis the axis of rotation
 		 * @param angle the angle of rotation
 		 */
-		static Matrix4x4 fromAxisAngle(const Vector3& axis, float angle);
+		static Matrix4x4T fromAxisAngle(const Vector3T<T>& axis, T angle);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * a rotation from a vector by using its magnitude for the angle of
@@ -117,7 +123,7 @@ class Matrix4x4
 		 *
 		 * @param axis the vector containing the axis and the angle of rotation
 		 */
-		static Matrix4x4 fromAxisAngle(const Vector3& axis);
+		static Matrix4x4T fromAxisAngle(const Vector3T<T>& axis);
 
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
@@ -127,7 +133,7 @@ class Matrix4x4
 		 * @param forward the forward direction vector
 		 * @param up the up direction vector
 		 */
-		static Matrix4x4 fromAxes(const Vector3& forward, const Vector3& up);
+		static MATH3D_CONSTEXPR Matrix4x4T fromAxes(const Vector3T<T>& forward, const Vector3T<T>& up);
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with
 		 * a rotation created from a normalized (unit) forward vector,
@@ -137,7 +143,7 @@ class Matrix4x4
 		 * @param up the up direction vector
 		 * @param right the right direction vector
 		 */
-		static Matrix4x4 fromAxes(const Vector3& forward, const Vector3& up, const Vector3& right);
+		static MATH3D_CONSTEXPR Matrix4x4T fromAxes(const Vector3T<T>& forward, const Vector3T<T>& up, const Vector3T<T>& right);
 
 		/**
 		 * Creates a new Matrix4x4 object and initializes it with a
@@ -149,38 +155,399 @@ class Matrix4x4
 		 * @param zNear the near value for the projection
 		 * @param zFar the far value for the projection
 		 */
-		static Matrix4x4 perspective(float fov, float aspectRatio, float zNear, float zFar);
+		static Matrix4x4T perspective(T fov, T aspectRatio, T zNear, T zFar);
 
 		/**
 		 * Creates a new Matrix4x4 and initializes all of its
 		 * components to 0
 		 */
-		Matrix4x4();
+		MATH3D_CONSTEXPR Matrix4x4T();
 		/**
 		 * Creates a new Matrix4x4 and ininitialzes its matrix
 		 * to the matrix of the given Matrix4x4 object
 		 */
-		Matrix4x4(const Matrix4x4&);
+		Matrix4x4T(const Matrix4x4T&) = default;
+		/**
+		 * Creates a new Matrix4x4 by converting the components of a
+		 * matrix with another scalar type, e.g. a Matrix4x4d
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit Matrix4x4T(const Matrix4x4T<U>& m4);
 
 		/** @brief calculates the determinant of the given matrix */
-		float determinant() const;
-		/** @brief calculates the inverse of the given matrix */
-		Matrix4x4 inverse() const;
+		T determinant() const;
+		/**
+		 * Calculates the inverse of the given matrix, which may be any
+		 * invertible matrix, including a projection
+		 */
+		Matrix4x4T inverse() const;
+		/**
+		 * Calculates the inverse of the given matrix, which is cheaper than
+		 * inverse() but only correct for affine matrices: ones built from
+		 * positions, rotations, and scales, with a bottom row of (0, 0, 0, 1)
+		 */
+		Matrix4x4T inverseAffine() const;
+		/**
+		 * Calculates the inverse of the given matrix by transposing its
+		 * rotation, which is the cheapest of the inverses
+		 *
+		 * Note: the matrix must only contain a rotation and a position
+		 * (no scale or projection)
+		 */
+		Matrix4x4T inverseRigid() const;
 		/** @brief calculates the transpose of the given matrix */
-		Matrix4x4 transpose() const;
+		MATH3D_CONSTEXPR Matrix4x4T transpose() const;
 
 		/** @brief multiplies two matrices together using matrix multiplication */
-		Matrix4x4 operator*(const Matrix4x4&) const;
+		MATH3D_CONSTEXPR Matrix4x4T operator*(const Matrix4x4T&) const;
 
 		/** @brief transforms a vector by the matrix using matrix multiplication */
-		Vector3 operator*(const Vector3&) const;
+		MATH3D_CONSTEXPR Vector3T<T> operator*(const Vector3T<T>&) const;
+		/**
+		 * Transforms a homogeneous (x, y, z, w) vector by the matrix using
+		 * matrix multiplication, with a few SSE instructions for floats
+		 */
+		MATH3D_CONSTEXPR Vector4T<T> operator*(const Vector4T<T>&) const;
+
+		/**
+		 * Transforms a batch of points (x, y, z, 1) by the matrix. The
+		 * matrix is kept in registers and several points are processed per
+		 * instruction, which is much faster than calling operator* per point.
+		 *
+		 * @param in the points, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param out receives the transformed points; may be the same as in
+		 */
+		void transformPoints(ConstVector3View in, Vector3View out) const;
+		/**
+		 * Transforms count points of an array of Vector3 objects, which
+		 * may be transformed in place by passing the same array as out
+		 */
+		void transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const;
+		/**
+		 * Transforms a batch of points in chunks on the threads of a pool,
+		 * with the same results as transforming them on one thread
+		 */
+		void transformPoints(ConstVector3View in, Vector3View out, ThreadPool& pool) const;
+		/** @brief transforms count points of an array of Vector3 objects on the threads of a pool */
+		void transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count, ThreadPool& pool) const;
+
+		/**
+		 * Transforms a batch of directions (x, y, z, 0) by the matrix, so
+		 * that only its rotation and scale are applied
+		 *
+		 * @param in the directions, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param out receives the transformed directions; may be the same as in
+		 */
+		void transformDirections(ConstVector3View in, Vector3View out) const;
+		/**
+		 * Transforms count directions of an array of Vector3 objects, which
+		 * may be transformed in place by passing the same array as out
+		 */
+		void transformDirections(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const;
+
+		/**
+		 * Transforms a batch of points (x, y, z, 1) by the matrix and divides
+		 * each result by its w component, e.g. to project points with a
+		 * perspective matrix
+		 *
+		 * @param in the points, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param out receives the projected points; may be the same as in
+		 */
+		void transformHomogeneous(ConstVector3View in, Vector3View out) const;
+		/**
+		 * Projects count points of an array of Vector3 objects, which
+		 * may be transformed in place by passing the same array as out
+		 */
+		void transformHomogeneous(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const;
 
 		/** @brief indexes the components of the matrix in [column][row] or [y][x] format */
-		float* operator[](int);
-		const float* operator[](int) const;
+		MATH3D_CONSTEXPR T* operator[](int);
+		MATH3D_CONSTEXPR const T* operator[](int) const;
 
-		float matrix[4][4];
+		/** @brief the components of the matrix, aligned for SIMD loads */
+		alignas(16) T matrix[4][4];
 	private:
+		/** @brief the runtime paths of the operator* overloads, which use the SIMD kernels */
+		static void multiplyKernel(Matrix4x4T& out, const Matrix4x4T& a, const Matrix4x4T& b);
+		static void transformPointKernel(Vector3T<T>& out, const Matrix4x4T& m, const Vector3T<T>& v3);
 };
 
+#include "vector3.hpp"
+#include "quaternion.hpp"
+#include "vector3array.hpp"
+#include "vector4.hpp"
+
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in matrix4x4.inl
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T>::Matrix4x4T()
+: matrix()
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR Matrix4x4T<T>::Matrix4x4T(const Matrix4x4T<U>& m4)
+: matrix()
+{
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			matrix[y][x] = (T)m4.matrix[y][x];
+		}
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::transpose() const
+{
+	Matrix4x4T<T> out;
+
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			out[y][x] = matrix[x][y];
+		}
+	}
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::identity()
+{
+	Matrix4x4T<T> out;
+
+	out[0][0] = 1;
+	out[1][1] = 1;
+	out[2][2] = 1;
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::position(T x, T y, T z)
+{
+	Matrix4x4T<T> out = identity();
+
+	out[0][3] = x;
+	out[1][3] = y;
+	out[2][3] = z;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::position(const Vector3T<T>& pos)
+{
+	Matrix4x4T<T> out = identity();
+
+	out[0][3] = pos.x;
+	out[1][3] = pos.y;
+	out[2][3] = pos.z;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::scale(T x, T y, T z)
+{
+	Matrix4x4T<T> out;
+
+	out[0][0] = x;
+	out[1][1] = y;
+	out[2][2] = z;
+	out[3][3] = 1;
+	
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::scale(const Vector3T<T>& scale)
+{
+	Matrix4x4T<T> out;
+
+	out[0][0] = scale.x;
+	out[1][1] = scale.y;
+	out[2][2] = scale.z;
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::rotation(T x, T y, T z, T w)
+{
+	Matrix4x4T<T> out;
+
+	out[0][0] = 1.0f - 2.0f * (y * y + z * z);
+	out[0][1] = 2.0f * (x * y - w * z);
+	out[0][2] = 2.0f * (x * z + w * y);
+
+	out[1][0] = 2.0f * (x * y + w * z);
+	out[1][1] = 1.0f - 2.0f * (x * x + z * z);
+	out[1][2] = 2.0f * (y * z - w * x);
+
+	out[2][0] = 2.0f * (x * z - w * y);
+	out[2][1] = 2.0f * (y * z + w * x);
+	out[2][2] = 1.0f - 2.0f * (x * x + y * y);
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::rotation(const QuaternionT<T>& rot)
+{
+	Matrix4x4T<T> out;
+
+	out[0][0] = 1.0f - 2.0f * (rot.y * rot.y + rot.z * rot.z);
+	out[0][1] = 2.0f * (rot.x * rot.y - rot.w * rot.z);
+	out[0][2] = 2.0f * (rot.x * rot.z + rot.w * rot.y);
+
+	out[1][0] = 2.0f * (rot.x * rot.y + rot.w * rot.z);
+	out[1][1] = 1.0f - 2.0f * (rot.x * rot.x + rot.z * rot.z);
+	out[1][2] = 2.0f * (rot.y * rot.z - rot.w * rot.x);
+
+	out[2][0] = 2.0f * (rot.x * rot.z - rot.w * rot.y);
+	out[2][1] = 2.0f * (rot.y * rot.z + rot.w * rot.x);
+	out[2][2] = 1.0f - 2.0f * (rot.x * rot.x + rot.y * rot.y);
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::fromAxes(const Vector3T<T>& forward, const Vector3T<T>& up)
+{
+	Matrix4x4T<T> out;
+	Vector3T<T> right = up.cross(forward);
+
+	out[0][0] = right.x;
+	out[0][1] = right.y;
+	out[0][2] = right.z;
+
+	out[1][0] = up.x;
+	out[1][1] = up.y;
+	out[1][2] = up.z;
+
+	out[2][0] = forward.x;
+	out[2][1] = forward.y;
+	out[2][2] = forward.z;
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::fromAxes(const Vector3T<T>& forward, const Vector3T<T>& up,
+	const Vector3T<T>& right)
+{
+	Matrix4x4T<T> out;
+
+	out[0][0] = right.x;
+	out[0][1] = right.y;
+	out[0][2] = right.z;
+
+	out[1][0] = up.x;
+	out[1][1] = up.y;
+	out[1][2] = up.z;
+
+	out[2][0] = forward.x;
+	out[2][1] = forward.y;
+	out[2][2] = forward.z;
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Matrix4x4T<T> Matrix4x4T<T>::operator*(const Matrix4x4T<T>& m4) const
+{
+	Matrix4x4T<T> out;
+
+	if (!math3d::detail::isConstantEvaluated())
+	{
+		multiplyKernel(out, *this, m4);
+
+		return out;
+	}
+
+	// the operations of mat4MulScalar, on the rows instead of a flat array
+	for (int y = 0; y < 4; y++)
+	{
+		for (int x = 0; x < 4; x++)
+		{
+			out.matrix[y][x] = matrix[y][0] * m4.matrix[0][x] +
+							matrix[y][1] * m4.matrix[1][x] +
+							matrix[y][2] * m4.matrix[2][x] +
+							matrix[y][3] * m4.matrix[3][x];
+		}
+	}
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Matrix4x4T<T>::operator*(const Vector3T<T>& v3) const
+{
+	if (!math3d::detail::isConstantEvaluated())
+	{
+		Vector3T<T> out;
+
+		transformPointKernel(out, *this, v3);
+
+		return out;
+	}
+
+	return Vector3T<T>(matrix[0][0] * v3.x + matrix[0][1] * v3.y + matrix[0][2] * v3.z + matrix[0][3],
+		matrix[1][0] * v3.x + matrix[1][1] * v3.y + matrix[1][2] * v3.z + matrix[1][3],
+		matrix[2][0] * v3.x + matrix[2][1] * v3.y + matrix[2][2] * v3.z + matrix[2][3]);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Matrix4x4T<T>::operator*(const Vector4T<T>& v4) const
+{
+	if (!math3d::detail::isConstantEvaluated())
+	{
+		Vector4T<T> out;
+
+		math3d::detail::mat4TransformVec4(&out.x, &matrix[0][0], &v4.x);
+
+		return out;
+	}
+
+	return Vector4T<T>(matrix[0][0] * v4.x + matrix[0][1] * v4.y + matrix[0][2] * v4.z + matrix[0][3] * v4.w,
+		matrix[1][0] * v4.x + matrix[1][1] * v4.y + matrix[1][2] * v4.z + matrix[1][3] * v4.w,
+		matrix[2][0] * v4.x + matrix[2][1] * v4.y + matrix[2][2] * v4.z + matrix[2][3] * v4.w,
+		matrix[3][0] * v4.x + matrix[3][1] * v4.y + matrix[3][2] * v4.z + matrix[3][3] * v4.w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T* Matrix4x4T<T>::operator[](int y)
+{
+	return matrix[y];
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T* Matrix4x4T<T>::operator[](int y) const
+{
+	return matrix[y];
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "matrix4x4.inl"
+#else
+extern template class Matrix4x4T<float>;
+extern template class Matrix4x4T<double>;
 #endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,337 @@
+#ifndef MATRIX4X4_INL
+#define MATRIX4X4_INL
+
+#include "config.hpp"
+#include "matrix4x4.hpp"
+#include "kernels/table.hpp"
+#include "streams.hpp"
+#include "threadpool.hpp"
+#include <cmath>
+
+template <typename T>
+MATH3D_INLINE T Matrix4x4T<T>::determinant() const
+{
+	return math3d::detail::mat4DeterminantScalar(&matrix[0][0]);
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::inverse() const
+{
+	Matrix4x4T<T> out;
+
+	math3d::detail::mat4Inverse(&out.matrix[0][0], &matrix[0][0]);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::inverseAffine() const
+{
+	Matrix4x4T<T> out;
+
+	math3d::detail::mat4InverseAffine(&out.matrix[0][0], &matrix[0][0]);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::inverseRigid() const
+{
+	Matrix4x4T<T> out;
+
+	math3d::detail::affineInverseRigidScalar(&out.matrix[0][0], &matrix[0][0]);
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::rotation(T x, T y, T z)
+{
+	Matrix4x4T<T> rx, ry, rz;
+
+	T sinX = std::sin(x);
+	T cosX = std::cos(x);
+
+	rx[0][0] = 1;
+	rx[1][1] = cosX;
+	rx[2][1] = sinX;
+	rx[1][2] = -sinX;
+	rx[2][2] = cosX;
+	rx[3][3] = 1;
+
+	T sinY = std::sin(y);
+	T cosY = std::cos(y);
+
+	ry[0][0] = cosY;
+	ry[1][1] = 1;
+	ry[2][0] = -sinY;
+	ry[0][2] = sinY;
+	ry[2][2] = cosY;
+	ry[3][3] = 1;
+
+	T sinZ = std::sin(z);
+	T cosZ = std::cos(z);
+
+	rz[0][0] = cosZ;
+	rz[1][0] = sinZ;
+	rz[0][1] = -sinZ;
+	rz[1][1] = cosZ;
+	rz[2][2] = 1;
+	rz[3][3] = 1;
+
+	return rz * (ry * rx);
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::rotation(const Vector3T<T>& rot)
+{
+	T x = rot.x;
+	T y = rot.y;
+	T z = rot.z;
+
+	Matrix4x4T<T> rx, ry, rz;
+
+	T sinX = std::sin(x);
+	T cosX = std::cos(x);
+
+	rx[0][0] = 1;
+	rx[1][1] = cosX;
+	rx[2][1] = sinX;
+	rx[1][2] = -sinX;
+	rx[2][2] = cosX;
+	rx[3][3] = 1;
+
+	T sinY = std::sin(y);
+	T cosY = std::cos(y);
+
+	ry[0][0] = cosY;
+	ry[1][1] = 1;
+	ry[2][0] = sinY;
+	ry[0][2] = -sinY;
+	ry[2][2] = cosY;
+	ry[3][3] = 1;
+
+	T sinZ = std::sin(z);
+	T cosZ = std::cos(z);
+
+	rz[0][0] = cosZ;
+	rz[1][0] = sinZ;
+	rz[0][1] = -sinZ;
+	rz[1][1] = cosZ;
+	rz[2][2] = 1;
+	rz[3][3] = 1;
+
+	return rz * (ry * rx);
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::fromAxisAngle(T x, T y, T z, T angle)
+{
+	Matrix4x4T<T> out;
+
+	T sinA = std::sin(angle);
+	T cosA = std::cos(angle);
+	T sCosA = 1 - cosA;
+
+	out[0][0] = cosA + x * x * sCosA;
+	out[0][1] = x * y * sCosA - z * sinA;
+	out[0][2] = x * z * sCosA + y * sinA;
+
+	out[1][0] = y * x * sCosA + z * sinA;
+	out[1][1] = cosA + y * y * sCosA;
+	out[1][2] = y * z * sCosA - x * sinA;
+
+	out[2][0] = z * x * sCosA - y * sinA;
+	out[2][1] = z * y * sCosA + x * sinA;
+	out[2][2] = cosA + z * z * sCosA;
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::fromAxisAngle(const Vector3T<T>& axis, T angle)
+{
+	Matrix4x4T<T> out;
+
+	T sinA = std::sin(angle);
+	T cosA = std::cos(angle);
+	T sCosA = 1 - cosA;
+
+	out[0][0] = cosA + axis.x * axis.x * sCosA;
+	out[0][1] = axis.x * axis.y * sCosA - axis.z * sinA;
+	out[0][2] = axis.x * axis.z * sCosA + axis.y * sinA;
+
+	out[1][0] = axis.y * axis.x * sCosA + axis.z * sinA;
+	out[1][1] = cosA + axis.y * axis.y * sCosA;
+	out[1][2] = axis.y * axis.z * sCosA - axis.x * sinA;
+
+	out[2][0] = axis.z * axis.x * sCosA - axis.y * sinA;
+	out[2][1] = axis.z * axis.y * sCosA + axis.x * sinA;
+	out[2][2] = cosA + axis.z * axis.z * sCosA;
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::fromAxisAngle(const Vector3T<T>& axis)
+{
+	Matrix4x4T<T> out;
+
+	T angle = axis.magnitude();
+	Vector3T<T> uAxis = axis.normalize();
+
+	T sinA = std::sin(angle);
+	T cosA = std::cos(angle);
+	T sCosA = 1 - cosA;
+
+	out[0][0] = cosA + uAxis.x * uAxis.x * sCosA;
+	out[0][1] = uAxis.x * uAxis.y * sCosA - uAxis.z * sinA;
+	out[0][2] = uAxis.x * uAxis.z * sCosA + uAxis.y * sinA;
+
+	out[1][0] = uAxis.y * uAxis.x * sCosA + uAxis.z * sinA;
+	out[1][1] = cosA + uAxis.y * uAxis.y * sCosA;
+	out[1][2] = uAxis.y * uAxis.z * sCosA - uAxis.x * sinA;
+
+	out[2][0] = uAxis.z * uAxis.x * sCosA - uAxis.y * sinA;
+	out[2][1] = uAxis.z * uAxis.y * sCosA + uAxis.x * sinA;
+	out[2][2] = cosA + uAxis.z * uAxis.z * sCosA;
+
+	out[3][3] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> Matrix4x4T<T>::perspective(T fov, T aspectRatio, T zNear, T zFar)
+{
+	Matrix4x4T<T> out;
+
+	T tanHalfFOV = std::tan(fov / 2);
+	T zRange = zNear - zFar;
+
+	out[0][0] = 1.0f / (tanHalfFOV * aspectRatio);
+	out[1][1] = 1.0f / tanHalfFOV;
+	out[2][2] = (-zNear - zFar) / zRange;
+	out[3][3] = 0;
+
+	out[2][3] = 2 * zFar * zNear / zRange;
+	out[3][2] = 1;
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::multiplyKernel(Matrix4x4T<T>& out, const Matrix4x4T<T>& a, const Matrix4x4T<T>& b)
+{
+	math3d::detail::mat4Mul(&out.matrix[0][0], &a.matrix[0][0], &b.matrix[0][0]);
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformPointKernel(Vector3T<T>& out, const Matrix4x4T<T>& m, const Vector3T<T>& v3)
+{
+	math3d::detail::mat4TransformPoint(&out.x, &m.matrix[0][0], &v3.x);
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformPoints(ConstVector3View in, Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	float storage[16];
+	const float* m = math3d::detail::floatMatrix(&matrix[0][0], storage, 16);
+
+	math3d::detail::forEachBlock(in, out, [&k, m](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.mat4TransformPoints(so.x, so.y, so.z, m, sa.x, sa.y, sa.z, n);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const
+{
+	math3d::detail::forEachVector(in, out, count, [this](ConstVector3View a, Vector3View o)
+	{
+		transformPoints(a, o);
+	}, [this](const Vector3T<T>& v3, Vector3T<T>& o)
+	{
+		math3d::detail::mat4TransformPointsScalar(&o.x, &o.y, &o.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformPoints(ConstVector3View in, Vector3View out, ThreadPool& pool) const
+{
+	pool.parallelFor(in.count, ThreadPool::chunkSize(6 * sizeof(float)), [this, &in, &out](size_t begin, size_t end)
+	{
+		transformPoints(in.subview(begin, end - begin), out.subview(begin, end - begin));
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformPoints(const Vector3T<T>* in, Vector3T<T>* out, size_t count,
+	ThreadPool& pool) const
+{
+	pool.parallelFor(count, ThreadPool::chunkSize(2 * sizeof(Vector3T<T>)), [this, in, out](size_t begin, size_t end)
+	{
+		transformPoints(in + begin, out + begin, end - begin);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformDirections(ConstVector3View in, Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	float storage[16];
+	const float* m = math3d::detail::floatMatrix(&matrix[0][0], storage, 16);
+
+	math3d::detail::forEachBlock(in, out, [&k, m](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.mat4TransformDirections(so.x, so.y, so.z, m, sa.x, sa.y, sa.z, n);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformDirections(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const
+{
+	math3d::detail::forEachVector(in, out, count, [this](ConstVector3View a, Vector3View o)
+	{
+		transformDirections(a, o);
+	}, [this](const Vector3T<T>& v3, Vector3T<T>& o)
+	{
+		math3d::detail::mat4TransformDirectionsScalar(&o.x, &o.y, &o.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformHomogeneous(ConstVector3View in, Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	float storage[16];
+	const float* m = math3d::detail::floatMatrix(&matrix[0][0], storage, 16);
+
+	math3d::detail::forEachBlock(in, out, [&k, m](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.mat4TransformHomogeneous(so.x, so.y, so.z, m, sa.x, sa.y, sa.z, n);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void Matrix4x4T<T>::transformHomogeneous(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const
+{
+	math3d::detail::forEachVector(in, out, count, [this](ConstVector3View a, Vector3View o)
+	{
+		transformHomogeneous(a, o);
+	}, [this](const Vector3T<T>& v3, Vector3T<T>& o)
+	{
+		math3d::detail::mat4TransformHomogeneousScalar(&o.x, &o.y, &o.z, &matrix[0][0], &v3.x, &v3.y, &v3.z, 1);
+	});
+}
+
+#endif
\ No newline at end of file
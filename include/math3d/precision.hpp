@@ -0,0 +1,21 @@
+#ifndef PRECISION_HPP
+#define PRECISION_HPP
+
+/**
+ * How normalize, and the functions that normalize their results, compute
+ * the reciprocal of the magnitude
+ *
+ * Fast replaces the square root and the division per component with a
+ * reciprocal square root estimate (rsqrtss/rsqrtps) refined by one
+ * Newton-Raphson step and a multiplication per component. For float the
+ * results have a relative error below 1e-6 (about 8 units in the last
+ * place) instead of being correctly rounded; without SSE, and for double,
+ * Fast computes 1 / sqrt exactly and only saves the divisions.
+ */
+enum class Precision
+{
+	Exact,
+	Fast
+};
+
+#endif
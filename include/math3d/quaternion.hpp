@@ -1,17 +1,21 @@
 #ifndef QUATERNION_HPP
 #define QUATERNION_HPP
 
-class Vector3;
-class Matrix4x4;
+#include "config.hpp"
+#include "fwd.hpp"
+#include "precision.hpp"
+#include <cstddef>
 
-#include "vector3.hpp"
-#include "matrix4x4.hpp"
+class ConstVector3View;
+class Vector3View;
+class ThreadPool;
 
 /**
  * Quaternion representation of a rotation in 3D space
  * using 4 (x, y, z, w) components
  */
-class Quaternion
+template <typename T>
+class QuaternionT
 {
 	public:
 		/**
@@ -24,7 +28,7 @@ class Quaternion
 		 * @param z the z component of the axis 
 		 * @param angle the angle by which to rotate
 		 */
-		static Quaternion fromAxisAngle(float x, float y, float z, float angle);
+		static QuaternionT fromAxisAngle(T x, T y, T z, T angle);
 		/**
 		 * Creates a quaternion from a Vector3 axis and an angle
 		 *
@@ -33,14 +37,14 @@ class Quaternion
 		 * @param axis the normalized axis to rotate about
 		 * @param angle the angle by which to rotate
 		 */
-		static Quaternion fromAxisAngle(const Vector3& axis, float angle);
+		static QuaternionT fromAxisAngle(const Vector3T<T>& axis, T angle);
 		/**
 		 * Creates a quaternion from a vector by using its magnitude
 		 * for the angle of rotation, and its normalized vector as an axis
 		 *
 		 * @param axis the vector containing the axis and the angle of the rotation
 		 */
-		static Quaternion fromAxisAngle(const Vector3& axis);
+		static QuaternionT fromAxisAngle(const Vector3T<T>& axis);
 
 		/**
 		 * Creates a quaternion from (x, y, z) euler angles
@@ -49,21 +53,45 @@ class Quaternion
 		 * @param y the y axis rotation
 		 * @param z the z axis rotation
 		 */
-		static Quaternion fromEulerAngles(float x, float y, float z);
+		static QuaternionT fromEulerAngles(T x, T y, T z);
 		/**
 		 * Creates a quaternion from (x, y, z) euler angles contained
 		 * within the vector angles
 		 *
 		 * @param angles the vector containing the euler angles
 		 */
-		static Quaternion fromEulerAngles(const Vector3& angles);
+		static QuaternionT fromEulerAngles(const Vector3T<T>& angles);
+
+		/**
+		 * Creates count quaternions from (x, y, z) euler angles, like
+		 * calling fromEulerAngles for each of them
+		 *
+		 * For float the sines and cosines come from the polynomials of
+		 * Trigonometry, a SIMD register of angles at a time, so the
+		 * components can differ from fromEulerAngles by up to about 5e-7.
+		 *
+		 * @param angles the euler angles of each quaternion
+		 * @param out receives the quaternions; must not overlap angles
+		 * @param count the number of quaternions
+		 */
+		static void fromEulerAnglesBatch(const Vector3T<T>* angles, QuaternionT* out, size_t count);
+		/**
+		 * Creates count quaternions from unit axes and angles, like calling
+		 * fromAxisAngle for each of them, see fromEulerAnglesBatch
+		 *
+		 * @param axes the normalized axis of each quaternion
+		 * @param angles the angle of each quaternion
+		 * @param out receives the quaternions; must not overlap axes or angles
+		 * @param count the number of quaternions
+		 */
+		static void fromAxisAngleBatch(const Vector3T<T>* axes, const T* angles, QuaternionT* out, size_t count);
 
 		/**
 		 * Creates a quaternion from the given matrix
 		 * 
 		 * @param m4 the matrix containing the rotation 
 		 */
-		static Quaternion fromMatrix(const Matrix4x4& m4);
+		static QuaternionT fromMatrix(const Matrix4x4T<T>& m4);
 
 		/**
 		 * Creates a new Quaternion from its (x, y, z, w) components
@@ -73,24 +101,35 @@ class Quaternion
 		 * @param z the z component of the quaternion
 		 * @param w the w component of the quaternion
 		 */
-		Quaternion(float x, float y, float z, float w);
+		MATH3D_CONSTEXPR QuaternionT(T x, T y, T z, T w);
 		/**
 		 * Creates a new quaternion by copying the corresponding
 		 * components of quaternion q
 		 */
-		Quaternion(const Quaternion& q);
+		QuaternionT(const QuaternionT& q) = default;
+		/**
+		 * Creates a new Quaternion by converting the components of a
+		 * quaternion with another scalar type, e.g. a Quaterniond
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit QuaternionT(const QuaternionT<U>& q);
 
 		/** @brief calculates the magnitude (length) of the quaternion */
-		float magnitude() const;
+		T magnitude() const;
 		/** @brief calculates the magnitude^2 of the quaternion */
-		float magSq() const;
-		/** @brief calculates a normalized (unit) quaternion */
-		Quaternion normalize() const;
+		MATH3D_CONSTEXPR T magSq() const;
+		/**
+		 * Calculates a normalized (unit) quaternion
+		 *
+		 * @param precision Precision::Fast to multiply by an approximate
+		 * reciprocal of the magnitude instead of dividing
+		 */
+		QuaternionT normalize(Precision precision = Precision::Exact) const;
 		/** @brief calculates the conjugate of the quaternion */
-		Quaternion conjugate() const;
+		MATH3D_CONSTEXPR QuaternionT conjugate() const;
 
 		/** @brief calculates the dot product of quaternions a and b */
-		float dot(const Quaternion& q) const;
+		MATH3D_CONSTEXPR T dot(const QuaternionT& q) const;
 
 		/**
 		 * Linearly interpolates between two vectors by a given percentage
@@ -98,8 +137,10 @@ class Quaternion
 		 * @param to the quaternion to lerp to
 		 * @param inc the percentage increment to interpolate between the quaternions
 		 * @param shortest whether or not to take the shortest path of interpolation
+		 * @param precision how the result is normalized
 		 */
-		Quaternion nlerp(const Quaternion& to, float inc, bool shortest = true) const;
+		QuaternionT nlerp(const QuaternionT& to, T inc, bool shortest = true,
+			Precision precision = Precision::Exact) const;
 		/**
 		 * Spherical-linear interpolation between two vectors by a given percentage
 		 *
@@ -107,50 +148,282 @@ class Quaternion
 		 * @param inc the percentage increment to interpolate between the quaternions
 		 * @param shortest whether or not to take the shortest path of interpolation
 		 */
-		Quaternion slerp(const Quaternion& to, float inc, bool shortest = true) const;
+		QuaternionT slerp(const QuaternionT& to, T inc, bool shortest = true) const;
+		/**
+		 * Spherically interpolates count pairs of quaternions, like
+		 * calling slerp for each of them
+		 *
+		 * Along the shortest path, float quaternions are interpolated
+		 * with the SIMD kernels and the Trigonometry polynomials, which
+		 * are within 1e-6 of slerp but not the same bit for bit.
+		 *
+		 * Note: float quaternions must be of unit length
+		 *
+		 * @param from the quaternions to interpolate from
+		 * @param to the quaternions to interpolate to
+		 * @param inc the percentage increment of each pair
+		 * @param out receives the quaternions; may be the same as from or to
+		 * @param count the number of quaternions
+		 * @param shortest whether or not to take the shortest path of interpolation
+		 */
+		static void slerpBatch(const QuaternionT* from, const QuaternionT* to, const T* inc, QuaternionT* out,
+			size_t count, bool shortest = true);
+		/** @brief interpolates count pairs of quaternions in chunks on the threads of a pool */
+		static void slerpBatch(const QuaternionT* from, const QuaternionT* to, const T* inc, QuaternionT* out,
+			size_t count, ThreadPool& pool, bool shortest = true);
 
 		/**
 		 * Compares whether two quaternions are equal by testing whether
 		 * all of their corresponding components are equal
 		 */
-		bool operator==(const Quaternion&) const;
-		bool operator!=(const Quaternion&) const;
+		MATH3D_CONSTEXPR bool operator==(const QuaternionT&) const;
+		MATH3D_CONSTEXPR bool operator!=(const QuaternionT&) const;
 
-		/** @brief rotates the quaternion by the given quaternion */
-		Quaternion rotateBy(const Quaternion&) const;
+		/**
+		 * Rotates the quaternion by the given quaternion
+		 *
+		 * @param by the rotation to apply
+		 * @param precision how the result is normalized
+		 */
+		QuaternionT rotateBy(const QuaternionT& by, Precision precision = Precision::Exact) const;
 
 		/** @brief negates the quaternion */
-		Quaternion operator-() const;
+		MATH3D_CONSTEXPR QuaternionT operator-() const;
 
 		/** @brief adds two quaternions together */
-		Quaternion operator+(const Quaternion&) const;
+		MATH3D_CONSTEXPR QuaternionT operator+(const QuaternionT&) const;
 		/** @brief subtracts two quaternions */
-		Quaternion operator-(const Quaternion&) const;
+		MATH3D_CONSTEXPR QuaternionT operator-(const QuaternionT&) const;
 		
 		/** @brief multiplies two quaternions together */
-		Quaternion operator*(const Quaternion&) const;
+		MATH3D_CONSTEXPR QuaternionT operator*(const QuaternionT&) const;
 		/** @brief multiplies a vector by a quaternion */
-		Quaternion operator*(const Vector3&) const;
+		MATH3D_CONSTEXPR QuaternionT operator*(const Vector3T<T>&) const;
 		/** @brief multiplies a quaternion by a number */
-		Quaternion operator*(float) const;
+		MATH3D_CONSTEXPR QuaternionT operator*(T) const;
 
 		/**
 		 * Gets a normalized (unit) vector facing the corresponding direction
 		 * relative to the orientation of the quaternion
 		 */
-		Vector3 forward() const;
-		Vector3 back() const;
-		Vector3 left() const;
-		Vector3 right() const;
-		Vector3 up() const;
-		Vector3 down() const;
+		MATH3D_CONSTEXPR Vector3T<T> forward() const;
+		MATH3D_CONSTEXPR Vector3T<T> back() const;
+		MATH3D_CONSTEXPR Vector3T<T> left() const;
+		MATH3D_CONSTEXPR Vector3T<T> right() const;
+		MATH3D_CONSTEXPR Vector3T<T> up() const;
+		MATH3D_CONSTEXPR Vector3T<T> down() const;
+
+		/**
+		 * Rotates a batch of vectors by the quaternion, like calling
+		 * Vector3::rotateBy for each of them. The quaternion is kept in
+		 * registers and several vectors are rotated per instruction.
+		 *
+		 * Note: the quaternion must be a unit (normalized) quaternion
+		 *
+		 * @param in the vectors, e.g. a Vector3Array or a view of a Vector3 array
+		 * @param out receives the rotated vectors; may be the same as in
+		 */
+		void rotateVectors(ConstVector3View in, Vector3View out) const;
+		/**
+		 * Rotates count vectors of an array of Vector3 objects, which
+		 * may be rotated in place by passing the same array as out
+		 */
+		void rotateVectors(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const;
+		/** @brief rotates a batch of vectors in chunks on the threads of a pool */
+		void rotateVectors(ConstVector3View in, Vector3View out, ThreadPool& pool) const;
+		/** @brief rotates count vectors of an array of Vector3 objects on the threads of a pool */
+		void rotateVectors(const Vector3T<T>* in, Vector3T<T>* out, size_t count, ThreadPool& pool) const;
 
 		/** @brief indexes the components of the quaternion */
-		float operator[](int);
-		const float operator[](int) const;
+		MATH3D_CONSTEXPR T operator[](int);
+		MATH3D_CONSTEXPR const T operator[](int) const;
 
-		float x, y, z, w;
+		T x, y, z, w;
 	private:
+		/** @brief the runtime path of operator*, which uses the SIMD kernel */
+		static void multiplyKernel(QuaternionT& out, const QuaternionT& a, const QuaternionT& b);
 };
 
+#include "vector3.hpp"
+#include "matrix4x4.hpp"
+
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in quaternion.inl
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T>::QuaternionT(T x, T y, T z, T w)
+: x(x), y(y), z(z), w(w)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR QuaternionT<T>::QuaternionT(const QuaternionT<U>& q)
+: x((T)q.x), y((T)q.y), z((T)q.z), w((T)q.w)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T QuaternionT<T>::magSq() const
+{
+	return x * x + y * y + z * z + w * w;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::conjugate() const
+{
+	return QuaternionT<T>(-x, -y, -z, w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T QuaternionT<T>::dot(const QuaternionT<T>& q) const
+{
+	return x * q.x + y * q.y + z * q.z + w * q.w;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool QuaternionT<T>::operator==(const QuaternionT<T>& q) const
+{
+	return x == q.x && y == q.y && z == q.z && w == q.w;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool QuaternionT<T>::operator!=(const QuaternionT<T>& q) const
+{
+	return x != q.x || y != q.y || z != q.z || w != q.w;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator-() const
+{
+	return QuaternionT<T>(-x, -y, -z, -w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator+(const QuaternionT<T>& q) const
+{
+	return QuaternionT<T>(x + q.x, y + q.y, z + q.z, w + q.w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator-(const QuaternionT<T>& q) const
+{
+	return QuaternionT<T>(x - q.x, y - q.y, z - q.z, w - q.w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator*(const QuaternionT<T>& q) const
+{
+	if (!math3d::detail::isConstantEvaluated())
+	{
+		QuaternionT<T> out(0, 0, 0, 0);
+
+		multiplyKernel(out, *this, q);
+
+		return out;
+	}
+
+	// the operations of quatMulScalar
+	return QuaternionT<T>(x * q.w + w * q.x + y * q.z - z * q.y,
+		y * q.w + w * q.y + z * q.x - x * q.z,
+		z * q.w + w * q.z + x * q.y - y * q.x,
+		w * q.w - x * q.x - y * q.y - z * q.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator*(const Vector3T<T>& v3) const
+{
+	T nx = w * v3.x + y * v3.z - z * v3.y;
+	T ny = w * v3.y + z * v3.x - x * v3.z;
+	T nz = w * v3.z + x * v3.y - y * v3.x;
+	T nw = -x * v3.x - y * v3.y - z * v3.z;
+
+	return QuaternionT<T>(nx, ny, nz, nw);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> QuaternionT<T>::operator*(T n) const
+{
+	return QuaternionT<T>(x * n, y * n, z * n, w * n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> QuaternionT<T>::forward() const
+{
+	return Vector3T<T>(0, 0, 1).rotateBy(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> QuaternionT<T>::back() const
+{
+	return Vector3T<T>(0, 0, -1).rotateBy(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> QuaternionT<T>::left() const
+{
+	return Vector3T<T>(-1, 0, 0).rotateBy(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> QuaternionT<T>::right() const
+{
+	return Vector3T<T>(1, 0, 0).rotateBy(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> QuaternionT<T>::up() const
+{
+	return Vector3T<T>(0, 1, 0).rotateBy(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> QuaternionT<T>::down() const
+{
+	return Vector3T<T>(0, -1, 0).rotateBy(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T QuaternionT<T>::operator[](int i)
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		case 3:
+			return w;
+		default:
+			return 0;
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T QuaternionT<T>::operator[](int i) const
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		case 3:
+			return w;
+		default:
+			return 0;
+	}
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "quaternion.inl"
+#else
+extern template class QuaternionT<float>;
+extern template class QuaternionT<double>;
 #endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,301 @@
+#ifndef QUATERNION_INL
+#define QUATERNION_INL
+
+#include "config.hpp"
+#include "quaternion.hpp"
+#include "kernels/table.hpp"
+#include "streams.hpp"
+#include "threadpool.hpp"
+#include <cmath>
+
+#define QUATERNION_EPSILON	1e-3f
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::fromAxisAngle(T x, T y, T z, T angle)
+{
+	T sinHalfA = std::sin(angle / 2);
+
+	return QuaternionT<T>(x * sinHalfA, y * sinHalfA, z * sinHalfA, std::cos(angle / 2));
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::fromAxisAngle(const Vector3T<T>& axis, T angle)
+{
+	T sinHalfA = std::sin(angle / 2);
+
+	return QuaternionT<T>(axis.x * sinHalfA, axis.y * sinHalfA, axis.z * sinHalfA, std::cos(angle / 2));
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::fromAxisAngle(const Vector3T<T>& axis)
+{
+	Vector3T<T> normAxis = axis.normalize();
+	T angle = axis.magnitude();
+	T sinHalfA = std::sin(angle / 2);
+
+	return QuaternionT<T>(normAxis.x * sinHalfA, normAxis.y * sinHalfA, normAxis.z * sinHalfA, std::cos(angle / 2));
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::fromEulerAngles(T x, T y, T z)
+{
+	T sin1 = std::sin(x / 2);
+	T cos1 = std::cos(x / 2);
+
+	T sin2 = std::sin(z / 2);
+	T cos2 = std::cos(z / 2);
+
+	T sin3 = std::sin(y / 2);
+	T cos3 = std::cos(y / 2);
+
+	T s1s2 = sin1 * sin2;
+	T c1c2 = cos1 * cos2;
+
+	return QuaternionT<T>(sin1 * cos2 * cos3 + cos1 * sin2 * sin3,
+		c1c2 * sin3 + s1s2 * cos3,
+		cos1 * sin2 * cos3 - sin1 * cos2 * sin3,
+		c1c2 * cos3 - s1s2 * sin3);
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::fromEulerAngles(const Vector3T<T>& angles)
+{
+	T sin1 = std::sin(angles.x / 2);
+	T cos1 = std::cos(angles.x / 2);
+
+	T sin2 = std::sin(angles.z / 2);
+	T cos2 = std::cos(angles.z / 2);
+
+	T sin3 = std::sin(angles.y / 2);
+	T cos3 = std::cos(angles.y / 2);
+
+	T s1s2 = sin1 * sin2;
+	T c1c2 = cos1 * cos2;
+
+	return QuaternionT<T>(sin1 * cos2 * cos3 + cos1 * sin2 * sin3,
+		c1c2 * sin3 + s1s2 * cos3,
+		cos1 * sin2 * cos3 - sin1 * cos2 * sin3,
+		c1c2 * cos3 - s1s2 * sin3);
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::fromEulerAnglesBatch(const Vector3T<T>* angles, QuaternionT<T>* out, size_t count)
+{
+	math3d::detail::quatFromEulerAngles(&out->x, &angles->x, count);
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::fromAxisAngleBatch(const Vector3T<T>* axes, const T* angles,
+	QuaternionT<T>* out, size_t count)
+{
+	math3d::detail::quatFromAxisAngle(&out->x, &axes->x, angles, count);
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::fromMatrix(const Matrix4x4T<T>& m4)
+{
+	T x, y, z, w;
+	T trace = m4[0][0] + m4[1][1] + m4[2][2];
+
+	if (trace > 0)
+	{
+		T s = 0.5f / std::sqrt(trace + 1.0f);
+		w = 0.25f / s;
+		x = (m4[1][2] - m4[2][1]) * s;
+		y = (m4[2][0] - m4[0][2]) * s;
+		z = (m4[0][1] - m4[1][0]) * s;
+	}
+	else
+	{
+		if (m4[0][0] > m4[1][1] && m4[0][0] > m4[2][2])
+		{
+			T s = 2.0f * std::sqrt(1.0f + m4[0][0] - m4[1][1] - m4[2][2]);
+			w = (m4[1][2] - m4[2][1]) / s;
+			x = 0.25f * s;
+			y = (m4[1][0] + m4[0][1]) / s;
+			z = (m4[2][0] + m4[0][2]) / s;
+		}
+		else if (m4[1][1] > m4[2][2])
+		{
+			T s = 2.0f * std::sqrt(1.0f + m4[1][1] - m4[0][0] - m4[2][2]);
+			w = (m4[2][0] - m4[0][2]) / s;
+			x = (m4[1][0] + m4[0][1]) / s;
+			y = 0.25f * s;
+			z = (m4[2][1] + m4[1][2]) / s;
+		}
+		else
+		{
+			T s = 2.0f * std::sqrt(1.0f + m4[2][2] - m4[0][0] - m4[1][1]);
+			w = (m4[0][1] - m4[1][0]) / s;
+			x = (m4[2][0] + m4[0][2]) / s;
+			y = (m4[1][2] + m4[2][1]) / s;
+			z = 0.25f * s;
+		}
+	}
+
+	T mag = std::sqrt(x * x +  y * y + z * z + w * w);
+
+	if (mag != 0)
+	{
+		x /= mag;
+		y /= mag;
+		z /= mag;
+		w /= mag;
+	}
+
+	return QuaternionT<T>(x, y, z, w);
+}
+
+template <typename T>
+MATH3D_INLINE T QuaternionT<T>::magnitude() const
+{
+	return std::sqrt(x * x + y * y + z * z + w * w);
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::normalize(Precision precision) const
+{
+	QuaternionT<T> out(0, 0, 0, 0);
+
+	if (precision == Precision::Fast)
+	{
+		math3d::detail::quatNormalizeFast(&out.x, &x);
+	}
+	else
+	{
+		math3d::detail::quatNormalize(&out.x, &x);
+	}
+
+	return out;
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::nlerp(const QuaternionT<T>& to, T inc, bool shortest,
+	Precision precision) const
+{
+	QuaternionT<T> correctedTo = to;
+
+	if (shortest && dot(to) < 0)
+	{
+		correctedTo = -to;
+	}
+
+	return ((*this) + (correctedTo - (*this)) * inc).normalize(precision);
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::slerp(const QuaternionT<T>& to, T inc, bool shortest) const
+{
+	T cs = dot(to);
+	QuaternionT<T> correctedTo = to;
+
+	if (shortest && cs < 0)
+	{
+		cs = -cs;
+		correctedTo = -to;
+	}
+
+	if (std::abs(cs) >= 1 - QUATERNION_EPSILON)
+	{
+		return nlerp(correctedTo, inc, false);
+	}
+
+	T sn = std::sqrt(1.0f - cs * cs);
+	T angle = std::atan2(sn, cs);
+	T invSin = 1.0f / sn;
+
+	T srcFactor = std::sin((1.0f - inc) * angle) * invSin;
+	T destFactor = std::sin(inc * angle) * invSin;
+
+	return (*this) * srcFactor + correctedTo * destFactor;
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::slerpBatch(const QuaternionT<T>* from, const QuaternionT<T>* to, const T* inc,
+	QuaternionT<T>* out, size_t count, bool shortest)
+{
+	if (!shortest)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			out[i] = from[i].slerp(to[i], inc[i], false);
+		}
+
+		return;
+	}
+
+	math3d::detail::quatSlerp(&out->x, &from->x, &to->x, inc, count, [from, to, inc, out](size_t i)
+	{
+		out[i] = from[i].slerp(to[i], inc[i]);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::slerpBatch(const QuaternionT<T>* from, const QuaternionT<T>* to, const T* inc,
+	QuaternionT<T>* out, size_t count, ThreadPool& pool, bool shortest)
+{
+	pool.parallelFor(count, ThreadPool::chunkSize(3 * sizeof(QuaternionT<T>) + sizeof(T)),
+		[from, to, inc, out, shortest](size_t begin, size_t end)
+	{
+		slerpBatch(from + begin, to + begin, inc + begin, out + begin, end - begin, shortest);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::rotateVectors(ConstVector3View in, Vector3View out) const
+{
+	const Kernels& k = math3d::detail::kernels();
+	float storage[4];
+	const float* q = math3d::detail::floatMatrix(&x, storage, 4);
+
+	math3d::detail::forEachBlock(in, out, [&k, q](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.quatRotateVectors(so.x, so.y, so.z, q, sa.x, sa.y, sa.z, n);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::rotateVectors(const Vector3T<T>* in, Vector3T<T>* out, size_t count) const
+{
+	math3d::detail::forEachVector(in, out, count, [this](ConstVector3View a, Vector3View o)
+	{
+		rotateVectors(a, o);
+	}, [this](const Vector3T<T>& v3, Vector3T<T>& o)
+	{
+		o = v3.rotateBy(*this);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::rotateVectors(ConstVector3View in, Vector3View out, ThreadPool& pool) const
+{
+	pool.parallelFor(in.count, ThreadPool::chunkSize(6 * sizeof(float)), [this, &in, &out](size_t begin, size_t end)
+	{
+		rotateVectors(in.subview(begin, end - begin), out.subview(begin, end - begin));
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::rotateVectors(const Vector3T<T>* in, Vector3T<T>* out, size_t count,
+	ThreadPool& pool) const
+{
+	pool.parallelFor(count, ThreadPool::chunkSize(2 * sizeof(Vector3T<T>)), [this, in, out](size_t begin, size_t end)
+	{
+		rotateVectors(in + begin, out + begin, end - begin);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void QuaternionT<T>::multiplyKernel(QuaternionT<T>& out, const QuaternionT<T>& a, const QuaternionT<T>& b)
+{
+	math3d::detail::quatMul(&out.x, &a.x, &b.x);
+}
+
+template <typename T>
+MATH3D_INLINE QuaternionT<T> QuaternionT<T>::rotateBy(const QuaternionT<T>& by, Precision precision) const
+{
+	return (by * (*this)).normalize(precision);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef RAY_HPP
+#define RAY_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include "vector3.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/** @brief the closest intersection of a ray with a set of triangles */
+template <typename T>
+struct RayHitT
+{
+	/** @brief the t of the hit point, which is ray.getPoint(distance) */
+	T distance;
+	/** @brief the index of the triangle that was hit */
+	uint32_t triangle;
+	/**
+	 * The barycentric coordinates of the hit point: the weights of the
+	 * second and third vertex, with 1 - u - v that of the first one
+	 */
+	T u, v;
+};
+
+/**
+ * A ray, stored as its origin and direction, which contains the points
+ * origin + direction * t for t >= 0
+ *
+ * The direction does not need to be normalized; distances along the ray,
+ * such as those of hits, are then measured in multiples of its length.
+ *
+ * Triangles are intersected with the Moller-Trumbore test, which counts
+ * hits on either side of a triangle. The batch forms test a SIMD register
+ * of triangles against one ray, or a register of rays against one
+ * triangle, at a time, and find the same hits as the single test.
+ */
+template <typename T>
+class RayT
+{
+	public:
+		/**
+		 * Creates a new ray
+		 *
+		 * @param origin the point the ray starts at
+		 * @param direction the direction the ray points in
+		 */
+		RayT(const Vector3T<T>& origin, const Vector3T<T>& direction);
+		/** @brief creates a new ray by copying the origin and direction of ray */
+		RayT(const RayT& ray);
+		/**
+		 * Creates a new ray by converting the components of a ray with
+		 * another scalar type, e.g. a Rayd
+		 */
+		template <typename U>
+		explicit RayT(const RayT<U>& ray);
+
+		/** @brief gets the point origin + direction * t */
+		Vector3T<T> getPoint(T t) const;
+
+		/**
+		 * Intersects the ray with a triangle
+		 *
+		 * @param a the first vertex of the triangle
+		 * @param b the second vertex of the triangle
+		 * @param c the third vertex of the triangle
+		 * @param maxDistance hits at a t of maxDistance or more are ignored
+		 * @param hit receives the hit, with a triangle index of 0, if there is one
+		 * @return whether the triangle is hit at a t greater than 0 and
+		 * less than maxDistance
+		 */
+		bool intersectTriangle(const Vector3T<T>& a, const Vector3T<T>& b, const Vector3T<T>& c,
+			T maxDistance, RayHitT<T>& hit) const;
+		/**
+		 * Finds the closest of a set of triangles hit by the ray, testing
+		 * a SIMD register of triangles at a time
+		 *
+		 * @param vertices 3 vertices for each triangle
+		 * @param triangleCount the number of triangles
+		 * @param maxDistance hits at a t of maxDistance or more are ignored
+		 * @param hit receives the closest hit, if there is one; of equally
+		 * close hits, the one with the lowest triangle index is kept
+		 * @return whether a triangle is hit at a t greater than 0 and less
+		 * than maxDistance
+		 */
+		bool intersectTriangles(const Vector3T<T>* vertices, size_t triangleCount, T maxDistance,
+			RayHitT<T>& hit) const;
+
+		/**
+		 * Intersects count rays with a triangle, testing a SIMD register
+		 * of rays at a time, and keeps the closest hit of each ray, so
+		 * that calling it for each triangle of a mesh finds the closest
+		 * hits with the mesh
+		 *
+		 * Note: the distance of each hit must be set before the first call,
+		 * e.g. to the largest distance at which hits count
+		 *
+		 * @param rays the rays
+		 * @param count the number of rays
+		 * @param a the first vertex of the triangle
+		 * @param b the second vertex of the triangle
+		 * @param c the third vertex of the triangle
+		 * @param triangle the index of the triangle to store in the hits
+		 * @param hits the hit of each ray, which is replaced if the ray
+		 * hits the triangle at a t greater than 0 and less than its distance
+		 * @return the number of rays that hit the triangle
+		 */
+		static size_t intersectBatch(const RayT* rays, size_t count, const Vector3T<T>& a, const Vector3T<T>& b,
+			const Vector3T<T>& c, uint32_t triangle, RayHitT<T>* hits);
+
+		/**
+		 * Compares whether two rays are equal by testing
+		 * whether their origins and directions are equal
+		 */
+		bool operator==(const RayT&) const;
+		bool operator!=(const RayT&) const;
+
+		Vector3T<T> origin;
+		Vector3T<T> direction;
+	private:
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "ray.inl"
+#else
+extern template class RayT<float>;
+extern template class RayT<double>;
+#endif
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef RAY_INL
+#define RAY_INL
+
+#include "config.hpp"
+#include "ray.hpp"
+#include "aligned.hpp"
+#include "kernels/table.hpp"
+
+/** @brief the number of triangles or rays converted to streams at a time */
+static const size_t RAY_BATCH_BLOCK_SIZE = 256;
+
+template <typename T>
+MATH3D_INLINE RayT<T>::RayT(const Vector3T<T>& origin, const Vector3T<T>& direction)
+: origin(origin), direction(direction)
+{
+}
+
+template <typename T>
+MATH3D_INLINE RayT<T>::RayT(const RayT<T>& ray)
+: origin(ray.origin), direction(ray.direction)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_INLINE RayT<T>::RayT(const RayT<U>& ray)
+: origin(ray.origin), direction(ray.direction)
+{
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> RayT<T>::getPoint(T t) const
+{
+	return origin + direction * t;
+}
+
+template <typename T>
+MATH3D_INLINE bool RayT<T>::intersectTriangle(const Vector3T<T>& a, const Vector3T<T>& b, const Vector3T<T>& c,
+	T maxDistance, RayHitT<T>& hit) const
+{
+	Vector3T<T> edge1 = b - a;
+	Vector3T<T> edge2 = c - a;
+
+	// the determinant is the volume spanned by the edges and the direction
+	Vector3T<T> p = direction.cross(edge2);
+	T det = edge1.dot(p);
+	T inv = T(1) / det;
+
+	// the barycentric coordinates and distance of the hit, by Cramer's rule
+	Vector3T<T> s = origin - a;
+	Vector3T<T> q = s.cross(edge1);
+	T u = s.dot(p) * inv;
+	T v = direction.dot(q) * inv;
+	T t = edge2.dot(q) * inv;
+
+	if (!(det != 0 && u >= 0 && v >= 0 && u + v <= 1 && t > 0 && t < maxDistance))
+	{
+		return false;
+	}
+
+	hit.distance = t;
+	hit.triangle = 0;
+	hit.u = u;
+	hit.v = v;
+
+	return true;
+}
+
+template <typename T>
+MATH3D_INLINE bool RayT<T>::intersectTriangles(const Vector3T<T>* vertices, size_t triangleCount, T maxDistance,
+	RayHitT<T>& hit) const
+{
+	const T ray[6] = {origin.x, origin.y, origin.z, direction.x, direction.y, direction.z};
+	alignas(math3d::detail::BATCH_ALIGNMENT) T streams[math3d::detail::TRIANGLE_STREAMS][RAY_BATCH_BLOCK_SIZE];
+	T distance = maxDistance;
+	T u = 0, v = 0;
+	size_t found = triangleCount;
+
+	for (size_t start = 0; start < triangleCount; start += RAY_BATCH_BLOCK_SIZE)
+	{
+		size_t n = triangleCount - start < RAY_BATCH_BLOCK_SIZE ? triangleCount - start : RAY_BATCH_BLOCK_SIZE;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			// the edges are subtracted per component rather than through
+			// Vector3 temporaries, which are calls outside of header-only builds
+			const Vector3T<T>* t = vertices + 3 * (start + i);
+
+			streams[0][i] = t[0].x;
+			streams[1][i] = t[0].y;
+			streams[2][i] = t[0].z;
+			streams[3][i] = t[1].x - t[0].x;
+			streams[4][i] = t[1].y - t[0].y;
+			streams[5][i] = t[1].z - t[0].z;
+			streams[6][i] = t[2].x - t[0].x;
+			streams[7][i] = t[2].y - t[0].y;
+			streams[8][i] = t[2].z - t[0].z;
+		}
+
+		size_t i = math3d::detail::rayTriangles(ray, streams[0], RAY_BATCH_BLOCK_SIZE, n, distance, u, v);
+
+		if (i < n)
+		{
+			found = start + i;
+		}
+	}
+
+	if (found == triangleCount)
+	{
+		return false;
+	}
+
+	hit.distance = distance;
+	hit.triangle = (uint32_t)found;
+	hit.u = u;
+	hit.v = v;
+
+	return true;
+}
+
+template <typename T>
+MATH3D_INLINE size_t RayT<T>::intersectBatch(const RayT<T>* rays, size_t count, const Vector3T<T>& a,
+	const Vector3T<T>& b, const Vector3T<T>& c, uint32_t triangle, RayHitT<T>* hits)
+{
+	Vector3T<T> edge1 = b - a;
+	Vector3T<T> edge2 = c - a;
+	const T triangleStreams[math3d::detail::TRIANGLE_STREAMS] = {a.x, a.y, a.z,
+		edge1.x, edge1.y, edge1.z, edge2.x, edge2.y, edge2.z};
+
+	// the origins, directions, distances, and barycentric coordinates of a block of rays
+	alignas(math3d::detail::BATCH_ALIGNMENT) T streams[9][RAY_BATCH_BLOCK_SIZE];
+	alignas(math3d::detail::BATCH_ALIGNMENT) uint32_t triangles[RAY_BATCH_BLOCK_SIZE];
+	size_t hitCount = 0;
+
+	for (size_t start = 0; start < count; start += RAY_BATCH_BLOCK_SIZE)
+	{
+		size_t n = count - start < RAY_BATCH_BLOCK_SIZE ? count - start : RAY_BATCH_BLOCK_SIZE;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const RayT<T>& ray = rays[start + i];
+			const RayHitT<T>& hit = hits[start + i];
+
+			streams[0][i] = ray.origin.x;
+			streams[1][i] = ray.origin.y;
+			streams[2][i] = ray.origin.z;
+			streams[3][i] = ray.direction.x;
+			streams[4][i] = ray.direction.y;
+			streams[5][i] = ray.direction.z;
+			streams[6][i] = hit.distance;
+			streams[7][i] = hit.u;
+			streams[8][i] = hit.v;
+			triangles[i] = hit.triangle;
+		}
+
+		size_t blockHits = math3d::detail::raysTriangle(triangles, streams[6], streams[7], streams[8], triangleStreams,
+			triangle, streams[0], streams[1], streams[2], streams[3], streams[4], streams[5], n);
+
+		// the rays that missed keep their values, so only blocks with hits are written back
+		if (blockHits > 0)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				RayHitT<T>& hit = hits[start + i];
+
+				hit.distance = streams[6][i];
+				hit.triangle = triangles[i];
+				hit.u = streams[7][i];
+				hit.v = streams[8][i];
+			}
+		}
+
+		hitCount += blockHits;
+	}
+
+	return hitCount;
+}
+
+template <typename T>
+MATH3D_INLINE bool RayT<T>::operator==(const RayT<T>& ray) const
+{
+	return origin == ray.origin && direction == ray.direction;
+}
+
+template <typename T>
+MATH3D_INLINE bool RayT<T>::operator!=(const RayT<T>& ray) const
+{
+	return origin != ray.origin || direction != ray.direction;
+}
+
+#endif
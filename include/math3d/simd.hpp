@@ -0,0 +1,38 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+/**
+ * Compile-time detection of the SIMD instruction sets available to the
+ * kernels in kernels/. The widest set enabled by the compiler flags
+ * (e.g. -mavx) is used, and defining MATH3D_NO_SIMD forces the scalar
+ * fallback everywhere.
+ *
+ * The static library ignores these and picks its kernels at runtime
+ * instead (see dispatch.hpp).
+ *
+ * The SIMD kernels perform the same operations in the same order as the
+ * scalar ones, so their results match bit-for-bit as long as the compiler
+ * is not allowed to contract multiplies and adds into FMA instructions
+ * (-ffp-contract=off, which the Makefiles pass).
+ */
+#ifndef MATH3D_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64)
+		#define MATH3D_SSE
+	#endif
+
+	#if defined(__AVX__)
+		#define MATH3D_AVX
+	#endif
+
+	#if defined(__AVX512F__)
+		#define MATH3D_AVX512
+	#endif
+#endif
+
+#if defined(MATH3D_AVX)
+	#include <immintrin.h>
+#elif defined(MATH3D_SSE)
+	#include <emmintrin.h>
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef SKINNING_HPP
+#define SKINNING_HPP
+
+#include "config.hpp"
+#include "vector3array.hpp"
+#include "matrix4x4.hpp"
+#include "affine3x4.hpp"
+#include "dualquaternion.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The bone influences of a batch of vertices: for each influence, a stream
+ * of bone indices into the palette and a stream of weights, one entry per
+ * vertex. The weights of each vertex are expected to sum to 1.
+ */
+class BoneWeightsView
+{
+	public:
+		/** @brief the largest number of influences per vertex */
+		static const int MAX_INFLUENCES = 4;
+
+		/**
+		 * Creates a view of separate index and weight streams
+		 *
+		 * Note: influences must be between 1 and MAX_INFLUENCES
+		 *
+		 * @param indices influences streams of bone indices
+		 * @param weights influences streams of weights
+		 * @param influences the number of bones each vertex is bound to
+		 * @param count the number of vertices
+		 */
+		BoneWeightsView(const uint16_t* const* indices, const float* const* weights, int influences, size_t count);
+
+		const uint16_t* indices[MAX_INFLUENCES];
+		const float* weights[MAX_INFLUENCES];
+		int influences;
+		size_t count;
+	private:
+};
+
+/**
+ * Batch skinning of vertex positions: each position is transformed by a
+ * weighted blend of the bones it is bound to, taken from a palette of
+ * skinning matrices or dual quaternions (usually the world transform of
+ * each bone multiplied by its inverse bind pose).
+ *
+ * Output views may be the same as the input positions.
+ */
+class Skinning
+{
+	public:
+		/**
+		 * Linear blend skinning: blends the bone matrices by weight and
+		 * transforms each position by the blend
+		 *
+		 * Note: weights must hold at least as many vertices as positions
+		 */
+		static void linearBlend(ConstVector3View positions, const BoneWeightsView& weights,
+			const Affine3x4* palette, Vector3View out);
+		/** @brief linear blend skinning with a palette of Matrix4x4, of which the bottom row is ignored */
+		static void linearBlend(ConstVector3View positions, const BoneWeightsView& weights,
+			const Matrix4x4* palette, Vector3View out);
+		/**
+		 * Dual quaternion skinning: blends the bone dual quaternions by
+		 * weight and transforms each position by the normalized blend,
+		 * which avoids the volume loss of linear blending around twisting
+		 * joints
+		 *
+		 * Note: the palette must hold unit dual quaternions, and weights
+		 * must hold at least as many vertices as positions
+		 */
+		static void dualQuaternionBlend(ConstVector3View positions, const BoneWeightsView& weights,
+			const DualQuaternion* palette, Vector3View out);
+	private:
+		static void linearBlend(ConstVector3View positions, const BoneWeightsView& weights,
+			const float* palette, size_t stride, Vector3View out);
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "skinning.inl"
+#endif
+
+#endif
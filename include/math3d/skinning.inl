@@ -0,0 +1,79 @@
+#ifndef SKINNING_INL
+#define SKINNING_INL
+
+#include "config.hpp"
+#include "skinning.hpp"
+#include "kernels/table.hpp"
+#include "streams.hpp"
+
+static_assert(sizeof(Affine3x4) == 12 * sizeof(float), "Affine3x4 palettes must be tightly packed");
+static_assert(sizeof(Matrix4x4) == 16 * sizeof(float), "Matrix4x4 palettes must be tightly packed");
+static_assert(sizeof(DualQuaternion) == 8 * sizeof(float), "DualQuaternion palettes must be tightly packed");
+
+MATH3D_INLINE BoneWeightsView::BoneWeightsView(const uint16_t* const* indices, const float* const* weights,
+	int influences, size_t count)
+: influences(influences), count(count)
+{
+	for (int k = 0; k < MAX_INFLUENCES; k++)
+	{
+		this->indices[k] = k < influences ? indices[k] : nullptr;
+		this->weights[k] = k < influences ? weights[k] : nullptr;
+	}
+}
+
+MATH3D_INLINE void Skinning::linearBlend(ConstVector3View positions, const BoneWeightsView& weights,
+	const Affine3x4* palette, Vector3View out)
+{
+	linearBlend(positions, weights, &palette->matrix[0][0], 12, out);
+}
+
+MATH3D_INLINE void Skinning::linearBlend(ConstVector3View positions, const BoneWeightsView& weights,
+	const Matrix4x4* palette, Vector3View out)
+{
+	linearBlend(positions, weights, &palette->matrix[0][0], 16, out);
+}
+
+MATH3D_INLINE void Skinning::linearBlend(ConstVector3View positions, const BoneWeightsView& weights,
+	const float* palette, size_t stride, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(positions, out, [&k, &weights, palette, stride](
+		const math3d::detail::Vector3Streams& sa, const math3d::detail::Vector3Streams& so, size_t start, size_t n)
+	{
+		const uint16_t* indices[BoneWeightsView::MAX_INFLUENCES];
+		const float* w[BoneWeightsView::MAX_INFLUENCES];
+
+		for (int i = 0; i < weights.influences; i++)
+		{
+			indices[i] = weights.indices[i] + start;
+			w[i] = weights.weights[i] + start;
+		}
+
+		k.skinLinear(so.x, so.y, so.z, sa.x, sa.y, sa.z, indices, w, weights.influences, palette, stride, n);
+	});
+}
+
+MATH3D_INLINE void Skinning::dualQuaternionBlend(ConstVector3View positions, const BoneWeightsView& weights,
+	const DualQuaternion* palette, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+	const float* p = &palette->real.x;
+
+	math3d::detail::forEachBlock(positions, out, [&k, &weights, p](
+		const math3d::detail::Vector3Streams& sa, const math3d::detail::Vector3Streams& so, size_t start, size_t n)
+	{
+		const uint16_t* indices[BoneWeightsView::MAX_INFLUENCES];
+		const float* w[BoneWeightsView::MAX_INFLUENCES];
+
+		for (int i = 0; i < weights.influences; i++)
+		{
+			indices[i] = weights.indices[i] + start;
+			w[i] = weights.weights[i] + start;
+		}
+
+		k.skinDualQuat(so.x, so.y, so.z, sa.x, sa.y, sa.z, indices, w, weights.influences, p, n);
+	});
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SPHERE_HPP
+#define SPHERE_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include "vector3.hpp"
+#include <cstddef>
+
+/** @brief a bounding sphere, stored as its center and radius */
+template <typename T>
+class SphereT
+{
+	public:
+		/**
+		 * Creates a sphere containing count points, centered on their
+		 * bounding box; it is not always the smallest one, but is found
+		 * in a single pass over the points
+		 *
+		 * Note: count must not be 0
+		 */
+		static SphereT fromPoints(const Vector3T<T>* points, size_t count);
+		/** @brief creates the smallest sphere containing a box */
+		static SphereT fromAABB(const AABBT<T>& box);
+
+		/**
+		 * Creates a new sphere
+		 *
+		 * @param center the center of the sphere
+		 * @param radius the radius of the sphere
+		 */
+		SphereT(const Vector3T<T>& center, T radius);
+		/** @brief creates a new sphere by copying the center and radius of sphere */
+		SphereT(const SphereT& sphere) = default;
+		/**
+		 * Creates a new sphere by converting the components of a sphere
+		 * with another scalar type, e.g. a Sphered
+		 */
+		template <typename U>
+		explicit SphereT(const SphereT<U>& sphere);
+
+		/** @brief gets the smallest box containing the sphere */
+		AABBT<T> getBounds() const;
+
+		/** @brief creates the smallest sphere containing this sphere and another */
+		SphereT merge(const SphereT& sphere) const;
+
+		/** @brief tests whether a point is inside of the sphere or on its surface */
+		bool contains(const Vector3T<T>& point) const;
+		/** @brief tests whether another sphere is entirely inside of this one */
+		bool contains(const SphereT& sphere) const;
+		/** @brief tests whether two spheres overlap or touch */
+		bool overlaps(const SphereT& sphere) const;
+		/** @brief tests whether the sphere and a box overlap or touch */
+		bool overlaps(const AABBT<T>& box) const;
+
+		/**
+		 * Creates a sphere containing this sphere transformed by a matrix:
+		 * the center is transformed as a point, and the radius is scaled
+		 * by the largest scale of the matrix
+		 *
+		 * Note: the bottom row of the matrix is ignored, so it must be an
+		 * affine transformation
+		 */
+		SphereT transform(const Matrix4x4T<T>& m) const;
+		/** @brief creates a sphere containing this sphere transformed by a matrix */
+		SphereT transform(const Affine3x4T<T>& m) const;
+
+		/**
+		 * Transforms count spheres by a matrix each
+		 *
+		 * Note: out may be the same as in
+		 */
+		static void transformBatch(const SphereT* in, const Affine3x4T<T>* matrices, SphereT* out, size_t count);
+
+		/**
+		 * Compares whether two spheres are equal by testing
+		 * whether their centers and radii are equal
+		 */
+		bool operator==(const SphereT&) const;
+		bool operator!=(const SphereT&) const;
+
+		Vector3T<T> center;
+		T radius;
+	private:
+};
+
+#include "aabb.hpp"
+#include "matrix4x4.hpp"
+#include "affine3x4.hpp"
+
+#ifdef MATH3D_HEADER_ONLY
+#include "sphere.inl"
+#else
+extern template class SphereT<float>;
+extern template class SphereT<double>;
+#endif
+
+#endif
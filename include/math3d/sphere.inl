@@ -0,0 +1,155 @@
+#ifndef SPHERE_INL
+#define SPHERE_INL
+
+#include "config.hpp"
+#include "sphere.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Transforms a sphere by the top 3 rows of a row-major matrix: the
+ * radius is scaled by the length of the longest of the first 3 columns
+ */
+template <typename T>
+MATH3D_INLINE static SphereT<T> transformSphere(const SphereT<T>& s, const T* m)
+{
+	const Vector3T<T>& c = s.center;
+	T scaleSq = 0;
+
+	for (int col = 0; col < 3; col++)
+	{
+		scaleSq = std::max(scaleSq, m[col] * m[col] + m[4 + col] * m[4 + col] + m[8 + col] * m[8 + col]);
+	}
+
+	return SphereT<T>(Vector3T<T>(m[0] * c.x + m[1] * c.y + m[2] * c.z + m[3],
+		m[4] * c.x + m[5] * c.y + m[6] * c.z + m[7],
+		m[8] * c.x + m[9] * c.y + m[10] * c.z + m[11]), s.radius * std::sqrt(scaleSq));
+}
+
+template <typename T>
+MATH3D_INLINE SphereT<T> SphereT<T>::fromPoints(const Vector3T<T>* points, size_t count)
+{
+	Vector3T<T> center = AABBT<T>::fromPoints(points, count).getCenter();
+	T radiusSq = 0;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		radiusSq = std::max(radiusSq, (points[i] - center).magSq());
+	}
+
+	return SphereT<T>(center, std::sqrt(radiusSq));
+}
+
+template <typename T>
+MATH3D_INLINE SphereT<T> SphereT<T>::fromAABB(const AABBT<T>& box)
+{
+	return SphereT<T>(box.getCenter(), box.getExtents().magnitude());
+}
+
+template <typename T>
+MATH3D_INLINE SphereT<T>::SphereT(const Vector3T<T>& center, T radius)
+: center(center), radius(radius)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_INLINE SphereT<T>::SphereT(const SphereT<U>& sphere)
+: center(sphere.center), radius((T)sphere.radius)
+{
+}
+
+template <typename T>
+MATH3D_INLINE AABBT<T> SphereT<T>::getBounds() const
+{
+	return AABBT<T>::fromCenterExtents(center, Vector3T<T>(radius, radius, radius));
+}
+
+template <typename T>
+MATH3D_INLINE SphereT<T> SphereT<T>::merge(const SphereT<T>& sphere) const
+{
+	Vector3T<T> offset = sphere.center - center;
+	T distance = offset.magnitude();
+
+	if (distance + sphere.radius <= radius)
+	{
+		return *this;
+	}
+
+	if (distance + radius <= sphere.radius)
+	{
+		return sphere;
+	}
+
+	// the merged sphere spans from the far side of one sphere to the far side of the other
+	T mergedRadius = (distance + radius + sphere.radius) * T(0.5);
+
+	return SphereT<T>(center + offset * ((mergedRadius - radius) / distance), mergedRadius);
+}
+
+template <typename T>
+MATH3D_INLINE bool SphereT<T>::contains(const Vector3T<T>& point) const
+{
+	return (point - center).magSq() <= radius * radius;
+}
+
+template <typename T>
+MATH3D_INLINE bool SphereT<T>::contains(const SphereT<T>& sphere) const
+{
+	return (sphere.center - center).magnitude() + sphere.radius <= radius;
+}
+
+template <typename T>
+MATH3D_INLINE bool SphereT<T>::overlaps(const SphereT<T>& sphere) const
+{
+	T radii = radius + sphere.radius;
+
+	return (sphere.center - center).magSq() <= radii * radii;
+}
+
+template <typename T>
+MATH3D_INLINE bool SphereT<T>::overlaps(const AABBT<T>& box) const
+{
+	// the distance to the closest point of the box
+	Vector3T<T> closest(std::min(std::max(center.x, box.min.x), box.max.x),
+		std::min(std::max(center.y, box.min.y), box.max.y),
+		std::min(std::max(center.z, box.min.z), box.max.z));
+
+	return (closest - center).magSq() <= radius * radius;
+}
+
+template <typename T>
+MATH3D_INLINE SphereT<T> SphereT<T>::transform(const Matrix4x4T<T>& m) const
+{
+	return transformSphere(*this, &m.matrix[0][0]);
+}
+
+template <typename T>
+MATH3D_INLINE SphereT<T> SphereT<T>::transform(const Affine3x4T<T>& m) const
+{
+	return transformSphere(*this, &m.matrix[0][0]);
+}
+
+template <typename T>
+MATH3D_INLINE void SphereT<T>::transformBatch(const SphereT<T>* in, const Affine3x4T<T>* matrices, SphereT<T>* out,
+	size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i] = transformSphere(in[i], &matrices[i].matrix[0][0]);
+	}
+}
+
+template <typename T>
+MATH3D_INLINE bool SphereT<T>::operator==(const SphereT<T>& sphere) const
+{
+	return center == sphere.center && radius == sphere.radius;
+}
+
+template <typename T>
+MATH3D_INLINE bool SphereT<T>::operator!=(const SphereT<T>& sphere) const
+{
+	return center != sphere.center || radius != sphere.radius;
+}
+
+#endif
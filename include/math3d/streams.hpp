@@ -0,0 +1,224 @@
+#ifndef STREAMS_HPP
+#define STREAMS_HPP
+
+#include "vector3array.hpp"
+#include "aligned.hpp"
+#include "kernels/table.hpp"
+
+/**
+ * Helpers that let the batch operations run their stream kernels
+ * over any ConstVector3View/Vector3View layout
+ */
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 views require tightly packed vectors");
+
+namespace math3d
+{
+	namespace detail
+	{
+		/** @brief the number of vectors converted at a time for views that are not packed */
+		static const size_t VECTOR3_BLOCK_SIZE = 256;
+
+		/** @brief packed x, y, and z streams for a block of vectors */
+		struct Vector3Streams
+		{
+			float* x;
+			float* y;
+			float* z;
+		};
+
+		/**
+		 * Gets packed streams for n vectors of v starting at start,
+		 * gathering them into scratch if the view is not packed
+		 */
+		static inline Vector3Streams packStreams(const ConstVector3View& v, size_t start, size_t n, float* scratch)
+		{
+			if (v.isPacked())
+			{
+				Vector3Streams s = {const_cast<float*>(v.x + start), const_cast<float*>(v.y + start),
+					const_cast<float*>(v.z + start)};
+				return s;
+			}
+
+			Vector3Streams s = {scratch, scratch + VECTOR3_BLOCK_SIZE, scratch + 2 * VECTOR3_BLOCK_SIZE};
+			size_t offset = start * v.stride;
+
+			if (v.stride == 3 && v.y == v.x + 1 && v.z == v.x + 2)
+			{
+				kernels().vec3Deinterleave(s.x, s.y, s.z, v.x + offset, n);
+				return s;
+			}
+
+			for (size_t i = 0; i < n; i++, offset += v.stride)
+			{
+				s.x[i] = v.x[offset];
+				s.y[i] = v.y[offset];
+				s.z[i] = v.z[offset];
+			}
+
+			return s;
+		}
+
+		/** @brief gets packed streams to write vectors of v to, using scratch if the view is not packed */
+		static inline Vector3Streams outputStreams(const Vector3View& v, size_t start, float* scratch)
+		{
+			if (v.isPacked())
+			{
+				Vector3Streams s = {v.x + start, v.y + start, v.z + start};
+				return s;
+			}
+
+			Vector3Streams s = {scratch, scratch + VECTOR3_BLOCK_SIZE, scratch + 2 * VECTOR3_BLOCK_SIZE};
+			return s;
+		}
+
+		/** @brief scatters n vectors written to scratch streams back to v, if it is not packed */
+		static inline void unpackStreams(const Vector3Streams& s, const Vector3View& v, size_t start, size_t n)
+		{
+			if (v.isPacked())
+			{
+				return;
+			}
+
+			size_t offset = start * v.stride;
+
+			if (v.stride == 3 && v.y == v.x + 1 && v.z == v.x + 2)
+			{
+				kernels().vec3Interleave(v.x + offset, s.x, s.y, s.z, n);
+				return;
+			}
+
+			for (size_t i = 0; i < n; i++, offset += v.stride)
+			{
+				v.x[offset] = s.x[i];
+				v.y[offset] = s.y[i];
+				v.z[offset] = s.z[i];
+			}
+		}
+
+		/**
+		 * Calls func(a, b, out, start, n) with packed streams for the vectors
+		 * of the views. When every view is packed this is a single call over
+		 * all of the vectors; otherwise the views are converted in blocks.
+		 *
+		 * @param a the first input view, which determines the count
+		 * @param b the second input view, which may be a itself for unary operations
+		 * @param out the output view, or nullptr if there is none
+		 * @param func the function to call for each block
+		 */
+		template <typename Func>
+		static inline void forEachBlock(const ConstVector3View& a, const ConstVector3View& b,
+			const Vector3View* out, Func func)
+		{
+			size_t n = a.count;
+
+			if (n == 0)
+			{
+				return;
+			}
+
+			bool packed = a.isPacked() && b.isPacked() && (out == nullptr || out->isPacked());
+			size_t blockSize = packed ? n : VECTOR3_BLOCK_SIZE;
+
+			alignas(BATCH_ALIGNMENT) float scratchA[3 * VECTOR3_BLOCK_SIZE];
+			alignas(BATCH_ALIGNMENT) float scratchB[3 * VECTOR3_BLOCK_SIZE];
+			alignas(BATCH_ALIGNMENT) float scratchOut[3 * VECTOR3_BLOCK_SIZE];
+
+			for (size_t start = 0; start < n; start += blockSize)
+			{
+				size_t count = n - start < blockSize ? n - start : blockSize;
+
+				Vector3Streams sa = packStreams(a, start, count, scratchA);
+				Vector3Streams sb = &b == &a ? sa : packStreams(b, start, count, scratchB);
+				Vector3Streams so = {nullptr, nullptr, nullptr};
+
+				if (out != nullptr)
+				{
+					so = outputStreams(*out, start, scratchOut);
+				}
+
+				func(sa, sb, so, start, count);
+
+				if (out != nullptr)
+				{
+					unpackStreams(so, *out, start, count);
+				}
+			}
+		}
+
+		/**
+		 * Calls func(a, out, start, n) with packed streams for the vectors
+		 * of a single input view and an output view, like the two input
+		 * version of forEachBlock
+		 */
+		template <typename Func>
+		static inline void forEachBlock(const ConstVector3View& a, const Vector3View& out, Func func)
+		{
+			size_t n = a.count;
+
+			if (n == 0)
+			{
+				return;
+			}
+
+			size_t blockSize = a.isPacked() && out.isPacked() ? n : VECTOR3_BLOCK_SIZE;
+
+			alignas(BATCH_ALIGNMENT) float scratchA[3 * VECTOR3_BLOCK_SIZE];
+			alignas(BATCH_ALIGNMENT) float scratchOut[3 * VECTOR3_BLOCK_SIZE];
+
+			for (size_t start = 0; start < n; start += blockSize)
+			{
+				size_t count = n - start < blockSize ? n - start : blockSize;
+
+				Vector3Streams sa = packStreams(a, start, count, scratchA);
+				Vector3Streams so = outputStreams(out, start, scratchOut);
+
+				func(sa, so, start, count);
+				unpackStreams(so, out, start, count);
+			}
+		}
+
+		/**
+		 * Gets the first n components of a matrix as floats for the batch
+		 * kernels, converting them into storage unless they already are
+		 */
+		static inline const float* floatMatrix(const float* m, float*, size_t)
+		{
+			return m;
+		}
+
+		template <typename T>
+		static inline const float* floatMatrix(const T* m, float* storage, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				storage[i] = (float)m[i];
+			}
+
+			return storage;
+		}
+
+		/**
+		 * Applies a batch operation to count vectors of an array, which may
+		 * be transformed in place: arrays of Vector3 are passed to batch(in, out)
+		 * as views, while arrays of any other scalar type are passed to
+		 * single(v, out) one vector at a time
+		 */
+		template <typename Batch, typename Single>
+		static inline void forEachVector(const Vector3* in, Vector3* out, size_t count, Batch batch, Single)
+		{
+			batch(ConstVector3View(in, count), Vector3View(out, count));
+		}
+
+		template <typename T, typename Batch, typename Single>
+		static inline void forEachVector(const Vector3T<T>* in, Vector3T<T>* out, size_t count, Batch, Single single)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				single(in[i], out[i]);
+			}
+		}
+	}
+}
+
+#endif
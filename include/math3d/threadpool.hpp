@@ -0,0 +1,137 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include "config.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A pool of worker threads that splits large batch jobs, such as
+ * transforming the points of a LiDAR frame, into chunks and runs them on
+ * every core
+ *
+ * Each thread starts with an even share of the chunks and takes them in
+ * order from the front of its share. A thread that runs out steals the
+ * back half of the largest remaining share, so that threads which are
+ * preempted or get slower chunks do not hold up the job. The thread that
+ * calls parallelFor works on the job as well.
+ *
+ * The chunk boundaries depend only on the element count and the chunk
+ * size, so the parallel batch operations give the same results as the
+ * serial ones for any number of threads. In the deterministic schedule,
+ * no chunks are stolen either, so each chunk also runs on the same thread
+ * every time, e.g. for per-thread accumulators that must be reproducible.
+ */
+class ThreadPool
+{
+	public:
+		/** @brief how the chunks of a job are assigned to the threads */
+		enum class Schedule
+		{
+			/** @brief idle threads steal chunks from busy ones */
+			Stealing,
+			/** @brief each thread runs the same fixed, contiguous range of chunks */
+			Deterministic
+		};
+
+		/**
+		 * The number of bytes of input and output per chunk of the
+		 * batch operations, which is small enough to stay in the
+		 * per-core caches and large enough to make scheduling negligible
+		 */
+		static const size_t CHUNK_BYTES = 64 * 1024;
+
+		/**
+		 * Creates a pool and starts its worker threads
+		 *
+		 * @param threads the number of threads that run a job, including
+		 * the one calling parallelFor, or 0 for the number of hardware threads
+		 * @param schedule how the chunks of a job are assigned to the threads
+		 */
+		explicit ThreadPool(unsigned threads = 0, Schedule schedule = Schedule::Stealing);
+		/** @brief stops and joins the worker threads */
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/** @brief gets the number of threads that run a job, including the calling one */
+		unsigned getThreadCount() const;
+		/** @brief gets how the chunks of a job are assigned to the threads */
+		Schedule getSchedule() const;
+		/** @brief sets how the chunks of the following jobs are assigned to the threads */
+		void setSchedule(Schedule schedule);
+
+		/**
+		 * Calls body for consecutive ranges [begin, end) of chunkSize
+		 * elements (the last one may be shorter) that together cover
+		 * [0, count), on all of the threads, and returns once every range
+		 * has been processed
+		 *
+		 * If body throws, the ranges that no thread has started are
+		 * skipped, and the first exception is rethrown once every thread
+		 * has returned from body.
+		 *
+		 * Note: body must not call parallelFor on the same pool; calls
+		 * from several threads run one job after another
+		 *
+		 * @param count the number of elements
+		 * @param chunkSize the number of elements per range, at least 1
+		 * @param body the function processing a range of elements
+		 */
+		void parallelFor(size_t count, size_t chunkSize, const std::function<void(size_t begin, size_t end)>& body);
+
+		/**
+		 * Gets the number of elements per chunk for the batch operations,
+		 * a multiple of 16 so that only the last chunk has a SIMD tail
+		 *
+		 * @param bytesPerElement the bytes of input and output per element
+		 */
+		static size_t chunkSize(size_t bytesPerElement);
+	private:
+		/** @brief the chunks [begin, end) left to one thread, on a cache line of its own */
+		struct alignas(64) Range
+		{
+			std::mutex mutex;
+			size_t begin;
+			size_t end;
+		};
+
+		void work(unsigned index);
+		void runChunks(unsigned index);
+		void cancel(std::exception_ptr exception);
+		bool takeChunk(unsigned index, size_t& chunk);
+		bool steal(unsigned index);
+
+		std::vector<std::thread> workers;
+		Range* ranges;
+		unsigned threadCount;
+		Schedule schedule;
+
+		// the current job, published to the workers under mutex
+		std::mutex submitMutex;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable done;
+		const std::function<void(size_t, size_t)>* body;
+		size_t count;
+		size_t chunkElements;
+		bool stealing;
+		uint64_t generation;
+		unsigned running;
+		bool stopping;
+		// the first exception thrown by body in the current job
+		std::exception_ptr error;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "threadpool.inl"
+#endif
+
+#endif
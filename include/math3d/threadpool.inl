@@ -0,0 +1,292 @@
+#ifndef THREADPOOL_INL
+#define THREADPOOL_INL
+
+#include "config.hpp"
+#include "threadpool.hpp"
+#include "aligned.hpp"
+#include <new>
+
+MATH3D_INLINE ThreadPool::ThreadPool(unsigned threads, Schedule schedule)
+	: ranges(nullptr), threadCount(threads), schedule(schedule), body(nullptr), count(0), chunkElements(1),
+	stealing(true), generation(0), running(0), stopping(false)
+{
+	if (threadCount == 0)
+	{
+		threadCount = std::thread::hardware_concurrency();
+	}
+
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+
+	ranges = static_cast<Range*>(math3d::detail::alignedAlloc(threadCount * sizeof(Range), alignof(Range)));
+
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		new (&ranges[i]) Range();
+		ranges[i].begin = 0;
+		ranges[i].end = 0;
+	}
+
+	// the calling thread is the last one, so there is one worker fewer
+	for (unsigned i = 0; i + 1 < threadCount; i++)
+	{
+		workers.push_back(std::thread(&ThreadPool::work, this, i));
+	}
+}
+
+MATH3D_INLINE ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	wake.notify_all();
+
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		ranges[i].~Range();
+	}
+
+	math3d::detail::alignedFree(ranges);
+}
+
+MATH3D_INLINE unsigned ThreadPool::getThreadCount() const
+{
+	return threadCount;
+}
+
+MATH3D_INLINE ThreadPool::Schedule ThreadPool::getSchedule() const
+{
+	return schedule;
+}
+
+MATH3D_INLINE void ThreadPool::setSchedule(Schedule schedule)
+{
+	std::lock_guard<std::mutex> lock(submitMutex);
+	this->schedule = schedule;
+}
+
+MATH3D_INLINE void ThreadPool::parallelFor(size_t count, size_t chunkSize,
+	const std::function<void(size_t begin, size_t end)>& body)
+{
+	if (chunkSize == 0)
+	{
+		chunkSize = 1;
+	}
+
+	size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+	// a single chunk, or a single thread, is not worth waking the workers for
+	if (chunks <= 1 || workers.empty())
+	{
+		for (size_t begin = 0; begin < count; begin += chunkSize)
+		{
+			body(begin, count - begin < chunkSize ? count : begin + chunkSize);
+		}
+
+		return;
+	}
+
+	std::lock_guard<std::mutex> submit(submitMutex);
+
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		ranges[i].begin = chunks * i / threadCount;
+		ranges[i].end = chunks * (i + 1) / threadCount;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->body = &body;
+		this->count = count;
+		chunkElements = chunkSize;
+		stealing = schedule == Schedule::Stealing;
+		running = (unsigned)workers.size();
+		generation++;
+	}
+
+	wake.notify_all();
+	runChunks(threadCount - 1);
+
+	std::exception_ptr exception;
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		// the workers use body until they return, even after an exception
+		done.wait(lock, [this]()
+		{
+			return running == 0;
+		});
+
+		this->body = nullptr;
+		exception = error;
+		error = nullptr;
+	}
+
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+MATH3D_INLINE size_t ThreadPool::chunkSize(size_t bytesPerElement)
+{
+	size_t elements = CHUNK_BYTES / (bytesPerElement > 0 ? bytesPerElement : 1) / 16 * 16;
+
+	return elements > 16 ? elements : 16;
+}
+
+MATH3D_INLINE void ThreadPool::work(unsigned index)
+{
+	uint64_t seen = 0;
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			wake.wait(lock, [this, seen]()
+			{
+				return stopping || generation != seen;
+			});
+
+			if (stopping)
+			{
+				return;
+			}
+
+			seen = generation;
+		}
+
+		runChunks(index);
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (--running == 0)
+		{
+			done.notify_one();
+		}
+	}
+}
+
+MATH3D_INLINE void ThreadPool::runChunks(unsigned index)
+{
+	size_t chunk;
+
+	try
+	{
+		do
+		{
+			while (takeChunk(index, chunk))
+			{
+				size_t begin = chunk * chunkElements;
+
+				(*body)(begin, count - begin < chunkElements ? count : begin + chunkElements);
+			}
+		}
+		while (stealing && steal(index));
+	}
+	catch (...)
+	{
+		cancel(std::current_exception());
+	}
+}
+
+MATH3D_INLINE void ThreadPool::cancel(std::exception_ptr exception)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (!error)
+		{
+			error = exception;
+		}
+	}
+
+	// empty every share, so that the other threads stop after their current chunk
+	for (unsigned i = 0; i < threadCount; i++)
+	{
+		std::lock_guard<std::mutex> lock(ranges[i].mutex);
+		ranges[i].begin = ranges[i].end;
+	}
+}
+
+MATH3D_INLINE bool ThreadPool::takeChunk(unsigned index, size_t& chunk)
+{
+	Range& range = ranges[index];
+	std::lock_guard<std::mutex> lock(range.mutex);
+
+	if (range.begin == range.end)
+	{
+		return false;
+	}
+
+	chunk = range.begin++;
+
+	return true;
+}
+
+MATH3D_INLINE bool ThreadPool::steal(unsigned index)
+{
+	for (;;)
+	{
+		// the thread with the most chunks left is the one most likely to finish last
+		unsigned victim = index;
+		size_t most = 0;
+
+		for (unsigned i = 0; i < threadCount; i++)
+		{
+			if (i != index)
+			{
+				std::lock_guard<std::mutex> lock(ranges[i].mutex);
+
+				if (ranges[i].end - ranges[i].begin > most)
+				{
+					most = ranges[i].end - ranges[i].begin;
+					victim = i;
+				}
+			}
+		}
+
+		if (most == 0)
+		{
+			return false;
+		}
+
+		size_t begin, end;
+
+		{
+			Range& range = ranges[victim];
+			std::lock_guard<std::mutex> lock(range.mutex);
+
+			// another thread may have taken the chunks since they were counted
+			if (range.begin == range.end)
+			{
+				continue;
+			}
+
+			end = range.end;
+			begin = end - (end - range.begin + 1) / 2;
+			range.end = begin;
+		}
+
+		Range& own = ranges[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+
+		own.begin = begin;
+		own.end = end;
+
+		return true;
+	}
+}
+
+#endif
@@ -1,22 +1,28 @@
 #ifndef TRANSFORM_HPP
 #define TRANSFORM_HPP
 
+#include "config.hpp"
 #include "vector3.hpp"
 #include "quaternion.hpp"
 #include "matrix4x4.hpp"
+#include "affine3x4.hpp"
+#include <cstddef>
+
+class ThreadPool;
 
 /**
  * Represents a transformation in 3D with a position,
  * rotation, and a scale
  */
-class Transform
+template <typename T>
+class TransformT
 {
 	public:
 		/**
 		 * Creates a new default Transform object with a position of
 		 * (0, 0, 0), a rotation of (0, 0, 0, 1) and a scale of (1, 1, 1)
 		 */
-		Transform();
+		TransformT();
 		/**
 		 * Creates a new Quaternion from a given position, rotation,
 		 * and scale
@@ -25,13 +31,48 @@ class Transform
 		 * @param rotation the rotation of the transform
 		 * @param scale the scale of the transform
 		 */
-		Transform(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+		TransformT(const Vector3T<T>& position, const QuaternionT<T>& rotation, const Vector3T<T>& scale);
+		/**
+		 * Creates a new Transform by converting the components of a
+		 * transform with another scalar type, e.g. a Transformd
+		 */
+		template <typename U>
+		explicit TransformT(const TransformT<U>& t);
 
 		/**
 		 * Creates a transformation matrix using the transform's
 		 * position, rotation, and scale
 		 */
-		Matrix4x4 getTransformation();
+		Matrix4x4T<T> getTransformation() const;
+		/**
+		 * Creates an affine transformation matrix using the transform's
+		 * position, rotation, and scale
+		 */
+		Affine3x4T<T> getAffineTransformation() const;
+
+		/**
+		 * Creates the transformation matrices of count transforms, like
+		 * calling getTransformation for each of them
+		 *
+		 * @param in the transforms
+		 * @param out receives the matrices
+		 * @param count the number of transforms
+		 */
+		static void getTransformationBatch(const TransformT* in, Matrix4x4T<T>* out, size_t count);
+		/** @brief creates the matrices of count transforms in chunks on the threads of a pool */
+		static void getTransformationBatch(const TransformT* in, Matrix4x4T<T>* out, size_t count, ThreadPool& pool);
+		/**
+		 * Creates the affine transformation matrices of count transforms,
+		 * like calling getAffineTransformation for each of them
+		 *
+		 * @param in the transforms
+		 * @param out receives the matrices
+		 * @param count the number of transforms
+		 */
+		static void getAffineTransformationBatch(const TransformT* in, Affine3x4T<T>* out, size_t count);
+		/** @brief creates the affine matrices of count transforms in chunks on the threads of a pool */
+		static void getAffineTransformationBatch(const TransformT* in, Affine3x4T<T>* out, size_t count,
+			ThreadPool& pool);
 
 		/**
 		 * translates the transform by the given (x, y, z)
@@ -41,21 +82,21 @@ class Transform
 		 * @param y the y component of the vector
 		 * @param z the z component of the vector
 		 */
-		Transform& translateBy(float x, float y, float z);
+		TransformT& translateBy(T x, T y, T z);
 		/**
 		 * translates the transform by the given (x, y, z)
 		 * vector
 		 *
 		 * @param v3 the vector to translate by
 		 */
-		Transform& translateBy(const Vector3& v3);
+		TransformT& translateBy(const Vector3T<T>& v3);
 
 		/**
 		 * Rotates the transform by the given rotation
 		 *
 		 * @param rot the rotation to rotate by
 		 */
-		Transform& rotateBy(const Quaternion& rot);
+		TransformT& rotateBy(const QuaternionT<T>& rot);
 
 		/**
 		 * Orients the transform so that it looks at the (x, y, z)
@@ -65,19 +106,26 @@ class Transform
 		 * @param y the y component of the point
 		 * @param z the z component of the point
 		 */
-		Transform& lookAt(float x, float y, float z);
+		TransformT& lookAt(T x, T y, T z);
 		/**
 		 * Orients the transform so that it looks at the (x, y, z)
 		 * point
 		 *
 		 * @param point the point to look at
 		 */
-		Transform& lookAt(const Vector3& point);
+		TransformT& lookAt(const Vector3T<T>& point);
 
-		Vector3 position;
-		Quaternion rotation;
-		Vector3 scale;
+		Vector3T<T> position;
+		QuaternionT<T> rotation;
+		Vector3T<T> scale;
 	private:
 };
 
+#ifdef MATH3D_HEADER_ONLY
+#include "transform.inl"
+#else
+extern template class TransformT<float>;
+extern template class TransformT<double>;
 #endif
+
+#endif
\ No newline at end of file
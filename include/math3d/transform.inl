@@ -0,0 +1,129 @@
+#ifndef TRANSFORM_INL
+#define TRANSFORM_INL
+
+#include "config.hpp"
+#include "transform.hpp"
+#include "threadpool.hpp"
+
+template <typename T>
+MATH3D_INLINE static QuaternionT<T> getLookAtRotation(const Vector3T<T>&, const Vector3T<T>&, const Vector3T<T>&);
+
+template <typename T>
+MATH3D_INLINE TransformT<T>::TransformT()
+: position(Vector3T<T>()), rotation(QuaternionT<T>(0, 0, 0, 1)), scale(Vector3T<T>(1, 1, 1))
+{
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T>::TransformT(const Vector3T<T>& position, const QuaternionT<T>& rotation, const Vector3T<T>& scale)
+: position(Vector3T<T>(position)), rotation(QuaternionT<T>(rotation)), scale(Vector3T<T>(scale))
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_INLINE TransformT<T>::TransformT(const TransformT<U>& t)
+: position(t.position), rotation(t.rotation), scale(t.scale)
+{
+}
+
+template <typename T>
+MATH3D_INLINE Matrix4x4T<T> TransformT<T>::getTransformation() const
+{
+	return getAffineTransformation().toMatrix4x4();
+}
+
+template <typename T>
+MATH3D_INLINE Affine3x4T<T> TransformT<T>::getAffineTransformation() const
+{
+	return Affine3x4T<T>::fromPositionRotationScale(position, rotation, scale);
+}
+
+template <typename T>
+MATH3D_INLINE void TransformT<T>::getTransformationBatch(const TransformT<T>* in, Matrix4x4T<T>* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i] = in[i].getTransformation();
+	}
+}
+
+template <typename T>
+MATH3D_INLINE void TransformT<T>::getTransformationBatch(const TransformT<T>* in, Matrix4x4T<T>* out, size_t count,
+	ThreadPool& pool)
+{
+	pool.parallelFor(count, ThreadPool::chunkSize(sizeof(TransformT<T>) + sizeof(Matrix4x4T<T>)),
+		[in, out](size_t begin, size_t end)
+	{
+		getTransformationBatch(in + begin, out + begin, end - begin);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE void TransformT<T>::getAffineTransformationBatch(const TransformT<T>* in, Affine3x4T<T>* out,
+	size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		out[i] = in[i].getAffineTransformation();
+	}
+}
+
+template <typename T>
+MATH3D_INLINE void TransformT<T>::getAffineTransformationBatch(const TransformT<T>* in, Affine3x4T<T>* out,
+	size_t count, ThreadPool& pool)
+{
+	pool.parallelFor(count, ThreadPool::chunkSize(sizeof(TransformT<T>) + sizeof(Affine3x4T<T>)),
+		[in, out](size_t begin, size_t end)
+	{
+		getAffineTransformationBatch(in + begin, out + begin, end - begin);
+	});
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T>& TransformT<T>::translateBy(T x, T y, T z)
+{
+	position += Vector3T<T>(x, y, z).rotateBy(rotation);
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T>& TransformT<T>::translateBy(const Vector3T<T>& v3)
+{
+	position += v3.rotateBy(rotation);
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T>& TransformT<T>::rotateBy(const QuaternionT<T>& rot)
+{
+	rotation = rotation.rotateBy(rot);
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T>& TransformT<T>::lookAt(T x, T y, T z)
+{
+	rotation = getLookAtRotation(position, Vector3T<T>(x, y, z), Vector3T<T>(0, 1, 0));
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_INLINE TransformT<T>& TransformT<T>::lookAt(const Vector3T<T>& point)
+{
+	rotation = getLookAtRotation(position, point, Vector3T<T>(0, 1, 0));
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_INLINE static QuaternionT<T> getLookAtRotation(const Vector3T<T>& a, const Vector3T<T>& b, const Vector3T<T>& up)
+{
+	return QuaternionT<T>::fromMatrix(Matrix4x4T<T>::fromAxes((b - a).normalize(), up));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef TRANSFORMHIERARCHY_HPP
+#define TRANSFORMHIERARCHY_HPP
+
+#include "config.hpp"
+#include "transform.hpp"
+#include "affine3x4.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A hierarchy of transforms, such as the nodes of a scene graph, that
+ * caches the local and world matrix of every node as an Affine3x4
+ *
+ * Nodes are stored in flattened arrays in which every parent comes before
+ * its children. Changing a node's position, rotation, or scale only marks
+ * it as dirty; update() then recomputes the matrices of the dirty nodes and
+ * their descendants in a single linear pass, leaving the rest untouched.
+ */
+class TransformHierarchy
+{
+	public:
+		/** @brief the parent of a root node */
+		static const size_t NONE = (size_t)-1;
+
+		/** @brief creates an empty hierarchy */
+		TransformHierarchy();
+
+		/**
+		 * Adds a node to the hierarchy
+		 *
+		 * Note: the parent must be a node that has already been added,
+		 * which keeps every parent before its children
+		 *
+		 * @param local the transform of the node relative to its parent
+		 * @param parent the index of the parent node, or NONE for a root node
+		 * @return the index of the new node
+		 */
+		size_t add(const Transform& local, size_t parent = NONE);
+		/** @brief removes all of the nodes */
+		void clear();
+		/** @brief reserves space for the given number of nodes */
+		void reserve(size_t count);
+
+		/** @brief gets the number of nodes */
+		size_t size() const;
+		/** @brief gets the parent of a node, or NONE if it is a root node */
+		size_t getParent(size_t node) const;
+
+		/** @brief gets the transform of a node relative to its parent */
+		const Transform& getLocal(size_t node) const;
+		/** @brief sets the transform of a node relative to its parent */
+		void setLocal(size_t node, const Transform& local);
+		/** @brief sets the position of a node relative to its parent */
+		void setPosition(size_t node, const Vector3& position);
+		/** @brief sets the rotation of a node relative to its parent */
+		void setRotation(size_t node, const Quaternion& rotation);
+		/** @brief sets the scale of a node relative to its parent */
+		void setScale(size_t node, const Vector3& scale);
+
+		/** @brief whether the node has changed since the last update */
+		bool isDirty(size_t node) const;
+
+		/**
+		 * Recomputes the local matrices of the dirty nodes and the world
+		 * matrices of the dirty nodes and all of their descendants
+		 */
+		void update();
+
+		/** @brief gets the local matrix of a node as of the last update */
+		const Affine3x4& getLocalMatrix(size_t node) const;
+		/** @brief gets the world matrix of a node as of the last update */
+		const Affine3x4& getWorldMatrix(size_t node) const;
+		/** @brief gets the world matrices of all of the nodes as of the last update */
+		const Affine3x4* getWorldMatrices() const;
+	private:
+		void markDirty(size_t node);
+
+		std::vector<size_t> parents;
+		std::vector<Transform> locals;
+		std::vector<Affine3x4> localMatrices;
+		std::vector<Affine3x4> worldMatrices;
+
+		// whether each local transform changed, and the update in which
+		// each world matrix was last recomputed
+		std::vector<unsigned char> localDirty;
+		std::vector<uint64_t> worldUpdated;
+
+		uint64_t updateCount;
+		size_t firstDirty;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "transformhierarchy.inl"
+#endif
+
+#endif
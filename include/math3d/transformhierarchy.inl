@@ -0,0 +1,162 @@
+#ifndef TRANSFORMHIERARCHY_INL
+#define TRANSFORMHIERARCHY_INL
+
+#include "config.hpp"
+#include "transformhierarchy.hpp"
+
+MATH3D_INLINE TransformHierarchy::TransformHierarchy()
+: updateCount(0), firstDirty(0)
+{
+}
+
+MATH3D_INLINE size_t TransformHierarchy::add(const Transform& local, size_t parent)
+{
+	size_t node = parents.size();
+
+	parents.push_back(parent);
+	locals.push_back(local);
+	localMatrices.push_back(Affine3x4());
+	worldMatrices.push_back(Affine3x4());
+	localDirty.push_back(1);
+	worldUpdated.push_back(0);
+
+	markDirty(node);
+
+	return node;
+}
+
+MATH3D_INLINE void TransformHierarchy::clear()
+{
+	parents.clear();
+	locals.clear();
+	localMatrices.clear();
+	worldMatrices.clear();
+	localDirty.clear();
+	worldUpdated.clear();
+
+	firstDirty = 0;
+}
+
+MATH3D_INLINE void TransformHierarchy::reserve(size_t count)
+{
+	parents.reserve(count);
+	locals.reserve(count);
+	localMatrices.reserve(count);
+	worldMatrices.reserve(count);
+	localDirty.reserve(count);
+	worldUpdated.reserve(count);
+}
+
+MATH3D_INLINE size_t TransformHierarchy::size() const
+{
+	return parents.size();
+}
+
+MATH3D_INLINE size_t TransformHierarchy::getParent(size_t node) const
+{
+	return parents[node];
+}
+
+MATH3D_INLINE const Transform& TransformHierarchy::getLocal(size_t node) const
+{
+	return locals[node];
+}
+
+MATH3D_INLINE void TransformHierarchy::setLocal(size_t node, const Transform& local)
+{
+	locals[node] = local;
+	markDirty(node);
+}
+
+MATH3D_INLINE void TransformHierarchy::setPosition(size_t node, const Vector3& position)
+{
+	locals[node].position = position;
+	markDirty(node);
+}
+
+MATH3D_INLINE void TransformHierarchy::setRotation(size_t node, const Quaternion& rotation)
+{
+	locals[node].rotation = rotation;
+	markDirty(node);
+}
+
+MATH3D_INLINE void TransformHierarchy::setScale(size_t node, const Vector3& scale)
+{
+	locals[node].scale = scale;
+	markDirty(node);
+}
+
+MATH3D_INLINE bool TransformHierarchy::isDirty(size_t node) const
+{
+	return localDirty[node] != 0;
+}
+
+MATH3D_INLINE void TransformHierarchy::update()
+{
+	size_t count = parents.size();
+
+	if (firstDirty >= count)
+	{
+		return;
+	}
+
+	updateCount++;
+
+	// parents come before their children, so a single pass starting at the
+	// first dirty node sees every parent's world matrix before its children
+	for (size_t node = firstDirty; node < count; node++)
+	{
+		size_t parent = parents[node];
+		bool parentUpdated = parent != NONE && worldUpdated[parent] == updateCount;
+
+		if (localDirty[node])
+		{
+			localMatrices[node] = locals[node].getAffineTransformation();
+			localDirty[node] = 0;
+		}
+		else if (!parentUpdated)
+		{
+			continue;
+		}
+
+		if (parent == NONE)
+		{
+			worldMatrices[node] = localMatrices[node];
+		}
+		else
+		{
+			worldMatrices[node] = worldMatrices[parent] * localMatrices[node];
+		}
+
+		worldUpdated[node] = updateCount;
+	}
+
+	firstDirty = count;
+}
+
+MATH3D_INLINE const Affine3x4& TransformHierarchy::getLocalMatrix(size_t node) const
+{
+	return localMatrices[node];
+}
+
+MATH3D_INLINE const Affine3x4& TransformHierarchy::getWorldMatrix(size_t node) const
+{
+	return worldMatrices[node];
+}
+
+MATH3D_INLINE const Affine3x4* TransformHierarchy::getWorldMatrices() const
+{
+	return worldMatrices.data();
+}
+
+MATH3D_INLINE void TransformHierarchy::markDirty(size_t node)
+{
+	localDirty[node] = 1;
+
+	if (node < firstDirty)
+	{
+		firstDirty = node;
+	}
+}
+
+#endif
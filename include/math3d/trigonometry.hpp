@@ -0,0 +1,58 @@
+#ifndef TRIGONOMETRY_HPP
+#define TRIGONOMETRY_HPP
+
+#include "config.hpp"
+#include <cstddef>
+
+/**
+ * Float sine, cosine and arctangent evaluated with polynomials, rather
+ * than through the standard library's double-precision functions
+ *
+ * The angle is reduced to [-pi/4, pi/4] and the minimax polynomials of
+ * Cephes' sinf, cosf and atanf are evaluated in float arithmetic, which
+ * the batch functions do for a full SIMD register at a time. Sines and
+ * cosines are within 1.5e-7 of the exact values and arctangents within
+ * 3.5e-7 (1.5 units in the last place of pi), and the batch functions
+ * return exactly the same values as the single ones.
+ *
+ * Quaternion::fromEulerAnglesBatch, Quaternion::fromAxisAngleBatch and
+ * the slerp of AnimationSampler use these for float.
+ *
+ * Note: angles must be finite and within [-8192, 8192]
+ */
+class Trigonometry
+{
+	public:
+		/**
+		 * Calculates the sine and cosine of an angle at once
+		 *
+		 * @param angle the angle in radians
+		 * @param s receives the sine
+		 * @param c receives the cosine
+		 */
+		static void sincos(float angle, float& s, float& c);
+		/** @brief calculates the sine of an angle in radians */
+		static float sin(float angle);
+		/** @brief calculates the cosine of an angle in radians */
+		static float cos(float angle);
+		/** @brief calculates the angle of (x, y) from the x axis, in [-pi, pi]; atan2(0, 0) is 0 */
+		static float atan2(float y, float x);
+
+		/**
+		 * Calculates the sines and cosines of count angles
+		 *
+		 * @param angles the angles in radians
+		 * @param s receives the sines; may be the same as angles
+		 * @param c receives the cosines; may be the same as angles, but not s
+		 * @param count the number of angles
+		 */
+		static void sincos(const float* angles, float* s, float* c, size_t count);
+		/** @brief out[i] = atan2(y[i], x[i]) for count pairs; out may be the same as y or x */
+		static void atan2(const float* y, const float* x, float* out, size_t count);
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "trigonometry.inl"
+#endif
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TRIGONOMETRY_INL
+#define TRIGONOMETRY_INL
+
+#include "config.hpp"
+#include "trigonometry.hpp"
+#include "kernels/table.hpp"
+
+MATH3D_INLINE void Trigonometry::sincos(float angle, float& s, float& c)
+{
+	math3d::detail::sincosScalar(angle, s, c);
+}
+
+MATH3D_INLINE float Trigonometry::sin(float angle)
+{
+	float s, c;
+
+	math3d::detail::sincosScalar(angle, s, c);
+
+	return s;
+}
+
+MATH3D_INLINE float Trigonometry::cos(float angle)
+{
+	float s, c;
+
+	math3d::detail::sincosScalar(angle, s, c);
+
+	return c;
+}
+
+MATH3D_INLINE float Trigonometry::atan2(float y, float x)
+{
+	return math3d::detail::atan2Scalar(y, x);
+}
+
+MATH3D_INLINE void Trigonometry::sincos(const float* angles, float* s, float* c, size_t count)
+{
+	math3d::detail::kernels().streamSinCos(s, c, angles, count);
+}
+
+MATH3D_INLINE void Trigonometry::atan2(const float* y, const float* x, float* out, size_t count)
+{
+	math3d::detail::kernels().streamAtan2(out, y, x, count);
+}
+
+#endif
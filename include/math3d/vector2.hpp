@@ -1,17 +1,22 @@
 #ifndef VECTOR2_HPP
 #define VECTOR2_HPP
 
+#include "config.hpp"
+#include "fwd.hpp"
+#include "precision.hpp"
+
 /**
  * 2-dimensional vector with x and y coordinates
  */
-class Vector2
+template <typename T>
+class Vector2T
 {
 	public:
 		/**
 		 * Creates a new Vector2 with its x and y components
 		 * both 0
 		 */
-		Vector2();
+		MATH3D_CONSTEXPR Vector2T();
 		/**
 		 * Creates a new Vector2 with the given x and y
 		 * components
@@ -19,75 +24,293 @@ class Vector2
 		 * @param x the x component
 		 * @param y the y component
 		 */
-		Vector2(float x, float y);
+		MATH3D_CONSTEXPR Vector2T(T x, T y);
 		/**
 		 * Creates a new Vector2 by copying the corresponding
 		 * components of Vector2 v2
 		 */
-		Vector2(const Vector2& v2);
+		Vector2T(const Vector2T& v2) = default;
+		/**
+		 * Creates a new Vector2 by converting the components of a
+		 * vector with another scalar type, e.g. a Vector2d
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit Vector2T(const Vector2T<U>& v2);
 
 		/** @brief calculates the dot product of this vector and v2 */
-		float dot(const Vector2& v2) const;
+		MATH3D_CONSTEXPR T dot(const Vector2T& v2) const;
 
 		/** @brief calculates the magnitude (length) of the vector */
-		float magnitude() const;
+		T magnitude() const;
 		/** @brief calculates the magnitude^2 of the vector */
-		float magSq() const;
-		/** @brief calculates a normalized (unit) vector */
-		Vector2 normalize() const;
+		MATH3D_CONSTEXPR T magSq() const;
+		/**
+		 * Calculates a normalized (unit) vector
+		 *
+		 * @param precision Precision::Fast to multiply by an approximate
+		 * reciprocal of the magnitude instead of dividing
+		 */
+		Vector2T normalize(Precision precision = Precision::Exact) const;
 
 		/**
 		 * Compares whether two vectors are equal by testing whether
 		 * all of their corresponding components are equal
 		 */
-		bool operator==(const Vector2&) const;
-		bool operator!=(const Vector2&) const;
+		MATH3D_CONSTEXPR bool operator==(const Vector2T&) const;
+		MATH3D_CONSTEXPR bool operator!=(const Vector2T&) const;
 
 		/** @brief negates the vector */
-		Vector2 operator-() const;
+		MATH3D_CONSTEXPR Vector2T operator-() const;
 
 		/** @brief adds two vectors together */
-		Vector2 operator+(const Vector2&) const;
+		MATH3D_CONSTEXPR Vector2T operator+(const Vector2T&) const;
 		/** @brief subtracts two vectors */
-		Vector2 operator-(const Vector2&) const;
+		MATH3D_CONSTEXPR Vector2T operator-(const Vector2T&) const;
 		/** @brief multiplies two vectors */
-		Vector2 operator*(const Vector2&) const;
+		MATH3D_CONSTEXPR Vector2T operator*(const Vector2T&) const;
 		/** @brief divides two vectors */
-		Vector2 operator/(const Vector2&) const;
+		MATH3D_CONSTEXPR Vector2T operator/(const Vector2T&) const;
 
 		/** @brief adds a number to the vector */
-		Vector2 operator+(float) const;
+		MATH3D_CONSTEXPR Vector2T operator+(T) const;
 		/** @brief subtracts a number from a vector */
-		Vector2 operator-(float) const;
+		MATH3D_CONSTEXPR Vector2T operator-(T) const;
 		/** @brief multiplies a number by a vector */
-		Vector2 operator*(float) const;
+		MATH3D_CONSTEXPR Vector2T operator*(T) const;
 		/** @brief divides a vector by a number */
-		Vector2 operator/(float) const;
+		MATH3D_CONSTEXPR Vector2T operator/(T) const;
 
 		/** @brief adds a vector to this vector*/
-		Vector2& operator+=(const Vector2&);
+		MATH3D_CONSTEXPR Vector2T& operator+=(const Vector2T&);
 		/** @brief subtracts a vector from this vector */
-		Vector2& operator-=(const Vector2&);
+		MATH3D_CONSTEXPR Vector2T& operator-=(const Vector2T&);
 		/** @brief multiplies a vector by this vector */
-		Vector2& operator*=(const Vector2&);
+		MATH3D_CONSTEXPR Vector2T& operator*=(const Vector2T&);
 		/** @brief divides this vector by a vector */
-		Vector2& operator/=(const Vector2&);
+		MATH3D_CONSTEXPR Vector2T& operator/=(const Vector2T&);
 
 		/** @brief adds a number to this vector */
-		Vector2& operator+=(float);
+		MATH3D_CONSTEXPR Vector2T& operator+=(T);
 		/** @brief subtracts a number from this vector */
-		Vector2& operator-=(float);
+		MATH3D_CONSTEXPR Vector2T& operator-=(T);
 		/** @brief multiplies a number by this vector */
-		Vector2& operator*=(float);
+		MATH3D_CONSTEXPR Vector2T& operator*=(T);
 		/** @brief divides this vector by a number */
-		Vector2& operator/=(float);
+		MATH3D_CONSTEXPR Vector2T& operator/=(T);
 
 		/** @brief indexes the components of the vector */
-		float operator[](int);
-		const float operator[](int) const;
+		MATH3D_CONSTEXPR T operator[](int);
+		MATH3D_CONSTEXPR const T operator[](int) const;
 
-		float x, y;
+		T x, y;
 	private:
 };
 
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in vector2.inl
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>::Vector2T()
+: x(0), y(0)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>::Vector2T(T x, T y)
+: x(x), y(y)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR Vector2T<T>::Vector2T(const Vector2T<U>& v2)
+: x((T)v2.x), y((T)v2.y)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector2T<T>::dot(const Vector2T<T>& v2) const
+{
+	return x * v2.x + y * v2.y;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector2T<T>::magSq() const
+{
+	return x * x + y * y;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator-() const
+{
+	return Vector2T<T>(-x, -y);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector2T<T>::operator==(const Vector2T<T>& v2) const
+{
+	return x == v2.x && y == v2.y;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector2T<T>::operator!=(const Vector2T<T>& v2) const
+{
+	return x != v2.x || y != v2.y;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator+(const Vector2T<T>& v2) const
+{
+	return Vector2T<T>(x + v2.x, y + v2.y);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator-(const Vector2T<T>& v2) const
+{
+	return Vector2T<T>(x - v2.x, y - v2.y);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator*(const Vector2T<T>& v2) const
+{
+	return Vector2T<T>(x * v2.x, y * v2.y);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator/(const Vector2T<T>& v2) const
+{
+	return Vector2T<T>(x / v2.x, y / v2.y);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator+(T n) const
+{
+	return Vector2T<T>(x + n, y + n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator-(T n) const
+{
+	return Vector2T<T>(x - n, y - n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator*(T n) const
+{
+	return Vector2T<T>(x * n, y * n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T> Vector2T<T>::operator/(T n) const
+{
+	return Vector2T<T>(x / n, y / n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator+=(const Vector2T<T>& v2)
+{
+	x += v2.x;
+	y += v2.y;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator-=(const Vector2T<T>& v2)
+{
+	x -= v2.x;
+	y -= v2.y;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator*=(const Vector2T<T>& v2)
+{
+	x *= v2.x;
+	y *= v2.y;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator/=(const Vector2T<T>& v2)
+{
+	x /= v2.x;
+	y /= v2.y;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator+=(T n)
+{
+	x += n;
+	y += n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator-=(T n)
+{
+	x -= n;
+	y -= n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator*=(T n)
+{
+	x *= n;
+	y *= n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector2T<T>& Vector2T<T>::operator/=(T n)
+{
+	x /= n;
+	y /= n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector2T<T>::operator[](int i)
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		default:
+			return 0;
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T Vector2T<T>::operator[](int i) const
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		default:
+			return 0;
+	}
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "vector2.inl"
+#else
+extern template class Vector2T<float>;
+extern template class Vector2T<double>;
 #endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef VECTOR2_INL
+#define VECTOR2_INL
+
+#include "config.hpp"
+#include "vector2.hpp"
+#include "kernels/table.hpp"
+#include <cmath>
+
+template <typename T>
+MATH3D_INLINE T Vector2T<T>::magnitude() const
+{
+	return std::sqrt(x * x + y * y);
+}
+
+template <typename T>
+MATH3D_INLINE Vector2T<T> Vector2T<T>::normalize(Precision precision) const
+{
+	if (precision == Precision::Fast)
+	{
+		T invMag = math3d::detail::rsqrtFast(magSq());
+
+		return Vector2T<T>(x * invMag, y * invMag);
+	}
+
+	T mag = magnitude();
+
+	return Vector2T<T>(x / mag, y / mag);
+}
+
+#endif
\ No newline at end of file
@@ -1,19 +1,22 @@
 #ifndef VECTOR3_HPP
 #define VECTOR3_HPP
 
-class Quaternion;
+#include "config.hpp"
+#include "fwd.hpp"
+#include "precision.hpp"
 
 /**
  * 3-dimensional vector with x, y, and z coordinates
  */
-class Vector3
+template <typename T>
+class Vector3T
 {
 	public:
 		/**
 		 * Creates a new Vector3 with its x, y, and z components
 		 * all 0
 		 */
-		Vector3();
+		MATH3D_CONSTEXPR Vector3T();
 		/**
 		 * Creates a new Vector3 with the given x, y, and z
 		 * components
@@ -22,92 +25,345 @@ class Vector3
 		 * @param y the y component
 		 * @param z the z component
 		 */
-		Vector3(float x, float y, float z);
+		MATH3D_CONSTEXPR Vector3T(T x, T y, T z);
 		/**
 		 * Creates a new Vector3 by copying the corresponding
 		 * components of Vector3 v3
 		 */
-		Vector3(const Vector3& v3);
+		Vector3T(const Vector3T& v3) = default;
+		/**
+		 * Creates a new Vector3 by converting the components of a
+		 * vector with another scalar type, e.g. a Vector3d
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit Vector3T(const Vector3T<U>& v3);
 
 		/** @brief calculates the dot product of the vector and v3 */
-		float dot(const Vector3& v3) const;
+		MATH3D_CONSTEXPR T dot(const Vector3T& v3) const;
 		/** @brief calculates the cross product of the vector and v3 */
-		Vector3 cross(const Vector3& v3) const;
+		MATH3D_CONSTEXPR Vector3T cross(const Vector3T& v3) const;
 
 		/** @brief calculates the magnitude (length) of the vector */
-		float magnitude() const;
+		T magnitude() const;
 		/** @brief calculates the magnitude^2 of the vector */
-		float magSq() const;
-		/** @brief calculates a normalized (unit) vector */
-		Vector3 normalize() const;
+		MATH3D_CONSTEXPR T magSq() const;
+		/**
+		 * Calculates a normalized (unit) vector
+		 *
+		 * @param precision Precision::Fast to multiply by an approximate
+		 * reciprocal of the magnitude instead of dividing
+		 */
+		Vector3T normalize(Precision precision = Precision::Exact) const;
 
 		/**
 		 * rotates the vector by the given quaternion
 		 *
+		 * Note: the quaternion must be a unit (normalized) quaternion
+		 *
 		 * @param rot the quaternion to rotate by
 		 */
-		Vector3 rotateBy(const Quaternion& rot) const;
+		MATH3D_CONSTEXPR Vector3T rotateBy(const QuaternionT<T>& rot) const;
 		/**
 		 * Rotates the vector around the axis by the given angle
 		 *
 		 * @param axis the axis to rotate around
 		 * @param angle the angle to rotate
 		 */
-		Vector3 rotateBy(const Vector3& axis, float angle) const;
+		Vector3T rotateBy(const Vector3T& axis, T angle) const;
 
 		/**
 		 * Compares whether two vectors are equal by testing whether
 		 * all of their corresponding components are equal
 		 */
-		bool operator==(const Vector3&) const;
-		bool operator!=(const Vector3&) const;
+		MATH3D_CONSTEXPR bool operator==(const Vector3T&) const;
+		MATH3D_CONSTEXPR bool operator!=(const Vector3T&) const;
 
 		/** @brief negates the vector */
-		Vector3 operator-() const;
+		MATH3D_CONSTEXPR Vector3T operator-() const;
 
 		/** @brief adds two vectors together */
-		Vector3 operator+(const Vector3&) const;
+		MATH3D_CONSTEXPR Vector3T operator+(const Vector3T&) const;
 		/** @brief subtracts two vectors */
-		Vector3 operator-(const Vector3&) const;
+		MATH3D_CONSTEXPR Vector3T operator-(const Vector3T&) const;
 		/** @brief multiplies two vectors */
-		Vector3 operator*(const Vector3&) const;
+		MATH3D_CONSTEXPR Vector3T operator*(const Vector3T&) const;
 		/** @brief divides two vectors */
-		Vector3 operator/(const Vector3&) const;
+		MATH3D_CONSTEXPR Vector3T operator/(const Vector3T&) const;
 
 		/** @brief adds a number to the vector */
-		Vector3 operator+(float) const;
+		MATH3D_CONSTEXPR Vector3T operator+(T) const;
 		/** @brief subtracts a number from the vector */
-		Vector3 operator-(float) const;
+		MATH3D_CONSTEXPR Vector3T operator-(T) const;
 		/** @brief multiplies a number by the vector */
-		Vector3 operator*(float) const;
+		MATH3D_CONSTEXPR Vector3T operator*(T) const;
 		/** @brief divides the vector by a number */
-		Vector3 operator/(float) const;
+		MATH3D_CONSTEXPR Vector3T operator/(T) const;
 
 
 		/** @brief adds a vector to this vector */
-		Vector3& operator+=(const Vector3&);
+		MATH3D_CONSTEXPR Vector3T& operator+=(const Vector3T&);
 		/** @brief subtractes a vector from this vector */
-		Vector3& operator-=(const Vector3&);
+		MATH3D_CONSTEXPR Vector3T& operator-=(const Vector3T&);
 		/** @brief multiplies a vector by this vector */
-		Vector3& operator*=(const Vector3&);
+		MATH3D_CONSTEXPR Vector3T& operator*=(const Vector3T&);
 		/** @brief divides this vector by a vector */
-		Vector3& operator/=(const Vector3&);
+		MATH3D_CONSTEXPR Vector3T& operator/=(const Vector3T&);
 
 		/** @brief adds a number to this vector */
-		Vector3& operator+=(float);
+		MATH3D_CONSTEXPR Vector3T& operator+=(T);
 		/** @brief subtracts a number from this vector */
-		Vector3& operator-=(float);
+		MATH3D_CONSTEXPR Vector3T& operator-=(T);
 		/** @brief multiplies a number by this vector */
-		Vector3& operator*=(float);
+		MATH3D_CONSTEXPR Vector3T& operator*=(T);
 		/** @brief divides this vector by a number */
-		Vector3& operator/=(float);
+		MATH3D_CONSTEXPR Vector3T& operator/=(T);
 
 		/** @brief indexes the components of the vector */
-		float operator[](int);
-		const float operator[](int) const;
+		MATH3D_CONSTEXPR T operator[](int);
+		MATH3D_CONSTEXPR const T operator[](int) const;
 
-		float x, y, z;
+		T x, y, z;
 	private:
 };
 
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in vector3.inl
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>::Vector3T()
+: x(0), y(0), z(0)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>::Vector3T(T x, T y, T z)
+: x(x), y(y), z(z)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR Vector3T<T>::Vector3T(const Vector3T<U>& v3)
+: x((T)v3.x), y((T)v3.y), z((T)v3.z)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector3T<T>::dot(const Vector3T<T>& v3) const
+{
+	return x * v3.x + y * v3.y + z * v3.z;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::cross(const Vector3T<T>& v3) const
+{
+	T nx = y * v3.z - z * v3.y;
+	T ny = z * v3.x - x * v3.z;
+	T nz = x * v3.y - y * v3.x;
+
+	return Vector3T<T>(nx, ny, nz);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector3T<T>::magSq() const
+{
+	return x * x + y * y + z * z;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::rotateBy(const QuaternionT<T>& rot) const
+{
+	// rot * v * conjugate(rot) expanded for a unit quaternion, which takes
+	// two cross products instead of two quaternion products
+	Vector3T<T> u(rot.x, rot.y, rot.z);
+	Vector3T<T> t = u.cross(*this) * 2;
+
+	return *this + t * rot.w + u.cross(t);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector3T<T>::operator==(const Vector3T<T>& v3) const
+{
+	return x == v3.x && y == v3.y && z == v3.z;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector3T<T>::operator!=(const Vector3T<T>& v3) const
+{
+	return x != v3.x || y != v3.y || z != v3.z;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator-() const
+{
+	return Vector3T<T>(-x, -y, -z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator+(const Vector3T<T>& v3) const
+{
+	return Vector3T<T>(x + v3.x, y + v3.y, z + v3.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator-(const Vector3T<T>& v3) const
+{
+	return Vector3T<T>(x - v3.x, y - v3.y, z - v3.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator*(const Vector3T<T>& v3) const
+{
+	return Vector3T<T>(x * v3.x, y * v3.y, z * v3.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator/(const Vector3T<T>& v3) const
+{
+	return Vector3T<T>(x / v3.x, y / v3.y, z / v3.z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator+(T n) const
+{
+	return Vector3T<T>(x + n, y + n, z + n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator-(T n) const
+{
+	return Vector3T<T>(x - n, y - n, z - n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator*(T n) const
+{
+	return Vector3T<T>(x * n, y * n, z * n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3T<T>::operator/(T n) const
+{
+	return Vector3T<T>(x / n, y / n, z / n);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator+=(const Vector3T<T>& v3)
+{
+	x += v3.x;
+	y += v3.y;
+	z += v3.z;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator-=(const Vector3T<T>& v3)
+{
+	x -= v3.x;
+	y -= v3.y;
+	z -= v3.z;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator*=(const Vector3T<T>& v3)
+{
+	x *= v3.x;
+	y *= v3.y;
+	z *= v3.z;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator/=(const Vector3T<T>& v3)
+{
+	x /= v3.x;
+	y /= v3.y;
+	z /= v3.z;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator+=(T n)
+{
+	x += n;
+	y += n;
+	z += n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator-=(T n)
+{
+	x -= n;
+	y -= n;
+	z -= n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator*=(T n)
+{
+	x *= n;
+	y *= n;
+	z *= n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T>& Vector3T<T>::operator/=(T n)
+{
+	x /= n;
+	y /= n;
+	z /= n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector3T<T>::operator[](int i)
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		default:
+			return 0;
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T Vector3T<T>::operator[](int i) const
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		default:
+			return 0;
+	}
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "vector3.inl"
+#else
+extern template class Vector3T<float>;
+extern template class Vector3T<double>;
 #endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef VECTOR3_INL
+#define VECTOR3_INL
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include "kernels/table.hpp"
+#include <cmath>
+
+#include "quaternion.hpp"
+
+template <typename T>
+MATH3D_INLINE T Vector3T<T>::magnitude() const
+{
+	return std::sqrt(x * x + y * y + z * z);
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> Vector3T<T>::normalize(Precision precision) const
+{
+	if (precision == Precision::Fast)
+	{
+		T invMag = math3d::detail::rsqrtFast(magSq());
+
+		return Vector3T<T>(x * invMag, y * invMag, z * invMag);
+	}
+
+	T mag = magnitude();
+	
+	return Vector3T<T>(x / mag, y / mag, z / mag);
+}
+
+template <typename T>
+MATH3D_INLINE Vector3T<T> Vector3T<T>::rotateBy(const Vector3T<T>& axis, T angle) const
+{
+	T sinA = std::sin(-angle);
+	T cosA = std::cos(-angle);
+
+	return cross(axis * sinA + (*this) * cosA + axis
+		* dot(axis * (1 - cosA)));
+}
+
+#endif
\ No newline at end of file
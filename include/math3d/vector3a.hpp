@@ -0,0 +1,450 @@
+#ifndef VECTOR3A_HPP
+#define VECTOR3A_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include "precision.hpp"
+#include "kernels/vec4.hpp"
+
+/**
+ * 3-dimensional vector with x, y, and z coordinates, padded to 16 bytes
+ * and 16-byte aligned like a Vector4
+ *
+ * Its float operators work on all four lanes with single SSE instructions
+ * (see kernels/vec4.hpp), so arrays of them trade a third more memory
+ * than Vector3 for faster math on each element. The results are the same
+ * as those of the Vector3 operators.
+ */
+template <typename T>
+class alignas(16) Vector3AT
+{
+	public:
+		/**
+		 * Creates a new Vector3A with its x, y, and z components
+		 * all 0
+		 */
+		MATH3D_CONSTEXPR Vector3AT();
+		/**
+		 * Creates a new Vector3A with the given x, y, and z
+		 * components
+		 *
+		 * @param x the x component
+		 * @param y the y component
+		 * @param z the z component
+		 */
+		MATH3D_CONSTEXPR Vector3AT(T x, T y, T z);
+		/** @brief creates a new Vector3A with the components of a Vector3 */
+		MATH3D_CONSTEXPR explicit Vector3AT(const Vector3T<T>& v3);
+		/**
+		 * Creates a new Vector3A by copying the corresponding
+		 * components of Vector3A v3
+		 */
+		Vector3AT(const Vector3AT& v3) = default;
+		/**
+		 * Creates a new Vector3A by converting the components of a
+		 * vector with another scalar type, e.g. a Vector3Ad
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit Vector3AT(const Vector3AT<U>& v3);
+
+		/** @brief gets the vector as an unpadded Vector3 */
+		MATH3D_CONSTEXPR Vector3T<T> toVector3() const;
+
+		/** @brief calculates the dot product of the vector and v3 */
+		MATH3D_CONSTEXPR T dot(const Vector3AT& v3) const;
+		/** @brief calculates the cross product of the vector and v3 */
+		MATH3D_CONSTEXPR Vector3AT cross(const Vector3AT& v3) const;
+
+		/** @brief calculates the magnitude (length) of the vector */
+		T magnitude() const;
+		/** @brief calculates the magnitude^2 of the vector */
+		MATH3D_CONSTEXPR T magSq() const;
+		/**
+		 * Calculates a normalized (unit) vector
+		 *
+		 * @param precision Precision::Fast to multiply by an approximate
+		 * reciprocal of the magnitude instead of dividing
+		 */
+		Vector3AT normalize(Precision precision = Precision::Exact) const;
+
+		/**
+		 * Compares whether two vectors are equal by testing whether
+		 * all of their corresponding components are equal
+		 */
+		MATH3D_CONSTEXPR bool operator==(const Vector3AT&) const;
+		MATH3D_CONSTEXPR bool operator!=(const Vector3AT&) const;
+
+		/** @brief negates the vector */
+		MATH3D_CONSTEXPR Vector3AT operator-() const;
+
+		/** @brief adds two vectors together */
+		MATH3D_CONSTEXPR Vector3AT operator+(const Vector3AT&) const;
+		/** @brief subtracts two vectors */
+		MATH3D_CONSTEXPR Vector3AT operator-(const Vector3AT&) const;
+		/** @brief multiplies two vectors */
+		MATH3D_CONSTEXPR Vector3AT operator*(const Vector3AT&) const;
+		/** @brief divides two vectors */
+		MATH3D_CONSTEXPR Vector3AT operator/(const Vector3AT&) const;
+
+		/** @brief adds a number to the vector */
+		MATH3D_CONSTEXPR Vector3AT operator+(T) const;
+		/** @brief subtracts a number from the vector */
+		MATH3D_CONSTEXPR Vector3AT operator-(T) const;
+		/** @brief multiplies a number by the vector */
+		MATH3D_CONSTEXPR Vector3AT operator*(T) const;
+		/** @brief divides the vector by a number */
+		MATH3D_CONSTEXPR Vector3AT operator/(T) const;
+
+		/** @brief adds a vector to this vector */
+		MATH3D_CONSTEXPR Vector3AT& operator+=(const Vector3AT&);
+		/** @brief subtracts a vector from this vector */
+		MATH3D_CONSTEXPR Vector3AT& operator-=(const Vector3AT&);
+		/** @brief multiplies a vector by this vector */
+		MATH3D_CONSTEXPR Vector3AT& operator*=(const Vector3AT&);
+		/** @brief divides this vector by a vector */
+		MATH3D_CONSTEXPR Vector3AT& operator/=(const Vector3AT&);
+
+		/** @brief adds a number to this vector */
+		MATH3D_CONSTEXPR Vector3AT& operator+=(T);
+		/** @brief subtracts a number from this vector */
+		MATH3D_CONSTEXPR Vector3AT& operator-=(T);
+		/** @brief multiplies a number by this vector */
+		MATH3D_CONSTEXPR Vector3AT& operator*=(T);
+		/** @brief divides this vector by a number */
+		MATH3D_CONSTEXPR Vector3AT& operator/=(T);
+
+		/** @brief indexes the components of the vector */
+		MATH3D_CONSTEXPR T operator[](int);
+		MATH3D_CONSTEXPR const T operator[](int) const;
+
+		T x, y, z;
+		/**
+		 * The fourth lane, which the constructors set to 0 and the
+		 * operators keep 0 (or -0), so that it never holds an infinity, a
+		 * NaN, or a denormal that would slow down the other lanes
+		 *
+		 * Note: it must not be set to anything else
+		 */
+		T padding;
+	private:
+};
+
+#include "vector3.hpp"
+
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in vector3a.inl
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>::Vector3AT()
+: x(0), y(0), z(0), padding(0)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>::Vector3AT(T x, T y, T z)
+: x(x), y(y), z(z), padding(0)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>::Vector3AT(const Vector3T<T>& v3)
+: x(v3.x), y(v3.y), z(v3.z), padding(0)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR Vector3AT<T>::Vector3AT(const Vector3AT<U>& v3)
+: x((T)v3.x), y((T)v3.y), z((T)v3.z), padding(0)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector3AT<T>::toVector3() const
+{
+	return Vector3T<T>(x, y, z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector3AT<T>::dot(const Vector3AT<T>& v3) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return x * v3.x + y * v3.y + z * v3.z;
+	}
+
+	return math3d::detail::vec3PaddedDot(&x, &v3.x);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::cross(const Vector3AT<T>& v3) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(y * v3.z - z * v3.y, z * v3.x - x * v3.z, x * v3.y - y * v3.x);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec3PaddedCross(&out.x, &x, &v3.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector3AT<T>::magSq() const
+{
+	return dot(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector3AT<T>::operator==(const Vector3AT<T>& v3) const
+{
+	return x == v3.x && y == v3.y && z == v3.z;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector3AT<T>::operator!=(const Vector3AT<T>& v3) const
+{
+	return x != v3.x || y != v3.y || z != v3.z;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator-() const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(-x, -y, -z);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4Negate(&out.x, &x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator+(const Vector3AT<T>& v3) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x + v3.x, y + v3.y, z + v3.z);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4Add(&out.x, &x, &v3.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator-(const Vector3AT<T>& v3) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x - v3.x, y - v3.y, z - v3.z);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4Sub(&out.x, &x, &v3.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator*(const Vector3AT<T>& v3) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x * v3.x, y * v3.y, z * v3.z);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4Mul(&out.x, &x, &v3.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator/(const Vector3AT<T>& v3) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x / v3.x, y / v3.y, z / v3.z);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec3PaddedDiv(&out.x, &x, &v3.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator+(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x + n, y + n, z + n);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4AddBroadcast(&out.x, &x, n, (T)0);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator-(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x - n, y - n, z - n);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4SubBroadcast(&out.x, &x, n, (T)0);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator*(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x * n, y * n, z * n);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4MulBroadcast(&out.x, &x, n, (T)0);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T> Vector3AT<T>::operator/(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector3AT<T>(x / n, y / n, z / n);
+	}
+
+	Vector3AT<T> out;
+
+	math3d::detail::vec4DivBroadcast(&out.x, &x, n, (T)1);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator+=(const Vector3AT<T>& v3)
+{
+	*this = *this + v3;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator-=(const Vector3AT<T>& v3)
+{
+	*this = *this - v3;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator*=(const Vector3AT<T>& v3)
+{
+	*this = *this * v3;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator/=(const Vector3AT<T>& v3)
+{
+	*this = *this / v3;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator+=(T n)
+{
+	*this = *this + n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator-=(T n)
+{
+	*this = *this - n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator*=(T n)
+{
+	*this = *this * n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3AT<T>& Vector3AT<T>::operator/=(T n)
+{
+	*this = *this / n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector3AT<T>::operator[](int i)
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		default:
+			return 0;
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T Vector3AT<T>::operator[](int i) const
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		default:
+			return 0;
+	}
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "vector3a.inl"
+#else
+extern template class Vector3AT<float>;
+extern template class Vector3AT<double>;
+#endif
+
+#endif
\ No newline at end of file
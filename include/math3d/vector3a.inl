@@ -0,0 +1,26 @@
+#ifndef VECTOR3A_INL
+#define VECTOR3A_INL
+
+#include "config.hpp"
+#include "vector3a.hpp"
+#include "kernels/table.hpp"
+#include <cmath>
+
+template <typename T>
+MATH3D_INLINE T Vector3AT<T>::magnitude() const
+{
+	return std::sqrt(magSq());
+}
+
+template <typename T>
+MATH3D_INLINE Vector3AT<T> Vector3AT<T>::normalize(Precision precision) const
+{
+	if (precision == Precision::Fast)
+	{
+		return *this * math3d::detail::rsqrtFast(magSq());
+	}
+
+	return *this / magnitude();
+}
+
+#endif
\ No newline at end of file
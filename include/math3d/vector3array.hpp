@@ -0,0 +1,214 @@
+#ifndef VECTOR3ARRAY_HPP
+#define VECTOR3ARRAY_HPP
+
+#include "config.hpp"
+#include "vector3.hpp"
+#include <cstddef>
+
+class ThreadPool;
+
+/**
+ * A read-only view of 3-dimensional vectors whose x, y and z components
+ * are each stored in a stream of floats, with consecutive vectors
+ * stride floats apart. A stride of 1 describes structure-of-arrays
+ * storage such as Vector3Array, and a stride of 3 describes an existing
+ * array of Vector3 objects.
+ */
+class ConstVector3View
+{
+	public:
+		/**
+		 * Creates a view of separate x, y, and z streams
+		 *
+		 * @param x the x components
+		 * @param y the y components
+		 * @param z the z components
+		 * @param count the number of vectors
+		 * @param stride the distance in floats between consecutive vectors
+		 */
+		ConstVector3View(const float* x, const float* y, const float* z, size_t count, size_t stride = 1);
+		/**
+		 * Creates a view of an existing array of Vector3 objects
+		 * without copying it
+		 *
+		 * @param vectors the array of vectors
+		 * @param count the number of vectors
+		 */
+		ConstVector3View(const Vector3* vectors, size_t count);
+
+		/** @brief whether the components are stored contiguously (stride of 1) */
+		bool isPacked() const;
+
+		/** @brief gets the vector at the given index */
+		Vector3 operator[](size_t) const;
+		/** @brief gets a view of count vectors starting at the given index */
+		ConstVector3View subview(size_t first, size_t count) const;
+
+		const float* x;
+		const float* y;
+		const float* z;
+		size_t count;
+		size_t stride;
+	private:
+};
+
+/**
+ * A writable view of 3-dimensional vectors, laid out as described
+ * in ConstVector3View
+ */
+class Vector3View
+{
+	public:
+		/**
+		 * Creates a view of separate x, y, and z streams
+		 *
+		 * @param x the x components
+		 * @param y the y components
+		 * @param z the z components
+		 * @param count the number of vectors
+		 * @param stride the distance in floats between consecutive vectors
+		 */
+		Vector3View(float* x, float* y, float* z, size_t count, size_t stride = 1);
+		/**
+		 * Creates a view of an existing array of Vector3 objects
+		 * without copying it
+		 *
+		 * @param vectors the array of vectors
+		 * @param count the number of vectors
+		 */
+		Vector3View(Vector3* vectors, size_t count);
+
+		/** @brief whether the components are stored contiguously (stride of 1) */
+		bool isPacked() const;
+
+		/** @brief gets the vector at the given index */
+		Vector3 operator[](size_t) const;
+		/** @brief sets the vector at the given index */
+		void set(size_t, const Vector3&);
+		/** @brief gets a view of count vectors starting at the given index */
+		Vector3View subview(size_t first, size_t count) const;
+
+		operator ConstVector3View() const;
+
+		float* x;
+		float* y;
+		float* z;
+		size_t count;
+		size_t stride;
+	private:
+};
+
+/**
+ * A resizable array of 3-dimensional vectors stored as separate,
+ * 64-byte aligned x, y, and z streams (structure-of-arrays), so that
+ * batch operations can process a full SIMD register of vectors at a time.
+ *
+ * The static batch operations mirror the Vector3 API and work on any
+ * combination of views, including views of plain Vector3 arrays. Output
+ * views may be the same as input views for in-place operation. Every
+ * view passed must hold at least as many vectors as the first input.
+ */
+class Vector3Array
+{
+	public:
+		/** @brief creates an empty array */
+		Vector3Array();
+		/**
+		 * Creates an array of count vectors, all (0, 0, 0)
+		 *
+		 * @param count the number of vectors
+		 */
+		explicit Vector3Array(size_t count);
+		/**
+		 * Creates an array by copying the vectors in a view, such as
+		 * a view of an array of Vector3 objects
+		 */
+		explicit Vector3Array(ConstVector3View);
+		Vector3Array(const Vector3Array&);
+		Vector3Array(Vector3Array&&);
+		~Vector3Array();
+
+		Vector3Array& operator=(const Vector3Array&);
+		Vector3Array& operator=(Vector3Array&&);
+
+		/**
+		 * Resizes the array, keeping the existing vectors and setting
+		 * new ones to (0, 0, 0)
+		 */
+		void resize(size_t count);
+		/** @brief gets the number of vectors in the array */
+		size_t size() const;
+
+		/** @brief gets the streams of components */
+		float* x();
+		float* y();
+		float* z();
+		const float* x() const;
+		const float* y() const;
+		const float* z() const;
+
+		/** @brief gets the vector at the given index */
+		Vector3 operator[](size_t) const;
+		/** @brief sets the vector at the given index */
+		void set(size_t, const Vector3&);
+
+		/** @brief gets a view of the whole array */
+		Vector3View view();
+		ConstVector3View view() const;
+
+		operator Vector3View();
+		operator ConstVector3View() const;
+
+		/** @brief copies the vectors of src to dst, converting between layouts */
+		static void copy(ConstVector3View src, Vector3View dst);
+
+		/** @brief out[i] = a[i] + b[i] */
+		static void add(ConstVector3View a, ConstVector3View b, Vector3View out);
+		/** @brief out[i] = a[i] - b[i] */
+		static void sub(ConstVector3View a, ConstVector3View b, Vector3View out);
+		/** @brief out[i] = a[i] * b[i] */
+		static void mul(ConstVector3View a, ConstVector3View b, Vector3View out);
+		/** @brief out[i] = a[i] * n */
+		static void scale(ConstVector3View a, float n, Vector3View out);
+
+		/** @brief out[i] = a[i].dot(b[i]) */
+		static void dot(ConstVector3View a, ConstVector3View b, float* out);
+		/** @brief out[i] = a[i].cross(b[i]) */
+		static void cross(ConstVector3View a, ConstVector3View b, Vector3View out);
+
+		/** @brief out[i] = a[i].magnitude() */
+		static void magnitude(ConstVector3View a, float* out);
+		/** @brief out[i] = a[i].magSq() */
+		static void magSq(ConstVector3View a, float* out);
+		/** @brief out[i] = a[i].normalize(precision) */
+		static void normalize(ConstVector3View a, Vector3View out, Precision precision = Precision::Exact);
+		/** @brief normalizes the vectors in chunks on the threads of a pool, see ThreadPool */
+		static void normalize(ConstVector3View a, Vector3View out, ThreadPool& pool,
+			Precision precision = Precision::Exact);
+
+		/**
+		 * out[i] = a[i].rotateBy(rotations[i]), rotating each vector by its
+		 * own unit quaternion, e.g. by the orientations of a set of bodies.
+		 * To rotate every vector by the same quaternion, use
+		 * Quaternion::rotateVectors.
+		 */
+		static void rotate(ConstVector3View a, const Quaternion* rotations, Vector3View out);
+		/**
+		 * out[i] = a[i].rotateBy(Quaternion(qx[i], qy[i], qz[i], qw[i])), for
+		 * unit quaternions stored as separate x, y, z, and w streams
+		 */
+		static void rotate(ConstVector3View a, const float* qx, const float* qy, const float* qz, const float* qw,
+			Vector3View out);
+	private:
+		void allocate(size_t capacity);
+
+		float* data;
+		size_t count;
+		size_t capacity;
+};
+
+#ifdef MATH3D_HEADER_ONLY
+#include "vector3array.inl"
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,419 @@
+#ifndef VECTOR3ARRAY_INL
+#define VECTOR3ARRAY_INL
+
+#include "config.hpp"
+#include "vector3array.hpp"
+#include "quaternion.hpp"
+#include "aligned.hpp"
+#include "streams.hpp"
+#include "threadpool.hpp"
+#include <cstring> //memset, memcpy
+
+MATH3D_INLINE ConstVector3View::ConstVector3View(const float* x, const float* y, const float* z,
+	size_t count, size_t stride)
+: x(x), y(y), z(z), count(count), stride(stride)
+{
+}
+
+MATH3D_INLINE ConstVector3View::ConstVector3View(const Vector3* vectors, size_t count)
+: x(&vectors->x), y(&vectors->y), z(&vectors->z), count(count), stride(3)
+{
+}
+
+MATH3D_INLINE bool ConstVector3View::isPacked() const
+{
+	return stride == 1;
+}
+
+MATH3D_INLINE Vector3 ConstVector3View::operator[](size_t i) const
+{
+	return Vector3(x[i * stride], y[i * stride], z[i * stride]);
+}
+
+MATH3D_INLINE ConstVector3View ConstVector3View::subview(size_t first, size_t count) const
+{
+	return ConstVector3View(x + first * stride, y + first * stride, z + first * stride, count, stride);
+}
+
+MATH3D_INLINE Vector3View::Vector3View(float* x, float* y, float* z, size_t count, size_t stride)
+: x(x), y(y), z(z), count(count), stride(stride)
+{
+}
+
+MATH3D_INLINE Vector3View::Vector3View(Vector3* vectors, size_t count)
+: x(&vectors->x), y(&vectors->y), z(&vectors->z), count(count), stride(3)
+{
+}
+
+MATH3D_INLINE bool Vector3View::isPacked() const
+{
+	return stride == 1;
+}
+
+MATH3D_INLINE Vector3 Vector3View::operator[](size_t i) const
+{
+	return Vector3(x[i * stride], y[i * stride], z[i * stride]);
+}
+
+MATH3D_INLINE void Vector3View::set(size_t i, const Vector3& v3)
+{
+	x[i * stride] = v3.x;
+	y[i * stride] = v3.y;
+	z[i * stride] = v3.z;
+}
+
+MATH3D_INLINE Vector3View Vector3View::subview(size_t first, size_t count) const
+{
+	return Vector3View(x + first * stride, y + first * stride, z + first * stride, count, stride);
+}
+
+MATH3D_INLINE Vector3View::operator ConstVector3View() const
+{
+	return ConstVector3View(x, y, z, count, stride);
+}
+
+MATH3D_INLINE Vector3Array::Vector3Array()
+: data(nullptr), count(0), capacity(0)
+{
+}
+
+MATH3D_INLINE Vector3Array::Vector3Array(size_t count)
+: data(nullptr), count(0), capacity(0)
+{
+	resize(count);
+}
+
+MATH3D_INLINE Vector3Array::Vector3Array(ConstVector3View v)
+: data(nullptr), count(0), capacity(0)
+{
+	resize(v.count);
+	copy(v, view());
+}
+
+MATH3D_INLINE Vector3Array::Vector3Array(const Vector3Array& arr)
+: data(nullptr), count(0), capacity(0)
+{
+	resize(arr.count);
+	copy(arr.view(), view());
+}
+
+MATH3D_INLINE Vector3Array::Vector3Array(Vector3Array&& arr)
+: data(arr.data), count(arr.count), capacity(arr.capacity)
+{
+	arr.data = nullptr;
+	arr.count = 0;
+	arr.capacity = 0;
+}
+
+MATH3D_INLINE Vector3Array::~Vector3Array()
+{
+	math3d::detail::alignedFree(data);
+}
+
+MATH3D_INLINE Vector3Array& Vector3Array::operator=(const Vector3Array& arr)
+{
+	if (this != &arr)
+	{
+		resize(arr.count);
+		copy(arr.view(), view());
+	}
+
+	return *this;
+}
+
+MATH3D_INLINE Vector3Array& Vector3Array::operator=(Vector3Array&& arr)
+{
+	if (this != &arr)
+	{
+		math3d::detail::alignedFree(data);
+
+		data = arr.data;
+		count = arr.count;
+		capacity = arr.capacity;
+
+		arr.data = nullptr;
+		arr.count = 0;
+		arr.capacity = 0;
+	}
+
+	return *this;
+}
+
+MATH3D_INLINE void Vector3Array::resize(size_t newCount)
+{
+	if (newCount > capacity)
+	{
+		float* oldData = data;
+		size_t oldCapacity = capacity;
+
+		allocate(math3d::detail::alignedCount<float>(newCount));
+
+		if (oldData != nullptr)
+		{
+			memcpy(x(), oldData, count * sizeof(float));
+			memcpy(y(), oldData + oldCapacity, count * sizeof(float));
+			memcpy(z(), oldData + 2 * oldCapacity, count * sizeof(float));
+
+			math3d::detail::alignedFree(oldData);
+		}
+	}
+
+	if (newCount > count)
+	{
+		memset(x() + count, 0, (newCount - count) * sizeof(float));
+		memset(y() + count, 0, (newCount - count) * sizeof(float));
+		memset(z() + count, 0, (newCount - count) * sizeof(float));
+	}
+
+	count = newCount;
+}
+
+MATH3D_INLINE size_t Vector3Array::size() const
+{
+	return count;
+}
+
+MATH3D_INLINE float* Vector3Array::x()
+{
+	return data;
+}
+
+MATH3D_INLINE float* Vector3Array::y()
+{
+	return data + capacity;
+}
+
+MATH3D_INLINE float* Vector3Array::z()
+{
+	return data + 2 * capacity;
+}
+
+MATH3D_INLINE const float* Vector3Array::x() const
+{
+	return data;
+}
+
+MATH3D_INLINE const float* Vector3Array::y() const
+{
+	return data + capacity;
+}
+
+MATH3D_INLINE const float* Vector3Array::z() const
+{
+	return data + 2 * capacity;
+}
+
+MATH3D_INLINE Vector3 Vector3Array::operator[](size_t i) const
+{
+	return Vector3(x()[i], y()[i], z()[i]);
+}
+
+MATH3D_INLINE void Vector3Array::set(size_t i, const Vector3& v3)
+{
+	x()[i] = v3.x;
+	y()[i] = v3.y;
+	z()[i] = v3.z;
+}
+
+MATH3D_INLINE Vector3View Vector3Array::view()
+{
+	return Vector3View(x(), y(), z(), count);
+}
+
+MATH3D_INLINE ConstVector3View Vector3Array::view() const
+{
+	return ConstVector3View(x(), y(), z(), count);
+}
+
+MATH3D_INLINE Vector3Array::operator Vector3View()
+{
+	return view();
+}
+
+MATH3D_INLINE Vector3Array::operator ConstVector3View() const
+{
+	return view();
+}
+
+MATH3D_INLINE void Vector3Array::copy(ConstVector3View src, Vector3View dst)
+{
+	math3d::detail::forEachBlock(src, dst, [](const math3d::detail::Vector3Streams& a,
+		const math3d::detail::Vector3Streams& out, size_t, size_t n)
+	{
+		if (out.x != a.x)
+		{
+			memmove(out.x, a.x, n * sizeof(float));
+			memmove(out.y, a.y, n * sizeof(float));
+			memmove(out.z, a.z, n * sizeof(float));
+		}
+	});
+}
+
+MATH3D_INLINE void Vector3Array::add(ConstVector3View a, ConstVector3View b, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, b, &out, [&k](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& sb, const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.streamAdd(so.x, sa.x, sb.x, n);
+		k.streamAdd(so.y, sa.y, sb.y, n);
+		k.streamAdd(so.z, sa.z, sb.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::sub(ConstVector3View a, ConstVector3View b, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, b, &out, [&k](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& sb, const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.streamSub(so.x, sa.x, sb.x, n);
+		k.streamSub(so.y, sa.y, sb.y, n);
+		k.streamSub(so.z, sa.z, sb.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::mul(ConstVector3View a, ConstVector3View b, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, b, &out, [&k](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& sb, const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.streamMul(so.x, sa.x, sb.x, n);
+		k.streamMul(so.y, sa.y, sb.y, n);
+		k.streamMul(so.z, sa.z, sb.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::scale(ConstVector3View a, float s, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, out, [&k, s](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.streamScale(so.x, sa.x, s, n);
+		k.streamScale(so.y, sa.y, s, n);
+		k.streamScale(so.z, sa.z, s, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::dot(ConstVector3View a, ConstVector3View b, float* out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, b, nullptr, [&k, out](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& sb, const math3d::detail::Vector3Streams&, size_t start, size_t n)
+	{
+		k.vec3Dot(out + start, sa.x, sa.y, sa.z, sb.x, sb.y, sb.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::cross(ConstVector3View a, ConstVector3View b, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, b, &out, [&k](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& sb, const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		k.vec3Cross(so.x, so.y, so.z, sa.x, sa.y, sa.z, sb.x, sb.y, sb.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::magnitude(ConstVector3View a, float* out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, a, nullptr, [&k, out](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams&, const math3d::detail::Vector3Streams&, size_t start, size_t n)
+	{
+		k.vec3Magnitude(out + start, sa.x, sa.y, sa.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::magSq(ConstVector3View a, float* out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, a, nullptr, [&k, out](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams&, const math3d::detail::Vector3Streams&, size_t start, size_t n)
+	{
+		k.vec3MagSq(out + start, sa.x, sa.y, sa.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::normalize(ConstVector3View a, Vector3View out, Precision precision)
+{
+	const Kernels& k = math3d::detail::kernels();
+	auto kernel = precision == Precision::Fast ? k.vec3NormalizeFast : k.vec3Normalize;
+
+	math3d::detail::forEachBlock(a, out, [kernel](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t, size_t n)
+	{
+		kernel(so.x, so.y, so.z, sa.x, sa.y, sa.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::normalize(ConstVector3View a, Vector3View out, ThreadPool& pool, Precision precision)
+{
+	pool.parallelFor(a.count, ThreadPool::chunkSize(6 * sizeof(float)), [&a, &out, precision](size_t begin, size_t end)
+	{
+		normalize(a.subview(begin, end - begin), out.subview(begin, end - begin), precision);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::rotate(ConstVector3View a, const Quaternion* rotations, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+	const size_t blockSize = math3d::detail::VECTOR3_BLOCK_SIZE;
+
+	math3d::detail::forEachBlock(a, out, [&k, rotations, blockSize](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t start, size_t n)
+	{
+		alignas(math3d::detail::BATCH_ALIGNMENT) float q[4 * blockSize];
+
+		// split the quaternions into x, y, z, and w streams a block at a time
+		for (size_t i = 0; i < n; i += blockSize)
+		{
+			size_t count = n - i < blockSize ? n - i : blockSize;
+			const Quaternion* r = rotations + start + i;
+
+			for (size_t j = 0; j < count; j++)
+			{
+				q[j] = r[j].x;
+				q[blockSize + j] = r[j].y;
+				q[2 * blockSize + j] = r[j].z;
+				q[3 * blockSize + j] = r[j].w;
+			}
+
+			k.quatsRotateVectors(so.x + i, so.y + i, so.z + i, q, q + blockSize, q + 2 * blockSize, q + 3 * blockSize,
+				sa.x + i, sa.y + i, sa.z + i, count);
+		}
+	});
+}
+
+MATH3D_INLINE void Vector3Array::rotate(ConstVector3View a, const float* qx, const float* qy, const float* qz,
+	const float* qw, Vector3View out)
+{
+	const Kernels& k = math3d::detail::kernels();
+
+	math3d::detail::forEachBlock(a, out, [&k, qx, qy, qz, qw](const math3d::detail::Vector3Streams& sa,
+		const math3d::detail::Vector3Streams& so, size_t start, size_t n)
+	{
+		k.quatsRotateVectors(so.x, so.y, so.z, qx + start, qy + start, qz + start, qw + start, sa.x, sa.y, sa.z, n);
+	});
+}
+
+MATH3D_INLINE void Vector3Array::allocate(size_t newCapacity)
+{
+	data = (float*)math3d::detail::alignedAlloc(3 * newCapacity * sizeof(float));
+	capacity = newCapacity;
+
+	// zero the padding so that it can be read by full-width SIMD loads
+	memset(data, 0, 3 * newCapacity * sizeof(float));
+}
+
+#endif
\ No newline at end of file
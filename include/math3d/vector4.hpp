@@ -0,0 +1,461 @@
+#ifndef VECTOR4_HPP
+#define VECTOR4_HPP
+
+#include "config.hpp"
+#include "fwd.hpp"
+#include "precision.hpp"
+#include "kernels/vec4.hpp"
+
+/**
+ * 4-dimensional vector with x, y, z, and w coordinates, e.g. a
+ * homogeneous point or direction
+ *
+ * The vector is 16-byte aligned, so that each float operator loads,
+ * computes, and stores all four components with single SSE instructions
+ * (see kernels/vec4.hpp). The results are the same as computing each
+ * component on its own.
+ */
+template <typename T>
+class alignas(16) Vector4T
+{
+	public:
+		/**
+		 * Creates a new Vector4 with its x, y, z, and w components
+		 * all 0
+		 */
+		MATH3D_CONSTEXPR Vector4T();
+		/**
+		 * Creates a new Vector4 with the given x, y, z, and w
+		 * components
+		 *
+		 * @param x the x component
+		 * @param y the y component
+		 * @param z the z component
+		 * @param w the w component
+		 */
+		MATH3D_CONSTEXPR Vector4T(T x, T y, T z, T w);
+		/**
+		 * Creates a new Vector4 from the x, y, and z components of a
+		 * Vector3 and a w component, e.g. 1 for a point or 0 for a direction
+		 */
+		MATH3D_CONSTEXPR Vector4T(const Vector3T<T>& v3, T w);
+		/** @brief creates a new Vector4 from the (x, y, z, w) components of a quaternion */
+		MATH3D_CONSTEXPR explicit Vector4T(const QuaternionT<T>& q);
+		/**
+		 * Creates a new Vector4 by copying the corresponding
+		 * components of Vector4 v4
+		 */
+		Vector4T(const Vector4T& v4) = default;
+		/**
+		 * Creates a new Vector4 by converting the components of a
+		 * vector with another scalar type, e.g. a Vector4d
+		 */
+		template <typename U>
+		MATH3D_CONSTEXPR explicit Vector4T(const Vector4T<U>& v4);
+
+		/** @brief gets the x, y, and z components, dropping w */
+		MATH3D_CONSTEXPR Vector3T<T> toVector3() const;
+		/**
+		 * Divides the x, y, and z components by w, e.g. to get the
+		 * point projected by a perspective matrix
+		 */
+		MATH3D_CONSTEXPR Vector3T<T> project() const;
+		/** @brief gets the components as the (x, y, z, w) of a quaternion */
+		MATH3D_CONSTEXPR QuaternionT<T> toQuaternion() const;
+
+		/** @brief calculates the dot product of the vector and v4 */
+		MATH3D_CONSTEXPR T dot(const Vector4T& v4) const;
+
+		/** @brief calculates the magnitude (length) of the vector */
+		T magnitude() const;
+		/** @brief calculates the magnitude^2 of the vector */
+		MATH3D_CONSTEXPR T magSq() const;
+		/**
+		 * Calculates a normalized (unit) vector
+		 *
+		 * @param precision Precision::Fast to multiply by an approximate
+		 * reciprocal of the magnitude instead of dividing
+		 */
+		Vector4T normalize(Precision precision = Precision::Exact) const;
+
+		/**
+		 * Compares whether two vectors are equal by testing whether
+		 * all of their corresponding components are equal
+		 */
+		MATH3D_CONSTEXPR bool operator==(const Vector4T&) const;
+		MATH3D_CONSTEXPR bool operator!=(const Vector4T&) const;
+
+		/** @brief negates the vector */
+		MATH3D_CONSTEXPR Vector4T operator-() const;
+
+		/** @brief adds two vectors together */
+		MATH3D_CONSTEXPR Vector4T operator+(const Vector4T&) const;
+		/** @brief subtracts two vectors */
+		MATH3D_CONSTEXPR Vector4T operator-(const Vector4T&) const;
+		/** @brief multiplies two vectors */
+		MATH3D_CONSTEXPR Vector4T operator*(const Vector4T&) const;
+		/** @brief divides two vectors */
+		MATH3D_CONSTEXPR Vector4T operator/(const Vector4T&) const;
+
+		/** @brief adds a number to the vector */
+		MATH3D_CONSTEXPR Vector4T operator+(T) const;
+		/** @brief subtracts a number from the vector */
+		MATH3D_CONSTEXPR Vector4T operator-(T) const;
+		/** @brief multiplies a number by the vector */
+		MATH3D_CONSTEXPR Vector4T operator*(T) const;
+		/** @brief divides the vector by a number */
+		MATH3D_CONSTEXPR Vector4T operator/(T) const;
+
+		/** @brief adds a vector to this vector */
+		MATH3D_CONSTEXPR Vector4T& operator+=(const Vector4T&);
+		/** @brief subtracts a vector from this vector */
+		MATH3D_CONSTEXPR Vector4T& operator-=(const Vector4T&);
+		/** @brief multiplies a vector by this vector */
+		MATH3D_CONSTEXPR Vector4T& operator*=(const Vector4T&);
+		/** @brief divides this vector by a vector */
+		MATH3D_CONSTEXPR Vector4T& operator/=(const Vector4T&);
+
+		/** @brief adds a number to this vector */
+		MATH3D_CONSTEXPR Vector4T& operator+=(T);
+		/** @brief subtracts a number from this vector */
+		MATH3D_CONSTEXPR Vector4T& operator-=(T);
+		/** @brief multiplies a number by this vector */
+		MATH3D_CONSTEXPR Vector4T& operator*=(T);
+		/** @brief divides this vector by a number */
+		MATH3D_CONSTEXPR Vector4T& operator/=(T);
+
+		/** @brief indexes the components of the vector */
+		MATH3D_CONSTEXPR T operator[](int);
+		MATH3D_CONSTEXPR const T operator[](int) const;
+
+		T x, y, z, w;
+	private:
+};
+
+#include "vector3.hpp"
+#include "quaternion.hpp"
+
+// constexpr functions must be visible in every translation unit that uses
+// them, so they are defined here rather than in vector4.inl
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>::Vector4T()
+: x(0), y(0), z(0), w(0)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>::Vector4T(T x, T y, T z, T w)
+: x(x), y(y), z(z), w(w)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>::Vector4T(const Vector3T<T>& v3, T w)
+: x(v3.x), y(v3.y), z(v3.z), w(w)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>::Vector4T(const QuaternionT<T>& q)
+: x(q.x), y(q.y), z(q.z), w(q.w)
+{
+}
+
+template <typename T>
+template <typename U>
+MATH3D_CONSTEXPR Vector4T<T>::Vector4T(const Vector4T<U>& v4)
+: x((T)v4.x), y((T)v4.y), z((T)v4.z), w((T)v4.w)
+{
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector4T<T>::toVector3() const
+{
+	return Vector3T<T>(x, y, z);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector3T<T> Vector4T<T>::project() const
+{
+	return Vector3T<T>(x / w, y / w, z / w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR QuaternionT<T> Vector4T<T>::toQuaternion() const
+{
+	return QuaternionT<T>(x, y, z, w);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector4T<T>::dot(const Vector4T<T>& v4) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return x * v4.x + y * v4.y + z * v4.z + w * v4.w;
+	}
+
+	return math3d::detail::vec4Dot(&x, &v4.x);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector4T<T>::magSq() const
+{
+	return dot(*this);
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector4T<T>::operator==(const Vector4T<T>& v4) const
+{
+	return x == v4.x && y == v4.y && z == v4.z && w == v4.w;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR bool Vector4T<T>::operator!=(const Vector4T<T>& v4) const
+{
+	return x != v4.x || y != v4.y || z != v4.z || w != v4.w;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator-() const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(-x, -y, -z, -w);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4Negate(&out.x, &x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator+(const Vector4T<T>& v4) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x + v4.x, y + v4.y, z + v4.z, w + v4.w);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4Add(&out.x, &x, &v4.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator-(const Vector4T<T>& v4) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x - v4.x, y - v4.y, z - v4.z, w - v4.w);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4Sub(&out.x, &x, &v4.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator*(const Vector4T<T>& v4) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x * v4.x, y * v4.y, z * v4.z, w * v4.w);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4Mul(&out.x, &x, &v4.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator/(const Vector4T<T>& v4) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x / v4.x, y / v4.y, z / v4.z, w / v4.w);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4Div(&out.x, &x, &v4.x);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator+(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x + n, y + n, z + n, w + n);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4AddBroadcast(&out.x, &x, n, n);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator-(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x - n, y - n, z - n, w - n);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4SubBroadcast(&out.x, &x, n, n);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator*(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x * n, y * n, z * n, w * n);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4MulBroadcast(&out.x, &x, n, n);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T> Vector4T<T>::operator/(T n) const
+{
+	if (math3d::detail::isConstantEvaluated())
+	{
+		return Vector4T<T>(x / n, y / n, z / n, w / n);
+	}
+
+	Vector4T<T> out;
+
+	math3d::detail::vec4DivBroadcast(&out.x, &x, n, n);
+
+	return out;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator+=(const Vector4T<T>& v4)
+{
+	*this = *this + v4;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator-=(const Vector4T<T>& v4)
+{
+	*this = *this - v4;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator*=(const Vector4T<T>& v4)
+{
+	*this = *this * v4;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator/=(const Vector4T<T>& v4)
+{
+	*this = *this / v4;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator+=(T n)
+{
+	*this = *this + n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator-=(T n)
+{
+	*this = *this - n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator*=(T n)
+{
+	*this = *this * n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR Vector4T<T>& Vector4T<T>::operator/=(T n)
+{
+	*this = *this / n;
+
+	return *this;
+}
+
+template <typename T>
+MATH3D_CONSTEXPR T Vector4T<T>::operator[](int i)
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		case 3:
+			return w;
+		default:
+			return 0;
+	}
+}
+
+template <typename T>
+MATH3D_CONSTEXPR const T Vector4T<T>::operator[](int i) const
+{
+	switch (i)
+	{
+		case 0:
+			return x;
+		case 1:
+			return y;
+		case 2:
+			return z;
+		case 3:
+			return w;
+		default:
+			return 0;
+	}
+}
+
+#ifdef MATH3D_HEADER_ONLY
+#include "vector4.inl"
+#else
+extern template class Vector4T<float>;
+extern template class Vector4T<double>;
+#endif
+
+#endif
\ No newline at end of file
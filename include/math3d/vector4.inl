@@ -0,0 +1,26 @@
+#ifndef VECTOR4_INL
+#define VECTOR4_INL
+
+#include "config.hpp"
+#include "vector4.hpp"
+#include "kernels/table.hpp"
+#include <cmath>
+
+template <typename T>
+MATH3D_INLINE T Vector4T<T>::magnitude() const
+{
+	return std::sqrt(magSq());
+}
+
+template <typename T>
+MATH3D_INLINE Vector4T<T> Vector4T<T>::normalize(Precision precision) const
+{
+	if (precision == Precision::Fast)
+	{
+		return *this * math3d::detail::rsqrtFast(magSq());
+	}
+
+	return *this / magnitude();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "aabb.hpp"
+#include "aabb.inl"
+
+template class AABBT<float>;
+template class AABBT<double>;
+template AABBT<float>::AABBT(const AABBT<double>&);
+template AABBT<double>::AABBT(const AABBT<float>&);
\ No newline at end of file
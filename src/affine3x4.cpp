@@ -0,0 +1,7 @@
+#include "affine3x4.hpp"
+#include "affine3x4.inl"
+
+template class Affine3x4T<float>;
+template class Affine3x4T<double>;
+template Affine3x4T<float>::Affine3x4T(const Affine3x4T<double>&);
+template Affine3x4T<double>::Affine3x4T(const Affine3x4T<float>&);
\ No newline at end of file
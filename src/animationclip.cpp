@@ -0,0 +1,2 @@
+#include "animationclip.hpp"
+#include "animationclip.inl"
\ No newline at end of file
@@ -0,0 +1,2 @@
+#include "animationsampler.hpp"
+#include "animationsampler.inl"
\ No newline at end of file
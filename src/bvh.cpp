@@ -0,0 +1,2 @@
+#include "bvh.hpp"
+#include "bvh.inl"
\ No newline at end of file
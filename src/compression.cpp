@@ -0,0 +1,2 @@
+#include "compression.hpp"
+#include "compression.inl"
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "dispatch.hpp"
+#include "kernel_tables.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define MATH3D_X86
+#endif
+
+#ifdef MATH3D_X86
+/** @brief reads the extended control register holding the OS-enabled state components */
+static unsigned long long readXCR0()
+{
+	unsigned int eax, edx;
+
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+
+	return ((unsigned long long)edx << 32) | eax;
+}
+#endif
+
+SIMDLevel Dispatch::detect()
+{
+#ifdef MATH3D_X86
+	unsigned int eax, ebx, ecx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(edx & bit_SSE2))
+	{
+		return SIMDLevel::Scalar;
+	}
+
+	if (!(ecx & bit_SSE4_2))
+	{
+		return SIMDLevel::SSE2;
+	}
+
+	// AVX registers are only usable if the OS saves the YMM state
+	bool osAVX = (ecx & bit_OSXSAVE) && (ecx & bit_AVX) && (readXCR0() & 0x6) == 0x6;
+
+	if (!osAVX || !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2))
+	{
+		return SIMDLevel::SSE42;
+	}
+
+	// ...and the opmask and ZMM state for AVX-512
+	if (!(ebx & bit_AVX512F) || (readXCR0() & 0xE6) != 0xE6)
+	{
+		return SIMDLevel::AVX2;
+	}
+
+	return SIMDLevel::AVX512;
+#else
+	return SIMDLevel::Scalar;
+#endif
+}
+
+SIMDLevel Dispatch::level()
+{
+	const Kernels* current = active();
+
+	for (int i = (int)SIMDLevel::AVX512; i > (int)SIMDLevel::Scalar; i--)
+	{
+		if (current == &kernels((SIMDLevel)i))
+		{
+			return (SIMDLevel)i;
+		}
+	}
+
+	return SIMDLevel::Scalar;
+}
+
+SIMDLevel Dispatch::setLevel(SIMDLevel level)
+{
+	SIMDLevel supported = detect();
+
+	if (level > supported)
+	{
+		level = supported;
+	}
+
+	active() = &kernels(level);
+
+	return level;
+}
+
+const Kernels& Dispatch::kernels()
+{
+	return *active();
+}
+
+const Kernels& Dispatch::kernels(SIMDLevel level)
+{
+#ifdef MATH3D_X86
+	switch (level)
+	{
+		case SIMDLevel::SSE2:
+			return math3d::detail::sse2Kernels;
+		case SIMDLevel::SSE42:
+			return math3d::detail::sse42Kernels;
+		case SIMDLevel::AVX2:
+			return math3d::detail::avx2Kernels;
+		case SIMDLevel::AVX512:
+			return math3d::detail::avx512Kernels;
+		default:
+			return math3d::detail::scalarKernels;
+	}
+#else
+	return math3d::detail::scalarKernels;
+#endif
+}
+
+const char* Dispatch::levelName(SIMDLevel level)
+{
+	switch (level)
+	{
+		case SIMDLevel::SSE2:
+			return "sse2";
+		case SIMDLevel::SSE42:
+			return "sse4.2";
+		case SIMDLevel::AVX2:
+			return "avx2";
+		case SIMDLevel::AVX512:
+			return "avx512";
+		default:
+			return "scalar";
+	}
+}
+
+bool Dispatch::parseLevel(const char* name, SIMDLevel& level)
+{
+	for (int i = (int)SIMDLevel::Scalar; i <= (int)SIMDLevel::AVX512; i++)
+	{
+		if (strcmp(name, levelName((SIMDLevel)i)) == 0)
+		{
+			level = (SIMDLevel)i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** @brief selects the kernels to start with, honouring MATH3D_SIMD */
+static const Kernels* initialKernels()
+{
+	SIMDLevel level = Dispatch::detect();
+	SIMDLevel requested;
+	const char* env = getenv("MATH3D_SIMD");
+
+	if (env != nullptr && Dispatch::parseLevel(env, requested) && requested < level)
+	{
+		level = requested;
+	}
+
+	return &Dispatch::kernels(level);
+}
+
+const Kernels*& Dispatch::active()
+{
+	static const Kernels* current = initialKernels();
+
+	return current;
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "dualquaternion.hpp"
+#include "dualquaternion.inl"
+
+template class DualQuaternionT<float>;
+template class DualQuaternionT<double>;
+template DualQuaternionT<float>::DualQuaternionT(const DualQuaternionT<double>&);
+template DualQuaternionT<double>::DualQuaternionT(const DualQuaternionT<float>&);
\ No newline at end of file
@@ -0,0 +1,2 @@
+#include "frustum.hpp"
+#include "frustum.inl"
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef KERNEL_TABLES_HPP
+#define KERNEL_TABLES_HPP
+
+#include "dispatch.hpp"
+
+/**
+ * Kernel tables for each SIMDLevel, each defined in its own translation
+ * unit compiled with the matching instruction set flags
+ */
+namespace math3d
+{
+	namespace detail
+	{
+		extern const Kernels scalarKernels;
+
+#if defined(__x86_64__) || defined(__i386__)
+		extern const Kernels sse2Kernels;
+		extern const Kernels sse42Kernels;
+		extern const Kernels avx2Kernels;
+		extern const Kernels avx512Kernels;
+#endif
+	}
+}
+
+#endif
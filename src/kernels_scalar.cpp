@@ -0,0 +1,6 @@
+#include "kernel_tables.hpp"
+
+#define MATH3D_NO_SIMD
+#include "kernels/table.hpp"
+
+const Kernels math3d::detail::scalarKernels = math3d::detail::compileTimeKernels;
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "kernel_tables.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "kernels/table.hpp"
+
+const Kernels math3d::detail::sse2Kernels = math3d::detail::compileTimeKernels;
+#endif
\ No newline at end of file
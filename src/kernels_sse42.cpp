@@ -0,0 +1,10 @@
+#include "kernel_tables.hpp"
+
+// Same kernels as the SSE2 table, compiled with -msse4.2 so that the
+// compiler can use the SSE4.1 shuffle, blend and insert instructions
+
+#if defined(__x86_64__) || defined(__i386__)
+#include "kernels/table.hpp"
+
+const Kernels math3d::detail::sse42Kernels = math3d::detail::compileTimeKernels;
+#endif
\ No newline at end of file
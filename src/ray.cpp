@@ -0,0 +1,7 @@
+#include "ray.hpp"
+#include "ray.inl"
+
+template class RayT<float>;
+template class RayT<double>;
+template RayT<float>::RayT(const RayT<double>&);
+template RayT<double>::RayT(const RayT<float>&);
\ No newline at end of file
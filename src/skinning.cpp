@@ -0,0 +1,2 @@
+#include "skinning.hpp"
+#include "skinning.inl"
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "sphere.hpp"
+#include "sphere.inl"
+
+template class SphereT<float>;
+template class SphereT<double>;
+template SphereT<float>::SphereT(const SphereT<double>&);
+template SphereT<double>::SphereT(const SphereT<float>&);
\ No newline at end of file
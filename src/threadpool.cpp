@@ -0,0 +1,2 @@
+#include "threadpool.hpp"
+#include "threadpool.inl"
\ No newline at end of file
@@ -0,0 +1,2 @@
+#include "transformhierarchy.hpp"
+#include "transformhierarchy.inl"
\ No newline at end of file
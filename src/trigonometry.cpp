@@ -0,0 +1,2 @@
+#include "trigonometry.hpp"
+#include "trigonometry.inl"
\ No newline at end of file
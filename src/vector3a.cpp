@@ -0,0 +1,7 @@
+#include "vector3a.hpp"
+#include "vector3a.inl"
+
+template class Vector3AT<float>;
+template class Vector3AT<double>;
+template Vector3AT<float>::Vector3AT(const Vector3AT<double>&);
+template Vector3AT<double>::Vector3AT(const Vector3AT<float>&);
\ No newline at end of file
@@ -0,0 +1,2 @@
+#include "vector3array.hpp"
+#include "vector3array.inl"
\ No newline at end of file
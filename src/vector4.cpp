@@ -0,0 +1,7 @@
+#include "vector4.hpp"
+#include "vector4.inl"
+
+template class Vector4T<float>;
+template class Vector4T<double>;
+template Vector4T<float>::Vector4T(const Vector4T<double>&);
+template Vector4T<double>::Vector4T(const Vector4T<float>&);
\ No newline at end of file